@@ -3,11 +3,10 @@
 
 // Include the Spinnnaker SDK Wrapper header file
 #include "../include/SpinnakerSDK_SpinCamera.h"
-#include <atomic>
 #include <thread>
 #include <iostream>
 #include <cmath>
-#include <iostream>
+#include <vector>
 
 struct Color {
     std::string name;
@@ -75,14 +74,22 @@ int main() {
     // Manually start aquisition to save compute time
     camera.StartAcquisition();
 
-    // Create a trigger variable
-    std::atomic<bool> trigger(false);
+    // Create a trigger, the capture thread briefly spins and then sleeps on it, waking the moment it fires
+    SpinTrigger trigger(SpinOption::TriggerWaitPolicy::SpinThenBlock, 200);
 
     // Create a variable to store the captured image
     SpinImage capturedImage(nullptr);
 
     // Start a thread to capture an image on trigger
-    std::thread capture_thread(&SpinCamera::CaptureSingleFrameOnTrigger, &camera, std::ref(capturedImage), std::ref(trigger), 500);
+    // Give up if no frame arrives within 10 seconds, and report errors here since exceptions cannot leave a thread
+    bool captured = false;
+    std::thread capture_thread([&] {
+        try {
+            captured = camera.CaptureSingleFrameOnTrigger(capturedImage, trigger, std::chrono::seconds(10));
+        } catch (const std::exception& e) {
+            std::cerr << "Capture failed: " << e.what() << std::endl;
+        }
+    });
 
     // Simulate some other operations in main program
     for (int i = 5; i > 0; i--) {
@@ -90,36 +97,60 @@ int main() {
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
     
-    // Set the trigger to true
-    trigger.store(true);
+    // Fire the trigger (this also records the trigger time)
+    trigger.Fire();
 
-    // Start a timer as soon as the trigger goes high
-    auto triggerTime = std::chrono::high_resolution_clock::now();
+    // Start a timer as soon as the trigger fires
+    auto triggerTime = std::chrono::steady_clock::now();
 
     // Wait for the capture thread to complete
     capture_thread.join();
+    if (!captured) {
+        std::cout << "No image captured" << std::endl;
+        return 1;
+    }
     std::cout << "Captured Image" << std::endl;
 
-    auto imageTime = std::chrono::high_resolution_clock::now();
+    auto imageTime = std::chrono::steady_clock::now();
 
-    // Calculate the average color of specific regions
+    // Calculate the average color of specific regions, all of them in one pass over the raw image
+    int sample_square_size = 5;
+    std::vector<SpinRoi> regions;
     for (int x_loc = 45; x_loc < 200; x_loc=x_loc+55) {
         for (int y_loc = 45; y_loc < 200; y_loc=y_loc+55) {
-            int sample_square_size = 5;
-            unsigned char avgR, avgG, avgB;
-            capturedImage.CalculateAverageColor(x_loc, y_loc, sample_square_size, sample_square_size, avgR, avgG, avgB);
-            printClosestColor(avgR, avgG, avgB);
-            capturedImage.DrawRedSquare(x_loc, y_loc, sample_square_size);
+            SpinRoi region;
+            region.x = x_loc;
+            region.y = y_loc;
+            region.width = sample_square_size;
+            region.height = sample_square_size;
+            regions.push_back(region);
         }
     }
+    std::vector<SpinRoiStats> stats = capturedImage.CalculateRoiStats(regions);
+
+    // Marking them only demosaics the tiles under each square, saving the image at the end finishes the rest
+    for (const SpinRoiStats& region : stats) {
+        if (region.pixelCount == 0) {
+            continue;
+        }
+        unsigned char avgR = static_cast<unsigned char>(region.channels[0].sum / region.pixelCount);
+        unsigned char avgG = static_cast<unsigned char>(region.channels[1].sum / region.pixelCount);
+        unsigned char avgB = static_cast<unsigned char>(region.channels[2].sum / region.pixelCount);
+        printClosestColor(avgR, avgG, avgB);
+        capturedImage.DrawRedSquare(region.roi.x, region.roi.y, sample_square_size);
+    }
 
     // Capture the time point right after the colors are processed
-    auto computeDone = std::chrono::high_resolution_clock::now();
+    auto computeDone = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(imageTime - triggerTime).count();
     std::cout << "Duration from trigger to image capture: " << duration << " us (" << duration/1000 << "ms)" << std::endl;
     duration = std::chrono::duration_cast<std::chrono::microseconds>(computeDone - triggerTime).count();
     std::cout << "Duration from trigger to compute done: " << duration << " us (" << duration/1000 << "ms)" << std::endl;
 
+    // Compare the trigger with the frame's own timestamp, both on the camera clock
+    int64_t exposureDelay = static_cast<int64_t>(capturedImage.GetTimeStamp() - camera.HostToDeviceTime(trigger.GetTriggerTime()));
+    std::cout << "Duration from trigger to start of exposure: " << exposureDelay / 1000 << " us" << std::endl;
+
     // End aquisition
     camera.StopAcquisition();
 
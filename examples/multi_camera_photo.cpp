@@ -1,14 +1,26 @@
 // Include the Spinnnaker SDK Wrapper header file
 #include "../include/SpinnakerSDK_SpinCamera.h"
+#include "../include/SpinnakerSDK_SpinCameraRegistry.h"
+#include <iostream>
 
 int main() {
     // Create camera objects
     SpinCamera camera_1;
     SpinCamera camera_2;
 
-    // Initialize the cameras
-    camera_1.Initialize(0);
-    camera_2.Initialize(1);
+    // List the connected cameras (the bus is only enumerated once, all cameras share it)
+    std::vector<std::string> serialNumbers = SpinCameraRegistry::Instance().GetSerialNumbers();
+    for (const std::string& serialNumber : serialNumbers) {
+        std::cout << "Found camera " << serialNumber << std::endl;
+    }
+    if (serialNumbers.size() < 2) {
+        std::cout << "[ ERROR ] This example needs two cameras." << std::endl;
+        return 1;
+    }
+
+    // Initialize the cameras by serial number (a fixed serial, e.g. camera_1.Initialize("12345678"), always opens the same camera)
+    camera_1.Initialize(serialNumbers[0]);
+    camera_2.Initialize(serialNumbers[1]);
 
     // Set all settings to default values
     camera_1.SetDefaultSettings();
@@ -1,32 +1,44 @@
 // Include the Spinnnaker SDK Wrapper header file
 #include "../include/SpinnakerSDK_SpinCamera.h"
-#include <atomic>
+#include "../include/SpinnakerSDK_SpinCameraGroup.h"
 #include <thread>
 #include <iostream>
 
 int main() {
-    // Create camera objectss
-    SpinCamera camera_1;
-    SpinCamera camera_2;
+    // Create a group with both cameras
+    SpinCameraGroup cameras;
+    cameras.AddCamera(0);
+    cameras.AddCamera(1);
 
-    // Initialize the cameras
-    camera_1.Initialize(0);
-    camera_2.Initialize(1);
-
-    // Set all settings to default values
-    camera_1.SetDefaultSettings();
-    camera_2.SetDefaultSettings();
+    // Initialize the cameras and set all settings to default values, on both cameras at once
+    std::vector<SpinCameraGroupResult> results = cameras.Initialize();
+    SpinCameraGroup::PrintResults(results);
+    if (!cameras.IsReady(0) || !cameras.IsReady(1)) {
+        return 1;
+    }
+    SpinCamera& camera_1 = cameras[0];
+    SpinCamera& camera_2 = cameras[1];
 
-    // Create a trigger variable
-    std::atomic<bool> trigger(false);
+    // Create a trigger, capture threads sleep on it until it fires
+    SpinTrigger trigger;
 
     // Create a variable to store the captured image
     SpinImage capturedImage_1(nullptr);
     SpinImage capturedImage_2(nullptr);
 
     // Start a thread for each camera to capture a parallel image on a shared trigger
-    std::thread capture_thread_1(&SpinCamera::CaptureSingleFrameOnTrigger, &camera_1, std::ref(capturedImage_1), std::ref(trigger), 10000);
-    std::thread capture_thread_2(&SpinCamera::CaptureSingleFrameOnTrigger, &camera_2, std::ref(capturedImage_2), std::ref(trigger), 10000);
+    // Give up if no frame arrives within 10 seconds, and report errors here since exceptions cannot leave a thread
+    bool captured_1 = false;
+    bool captured_2 = false;
+    auto capture = [&trigger](SpinCamera& camera, SpinImage& image, bool& captured) {
+        try {
+            captured = camera.CaptureSingleFrameOnTrigger(image, trigger, std::chrono::seconds(10));
+        } catch (const std::exception& e) {
+            std::cerr << "Capture failed: " << e.what() << std::endl;
+        }
+    };
+    std::thread capture_thread_1([&] { capture(camera_1, capturedImage_1, captured_1); });
+    std::thread capture_thread_2([&] { capture(camera_2, capturedImage_2, captured_2); });
 
     // Simulate some other operations in main program
     for (int i = 5; i > 0; i--) {
@@ -34,12 +46,16 @@ int main() {
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
     
-    // Set the trigger to true
-    trigger.store(true);
+    // Fire the trigger
+    trigger.Fire();
 
     // Wait for the capture threads to complete
     capture_thread_1.join();
     capture_thread_2.join();
+    if (!captured_1 || !captured_2) {
+        std::cout << "Not every camera captured an image" << std::endl;
+        return 1;
+    }
     std::cout << "Captured Images" << std::endl;
 
     // Save the image
@@ -1,83 +1,63 @@
 #include "../include/SpinnakerSDK_SpinCamera.h"
-#include <filesystem>
+#include "../include/SpinnakerSDK_SpinCameraGroup.h"
+#include "../include/SpinnakerSDK_SpinFrameSynchronizer.h"
+#include "../include/SpinnakerSDK_SpinVideoWriter.h"
 #include <iostream>
 #include <string>
-#include <cstdlib>
-#include <iomanip>
 #include <vector>
-#include <thread>
-
-void createVideoFromImages(const std::string&, const std::string&, int);
-void captureFrames(SpinCamera&, std::vector<SpinImage>&, int, const std::string&);
-
-namespace fs = std::__fs::filesystem;
 
 int main() {
-    // Create folders to store the video frames
-    std::string folderName_1 = "Camera_1_parallel_frames";
-    std::string folderName_2 = "Camera_2_parallel_frames";
-    if (!fs::exists(folderName_1)) {
-        fs::create_directory(folderName_1);
+    // Create a group with both cameras
+    SpinCameraGroup cameras;
+    cameras.AddCamera(0);
+    cameras.AddCamera(1);
+
+    // Initialize the cameras and set all settings to default values, on both cameras at once
+    SpinCameraGroup::PrintResults(cameras.Initialize());
+    if (!cameras.IsReady(0) || !cameras.IsReady(1)) {
+        return 1;
     }
-    if (!fs::exists(folderName_2)) {
-        fs::create_directory(folderName_2);
-    }
-
-    // Create camera objects
-    SpinCamera camera_1;
-    SpinCamera camera_2;
+    SpinCamera& camera_1 = cameras[0];
+    SpinCamera& camera_2 = cameras[1];
+
+    // Put the frames of both cameras on the host clock, and pair up frames captured within 5 ms of each other
+    SpinFrameSynchronizer synchronizer(2, std::chrono::milliseconds(5));
+    camera_1.SynchronizeClock();
+    camera_2.SynchronizeClock();
+    synchronizer.SetClockOffset(0, camera_1.GetClockOffset());
+    synchronizer.SetClockOffset(1, camera_2.GetClockOffset());
+
+    // Stream both cameras at once, each from its own event thread
+    camera_1.StartStream(synchronizer.GetStreamHandler(0));
+    camera_2.StartStream(synchronizer.GetStreamHandler(1));
+
+    // Encode matched frame sets (video frames) into one video per camera while they are being captured
+    // Each writer converts and pipes its frames on a background thread, nothing goes through image files on disk
+    SpinVideoWriterConfig videoConfig;
+    videoConfig.frameRate = 30;
+    SpinVideoWriter videoWriter_1(videoConfig);
+    SpinVideoWriter videoWriter_2(videoConfig);
+    videoWriter_1.OpenPipe(SpinVideoWriter::FfmpegCommand("../Camera_1_Parallel_Video.mp4"));
+    videoWriter_2.OpenPipe(SpinVideoWriter::FfmpegCommand("../Camera_2_Parallel_Video.mp4"));
 
-    // Initialize the cameras
-    camera_1.Initialize(0);
-    camera_2.Initialize(1);
-
-    // Set all settings to default values
-    camera_1.SetDefaultSettings();
-    camera_2.SetDefaultSettings();
-
-    // Capture all images (video frames)
     int numFrames = 100;
-    std::vector<SpinImage> videoFrames_1;
-    std::vector<SpinImage> videoFrames_2;
-
-    // Create threads to capture frames simultaneously
-    std::thread thread_1(captureFrames, std::ref(camera_1), std::ref(videoFrames_1), numFrames, folderName_1);
-    std::thread thread_2(captureFrames, std::ref(camera_2), std::ref(videoFrames_2), numFrames, folderName_2);
+    int writtenFrames = 0;
+    SpinFrameSet frameSet;
+    while (writtenFrames < numFrames && synchronizer.GetFrameSet(frameSet, std::chrono::milliseconds(1000))) {
+        videoWriter_1.Push(frameSet.frames[0]);
+        videoWriter_2.Push(frameSet.frames[1]);
+        writtenFrames++;
+    }
 
-    // Wait for both threads to complete
-    thread_1.join();
-    thread_2.join();
+    camera_1.StopStream();
+    camera_2.StopStream();
+    synchronizer.PrintStats();
 
-    // Use ffmpeg to create a video from the images
-    int fps = 30;
-    createVideoFromImages(folderName_1, "../Camera_1_Parallel_Video.mp4", 30);
-    createVideoFromImages(folderName_2, "../Camera_2_Parallel_Video.mp4", 30);
+    // Wait for both encoders to finish
+    videoWriter_1.Close();
+    videoWriter_2.Close();
+    videoWriter_1.PrintStats();
+    videoWriter_2.PrintStats();
 
     return 0;
 }
-
-void captureFrames(SpinCamera& camera, std::vector<SpinImage>& frames, int numFrames, const std::string& folderName) {
-    camera.CaptureContinuousFrames(frames, numFrames);
-    for (int i = 0; i < frames.size(); ++i) {
-        std::ostringstream filename;
-        filename << folderName << "/video_frame_" << std::setw(4) << std::setfill('0') << i << ".png";
-        frames[i].SaveImage(filename.str());
-    }
-}
-
-void createVideoFromImages(const std::string& folderPath, const std::string& outputVideoPath, int fps) {
-    // Construct the ffmpeg command
-    std::string command = "cd " + folderPath + " && ffmpeg -framerate " + std::to_string(fps) + " -i video_frame_%04d.png -c:v libx264 -pix_fmt yuv420p " + outputVideoPath;
-    
-    // Print the command to verify it's correct
-    std::cout << "Running command: " << command << std::endl;
-
-    // Execute the command
-    int result = system(command.c_str());
-    
-    if (result != 0) {
-        std::cerr << "Error: ffmpeg command failed with exit code " << result << std::endl;
-    } else {
-        std::cout << "Video created successfully: " << outputVideoPath << std::endl;
-    }
-}
\ No newline at end of file
@@ -1,27 +1,12 @@
 #include "../include/SpinnakerSDK_SpinCamera.h"
-#include <filesystem>
+#include "../include/SpinnakerSDK_SpinVideoWriter.h"
 #include <iostream>
 #include <string>
-#include <cstdlib>
-#include <iomanip>
 #include <vector>
-#include <thread>
 
-void createVideoFromImages(const std::string&, const std::string&, int);
-
-namespace fs = std::__fs::filesystem;
+void writeVideo(std::vector<SpinImage>&, const std::string&, double);
 
 int main() {
-    // Create folders to store the video frames
-    std::string folderName_1 = "Camera_1_sequential_frames";
-    std::string folderName_2 = "Camera_2_sequential_frames";
-    if (!fs::exists(folderName_1)) {
-        fs::create_directory(folderName_1);
-    }
-    if (!fs::exists(folderName_2)) {
-        fs::create_directory(folderName_2);
-    }
-
     // Create camera objects
     SpinCamera camera_1;
     SpinCamera camera_2;
@@ -43,39 +28,21 @@ int main() {
     camera_1.CaptureContinuousFrames(videoFrames_1, numFrames);
     camera_2.CaptureContinuousFrames(videoFrames_2, numFrames);
 
-    // Process all images
-    for (int i = 0; i < videoFrames_1.size(); ++i) {
-        std::ostringstream filename;
-        filename << folderName_1 << "/video_frame_" << std::setw(4) << std::setfill('0') << i << ".png";
-        videoFrames_1[i].SaveImage(filename.str());
-    }
-    for (int i = 0; i < videoFrames_2.size(); ++i) {
-        std::ostringstream filename;
-        filename << folderName_2 << "/video_frame_" << std::setw(4) << std::setfill('0') << i << ".png";
-        videoFrames_2[i].SaveImage(filename.str());
-    }
-
-    // Use ffmpeg to create a video from the images
-    int fps = 30;
-    createVideoFromImages(folderName_1, "../Camera_1_Sequential_Video.mp4", 30);
-    createVideoFromImages(folderName_2, "../Camera_2_Sequential_Video.mp4", 30);
+    // Encode the frames of each camera straight into its own video, without writing any images to disk
+    writeVideo(videoFrames_1, "../Camera_1_Sequential_Video.mp4", 30);
+    writeVideo(videoFrames_2, "../Camera_2_Sequential_Video.mp4", 30);
 
     return 0;
 }
 
-void createVideoFromImages(const std::string& folderPath, const std::string& outputVideoPath, int fps) {
-    // Construct the ffmpeg command
-    std::string command = "cd " + folderPath + " && ffmpeg -framerate " + std::to_string(fps) + " -i video_frame_%04d.png -c:v libx264 -pix_fmt yuv420p " + outputVideoPath;
-    
-    // Print the command to verify it's correct
-    std::cout << "Running command: " << command << std::endl;
-
-    // Execute the command
-    int result = system(command.c_str());
-    
-    if (result != 0) {
-        std::cerr << "Error: ffmpeg command failed with exit code " << result << std::endl;
-    } else {
-        std::cout << "Video created successfully: " << outputVideoPath << std::endl;
+void writeVideo(std::vector<SpinImage>& frames, const std::string& outputVideoPath, double fps) {
+    SpinVideoWriterConfig videoConfig;
+    videoConfig.frameRate = fps;
+    SpinVideoWriter videoWriter(videoConfig);
+    videoWriter.OpenPipe(SpinVideoWriter::FfmpegCommand(outputVideoPath));
+    for (SpinImage& frame : frames) {
+        videoWriter.Push(frame);
     }
-}
\ No newline at end of file
+    videoWriter.Close();
+    std::cout << "Video created: " << outputVideoPath << " (" << videoWriter.GetStats().framesWritten << " frames)" << std::endl;
+}
@@ -1,6 +1,5 @@
 // Include the Spinnnaker SDK Wrapper header file
 #include "../include/SpinnakerSDK_SpinCamera.h"
-#include <atomic>
 #include <thread>
 #include <iostream>
 
@@ -14,14 +13,22 @@ int main() {
     // Set all settings to default values
     camera.SetDefaultSettings();
 
-    // Create a trigger variable
-    std::atomic<bool> trigger(false);
+    // Create a trigger, capture threads sleep on it until it fires
+    SpinTrigger trigger;
 
     // Create a variable to store the captured image
     SpinImage capturedImage(nullptr);
 
     // Start a thread to capture an image on trigger
-    std::thread capture_thread(&SpinCamera::CaptureSingleFrameOnTrigger, &camera, std::ref(capturedImage), std::ref(trigger), 10000);
+    // Give up if no frame arrives within 10 seconds, and report errors here since exceptions cannot leave a thread
+    bool captured = false;
+    std::thread capture_thread([&] {
+        try {
+            captured = camera.CaptureSingleFrameOnTrigger(capturedImage, trigger, std::chrono::seconds(10));
+        } catch (const std::exception& e) {
+            std::cerr << "Capture failed: " << e.what() << std::endl;
+        }
+    });
 
     // Simulate some other operations in main program
     for (int i = 5; i > 0; i--) {
@@ -29,11 +36,15 @@ int main() {
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
     
-    // Set the trigger to true
-    trigger.store(true);
+    // Fire the trigger
+    trigger.Fire();
 
     // Wait for the capture thread to complete
     capture_thread.join();
+    if (!captured) {
+        std::cout << "No image captured" << std::endl;
+        return 1;
+    }
     std::cout << "Captured Image" << std::endl;
 
     // Save the image
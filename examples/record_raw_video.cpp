@@ -0,0 +1,49 @@
+// Record raw frames straight to disk for as long as the disk keeps up, and convert them later
+
+// Include the Spinnnaker SDK Wrapper header file
+#include "../include/SpinnakerSDK_SpinCamera.h"
+#include "../include/SpinnakerSDK_SpinRawRecorder.h"
+#include <iostream>
+#include <thread>
+
+int main() {
+    // Create a camera object
+    SpinCamera camera;
+
+    // Initialize the camera (index 0)
+    camera.Initialize(0);
+
+    // Set all settings to default values
+    camera.SetDefaultSettings();
+
+    // Write 8 MiB at a time from two writer threads, with 128 MiB of chunks to absorb slow moments of the disk
+    SpinRawRecorderConfig config;
+    config.chunkSize = 8 * 1024 * 1024;
+    config.chunkCount = 16;
+    config.writerThreads = 2;
+    // Reserve 4 GiB up front, the file is trimmed to what was actually recorded
+    config.preallocateBytes = 4ull * 1024 * 1024 * 1024;
+    // Compress the Bayer data losslessly on four cores, roughly halving what goes to the disk
+    config.compression = SpinRawFormat::Compression::BayerLossless;
+    config.codecOptions.threadCount = 4;
+
+    // Open the recording, sized for the largest frame the camera can send
+    SpinRawRecorder recorder(config);
+    recorder.Open("recording.spinraw", static_cast<size_t>(camera.GetBackend()->GetIntegerValue("PayloadSize")));
+
+    // Stream every frame into the recorder for 10 seconds
+    camera.StartStream(recorder.GetStreamHandler());
+    for (int second = 0; second < 10; ++second) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        SpinRawRecorderStats stats = recorder.GetStats();
+        std::cout << stats.framesWritten << " frames written, " << stats.framesDropped << " dropped, "
+                  << stats.chunksInFlight << " chunks waiting on the disk" << std::endl;
+    }
+    camera.StopStream();
+
+    // Finish the file and report how the disk kept up
+    recorder.Close();
+    recorder.PrintStats();
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+// Jump around a raw recording (see record_raw_video) without decoding or loading the frames in between
+
+// Include the Spinnnaker SDK Wrapper header file
+#include "../include/SpinnakerSDK_SpinRawReader.h"
+#include <iostream>
+
+int main() {
+    // Map the recording, only the frame index is read up front
+    SpinRawReader reader("recording.spinraw");
+    std::cout << reader.GetFrameCount() << " frames spanning "
+              << (reader.GetLastTimestamp() - reader.GetFirstTimestamp()) / 1e9 << " seconds" << std::endl;
+    if (reader.GetFrameCount() == 0) {
+        return 0;
+    }
+
+    // Look at the frame in the middle of the recording
+    SpinImage middle = reader.GetFrame(reader.GetFrameCount() / 2);
+    middle.PrintSimpleImageInformation();
+
+    // Pull out the 100 ms following the first second, the frames are views of the file and copy nothing
+    uint64_t start = reader.GetFirstTimestamp() + 1000000000ull;
+    std::vector<SpinImage> frames = reader.GetFrames(start, start + 100000000ull);
+    for (SpinImage& frame : frames) {
+        unsigned char avgR, avgG, avgB;
+        frame.CalculateAverageColor(frame.GetWidth() / 2, frame.GetHeight() / 2, 10, 10, avgR, avgG, avgB);
+        std::cout << "Frame " << frame.GetFrameID() << " center color: (" << (int)avgR << ", " << (int)avgG << ", " << (int)avgB << ")" << std::endl;
+    }
+
+    // Play the recording back, reading a few frames ahead of the one being shown
+    for (size_t i = 0; i < reader.GetFrameCount(); ++i) {
+        reader.Prefetch(i + 1, 8);
+        SpinImage frame = reader.GetFrame(i);
+        // ... display or analyze the frame
+    }
+
+    return 0;
+}
@@ -18,5 +18,15 @@ int main() {
     // Save the image (specify any path and filetype)
     image.SaveImage("Simple_Photo.png");
 
+    // Save it again with the built-in encoders, trading size for speed: a fast PNG and a quality 85 JPEG, both
+    // compressed on every core
+    SpinEncodeOptions fastPng;
+    fastPng.pngCompressionLevel = 1;
+    image.SaveImage("Simple_Photo_Fast.png", fastPng);
+
+    SpinEncodeOptions jpeg;
+    jpeg.jpegQuality = 85;
+    image.SaveImage("Simple_Photo.jpg", jpeg);
+
     return 0;
 }
\ No newline at end of file
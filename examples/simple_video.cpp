@@ -1,22 +1,11 @@
 // Include the Spinnnaker SDK Wrapper header file
 #include "../include/SpinnakerSDK_SpinCamera.h"
-#include <filesystem>
+#include "../include/SpinnakerSDK_SpinVideoWriter.h"
 #include <iostream>
 #include <string>
-#include <cstdlib>
-#include <iomanip>
 #include <vector>
 
-void createVideoFromImages(const std::string&, const std::string&, int);
-namespace fs = std::__fs::filesystem;
-
 int main() {
-    // Create a folder to store the video frames
-    std::string folderName = "video_frames";
-    if (!fs::exists(folderName)) {
-        fs::create_directory(folderName);
-    }
-
     // Create a camera object
     SpinCamera camera;
 
@@ -26,40 +15,29 @@ int main() {
     // Set all settings to default values
     camera.SetDefaultSettings();
 
-    // Capture all images (video frames)
+    // Preallocate storage for every frame so the capture never waits on the allocator
     int numFrames = 100;
+    camera.CreateFramePool(numFrames);
+
+    // Give the stream enough buffers to ride out a 250 ms hiccup, without pinning more than 256 MiB
+    camera.SetBufferPolicy(SpinBufferPolicy(250.0, 256 * 1024 * 1024));
+
+    // Capture all images (video frames)
     std::vector<SpinImage> videoFrames;
     camera.CaptureContinuousFrames(videoFrames, numFrames);
-
-    // Process video frames (e.g., save them to files)
-    for (int i = 0; i < videoFrames.size(); ++i) {
-        std::ostringstream filename;
-        filename << folderName << "/video_frame_" << std::setw(4) << std::setfill('0') << i << ".png";
-        videoFrames[i].SaveImage(filename.str());
+    camera.GetFramePool()->PrintStats();
+    std::cout << "Stream buffers: " << camera.GetBufferDecision().rationale << std::endl;
+
+    // Encode the frames straight into a video, ffmpeg reads them from a pipe so no images are written to disk
+    SpinVideoWriterConfig videoConfig;
+    videoConfig.frameRate = 30;
+    SpinVideoWriter videoWriter(videoConfig);
+    videoWriter.OpenPipe(SpinVideoWriter::FfmpegCommand("../simple_video.mp4"));
+    for (SpinImage& frame : videoFrames) {
+        videoWriter.Push(frame);
     }
-
-    // Use ffmpeg to create a video from the images
-    int fps = 30;
-    std::string folderPath = "./video_frames";
-    std::string outputVideoPath = "../simple_video.mp4";
-    createVideoFromImages(folderPath, outputVideoPath, fps);
+    videoWriter.Close();
+    videoWriter.PrintStats();
 
     return 0;
 }
-
-void createVideoFromImages(const std::string& folderPath, const std::string& outputVideoPath, int fps) {
-    // Construct the ffmpeg command
-    std::string command = "cd " + folderPath + " && ffmpeg -framerate " + std::to_string(fps) + " -i video_frame_%04d.png -c:v libx264 -pix_fmt yuv420p " + outputVideoPath;
-    
-    // Print the command to verify it's correct
-    std::cout << "Running command: " << command << std::endl;
-
-    // Execute the command
-    int result = system(command.c_str());
-    
-    if (result != 0) {
-        std::cerr << "Error: ffmpeg command failed with exit code " << result << std::endl;
-    } else {
-        std::cout << "Video created successfully: " << outputVideoPath << std::endl;
-    }
-}
\ No newline at end of file
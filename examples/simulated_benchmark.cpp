@@ -0,0 +1,56 @@
+// Measure capture throughput and latency without a camera attached, using the simulated camera backend
+
+// Include the Spinnnaker SDK Wrapper header file
+#include "../include/SpinnakerSDK_SpinCamera.h"
+#include "../include/SpinnakerSDK_SpinSimulatedBackend.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main() {
+    // Describe the simulated camera (1440x1080 BayerRG8 at up to 200 fps, with some frames lost or incomplete)
+    SpinSimulatedCameraConfig config;
+    config.frameRate = 200.0;
+    config.dropProbability = 0.01;
+    config.incompleteProbability = 0.01;
+
+    // Create a camera object backed by the simulated camera
+    SpinCamera camera;
+    SpinSimulatedBackend* simulated = new SpinSimulatedBackend(config);
+    camera.Initialize(std::unique_ptr<SpinCameraBackend>(simulated));
+
+    // Set all settings to default values, with a short exposure so the frame rate is not capped by it
+    camera.SetDefaultSettings();
+    camera.SetExposureTime(SpinOption::ExposureTime::Preset_1ms);
+
+    // Stream into a queue and time how long each frame took from exposure to being processed
+    SpinQueue<SpinImage> frameQueue(32);
+    camera.SynchronizeClock();
+    camera.StartStream(frameQueue);
+
+    int numFrames = 1000;
+    std::vector<double> latencies;
+    latencies.reserve(numFrames);
+    auto startTime = std::chrono::steady_clock::now();
+    SpinImage frame(nullptr);
+    while (static_cast<int>(latencies.size()) < numFrames) {
+        if (!frameQueue.TryPop(frame)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+        uint64_t now = camera.HostToDeviceTime(SpinTrigger::Now());
+        latencies.push_back((now - frame.GetTimeStamp()) / 1000000.0);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    camera.StopStream();
+
+    // Print the results
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Frames processed: " << numFrames << " in " << seconds << " s (" << numFrames / seconds << " fps)" << std::endl;
+    std::cout << "Exposure to processing latency: median " << latencies[numFrames / 2] << " ms, 99th percentile " << latencies[numFrames * 99 / 100] << " ms" << std::endl;
+    std::cout << "Frames generated: " << simulated->GetGeneratedFrames() << ", lost in transport: " << simulated->GetInjectedDrops()
+              << ", incomplete: " << simulated->GetInjectedIncompletes() << ", dropped by the queue: " << camera.GetStreamDroppedFrames() << std::endl;
+
+    return 0;
+}
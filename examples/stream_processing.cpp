@@ -0,0 +1,56 @@
+// Process frames while they are still being captured, instead of waiting for the whole capture to finish
+
+// Include the Spinnnaker SDK Wrapper header file
+#include "../include/SpinnakerSDK_SpinCamera.h"
+#include <iostream>
+#include <thread>
+
+int main() {
+    // Create a camera object
+    SpinCamera camera;
+
+    // Initialize the camera (index 0)
+    camera.Initialize(0);
+
+    // Set all settings to default values
+    camera.SetDefaultSettings();
+
+    // Create a queue that the camera fills as frames arrive
+    // Memory stays flat no matter how long the stream runs, frames are dropped (and counted) if processing falls behind
+    SpinQueue<SpinImage> frameQueue(32);
+
+    // Line up the camera and host clocks, so the telemetry can measure how long frames take to arrive
+    camera.SynchronizeClock();
+
+    // Start streaming
+    camera.StartStream(frameQueue);
+
+    // Process frames as they arrive
+    int numFrames = 300;
+    int processedFrames = 0;
+    SpinImage frame(nullptr);
+    while (processedFrames < numFrames) {
+        if (!frameQueue.TryPop(frame)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        // Sample the average color at the center of the frame
+        unsigned char avgR, avgG, avgB;
+        frame.CalculateAverageColor(frame.GetWidth() / 2, frame.GetHeight() / 2, 10, 10, avgR, avgG, avgB);
+        std::cout << "Frame " << frame.GetFrameID() << " center color: (" << (int)avgR << ", " << (int)avgG << ", " << (int)avgB << ")" << std::endl;
+        processedFrames++;
+
+        // Publish the capture health every 100 frames (e.g. for a Prometheus node exporter textfile collector)
+        if (processedFrames % 100 == 0) {
+            camera.GetTelemetry()->WriteFile("camera_telemetry.prom");
+        }
+    }
+
+    // Stop streaming
+    camera.StopStream();
+    std::cout << "Dropped frames: " << camera.GetStreamDroppedFrames() << std::endl;
+    camera.GetTelemetry()->PrintStats();
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef SPINNAKER_SDK_SPINBAYERCODEC_H
+#define SPINNAKER_SDK_SPINBAYERCODEC_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include "SpinnakerSDK_SpinThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct SpinBayerCodecOptions {
+    size_t threadCount = 0;         // Tiles coded at once, 0 means one per hardware thread, 1 codes on the calling thread
+    int tileRows = 64;              // Rows of each colour plane per tile (rounded up to a multiple of 4)
+    SpinThreadPool* pool = nullptr; // Pool to code the tiles on instead of the codec's own
+};
+
+// Lossless compression for raw Bayer (and Mono) frames in 8, 10p, 12p and 16 bit formats
+// The frame is split into its four colour planes (the 2x2 CFA sites), so neighbouring samples of a plane have the same
+// colour and predict each other well. Each sample is predicted from its left, upper and upper-left neighbours (the
+// LOCO-I median edge detector) and the residual is Rice coded with a running estimate of its magnitude. The frame is cut
+// into horizontal tiles that are coded independently and in parallel, a tile that does not compress is stored as is,
+// so the output is never much larger than the input. Decoding restores the frame byte for byte.
+class SpinBayerCodec {
+public:
+    explicit SpinBayerCodec(const SpinBayerCodecOptions& options = SpinBayerCodecOptions());
+
+    // Compress a frame, output is replaced
+    void Encode(const SpinImage& frame, std::vector<unsigned char>& output);
+    void Encode(const unsigned char* data, size_t size, int width, int height, Spinnaker::PixelFormatEnums pixelFormat, std::vector<unsigned char>& output);
+
+    // Restore a frame into output (GetDecodedSize bytes)
+    void Decode(const unsigned char* data, size_t size, unsigned char* output, size_t outputSize);
+    static size_t GetDecodedSize(const unsigned char* data, size_t size);
+
+    // Bits per sample of a supported pixel format, 0 if the codec cannot handle it
+    static int GetBitsPerPixel(Spinnaker::PixelFormatEnums pixelFormat);
+    // Largest possible output for a frame of the given size (to size buffers)
+    static size_t GetMaxEncodedSize(size_t size, int height, int tileRows = 64);
+
+private:
+    void ForEachTile(size_t tileCount, const std::function<void(size_t)>& body);
+
+    SpinBayerCodecOptions options;
+    std::unique_ptr<SpinThreadPool> ownPool;
+};
+
+#endif // SPINNAKER_SDK_SPINBAYERCODEC_H
@@ -0,0 +1,90 @@
+#ifndef SPINNAKER_SDK_SPINBAYERSTATS_H
+#define SPINNAKER_SDK_SPINBAYERSTATS_H
+
+#include "SpinnakerSDK_SpinImageView.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Rectangle of pixels, clipped to the frame when the statistics are computed
+struct SpinRoi {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Statistics of one colour channel over the pixels of a region
+struct SpinChannelStats {
+    uint64_t sum = 0;
+    uint64_t sumOfSquares = 0;
+    double mean = 0.0;
+    double variance = 0.0;  // Of the population (divided by the pixel count)
+    unsigned char min = 0;
+    unsigned char max = 0;
+};
+
+struct SpinRoiStats {
+    SpinRoi roi;                  // The region after clipping
+    uint64_t pixelCount = 0;
+    SpinChannelStats channels[3]; // R, G, B
+};
+
+// What the samples of a frame are: one per pixel behind a colour filter, grey, or R, G and B next to each other
+struct SpinSampleLayout {
+    enum class Kind {
+        Bayer,
+        Mono,
+        RGB
+    };
+    Kind kind = Kind::Bayer;
+    SpinBayer::Pattern pattern = SpinBayer::Pattern::RGGB;  // Of Bayer samples
+};
+
+// Per channel statistics of many regions of a frame, straight from the raw samples
+// Every pixel gets the colour SpinImage::GetPixelRGB gives it. On Bayer frames (of any pattern) that is red and blue from
+// its 2x2 quad, green its own sample on a green site and the truncated average of the quad's two greens on a red or blue
+// one, grey frames repeat the sample and RGB frames are read as they are. So a region's sum divided by its pixel count is
+// what SpinImage::CalculateAverageColor returns. All regions are done in one pass down the frame, each row is read once for
+// every region crossing it, whole Bayer quads 8 at a time with SIMD. Samples past the last row or column (odd sized frames)
+// are taken from the last one.
+// 10p, 12p (one stream of samples when the stride is 0) and 16 bit samples (bitsPerPixel) are reduced to 8 bits a row at a
+// time as the pass reaches it, keeping the top 8 bits of every sample or mapping it through toneMap (see SpinUnpacker).
+class SpinBayerStats {
+public:
+    static void Compute(const unsigned char* bayer, size_t bayerStride, int width, int height, const SpinRoi* rois, size_t count,
+                        SpinRoiStats* results, int bitsPerPixel = 8, const unsigned char* toneMap = nullptr,
+                        const SpinSampleLayout& layout = SpinSampleLayout());
+    static std::vector<SpinRoiStats> Compute(const unsigned char* bayer, size_t bayerStride, int width, int height,
+                                             const std::vector<SpinRoi>& rois, int bitsPerPixel = 8, const unsigned char* toneMap = nullptr,
+                                             const SpinSampleLayout& layout = SpinSampleLayout());
+};
+
+// Summed-area tables of the R, G and B of a frame (the GetPixelRGB colours, like SpinBayerStats)
+// Entry (x, y) of a table is the sum over every pixel above and to the left of (x, y), so the sum over any region is four
+// lookups, whatever its size. Worth building when many regions of the same frame are asked for. Building is one pass,
+// the running sum along each row in vectors of four. The tables are 32 bit and wrap around, which the differences
+// undo. That is exact up to 16.8 million pixels per region, larger regions are summed in strips that fit.
+// Deeper samples are reduced to 8 bits row by row while building, as in SpinBayerStats.
+class SpinBayerIntegralImage {
+public:
+    SpinBayerIntegralImage(const unsigned char* bayer, size_t bayerStride, int width, int height, int bitsPerPixel = 8,
+                           const unsigned char* toneMap = nullptr, const SpinSampleLayout& layout = SpinSampleLayout());
+
+    // Sums over the region (clipped to the frame), pixelCount is the number of pixels summed
+    void GetSums(const SpinRoi& roi, uint64_t sums[3], uint64_t& pixelCount) const;
+    // Truncated means, 0 for an empty region (what SpinImage::CalculateAverageColor returns)
+    void GetAverage(const SpinRoi& roi, unsigned char& R, unsigned char& G, unsigned char& B) const;
+
+    int GetWidth() const;
+    int GetHeight() const;
+    size_t GetMemorySize() const;
+
+private:
+    int width;
+    int height;
+    size_t tableStride;              // width + 1, the first row and column are zeros
+    std::vector<uint32_t> tables[3]; // R, G, B
+};
+
+#endif // SPINNAKER_SDK_SPINBAYERSTATS_H
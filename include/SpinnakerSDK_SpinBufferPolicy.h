@@ -0,0 +1,41 @@
+#ifndef SPINNAKER_SDK_SPINBUFFERPOLICY_H
+#define SPINNAKER_SDK_SPINBUFFERPOLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Stream buffer count chosen by a SpinBufferPolicy, and why
+struct SpinBufferDecision {
+    int64_t bufferCount = 0;        // Number of stream buffers to allocate
+    int64_t stallBuffers = 0;       // Buffers needed to ride out the stall tolerance at the frame rate
+    int64_t heldBuffers = 0;        // Buffers kept busy by the caller (e.g. leased frames)
+    int64_t payloadSize = 0;        // Bytes per buffer (0 if unknown)
+    double frameRate = 0.0;         // Frames per second (0 if unknown)
+    double stallToleranceMs = 0.0;  // Consumer stall the buffers absorb with the chosen count
+    size_t memoryBytes = 0;         // bufferCount x payloadSize
+    bool limitedByMemory = false;   // The memory budget capped the count below what the stall tolerance asks for
+    std::string rationale;          // Human readable summary of the above
+};
+
+// Sizes the stream buffer pool from the frame size, the frame rate, the longest consumer stall to absorb and a memory
+// budget, instead of a fixed count. Too few buffers drop frames whenever processing hiccups, too many pin memory for nothing.
+class SpinBufferPolicy {
+public:
+    explicit SpinBufferPolicy(double stallToleranceMs = 500.0, size_t memoryBudgetBytes = 512ull * 1024 * 1024);
+
+    void SetStallTolerance(double stallToleranceMs);
+    void SetMemoryBudget(size_t memoryBudgetBytes);
+    double GetStallTolerance() const;
+    size_t GetMemoryBudget() const;
+
+    // Buffer count for the given stream, clamped to [minCount, maxCount] (the limits of the camera's buffer count node)
+    // heldFrames are buffers the caller keeps busy on top of the stall (leased frames), they are always added.
+    SpinBufferDecision Decide(int64_t payloadSize, double frameRate, size_t heldFrames = 0, int64_t minCount = 1, int64_t maxCount = INT64_MAX) const;
+
+private:
+    double stallToleranceMs;
+    size_t memoryBudgetBytes;
+};
+
+#endif // SPINNAKER_SDK_SPINBUFFERPOLICY_H
@@ -5,12 +5,20 @@
 #include "SpinGenApi/SpinnakerGenApi.h"
 #include "SpinnakerSDK_SpinOption.h"
 #include "SpinnakerSDK_SpinImage.h"
+#include "SpinnakerSDK_SpinCameraBackend.h"
+#include "SpinnakerSDK_SpinQueue.h"
+#include "SpinnakerSDK_SpinTrigger.h"
+#include "SpinnakerSDK_SpinPreRollBuffer.h"
+#include "SpinnakerSDK_SpinBufferPolicy.h"
+#include "SpinnakerSDK_SpinTelemetry.h"
 #include <string>
 #include <iostream>
 #include <atomic>
 #include <thread>
 #include <chrono>
 #include <unordered_map>
+#include <functional>
+#include <memory>
 
 class SpinCamera {
 public:
@@ -19,20 +27,58 @@ public:
 
     // Camera setup and information
     void Initialize(int camera_index);
+    void Initialize(const std::string& serial_number);
+    // The backend is only taken over once its Init succeeded, the caller keeps it otherwise
+    void Initialize(std::unique_ptr<SpinCameraBackend>&& camera_backend);
+    SpinCameraBackend* GetBackend() const;
     void Shutdown();
+    // Shutdown, handing the de-initialized backend back instead of destroying it (e.g. to retry Initialize with it)
+    std::unique_ptr<SpinCameraBackend> ReleaseBackend();
     void SetDefaultSettings();
     void SetAutoSettings();
     void PrintSettings();
 
+    // Mapping between the host steady clock (SpinTrigger) and the camera clock (frame timestamps)
+    bool SynchronizeClock();
+    uint64_t HostToDeviceTime(uint64_t host_time_ns) const;
+    int64_t GetClockOffset() const;
+
     // Aquisition and Capture
     void StartAcquisition();
     void StopAcquisition();
     void CaptureSingleFrame(SpinImage&);
     void CaptureSingleFrameOnTrigger(SpinImage&, std::atomic<bool>&, int);
+    // Waits up to timeout for the trigger and again up to timeout for a frame exposed after it, returns whether a frame
+    // was captured (the image is left untouched otherwise)
+    bool CaptureSingleFrameOnTrigger(SpinImage&, SpinTrigger&, std::chrono::milliseconds timeout = std::chrono::milliseconds(10000));
     void CaptureContinuousFrames(std::vector<SpinImage>&, int);
-    
+
+    // Pre-roll (keep the most recent frames while acquisition runs, and pick from them when a trigger fires)
+    void EnablePreRoll(size_t numFrames);
+    void DisablePreRoll();
+    // Waits up to timeout for the trigger, returns whether it fired and buffered frames were found around it
+    bool CaptureFrameWindowOnTrigger(std::vector<SpinImage>&, SpinTrigger&, size_t framesBefore, size_t framesAfter,
+                                     std::chrono::milliseconds timeout = std::chrono::milliseconds(10000));
+
+    // Streaming (frames are delivered from the camera's event thread as soon as they arrive)
+    void StartStream(std::function<void(SpinImage&)> handler);
+    void StartStream(SpinQueue<SpinImage>& queue);
+    void StopStream();
+    bool IsStreaming() const;
+    uint64_t GetStreamDroppedFrames() const;
+
+    // Capture health (delivered, lost and incomplete frames, intervals, latency, throughput), readable while streaming
+    std::shared_ptr<SpinTelemetry> GetTelemetry();
 
     // Setting Camera Settings
+    void SetImageOwnership(SpinOption::ImageOwnership);
+    std::shared_ptr<SpinFramePool> CreateFramePool(size_t frameCount, bool useHugePages = false, bool lockMemory = false);
+    void SetFramePool(std::shared_ptr<SpinFramePool>);
+    std::shared_ptr<SpinFramePool> GetFramePool() const;
+    void SetBufferPolicy(const SpinBufferPolicy&);
+    const SpinBufferPolicy& GetBufferPolicy() const;
+    SpinBufferDecision ApplyBufferPolicy(size_t heldFrames = 0);
+    const SpinBufferDecision& GetBufferDecision() const;
     void SetAcquisitionMode(SpinOption::AcquisitionMode);
     void SetBufferHandlingMode(SpinOption::BufferHandlingMode);
     void SetPixelFormat(SpinOption::PixelFormat);
@@ -54,15 +100,40 @@ public:
     void SetBlueBalanceRatio(float);
 
 private:
-    // Primary Spinnaker-relevant variables
-    Spinnaker::CameraPtr pCam;
-    Spinnaker::SystemPtr system;
-    Spinnaker::CameraList camList;
-    Spinnaker::GenApi::INodeMap* nodeMap;
-    Spinnaker::GenApi::INodeMap* streamNodeMap;
+    // Backend image handler backing StartStream/StopStream
+    class StreamEventHandler;
+    std::unique_ptr<StreamEventHandler> streamHandler;
+    bool streamStartedAcquisition = false;
+    uint64_t streamDroppedFrames = 0;
+    void BeginStream();
+
+    // Next frame from the backend, recorded in the telemetry
+    SpinImage NextImage(uint64_t timeoutMs = SpinCameraBackend::kInfiniteTimeout);
+    void UpdateLostFrames();
+    std::shared_ptr<SpinTelemetry> telemetry = std::make_shared<SpinTelemetry>();
+
+    // Most recent frames, filled by the stream while pre-roll is enabled
+    std::unique_ptr<SpinPreRollBuffer> preRollBuffer;
+
+    // The camera itself (a physical camera through Spinnaker, or a simulated one)
+    std::unique_ptr<SpinCameraBackend> backend;
 
     // Status for if the camera aquisition is currently active
     bool acquisitionActive = false;
+
+    // Camera clock minus host steady clock (ns), valid once SynchronizeClock has succeeded
+    int64_t deviceClockOffset = 0;
+    bool clockSynchronized = false;
+
+    // Whether captured frames copy or lease the driver buffers
+    SpinOption::ImageOwnership imageOwnership = SpinOption::ImageOwnership::Copy;
+
+    // Optional preallocated storage for copied frames
+    std::shared_ptr<SpinFramePool> framePool;
+
+    // How many stream buffers continuous captures and streams allocate, and the last count chosen
+    SpinBufferPolicy bufferPolicy;
+    SpinBufferDecision bufferDecision;
 };
 
 #endif // SPINNAKER_SDK_SPINCAMERA_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef SPINNAKER_SDK_SPINCAMERABACKEND_H
+#define SPINNAKER_SDK_SPINCAMERABACKEND_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Everything SpinCamera needs from a camera: its lifecycle, its frames and its GenICam nodes
+// Nodes are addressed by name and looked up in the device node map first, then in the stream node map.
+// Frames are handed out as leases on the backend's own buffers (see SpinImage::IsLeased), incomplete
+// frames are delivered too and flagged with SpinImage::IsIncomplete.
+class SpinCameraBackend {
+public:
+    static const uint64_t kInfiniteTimeout = UINT64_MAX;
+
+    virtual ~SpinCameraBackend() {}
+
+    // Camera setup and information
+    virtual void Init() = 0;
+    virtual void DeInit() = 0;
+    virtual std::string GetSerialNumber() = 0;
+
+    // Acquisition
+    virtual void BeginAcquisition() = 0;
+    virtual void EndAcquisition() = 0;
+    // Wait for the next frame, throws if none arrives within timeoutMs
+    virtual SpinImage GetNextImage(uint64_t timeoutMs = kInfiniteTimeout) = 0;
+    // Deliver every frame to the handler (on a backend thread) as soon as it arrives
+    virtual void RegisterImageHandler(std::function<void(SpinImage&)> handler) = 0;
+    virtual void UnregisterImageHandler() = 0;
+
+    // Node access (setters and getters throw if the node does not exist or has the wrong type)
+    virtual bool IsReadable(const std::string& node) = 0;
+    virtual bool IsWritable(const std::string& node) = 0;
+    virtual int64_t GetIntegerValue(const std::string& node) = 0;
+    virtual int64_t GetIntegerMin(const std::string& node) = 0;
+    virtual int64_t GetIntegerMax(const std::string& node) = 0;
+    virtual void SetIntegerValue(const std::string& node, int64_t value) = 0;
+    virtual double GetFloatValue(const std::string& node) = 0;
+    virtual double GetFloatMin(const std::string& node) = 0;
+    virtual double GetFloatMax(const std::string& node) = 0;
+    virtual void SetFloatValue(const std::string& node, double value) = 0;
+    virtual bool GetBooleanValue(const std::string& node) = 0;
+    virtual void SetBooleanValue(const std::string& node, bool value) = 0;
+    virtual std::string GetEnumerationValue(const std::string& node) = 0;
+    virtual bool IsEnumerationEntryReadable(const std::string& node, const std::string& entry) = 0;
+    virtual void SetEnumerationValue(const std::string& node, const std::string& entry) = 0;
+    virtual void ExecuteCommand(const std::string& node) = 0;
+};
+
+#endif // SPINNAKER_SDK_SPINCAMERABACKEND_H
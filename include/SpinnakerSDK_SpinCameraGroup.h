@@ -0,0 +1,64 @@
+#ifndef SPINNAKER_SDK_SPINCAMERAGROUP_H
+#define SPINNAKER_SDK_SPINCAMERAGROUP_H
+
+#include "SpinnakerSDK_SpinCamera.h"
+#include "SpinnakerSDK_SpinThreadPool.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Outcome of initializing (or running an operation on) one camera of a group
+struct SpinCameraGroupResult {
+    std::string camera;         // How the camera was added (index, serial number or backend serial)
+    bool success = false;
+    std::string error;          // Exception message when the camera failed
+    double initTimeMs = 0.0;    // Time spent in Initialize
+    double configTimeMs = 0.0;  // Time spent applying the configuration (or running the operation)
+};
+
+// A set of cameras that are initialized, configured and operated on in parallel
+// One camera failing never stops the others, its error is reported in its result and it is skipped afterwards.
+class SpinCameraGroup {
+public:
+    // 0 threads means one worker per camera
+    explicit SpinCameraGroup(size_t threadCount = 0);
+    ~SpinCameraGroup();
+
+    // Add cameras to the group (they are opened by Initialize)
+    void AddCamera(int camera_index);
+    void AddCamera(const std::string& serial_number);
+    void AddCamera(std::unique_ptr<SpinCameraBackend> camera_backend);
+
+    // Initialize every camera and apply the configuration, all cameras at once
+    std::vector<SpinCameraGroupResult> Initialize(std::function<void(SpinCamera&)> configure = [](SpinCamera& camera) { camera.SetDefaultSettings(); });
+    // Run an operation on every ready camera at once (timed as configTimeMs)
+    std::vector<SpinCameraGroupResult> ForEach(std::function<void(SpinCamera&)> operation);
+    void Shutdown();
+
+    size_t Size() const;
+    bool IsReady(size_t index) const;
+    SpinCamera& GetCamera(size_t index);
+    SpinCamera& operator[](size_t index);
+
+    static void PrintResults(const std::vector<SpinCameraGroupResult>& results);
+
+private:
+    struct Member {
+        std::string name;
+        int cameraIndex = -1;
+        std::string serialNumber;
+        std::unique_ptr<SpinCameraBackend> backend;  // Kept here while the camera is not initialized
+        bool ownBackend = false;                     // Added with a backend, which the camera hands back when it fails or shuts down
+        std::unique_ptr<SpinCamera> camera;
+        bool ready = false;
+    };
+
+    SpinThreadPool& GetPool();
+
+    size_t threadCount;
+    std::unique_ptr<SpinThreadPool> pool;
+    std::vector<Member> members;
+};
+
+#endif // SPINNAKER_SDK_SPINCAMERAGROUP_H
@@ -0,0 +1,51 @@
+#ifndef SPINNAKER_SDK_SPINCAMERAREGISTRY_H
+#define SPINNAKER_SDK_SPINCAMERAREGISTRY_H
+
+#include "Spinnaker.h"
+#include "SpinGenApi/SpinnakerGenApi.h"
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Process-wide owner of the Spinnaker system and the list of connected cameras
+// The bus is enumerated once and the cameras are cached by serial number. Every open camera holds a reference on the
+// system, which is released when the last open camera is closed, so cameras can be opened and closed independently.
+class SpinCameraRegistry {
+public:
+    static SpinCameraRegistry& Instance();
+
+    // Open a camera by enumeration index or serial number (throws if it does not exist or is already open)
+    Spinnaker::CameraPtr OpenCamera(int camera_index, std::string& serial_number);
+    Spinnaker::CameraPtr OpenCamera(const std::string& serial_number);
+    void CloseCamera(const std::string& serial_number);
+
+    // Connected cameras, in enumeration order
+    std::vector<std::string> GetSerialNumbers();
+    size_t GetCameraCount();
+
+    // Enumerate the bus again (e.g. after plugging in a camera)
+    void Refresh();
+
+private:
+    SpinCameraRegistry() = default;
+    ~SpinCameraRegistry();
+    SpinCameraRegistry(const SpinCameraRegistry&) = delete;
+    SpinCameraRegistry& operator=(const SpinCameraRegistry&) = delete;
+
+    // Callers must hold the mutex
+    void Enumerate();
+    Spinnaker::CameraPtr Open(const std::string& serial_number);
+    void ReleaseSystemIfUnused();
+
+    std::mutex mutex;
+    Spinnaker::SystemPtr system;
+    Spinnaker::CameraList camList;
+    bool enumerated = false;
+    std::vector<std::string> serialNumbers;
+    std::unordered_map<std::string, Spinnaker::CameraPtr> cameras;
+    std::set<std::string> openCameras;
+};
+
+#endif // SPINNAKER_SDK_SPINCAMERAREGISTRY_H
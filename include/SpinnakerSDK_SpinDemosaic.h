@@ -0,0 +1,112 @@
+#ifndef SPINNAKER_SDK_SPINDEMOSAIC_H
+#define SPINNAKER_SDK_SPINDEMOSAIC_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SpinThreadPool;
+
+namespace SpinDemosaicing {
+    enum class Method {
+        Bilinear,        // Average of the nearest samples of each colour, fastest
+        MalvarHeCutler   // Bilinear corrected by the local gradient of the sample's own colour, much less colour fringing
+    };
+
+    // Instruction set of the inner loop, Auto picks the best one the CPU supports
+    enum class Isa {
+        Auto,
+        Scalar,
+        SSE2,
+        AVX2,
+        NEON
+    };
+}
+
+struct SpinDemosaicOptions {
+    SpinDemosaicing::Method method = SpinDemosaicing::Method::Bilinear;
+    SpinDemosaicing::Isa isa = SpinDemosaicing::Isa::Auto;  // An instruction set the CPU lacks falls back to the best available
+
+    size_t threadCount = 1;          // Bands demosaiced at once, 1 works on the calling thread, 0 means one per hardware thread
+    int bandRows = 0;                // Rows per band, 0 sizes bands to stay in a 256 KiB L2 cache (raw and RGB rows together)
+    SpinThreadPool* pool = nullptr;  // Pool to run the bands on instead of the shared one (must not be the caller's own pool)
+
+    const unsigned char* toneMap = nullptr;  // DemosaicPacked: 8 bit value of every sample (see SpinUnpacker), nullptr keeps the top 8 bits
+};
+
+// Native demosaicing of BayerRG8 frames into RGB8
+// Writes straight into the caller's buffer: no allocation, no copy of the raw frame. Every output pixel is a weighted sum
+// of the 5x5 neighbourhood (the weights depend on the colour site), evaluated for 8 to 16 pixels at once with SIMD.
+// Borders are mirrored, so edge pixels see samples of the right colour. All instruction sets give identical output.
+// With more than one thread the frame is cut into bands of rows that run on a thread pool. Every band reads the two rows
+// above and below it straight from the frame, so the result is identical to the single threaded one.
+class SpinDemosaicer {
+public:
+    // Demosaic a whole frame, strides are bytes per row (0 means width and width * 3)
+    static void Demosaic(const unsigned char* bayer, size_t bayerStride, int width, int height, unsigned char* rgb, size_t rgbStride = 0,
+                         const SpinDemosaicOptions& options = SpinDemosaicOptions());
+    // Only the rectangle at x, y (reading up to two pixels around it), rgb points at its first pixel (0 means regionWidth * 3)
+    static void DemosaicRegion(const unsigned char* bayer, size_t bayerStride, int width, int height, int x, int y, int regionWidth,
+                               int regionHeight, unsigned char* rgb, size_t rgbStride = 0, const SpinDemosaicOptions& options = SpinDemosaicOptions());
+    // A 10p, 12p or 16 bit frame (one stream of samples if dataStride is 0, see SpinUnpacker, else rows dataStride bytes
+    // apart), each band is unpacked to 8 bits (with the two rows around it) just before it is demosaiced, so the unpacked
+    // samples are still in the cache
+    static void DemosaicPacked(const unsigned char* data, size_t dataStride, int bitsPerPixel, int width, int height, unsigned char* rgb,
+                               size_t rgbStride = 0, const SpinDemosaicOptions& options = SpinDemosaicOptions());
+    // Only rows firstRow to firstRow + rowCount - 1 (reading up to two rows around them), rgb points at the first of them
+    // This runs on the calling thread, the threading options are ignored.
+    static void DemosaicRows(const unsigned char* bayer, size_t bayerStride, int width, int height, int firstRow, int rowCount,
+                             unsigned char* rgb, size_t rgbStride = 0, const SpinDemosaicOptions& options = SpinDemosaicOptions());
+
+    // Instruction set that will actually be used for a request
+    static SpinDemosaicing::Isa ResolveIsa(SpinDemosaicing::Isa isa = SpinDemosaicing::Isa::Auto);
+    static const char* GetIsaName(SpinDemosaicing::Isa isa);
+    // Rows per band for a frame width and options (bandRows, or what fits the L2 cache)
+    static int GetBandRows(int width, const SpinDemosaicOptions& options = SpinDemosaicOptions());
+};
+
+// Demosaics a frame lazily, tile by tile, into one full size RGB buffer
+// A region is rounded out to whole tiles and only the tiles not done yet are demosaiced, so a few small regions cost a few
+// tiles and a later full frame only does what is left. Every tile reads its border straight from the raw frame, so the
+// result is identical to demosaicing the whole frame at once. The raw frame must outlive the cache. Thread safe.
+class SpinDemosaicCache {
+public:
+    SpinDemosaicCache(const unsigned char* bayer, size_t bayerStride, int width, int height, int tileSize = 64);
+
+    SpinDemosaicCache(const SpinDemosaicCache&) = delete;
+    SpinDemosaicCache& operator=(const SpinDemosaicCache&) = delete;
+
+    // Demosaic what is missing of the rectangle (clipped to the frame) and return the RGB frame, width * 3 bytes per row
+    // Another method than the one of the tiles already done redoes them, except the kept ones (see Keep).
+    unsigned char* Region(int x, int y, int regionWidth, int regionHeight, const SpinDemosaicOptions& options = SpinDemosaicOptions());
+    unsigned char* Frame(const SpinDemosaicOptions& options = SpinDemosaicOptions());
+    // Never redo the tiles of the rectangle once they are done, e.g. after drawing into them (SpinImage::DrawRedSquare)
+    void Keep(int x, int y, int regionWidth, int regionHeight);
+    // Forget every tile, kept ones too (e.g. after the raw frame changed)
+    void Reset();
+
+    int GetWidth() const;
+    int GetHeight() const;
+    size_t GetStride() const;
+    size_t GetTileCount() const;
+    size_t GetTilesDone() const;
+    bool IsComplete() const;
+
+private:
+    const unsigned char* bayer;
+    size_t bayerStride;
+    int width;
+    int height;
+    int tileSize;
+    int tilesX;
+    int tilesY;
+    SpinDemosaicing::Method method = SpinDemosaicing::Method::Bilinear;
+    std::unique_ptr<unsigned char[]> rgb;  // Allocated on the first request, never cleared
+    std::vector<unsigned char> tileDone;
+    std::vector<unsigned char> tileKept;
+    size_t tilesDone = 0;
+    mutable std::mutex mutex;
+};
+
+#endif // SPINNAKER_SDK_SPINDEMOSAIC_H
@@ -0,0 +1,56 @@
+#ifndef SPINNAKER_SDK_SPINFRAMEPOOL_H
+#define SPINNAKER_SDK_SPINFRAMEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Usage counters of a SpinFramePool
+struct SpinFramePoolStats {
+    size_t capacity = 0;          // Number of preallocated frame buffers
+    size_t frameSize = 0;         // Usable bytes per frame buffer
+    size_t inUse = 0;             // Frame buffers currently borrowed
+    size_t highWaterMark = 0;     // Most frame buffers ever borrowed at once
+    uint64_t acquisitions = 0;    // Successful borrows
+    uint64_t exhaustions = 0;     // Borrows that failed because every buffer was in use
+    uint64_t oversizeRequests = 0;// Borrows that failed because the frame was larger than the buffers
+    bool hugePages = false;       // Whether the backing memory uses huge pages
+    bool locked = false;          // Whether the backing memory is locked into RAM (mlock)
+};
+
+// Fixed set of frame buffers allocated (and pre-faulted) up front, so capture never touches the allocator
+// Buffers are handed out as shared pointers and return to the pool when the last reference is dropped.
+class SpinFramePool : public std::enable_shared_from_this<SpinFramePool> {
+public:
+    static std::shared_ptr<SpinFramePool> Create(size_t frameCount, size_t frameSize, bool useHugePages = false, bool lockMemory = false);
+    ~SpinFramePool();
+
+    SpinFramePool(const SpinFramePool&) = delete;
+    SpinFramePool& operator=(const SpinFramePool&) = delete;
+
+    // Borrow a buffer of at least size bytes, returns nullptr if the pool is exhausted or size is too large
+    std::shared_ptr<unsigned char> Acquire(size_t size);
+
+    size_t GetFrameSize() const;
+    size_t GetFrameCount() const;
+    SpinFramePoolStats GetStats() const;
+    void PrintStats() const;
+
+private:
+    SpinFramePool(size_t frameCount, size_t frameSize, bool useHugePages, bool lockMemory);
+    void Return(unsigned char* frame);
+
+    unsigned char* memory = nullptr;
+    size_t mappedSize = 0;
+    size_t frameCount;
+    size_t frameSize;
+    size_t frameStride;
+
+    mutable std::mutex mutex;
+    std::vector<unsigned char*> freeFrames;
+    SpinFramePoolStats stats;
+};
+
+#endif // SPINNAKER_SDK_SPINFRAMEPOOL_H
@@ -0,0 +1,86 @@
+#ifndef SPINNAKER_SDK_SPINFRAMESYNCHRONIZER_H
+#define SPINNAKER_SDK_SPINFRAMESYNCHRONIZER_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include "SpinnakerSDK_SpinQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// One frame from every camera, captured within the synchronizer's tolerance of each other
+struct SpinFrameSet {
+    uint64_t timestamp = 0;         // Earliest frame of the set, on the common clock (see SetClockOffset)
+    uint64_t skew = 0;              // Latest minus earliest frame of the set (ns)
+    std::vector<SpinImage> frames;  // Indexed by camera
+};
+
+// Matching counters of one camera
+struct SpinFrameSynchronizerCameraStats {
+    uint64_t receivedFrames = 0;   // Frames that made it into the camera's queue
+    uint64_t droppedFrames = 0;    // Frames lost because the camera's queue was full
+    uint64_t unmatchedFrames = 0;  // Frames discarded because no other camera had a frame close enough in time
+};
+
+// Pairs up frames from several cameras by device timestamp
+// Every camera pushes into its own bounded lock-free queue (from its stream thread), a single consumer thread pulls
+// matched sets out. A set is emitted once every camera has a frame within the tolerance of the others. Frames that can
+// no longer be matched (another camera is already past them) are discarded and counted, so memory stays bounded by
+// the queue capacity no matter how far the cameras drift apart.
+class SpinFrameSynchronizer {
+public:
+    SpinFrameSynchronizer(size_t cameraCount, std::chrono::nanoseconds tolerance, size_t queueCapacity = 32);
+
+    // Camera clock minus common clock (ns), subtracted from the camera's frame timestamps before matching
+    // Leave at 0 when the cameras share a clock (e.g. PTP), otherwise use SpinCamera::GetClockOffset.
+    void SetClockOffset(size_t camera, int64_t offset);
+
+    // Producer side, one thread per camera. Returns false (and counts a drop) when the camera's queue is full.
+    bool Push(size_t camera, const SpinImage& frame);
+    // Stream handler pushing into the given camera's queue (for SpinCamera::StartStream)
+    std::function<void(SpinImage&)> GetStreamHandler(size_t camera);
+
+    // Consumer side, one thread only
+    bool TryGetFrameSet(SpinFrameSet& frameSet);
+    bool GetFrameSet(SpinFrameSet& frameSet, std::chrono::milliseconds timeout);
+    // Discard every queued and pending frame (e.g. between recordings)
+    void Clear();
+
+    size_t GetCameraCount() const;
+    uint64_t GetMatchedSets() const;
+    SpinFrameSynchronizerCameraStats GetCameraStats(size_t camera) const;
+    void PrintStats() const;
+
+private:
+    struct CameraState {
+        explicit CameraState(size_t queueCapacity) : queue(queueCapacity) {}
+
+        SpinQueue<SpinImage> queue;
+        std::atomic<int64_t> clockOffset{0};
+        std::atomic<uint64_t> receivedFrames{0};
+        std::atomic<uint64_t> droppedFrames{0};
+        std::atomic<uint64_t> unmatchedFrames{0};
+
+        // Oldest frame taken out of the queue that still waits for a match (consumer only)
+        SpinImage pending{nullptr};
+        bool hasPending = false;
+        int64_t pendingTime = 0;  // On the common clock
+    };
+
+    // The queues are cache line aligned, which plain new does not honour before C++17
+    struct CameraStateDeleter {
+        void operator()(CameraState* state) const;
+    };
+    using CameraStatePtr = std::unique_ptr<CameraState, CameraStateDeleter>;
+    static CameraStatePtr CreateCameraState(size_t queueCapacity);
+
+    CameraState& Camera(size_t camera) const;
+
+    std::vector<CameraStatePtr> cameras;
+    int64_t tolerance;
+    std::atomic<uint64_t> matchedSets{0};
+};
+
+#endif // SPINNAKER_SDK_SPINFRAMESYNCHRONIZER_H
@@ -0,0 +1,69 @@
+#ifndef SPINNAKER_SDK_SPINHARDWAREBACKEND_H
+#define SPINNAKER_SDK_SPINHARDWAREBACKEND_H
+
+#include "Spinnaker.h"
+#include "SpinGenApi/SpinnakerGenApi.h"
+#include "SpinnakerSDK_SpinCameraBackend.h"
+#include "SpinnakerSDK_SpinCameraRegistry.h"
+#include <memory>
+
+// Camera backend for a physical camera, driven through the Spinnaker SDK
+// The camera is opened through the SpinCameraRegistry, so several backends share one Spinnaker system.
+class SpinHardwareBackend : public SpinCameraBackend {
+public:
+    explicit SpinHardwareBackend(int camera_index);
+    explicit SpinHardwareBackend(const std::string& serial_number);
+    ~SpinHardwareBackend() override;
+
+    // Camera setup and information
+    void Init() override;
+    void DeInit() override;
+    std::string GetSerialNumber() override;
+
+    // Acquisition
+    void BeginAcquisition() override;
+    void EndAcquisition() override;
+    SpinImage GetNextImage(uint64_t timeoutMs = kInfiniteTimeout) override;
+    void RegisterImageHandler(std::function<void(SpinImage&)> handler) override;
+    void UnregisterImageHandler() override;
+
+    // Node access
+    bool IsReadable(const std::string& node) override;
+    bool IsWritable(const std::string& node) override;
+    int64_t GetIntegerValue(const std::string& node) override;
+    int64_t GetIntegerMin(const std::string& node) override;
+    int64_t GetIntegerMax(const std::string& node) override;
+    void SetIntegerValue(const std::string& node, int64_t value) override;
+    double GetFloatValue(const std::string& node) override;
+    double GetFloatMin(const std::string& node) override;
+    double GetFloatMax(const std::string& node) override;
+    void SetFloatValue(const std::string& node, double value) override;
+    bool GetBooleanValue(const std::string& node) override;
+    void SetBooleanValue(const std::string& node, bool value) override;
+    std::string GetEnumerationValue(const std::string& node) override;
+    bool IsEnumerationEntryReadable(const std::string& node, const std::string& entry) override;
+    void SetEnumerationValue(const std::string& node, const std::string& entry) override;
+    void ExecuteCommand(const std::string& node) override;
+
+private:
+    // Look a node up in the device node map, then in the stream node map
+    Spinnaker::GenApi::CNodePtr FindNode(const std::string& node);
+
+    // Forwards Spinnaker image events to the registered handler
+    class ImageHandler;
+    std::unique_ptr<ImageHandler> imageHandler;
+
+    // Which camera to open, by index when no serial number was given
+    int cameraIndex;
+    std::string requestedSerialNumber;
+    // Name of the open camera in the registry ("index:N" for cameras without a serial number) and the device's own serial
+    std::string registryKey;
+    std::string serialNumber;
+
+    // Primary Spinnaker-relevant variables
+    Spinnaker::CameraPtr pCam;
+    Spinnaker::GenApi::INodeMap* nodeMap;
+    Spinnaker::GenApi::INodeMap* streamNodeMap;
+};
+
+#endif // SPINNAKER_SDK_SPINHARDWAREBACKEND_H
@@ -4,31 +4,183 @@
 #include "Spinnaker.h"
 #include "SpinGenApi/SpinnakerGenApi.h"
 #include "SpinnakerSDK_SpinOption.h"
+#include "SpinnakerSDK_SpinFramePool.h"
+#include "SpinnakerSDK_SpinImageEncoder.h"
+#include "SpinnakerSDK_SpinDemosaic.h"
+#include "SpinnakerSDK_SpinBayerStats.h"
+#include "SpinnakerSDK_SpinUnpack.h"
+#include "SpinnakerSDK_SpinImageView.h"
 #include <string>
 #include <vector>
 #include <iomanip>
 #include <sstream>
+#include <memory>
+#include <functional>
+
+// Options of SpinImage::SaveImages
+struct SpinImageSaveOptions {
+    size_t threadCount = 0;       // 0 means one per hardware thread
+    size_t maxInFlight = 0;       // Most images demosaiced at once, each holds a full colour frame (0 means one per thread)
+    size_t firstIndex = 0;        // Number given to the first image in the filename pattern
+    bool keepDemosaiced = false;  // Keep the demosaiced copies after saving instead of freeing them
+    Spinnaker::ImageFileFormat format = Spinnaker::ImageFileFormat::SPINNAKER_IMAGE_FILE_FORMAT_FROM_FILE_EXT;
+    bool useEncoder = false;      // Save with the built-in PNG/JPEG encoders (encodeOptions) instead of the SDK
+    SpinEncodeOptions encodeOptions;  // Strips run on one thread per image unless threadCount is set, the images are already in parallel
+};
+
+// The Spinnaker pixel format behind each SpinImageView format
+template <typename Format>
+struct SpinViewPixelFormat;
+#define SPIN_VIEW_PIXEL_FORMAT(format) \
+    template <> \
+    struct SpinViewPixelFormat<SpinPixel::format> { \
+        static constexpr Spinnaker::PixelFormatEnums value = Spinnaker::PixelFormatEnums::PixelFormat_##format; \
+    };
+SPIN_VIEW_PIXEL_FORMAT(Mono8)
+SPIN_VIEW_PIXEL_FORMAT(Mono16)
+SPIN_VIEW_PIXEL_FORMAT(RGB8)
+SPIN_VIEW_PIXEL_FORMAT(RGB16)
+SPIN_VIEW_PIXEL_FORMAT(BayerRG8)
+SPIN_VIEW_PIXEL_FORMAT(BayerGR8)
+SPIN_VIEW_PIXEL_FORMAT(BayerGB8)
+SPIN_VIEW_PIXEL_FORMAT(BayerBG8)
+SPIN_VIEW_PIXEL_FORMAT(BayerRG16)
+SPIN_VIEW_PIXEL_FORMAT(BayerGR16)
+SPIN_VIEW_PIXEL_FORMAT(BayerGB16)
+SPIN_VIEW_PIXEL_FORMAT(BayerBG16)
+#undef SPIN_VIEW_PIXEL_FORMAT
+
+// Outcome of saving one image of a batch
+struct SpinImageSaveResult {
+    std::string filename;
+    bool success = false;
+    std::string error;
+};
 
 class SpinImage {
 public:
-    SpinImage(Spinnaker::ImagePtr rawImage);
+    // Copied images borrow their storage from the pool when one is given (falling back to the heap if it is exhausted)
+    SpinImage(Spinnaker::ImagePtr rawImage, SpinOption::ImageOwnership ownership = SpinOption::ImageOwnership::Copy,
+              const std::shared_ptr<SpinFramePool>& pool = nullptr);
+    // Wrap an existing buffer without copying it, releaseHook is called once the last reference is dropped
+    // stride is the bytes from one row to the next, 0 for rows without padding
+    SpinImage(unsigned char* data, size_t size, int width, int height, Spinnaker::PixelFormatEnums pixelFormat,
+              std::function<void()> releaseHook, uint64_t timestamp = 0, uint64_t frameID = 0, size_t stride = 0);
     ~SpinImage();
 
+    // Ownership of the pixel data
+    SpinImage Detach(const std::shared_ptr<SpinFramePool>& pool = nullptr) const;
+    bool IsLeased() const;
+
+    // Raw image data and metadata
+    const unsigned char* GetData() const;
+    size_t GetDataSize() const;
+    int GetWidth() const;
+    int GetHeight() const;
+    // Bytes from one row to the next, including any padding at the end of the rows
+    size_t GetStride() const;
+    Spinnaker::PixelFormatEnums GetPixelFormat() const;
+    uint64_t GetTimeStamp() const;
+    uint64_t GetFrameID() const;
+    bool IsIncomplete() const;
+    int GetImageStatus() const;
+    // Bits per raw sample (8, 10, 12 or 16), 0 for formats that are not raw Bayer or Mono samples
+    int GetBitsPerPixel() const;
+    // Zero-copy typed view of the raw pixels (with the stride), Format must be the image's pixel format
+    // e.g. image.GetView<SpinPixel::BayerRG8>().Crop(x, y, 64, 64). Packed formats (10p, 12p) have no view.
+    // A writable view of read-only data (see MarkReadOnly) copies the data first.
+    template <typename Format>
+    SpinImageView<Format> GetView() {
+        MakeWritable();
+        CheckView(SpinViewPixelFormat<Format>::value, sizeof(typename Format::Sample) * Format::channels);
+        return SpinImageView<Format>(imageData.get(), imageWidth, imageHeight, imageStride);
+    }
+    template <typename Format>
+    SpinConstImageView<Format> GetView() const {
+        CheckView(SpinViewPixelFormat<Format>::value, sizeof(typename Format::Sample) * Format::channels);
+        return SpinConstImageView<Format>(imageData.get(), imageWidth, imageHeight, imageStride);
+    }
+    // Flag the frame as incomplete (used by camera backends that build frames themselves)
+    void MarkIncomplete(int status);
+    // Flag the data as not writable (e.g. a read-only file mapping), anything about to write into it takes a copy first
+    void MarkReadOnly();
+    bool IsReadOnly() const;
+
     void PrintAllImageInformation();
     void PrintSimpleImageInformation();
     void Demosaic();
+    // Raw samples one per pixel (width * height, without row padding), unpacked from 10p and 12p (see SpinUnpacker), 8 bit
+    // ones through toneMap if given
+    void UnpackTo8(unsigned char* samples, const unsigned char* toneMap = nullptr) const;
+    void UnpackTo16(uint16_t* samples, int shift = 0) const;
+    // Native BayerRG8, 10p, 12p or 16 to RGB8 demosaicing straight into the caller's buffer (height rows of rgbStride bytes,
+    // 0 means width * 3). Deeper formats are unpacked band by band on the way, to their top 8 bits or through options.toneMap.
+    void DemosaicInto(unsigned char* rgb, size_t rgbStride = 0, const SpinDemosaicOptions& options = SpinDemosaicOptions()) const;
+    // The same into a buffer from the pool (the heap if it is exhausted), handed back as an RGB8 image
+    SpinImage DemosaicToRGB8(const std::shared_ptr<SpinFramePool>& pool = nullptr, const SpinDemosaicOptions& options = SpinDemosaicOptions()) const;
+    // Native BayerRG8 demosaicing of just the rectangle (rounded out to 64 pixel tiles), tiles already done are reused
+    // Returns the RGB8 frame (width * 3 bytes per row), valid inside the rectangle (and writable, like DrawRedSquare does). DrawRedSquare and saving a BayerRG8
+    // image go through the same tiles, so they only demosaic what is still missing. Another method redoes the tiles, except
+    // the ones DrawRedSquare drew into: those keep the square and the method they were first demosaiced with.
+    unsigned char* DemosaicRegion(int x, int y, int width, int height, const SpinDemosaicOptions& options = SpinDemosaicOptions());
     void SaveImage(const std::string& filename, Spinnaker::ImageFileFormat format = Spinnaker::ImageFileFormat::SPINNAKER_IMAGE_FILE_FORMAT_FROM_FILE_EXT);
+    // Save with the built-in encoders, with control over the codec, compression and threads
+    void SaveImage(const std::string& filename, const SpinEncodeOptions& options);
+    // Encode into memory with the built-in encoders (PNG unless options.codec says otherwise)
+    void EncodeImage(const SpinEncodeOptions& options, std::vector<unsigned char>& output);
+    // Save a batch of images in parallel, filenamePattern takes the image number printf style (e.g. "frame_%04d.png")
+    // Results come back in the order of the images, a failed image does not stop the others.
+    static std::vector<SpinImageSaveResult> SaveImages(SpinImage* images, size_t count, const std::string& filenamePattern,
+                                                       const SpinImageSaveOptions& options = SpinImageSaveOptions());
+    static std::vector<SpinImageSaveResult> SaveImages(std::vector<SpinImage>& images, const std::string& filenamePattern,
+                                                       const SpinImageSaveOptions& options = SpinImageSaveOptions());
     void DrawRedSquare(int x, int y, int squareSize);
     void GetPixelRGB(int x, int y, unsigned char& R, unsigned char& G, unsigned char& B);
     void CalculateAverageColor(int x, int y, int width, int height, unsigned char& R, unsigned char& G, unsigned char& B);
+    // Sum, mean, variance, min and max of R, G and B in each region, in one pass over the raw samples (Bayer of any pattern,
+    // grey or RGB, other formats throw). The colours are the ones GetPixelRGB gives, so sum / pixelCount is what
+    // CalculateAverageColor returns. Deeper formats are reduced row by row to their top 8 bits or through toneMap (as all of
+    // these do).
+    std::vector<SpinRoiStats> CalculateRoiStats(const std::vector<SpinRoi>& rois, const unsigned char* toneMap = nullptr) const;
+    // Build summed-area tables of the frame (12 bytes per pixel), after which CalculateAverageColor costs four lookups per
+    // channel whatever the size of the region. Worth it when many regions of the same frame are asked for.
+    void BuildIntegralImage(const unsigned char* toneMap = nullptr);
+    // The tables, nullptr until BuildIntegralImage
+    std::shared_ptr<const SpinBayerIntegralImage> GetIntegralImage() const;
 
 private:
+    // 8-bit grey or RGB pixels of the image for the built-in encoders, converted or storage keeps the conversion alive
+    SpinPixelBuffer GetEncoderPixels(Spinnaker::ImagePtr& converted, std::vector<unsigned char>& storage);
+    // Whether the data holds all width * height samples of the pixel format
+    bool HasAllSamples() const;
+    // The stride when rows are padded, 0 when they follow each other (packed frames are then one stream of samples)
+    size_t GetPaddedStride() const;
+    // Swap read-only data for a writable copy of it
+    void MakeWritable();
+    // Throws unless the image is in pixelFormat with every row of pixelBytes per pixel in the data
+    void CheckView(Spinnaker::PixelFormatEnums viewFormat, size_t pixelBytes) const;
+    // How SpinBayerStats reads the samples, throws for formats it cannot or when samples are missing
+    SpinSampleLayout GetStatsLayout(int& bitsPerSample) const;
+    // Colour image to save with the SDK: the demosaiced image, the completed tiles of a BayerRG8 frame, or a new demosaic
+    Spinnaker::ImagePtr GetColorImage();
+
     Spinnaker::ImagePtr rawImage;
     Spinnaker::ImagePtr demosaicedImage;
+    std::shared_ptr<SpinDemosaicCache> demosaicCache;  // Tiles demosaiced by DemosaicRegion (BayerRG8 only)
+    std::shared_ptr<const SpinBayerIntegralImage> integralImage;  // Summed-area tables from BuildIntegralImage
     Spinnaker::ImageProcessor imageProcessor;
     int imageWidth;
     int imageHeight;
-    std::vector<unsigned char> imageData; // Local copy of image data
+    size_t imageStride;
+    Spinnaker::PixelFormatEnums pixelFormat;
+    uint64_t timestamp;
+    uint64_t frameID;
+    bool incomplete;
+    int imageStatus;
+    std::shared_ptr<unsigned char> imageData; // Either a local copy of the image data or a lease on the driver buffer
+    size_t imageSize;
+    bool leased;
+    bool readOnly;  // The data must not be written (MarkReadOnly), it is copied on the first write
 };
 
-#endif // SPINNAKER_SDK_SPINIMAGE_H
\ No newline at end of file
+#endif // SPINNAKER_SDK_SPINIMAGE_H
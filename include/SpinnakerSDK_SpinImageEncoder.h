@@ -0,0 +1,79 @@
+#ifndef SPINNAKER_SDK_SPINIMAGEENCODER_H
+#define SPINNAKER_SDK_SPINIMAGEENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class SpinThreadPool;
+
+namespace SpinEncoding {
+    enum class Codec {
+        Auto,  // From the file extension (.png, .jpg/.jpeg), PNG when there is none
+        Png,
+        Jpeg
+    };
+
+    // PNG row filters, Adaptive picks the best one per row (smallest output, slowest)
+    enum class PngFilter {
+        None,
+        Sub,
+        Up,
+        Average,
+        Paeth,
+        Adaptive
+    };
+}
+
+// How to encode one image, the speed/size trade-off is made per call
+struct SpinEncodeOptions {
+    SpinEncoding::Codec codec = SpinEncoding::Codec::Auto;
+
+    int pngCompressionLevel = 1;   // zlib level, 0 (stored) to 9 (smallest), 1 is usually within a few percent of 6 at several times the speed
+    SpinEncoding::PngFilter pngFilter = SpinEncoding::PngFilter::Up;
+
+    int jpegQuality = 90;          // 1 to 100
+    bool jpegSubsampling = true;   // 4:2:0 chroma (smaller and faster), 4:4:4 otherwise
+
+    size_t threadCount = 0;        // Strips encoded at once, 0 means one per hardware thread, 1 encodes on the calling thread
+    size_t stripRows = 0;          // Rows per strip (rounded to whole JPEG MCU rows), 0 picks about four strips per thread
+    SpinThreadPool* pool = nullptr;  // Pool to encode the strips on instead of one created per call (must not be the caller's own pool)
+};
+
+// Pixels handed to an encoder, 8 bits per sample
+struct SpinPixelBuffer {
+    const unsigned char* data = nullptr;
+    int width = 0;
+    int height = 0;
+    int channels = 0;    // 1 (grey) or 3 (RGB)
+    size_t stride = 0;   // Bytes per row, 0 means width * channels
+};
+
+// Image encoder backend
+// Encoders split the image into horizontal strips that are compressed independently on a thread pool and stitched back
+// together into one standard file, so any decoder can read the result.
+class SpinImageEncoder {
+public:
+    virtual ~SpinImageEncoder() = default;
+
+    virtual void Encode(const SpinPixelBuffer& pixels, const SpinEncodeOptions& options, std::vector<unsigned char>& output) = 0;
+
+    // Encoder for a codec, Auto picks one from the filename extension
+    static std::unique_ptr<SpinImageEncoder> Create(SpinEncoding::Codec codec, const std::string& filename = "");
+    // Encode and write a file in one go
+    static void Save(const std::string& filename, const SpinPixelBuffer& pixels, const SpinEncodeOptions& options = SpinEncodeOptions());
+
+protected:
+    // Pool of options.threadCount threads for one Encode call when options has no pool and there is more than one strip
+    // to share out, options then points at it until the returned pool goes (nullptr when none is needed)
+    static std::unique_ptr<SpinThreadPool> CreateStripPool(size_t stripCount, SpinEncodeOptions& options);
+    // Run body(strip) for every strip, on options.pool or the calling thread
+    static void ForEachStrip(size_t stripCount, const SpinEncodeOptions& options, const std::function<void(size_t)>& body);
+    // Rows per strip for the image height (a multiple of rowMultiple)
+    static int StripRows(int height, int rowMultiple, const SpinEncodeOptions& options);
+};
+
+#endif // SPINNAKER_SDK_SPINIMAGEENCODER_H
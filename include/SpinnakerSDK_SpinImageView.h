@@ -0,0 +1,183 @@
+#ifndef SPINNAKER_SDK_SPINIMAGEVIEW_H
+#define SPINNAKER_SDK_SPINIMAGEVIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace SpinBayer {
+    // Colour filter layout, named after the 2x2 quad at the top left of the frame
+    enum class Pattern {
+        RGGB,
+        GRBG,
+        GBRG,
+        BGGR
+    };
+}
+
+// Pixel formats a SpinImageView is typed with, each one describes its memory layout at compile time
+namespace SpinPixel {
+    // Samples of every pixel next to each other (grey or R, G, B)
+    template <typename T, int Channels>
+    struct Interleaved {
+        using Sample = T;
+        static constexpr int channels = Channels;
+        static constexpr bool bayer = false;
+    };
+
+    // One sample per pixel behind a colour filter, (redX, redY) is the red site of every 2x2 quad
+    template <typename T, SpinBayer::Pattern Layout>
+    struct Bayer {
+        using Sample = T;
+        static constexpr int channels = 1;
+        static constexpr bool bayer = true;
+        static constexpr SpinBayer::Pattern pattern = Layout;
+        static constexpr int redX = (Layout == SpinBayer::Pattern::GRBG || Layout == SpinBayer::Pattern::BGGR) ? 1 : 0;
+        static constexpr int redY = (Layout == SpinBayer::Pattern::GBRG || Layout == SpinBayer::Pattern::BGGR) ? 1 : 0;
+    };
+
+    using Mono8 = Interleaved<uint8_t, 1>;
+    using Mono16 = Interleaved<uint16_t, 1>;
+    using RGB8 = Interleaved<uint8_t, 3>;
+    using RGB16 = Interleaved<uint16_t, 3>;
+    using BayerRG8 = Bayer<uint8_t, SpinBayer::Pattern::RGGB>;
+    using BayerGR8 = Bayer<uint8_t, SpinBayer::Pattern::GRBG>;
+    using BayerGB8 = Bayer<uint8_t, SpinBayer::Pattern::GBRG>;
+    using BayerBG8 = Bayer<uint8_t, SpinBayer::Pattern::BGGR>;
+    using BayerRG16 = Bayer<uint16_t, SpinBayer::Pattern::RGGB>;
+    using BayerGR16 = Bayer<uint16_t, SpinBayer::Pattern::GRBG>;
+    using BayerGB16 = Bayer<uint16_t, SpinBayer::Pattern::GBRG>;
+    using BayerBG16 = Bayer<uint16_t, SpinBayer::Pattern::BGGR>;
+}
+
+// Typed window onto pixels someone else owns: a pointer to the first pixel, the size and the bytes from one row to the next
+// Nothing is copied, so the pixels must outlive the view. The format is a template parameter, which makes every access a
+// fixed computation for that layout (no per pixel checks of the format), and a kernel written against the view is compiled
+// once per format. Views of Bayer data also carry the phase, where the view starts in the colour filter, so a crop at an odd
+// row or column still knows the colour of every site. Accesses are not bounds checked.
+// Byte is const unsigned char for read-only views (SpinConstImageView).
+template <typename Format, typename Byte = unsigned char>
+class SpinImageView {
+public:
+    using Sample = typename std::conditional<std::is_const<Byte>::value, const typename Format::Sample, typename Format::Sample>::type;
+    using Value = typename Format::Sample;
+
+    SpinImageView() = default;
+    // stride 0 means width pixels without padding
+    SpinImageView(Byte* viewData, int viewWidth, int viewHeight, size_t viewStride = 0, int firstPhaseX = 0, int firstPhaseY = 0)
+        : data(viewData), width(viewWidth), height(viewHeight),
+          stride(viewStride ? viewStride : static_cast<size_t>(viewWidth) * kPixelBytes), phaseX(firstPhaseX & 1), phaseY(firstPhaseY & 1) {
+        if (width < 0 || height < 0 || (!data && width > 0 && height > 0)) {
+            throw std::runtime_error("[ ERROR ] Invalid image view.");
+        }
+        if (stride < static_cast<size_t>(width) * kPixelBytes) {
+            throw std::runtime_error("[ ERROR ] Image view stride is smaller than a row.");
+        }
+    }
+    // A writable view can be read through a read-only one
+    template <typename OtherByte, typename = typename std::enable_if<std::is_same<Byte, const OtherByte>::value>::type>
+    SpinImageView(const SpinImageView<Format, OtherByte>& other)
+        : SpinImageView(other.GetData(), other.GetWidth(), other.GetHeight(), other.GetStride(), other.GetPhaseX(), other.GetPhaseY()) {}
+
+    Byte* GetData() const { return data; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    size_t GetStride() const { return stride; }
+    int GetPhaseX() const { return phaseX; }
+    int GetPhaseY() const { return phaseY; }
+    bool IsEmpty() const { return width == 0 || height == 0; }
+
+    Sample* Row(int y) const {
+        return reinterpret_cast<Sample*>(data + static_cast<size_t>(y) * stride);
+    }
+    // Sample of channel c (0 for grey and Bayer data)
+    Sample& At(int x, int y, int c = 0) const {
+        return Row(y)[static_cast<size_t>(x) * Format::channels + c];
+    }
+
+    // The same pixels from (x, y) on, clipped to the view (an empty view if nothing is left)
+    SpinImageView Crop(int x, int y, int cropWidth, int cropHeight) const {
+        const int64_t left = std::max<int64_t>(x, 0);
+        const int64_t top = std::max<int64_t>(y, 0);
+        const int64_t right = std::min<int64_t>(static_cast<int64_t>(x) + cropWidth, width);
+        const int64_t bottom = std::min<int64_t>(static_cast<int64_t>(y) + cropHeight, height);
+        if (right <= left || bottom <= top) {
+            return SpinImageView();
+        }
+        return SpinImageView(data + static_cast<size_t>(top) * stride + static_cast<size_t>(left) * kPixelBytes, static_cast<int>(right - left),
+                             static_cast<int>(bottom - top), stride, phaseX + static_cast<int>(left), phaseY + static_cast<int>(top));
+    }
+
+    // Colour index (0 R, 1 G, 2 B) of the Bayer site at (x, y)
+    int GetSiteColor(int x, int y) const {
+        static_assert(Format::bayer, "Only Bayer views have colour sites");
+        const int siteX = (x + phaseX - Format::redX) & 1;
+        const int siteY = (y + phaseY - Format::redY) & 1;
+        // Red where both match the red site, blue where neither does, green otherwise
+        return siteX + siteY == 1 ? 1 : siteX << 1;
+    }
+
+    // Colour of a pixel without interpolation: grey is repeated, RGB is read as is. A Bayer pixel takes red and blue from
+    // its 2x2 quad of the colour filter, green its own sample on a green site and the truncated average of the quad's two
+    // greens on a red or blue one (what SpinImage::GetPixelRGB has always done). Quads cut by the view's edges take the
+    // missing samples from its last row or column. down drops that many low bits of every sample before the greens are
+    // averaged (SpinBayerStats averages 8 bit samples).
+    void GetRGB(int x, int y, Value& R, Value& G, Value& B, int down = 0) const {
+        ReadRGB(x, y, R, G, B, down, std::integral_constant<bool, Format::bayer>());
+    }
+
+    // Set every pixel of the rectangle (clipped to the view) to value, one sample per channel
+    void Fill(int x, int y, int fillWidth, int fillHeight, const Value* value) const {
+        static_assert(!std::is_const<Byte>::value, "Read-only views cannot be filled");
+        const SpinImageView region = Crop(x, y, fillWidth, fillHeight);
+        for (int row = 0; row < region.height; ++row) {
+            Sample* samples = region.Row(row);
+            for (int i = 0; i < region.width; ++i) {
+                std::copy(value, value + Format::channels, samples + static_cast<size_t>(i) * Format::channels);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kPixelBytes = sizeof(Value) * Format::channels;
+
+    void ReadRGB(int x, int y, Value& R, Value& G, Value& B, int down, std::false_type) const {
+        const Sample* pixel = &At(x, y);
+        R = static_cast<Value>(pixel[0] >> down);
+        G = static_cast<Value>(pixel[Format::channels > 1 ? 1 : 0] >> down);
+        B = static_cast<Value>(pixel[Format::channels > 1 ? 2 : 0] >> down);
+    }
+
+    void ReadRGB(int x, int y, Value& R, Value& G, Value& B, int down, std::true_type) const {
+        // Corners of the quad in view coordinates, the red site first
+        const int quadX = ((x + phaseX) & ~1) - phaseX;
+        const int quadY = ((y + phaseY) & ~1) - phaseY;
+        const int redX = Clamp(quadX + Format::redX, width);
+        const int redY = Clamp(quadY + Format::redY, height);
+        const int blueX = Clamp(quadX + (Format::redX ^ 1), width);
+        const int blueY = Clamp(quadY + (Format::redY ^ 1), height);
+        R = static_cast<Value>(At(redX, redY) >> down);
+        B = static_cast<Value>(At(blueX, blueY) >> down);
+        // The greens share a row with one and a column with the other
+        const Value average = static_cast<Value>(((At(blueX, redY) >> down) + (At(redX, blueY) >> down)) >> 1);
+        G = GetSiteColor(x, y) == 1 ? static_cast<Value>(At(x, y) >> down) : average;
+    }
+
+    static int Clamp(int value, int size) {
+        return std::min(std::max(value, 0), size - 1);
+    }
+
+    Byte* data = nullptr;
+    int width = 0;
+    int height = 0;
+    size_t stride = 0;
+    int phaseX = 0;  // Column of the view's first pixel in the colour filter's quad (0 or 1)
+    int phaseY = 0;
+};
+
+template <typename Format>
+using SpinConstImageView = SpinImageView<Format, const unsigned char>;
+
+#endif // SPINNAKER_SDK_SPINIMAGEVIEW_H
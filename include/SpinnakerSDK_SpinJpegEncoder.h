@@ -0,0 +1,14 @@
+#ifndef SPINNAKER_SDK_SPINJPEGENCODER_H
+#define SPINNAKER_SDK_SPINJPEGENCODER_H
+
+#include "SpinnakerSDK_SpinImageEncoder.h"
+
+// Baseline JPEG encoder (standard tables, JFIF), encoding strips of MCU rows in parallel
+// A restart marker closes every MCU row, which resets the DC prediction and byte-aligns the entropy coded data, so the
+// strips are encoded independently and simply concatenated.
+class SpinJpegEncoder : public SpinImageEncoder {
+public:
+    void Encode(const SpinPixelBuffer& pixels, const SpinEncodeOptions& options, std::vector<unsigned char>& output) override;
+};
+
+#endif // SPINNAKER_SDK_SPINJPEGENCODER_H
@@ -0,0 +1,226 @@
+#ifndef SPINNAKER_SDK_SPINLOGGER_H
+#define SPINNAKER_SDK_SPINLOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Log levels, also usable in the preprocessor for SPIN_LOG_MIN_LEVEL
+#define SPIN_LOG_LEVEL_DEBUG 0
+#define SPIN_LOG_LEVEL_INFO 1
+#define SPIN_LOG_LEVEL_WARNING 2
+#define SPIN_LOG_LEVEL_ERROR 3
+#define SPIN_LOG_LEVEL_OFF 4
+
+// Messages below this level are compiled out entirely (e.g. -DSPIN_LOG_MIN_LEVEL=SPIN_LOG_LEVEL_INFO)
+#ifndef SPIN_LOG_MIN_LEVEL
+#define SPIN_LOG_MIN_LEVEL SPIN_LOG_LEVEL_DEBUG
+#endif
+
+enum class SpinLogLevel {
+    Debug = SPIN_LOG_LEVEL_DEBUG,
+    Info = SPIN_LOG_LEVEL_INFO,
+    Warning = SPIN_LOG_LEVEL_WARNING,
+    Error = SPIN_LOG_LEVEL_ERROR,
+    Off = SPIN_LOG_LEVEL_OFF
+};
+
+// A formatted message, as handed to the sink
+struct SpinLogMessage {
+    SpinLogLevel level;
+    uint64_t timestamp;  // Host steady clock (ns) at the time of the call
+    std::string text;    // Without the level prefix
+};
+
+// Asynchronous leveled logger
+// Logging a message only records a timestamp and copies its arguments into a slot of a lock-free ring buffer. A background
+// thread formats the messages and writes them out, flushing once per batch instead of once per line. When the ring is
+// full the message is dropped (and counted) rather than stalling the caller.
+// String literals are stored by pointer, every other string is copied (and truncated past kMaxTextSize bytes).
+class SpinLogger {
+public:
+    static const size_t kMaxArguments = 12;
+    static const size_t kMaxTextSize = 192;
+    static const size_t kRingSize = 2048;
+
+    static SpinLogger& Instance();
+
+    // Runtime level, messages below it are skipped at the cost of one atomic load
+    void SetLevel(SpinLogLevel level);
+    SpinLogLevel GetLevel() const;
+    bool IsEnabled(SpinLogLevel level) const {
+        return static_cast<int>(level) >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    // Where formatted messages go (default: errors to std::cerr, the rest to std::cout with the level as prefix)
+    // The sink runs on the logger thread, a null sink restores the default.
+    void SetSink(std::function<void(const SpinLogMessage&)> sink);
+
+    template <typename... Args>
+    void Log(SpinLogLevel level, const Args&... args) {
+        static_assert(sizeof...(Args) <= kMaxArguments, "Too many arguments for one log message");
+        Record record;
+        record.level = level;
+        record.timestamp = Now();
+        record.argumentCount = 0;
+        record.textSize = 0;
+        int expand[] = {0, (ArgumentTraits<Args>::Add(record, args), 0)...};
+        (void)expand;
+        Push(record);
+    }
+
+    // Block until every message logged before this call has been written
+    void Flush();
+    // Call before printing a report to the console: queued messages are let out first (Flush), so they do not end up in
+    // the middle of the report
+    void BeginReport();
+    // Messages lost because the ring was full
+    uint64_t GetDroppedMessages() const;
+
+    // Drain and stop the logger thread, later messages are written synchronously (runs automatically at exit)
+    void Shutdown();
+
+    static const char* LevelPrefix(SpinLogLevel level);
+
+private:
+    struct TextSpan {
+        uint16_t offset;
+        uint16_t size;
+    };
+
+    struct Argument {
+        enum class Type : uint8_t { Literal, Text, Signed, Unsigned, Float, Bool, Char, Pointer };
+        Type type;
+        union {
+            const char* literal;
+            TextSpan text;
+            int64_t signedValue;
+            uint64_t unsignedValue;
+            double floatValue;
+            bool boolValue;
+            char charValue;
+            const void* pointerValue;
+        };
+    };
+
+    struct Record {
+        SpinLogLevel level;
+        uint8_t argumentCount;
+        uint16_t textSize;
+        uint64_t timestamp;
+        Argument arguments[kMaxArguments];
+        char text[kMaxTextSize];  // Copied string arguments, back to back
+    };
+
+    // Slot of the bounded multi-producer queue (Vyukov), the sequence tells producers and the consumer whose turn it is
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    SpinLogger();
+    ~SpinLogger() = delete;  // Lives until the process ends, so static destructors can still log
+
+    static uint64_t Now();
+
+    static void AddText(Record& record, const char* value, size_t size);
+    static Argument& NextArgument(Record& record, Argument::Type type) {
+        Argument& argument = record.arguments[record.argumentCount++];
+        argument.type = type;
+        return argument;
+    }
+
+    static void AddValue(Record& record, const char* value) {
+        AddText(record, value ? value : "(null)", value ? std::strlen(value) : 6);
+    }
+    static void AddValue(Record& record, const std::string& value) {
+        AddText(record, value.data(), value.size());
+    }
+    static void AddValue(Record& record, bool value) {
+        NextArgument(record, Argument::Type::Bool).boolValue = value;
+    }
+    static void AddValue(Record& record, char value) {
+        NextArgument(record, Argument::Type::Char).charValue = value;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type AddValue(Record& record, T value) {
+        NextArgument(record, Argument::Type::Signed).signedValue = value;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type AddValue(Record& record, T value) {
+        NextArgument(record, Argument::Type::Unsigned).unsignedValue = value;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type AddValue(Record& record, T value) {
+        NextArgument(record, Argument::Type::Float).floatValue = value;
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_enum<T>::value>::type AddValue(Record& record, T value) {
+        AddValue(record, static_cast<typename std::underlying_type<T>::type>(value));
+    }
+    template <typename T>
+    static void AddValue(Record& record, const T* value) {
+        NextArgument(record, Argument::Type::Pointer).pointerValue = value;
+    }
+
+    // Character arrays are taken to be string literals and kept by pointer, everything else goes through AddValue
+    template <typename T>
+    struct ArgumentTraits {
+        static void Add(Record& record, const T& value) {
+            AddValue(record, value);
+        }
+    };
+    template <size_t N>
+    struct ArgumentTraits<char[N]> {
+        static void Add(Record& record, const char (&value)[N]) {
+            NextArgument(record, Argument::Type::Literal).literal = value;
+        }
+    };
+
+    void Push(const Record& record);
+    std::string Format(const Record& record) const;
+    void Write(const SpinLogMessage& message);
+    void DrainLoop();
+    // Pop and write everything queued, returns the number of messages written (logger thread or after shutdown)
+    size_t Drain();
+
+    std::unique_ptr<Cell[]> cells;
+    // Producer and consumer positions on separate cache lines (padded by hand, the logger is allocated with plain new)
+    char padding0[64];
+    std::atomic<size_t> enqueuePosition{0};
+    char padding1[64];
+    std::atomic<size_t> dequeuePosition{0};
+    char padding2[64];
+    std::atomic<size_t> writtenPosition{0};  // Every message before this position has been written
+
+    std::atomic<int> runtimeLevel{SPIN_LOG_LEVEL_INFO};
+    std::atomic<uint64_t> droppedMessages{0};
+    uint64_t reportedDrops = 0;
+
+    std::mutex sinkMutex;  // Guards the sink, and serializes draining once the thread has stopped
+    std::function<void(const SpinLogMessage&)> sink;
+
+    std::atomic<bool> running{false};
+    std::thread drainThread;
+};
+
+#define SPIN_LOG(level, levelValue, ...)                                                    \
+    do {                                                                                    \
+        if ((levelValue) >= SPIN_LOG_MIN_LEVEL && SpinLogger::Instance().IsEnabled(level)) { \
+            SpinLogger::Instance().Log(level, __VA_ARGS__);                                 \
+        }                                                                                   \
+    } while (0)
+
+#define SPIN_LOG_DEBUG(...) SPIN_LOG(SpinLogLevel::Debug, SPIN_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define SPIN_LOG_INFO(...) SPIN_LOG(SpinLogLevel::Info, SPIN_LOG_LEVEL_INFO, __VA_ARGS__)
+#define SPIN_LOG_WARNING(...) SPIN_LOG(SpinLogLevel::Warning, SPIN_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define SPIN_LOG_ERROR(...) SPIN_LOG(SpinLogLevel::Error, SPIN_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif // SPINNAKER_SDK_SPINLOGGER_H
@@ -32,6 +32,24 @@ namespace SpinOption {
         NewestFirst  // Newest first buffer handling mode
     };
 
+    // Available image ownership modes
+    // Copy duplicates the frame into host memory and hands the driver buffer straight back to the stream.
+    // Lease wraps the driver buffer without copying and hands it back once the last SpinImage referencing it is destroyed.
+    // NOTE: Every leased frame occupies one stream buffer, so keep fewer alive than the stream buffer count
+    // and drop them before stopping acquisition. Use SpinImage::Detach() to keep a frame for longer.
+    enum class ImageOwnership {
+        Copy,  // Copy the frame out of the driver buffer (default)
+        Lease  // Reference the driver buffer directly (zero-copy)
+    };
+
+    // Available trigger wait policies
+    // Spinning reacts fastest but occupies a core while waiting, blocking costs a thread wake-up but no CPU
+    enum class TriggerWaitPolicy {
+        Block,          // Sleep until the trigger fires
+        SpinThenBlock,  // Busy-wait for a short while, then sleep
+        Spin            // Busy-wait until the trigger fires
+    };
+
     // Available pixel binning formats
     // Pixel binning is the process of combining the charge from adjacent pixels into a single pixel. 
     // This effectively reduces the resolution of the sensor but increases the signal-to-noise ratio 
@@ -0,0 +1,14 @@
+#ifndef SPINNAKER_SDK_SPINPNGENCODER_H
+#define SPINNAKER_SDK_SPINPNGENCODER_H
+
+#include "SpinnakerSDK_SpinImageEncoder.h"
+
+// PNG encoder on zlib, compressing strips of rows in parallel
+// Every strip is deflated on its own (primed with the end of the previous strip as dictionary, so little ratio is lost)
+// and ends on a byte boundary, so the strips join into a single zlib stream inside one IDAT chunk.
+class SpinPngEncoder : public SpinImageEncoder {
+public:
+    void Encode(const SpinPixelBuffer& pixels, const SpinEncodeOptions& options, std::vector<unsigned char>& output) override;
+};
+
+#endif // SPINNAKER_SDK_SPINPNGENCODER_H
@@ -0,0 +1,46 @@
+#ifndef SPINNAKER_SDK_SPINPREROLLBUFFER_H
+#define SPINNAKER_SDK_SPINPREROLLBUFFER_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Ring of the most recent frames, searchable by device timestamp
+// Frames are expected to be pushed in capture order (non-decreasing timestamps), the oldest frame is overwritten when full.
+class SpinPreRollBuffer {
+public:
+    explicit SpinPreRollBuffer(size_t capacity);
+
+    void Push(const SpinImage& frame);
+    void Clear();
+
+    // Frame whose timestamp is closest to the given timestamp, returns false if the buffer is empty
+    bool FindClosest(uint64_t timestamp, SpinImage& frame) const;
+    // The closest frame plus up to framesBefore older and framesAfter newer frames, oldest first
+    std::vector<SpinImage> GetWindow(uint64_t timestamp, size_t framesBefore, size_t framesAfter) const;
+
+    // Block until framesAfter frames newer than the closest frame to timestamp are buffered, returns false on timeout
+    // With framesAfter = 0 this waits until the closest frame can no longer change (a frame at or past timestamp arrived).
+    bool WaitForFramesAfter(uint64_t timestamp, size_t framesAfter, std::chrono::milliseconds timeout) const;
+
+    size_t Size() const;
+    size_t Capacity() const;
+
+private:
+    // Logical index 0 is the oldest buffered frame (callers must hold the mutex)
+    const SpinImage& At(size_t index) const;
+    size_t ClosestIndex(uint64_t timestamp) const;
+    // Number of frames from the closest frame to the newest, inclusive (0 while the closest frame is not settled)
+    size_t FramesFromClosest(uint64_t timestamp) const;
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable frameArrived;
+    std::vector<SpinImage> frames;
+    size_t head = 0;   // Next slot to write
+    size_t count = 0;  // Number of buffered frames
+};
+
+#endif // SPINNAKER_SDK_SPINPREROLLBUFFER_H
@@ -0,0 +1,97 @@
+#ifndef SPINNAKER_SDK_SPINQUEUE_H
+#define SPINNAKER_SDK_SPINQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free single-producer / single-consumer queue
+// Exactly one thread may push (e.g. the camera's image event thread) and exactly one thread may pop.
+// The capacity is rounded up to the next power of two.
+template <typename T>
+class SpinQueue {
+public:
+    explicit SpinQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        slotCount = rounded;
+        slotMask = rounded - 1;
+        slots = new Slot[slotCount];
+    }
+
+    ~SpinQueue() {
+        // Destroy anything still queued
+        for (size_t i = head.load(); i != tail.load(); ++i) {
+            reinterpret_cast<T*>(&slots[i & slotMask].storage)->~T();
+        }
+        delete[] slots;
+    }
+
+    SpinQueue(const SpinQueue&) = delete;
+    SpinQueue& operator=(const SpinQueue&) = delete;
+
+    // Producer side, returns false (and leaves item untouched) when the queue is full
+    bool TryPush(T&& item) {
+        const size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - cachedHead >= slotCount) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (currentTail - cachedHead >= slotCount) {
+                return false;
+            }
+        }
+        new (&slots[currentTail & slotMask].storage) T(std::move(item));
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(const T& item) {
+        T copy(item);
+        return TryPush(std::move(copy));
+    }
+
+    // Consumer side, returns false when the queue is empty
+    bool TryPop(T& item) {
+        const size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (currentHead == cachedTail) {
+                return false;
+            }
+        }
+        T* stored = reinterpret_cast<T*>(&slots[currentHead & slotMask].storage);
+        item = std::move(*stored);
+        stored->~T();
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of queued items (exact when called from either endpoint with the other idle)
+    size_t Size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const {
+        return slotCount;
+    }
+
+private:
+    struct Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    Slot* slots;
+    size_t slotCount;
+    size_t slotMask;
+
+    // Producer and consumer indices live on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;
+};
+
+#endif // SPINNAKER_SDK_SPINQUEUE_H
@@ -0,0 +1,66 @@
+#ifndef SPINNAKER_SDK_SPINRAWREADER_H
+#define SPINNAKER_SDK_SPINRAWREADER_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include "SpinnakerSDK_SpinRawRecorder.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Random access to a raw recording made by SpinRawRecorder
+// The file is memory mapped and frames are handed out as SpinImage views of the mapping, so opening a recording and
+// jumping to any frame costs a binary search and a page fault instead of a decode. Views keep the mapping alive, they
+// stay valid after the reader is closed or destroyed. The mapping is read-only and so are the views, writing into one
+// (through SpinImage::GetView) copies the frame first, Detach does too.
+// Frames of a compressed recording are decoded on the way out (the tiles in parallel) into a buffer of their own.
+class SpinRawReader {
+public:
+    SpinRawReader();
+    explicit SpinRawReader(const std::string& filename);
+
+    void Open(const std::string& filename);
+    void Close();
+    bool IsOpen() const;
+
+    size_t GetFrameCount() const;
+    uint64_t GetFirstTimestamp() const;
+    uint64_t GetLastTimestamp() const;
+    // Whether the index came from the file (false when it had to be rebuilt from an unclosed recording)
+    bool HasStoredIndex() const;
+
+    const SpinRawFormat::IndexEntry& GetIndexEntry(size_t frame) const;
+    // Zero-copy view of a frame by its number in the recording (a decoded copy if the frame is compressed)
+    SpinImage GetFrame(size_t frame) const;
+    // Number of the first frame with a timestamp at or after the given one (GetFrameCount if there is none)
+    size_t FindFrame(uint64_t timestamp) const;
+    // Views of every frame with startTimestamp <= timestamp < endTimestamp
+    std::vector<SpinImage> GetFrames(uint64_t startTimestamp, uint64_t endTimestamp) const;
+
+    // Ask the kernel to start reading frames ahead of time (e.g. the next ones during playback)
+    void Prefetch(size_t firstFrame, size_t frameCount) const;
+
+private:
+    struct Mapping {
+        ~Mapping();
+        unsigned char* data = nullptr;
+        size_t size = 0;
+    };
+
+    void LoadIndex();
+    void RebuildIndex();
+
+    std::string filename;
+    std::shared_ptr<Mapping> mapping;
+    SpinRawFormat::FileHeader header;
+    // Points into the mapping when the file has an index, otherwise at rebuiltIndex
+    const SpinRawFormat::IndexEntry* index = nullptr;
+    size_t frameCount = 0;
+    std::vector<SpinRawFormat::IndexEntry> rebuiltIndex;
+    bool storedIndex = false;
+    bool sorted = true;                     // Whether the timestamps never go backwards, FindFrame falls back to a scan otherwise
+    std::unique_ptr<SpinBayerCodec> codec;  // Only for compressed recordings
+};
+
+#endif // SPINNAKER_SDK_SPINRAWREADER_H
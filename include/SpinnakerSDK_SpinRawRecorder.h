@@ -0,0 +1,224 @@
+#ifndef SPINNAKER_SDK_SPINRAWRECORDER_H
+#define SPINNAKER_SDK_SPINRAWRECORDER_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include "SpinnakerSDK_SpinBayerCodec.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// On-disk layout of a raw recording (little-endian)
+// A 4096 byte file header, followed by one record per frame and then the frame index. Every record is a 64 byte frame
+// header and the raw pixel data, padded to a multiple of 4096 bytes so the file can be written with O_DIRECT and every
+// frame starts on a page boundary. The index holds one 64 byte entry per frame, so a reader can find any frame without
+// touching the others. A recording that was never closed has no index, its records can still be walked one by one.
+// In a compressed recording the pixel data of most records is the codec's output, frames the codec cannot handle (or
+// that do not get any smaller) are stored as is. The frame magic and the rawSize in the index tell the two apart.
+namespace SpinRawFormat {
+    const uint64_t kFileMagic = 0x315741524e495053ull;   // "SPINRAW1"
+    const uint32_t kFrameMagic = 0x4d415246u;            // "FRAM"
+    const uint32_t kCompressedFrameMagic = 0x5a4d5246u;  // "FRMZ", the pixel data is compressed
+    const uint32_t kVersion = 1;
+    const size_t kBlockSize = 4096;
+
+    enum class Compression : uint32_t {
+        None = 0,
+        BayerLossless = 1  // SpinBayerCodec
+    };
+
+    struct FileHeader {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t headerSize;       // Offset of the first record
+        uint32_t blockSize;        // Alignment of every record
+        uint32_t compression;      // SpinRawFormat::Compression of the pixel data
+        uint64_t frameCount;       // Filled in when the recording is closed
+        uint64_t dataSize;         // Bytes of records following the header
+        uint64_t firstTimestamp;   // Device timestamps of the first and last frame (ns)
+        uint64_t lastTimestamp;
+        uint64_t indexOffset;      // Offset of the frame index, 0 if the recording was not closed
+        uint64_t indexCount;       // Entries in the frame index
+    };
+
+    struct FrameHeader {
+        uint32_t magic;
+        uint32_t headerSize;       // Offset of the pixel data within the record
+        uint64_t recordSize;       // Header, data and padding (multiple of blockSize)
+        uint64_t dataSize;         // Bytes of pixel data
+        uint64_t frameID;
+        uint64_t timestamp;        // Device timestamp (ns)
+        uint32_t width;
+        uint32_t height;
+        int32_t pixelFormat;       // Spinnaker::PixelFormatEnums
+        int32_t imageStatus;       // 0 for complete frames
+        uint64_t sequence;         // Index of the frame within the recording
+    };
+    static_assert(sizeof(FrameHeader) == 64, "Raw frame header must stay 64 bytes");
+
+    struct IndexEntry {
+        uint64_t offset;           // Offset of the frame's record
+        uint64_t dataSize;         // Bytes of pixel data (they start headerSize bytes into the record)
+        uint64_t frameID;
+        uint64_t timestamp;        // Device timestamp (ns)
+        uint32_t width;
+        uint32_t height;
+        uint32_t stride;           // Bytes per row
+        int32_t pixelFormat;       // Spinnaker::PixelFormatEnums
+        int32_t imageStatus;       // 0 for complete frames
+        uint32_t headerSize;       // Offset of the pixel data within the record
+        uint64_t rawSize;          // Bytes of pixel data once decompressed, 0 if the frame is stored as is
+    };
+    static_assert(sizeof(IndexEntry) == 64, "Raw index entry must stay 64 bytes");
+
+    // Size of the record holding dataSize bytes of pixels
+    inline uint64_t RecordSize(uint64_t dataSize) {
+        return (sizeof(FrameHeader) + dataSize + kBlockSize - 1) / kBlockSize * kBlockSize;
+    }
+}
+
+struct SpinRawRecorderConfig {
+    size_t chunkSize = 8 * 1024 * 1024;  // Bytes per write (raised to fit the largest frame given to Open)
+    size_t chunkCount = 16;              // Chunks in flight, this is how much the recorder can absorb while the disk is slow
+    size_t writerThreads = 2;            // Threads issuing writes at once
+    uint64_t preallocateBytes = 0;       // Reserve this much disk space up front (trimmed to the recorded size on Close)
+    bool directIO = true;                // Bypass the page cache (O_DIRECT on Linux, F_NOCACHE on macOS) where supported
+    bool blockWhenFull = false;          // Wait for a free chunk instead of dropping the frame
+    SpinRawFormat::Compression compression = SpinRawFormat::Compression::None;
+    SpinBayerCodecOptions codecOptions;  // Threads and tiles of the Bayer codec
+    size_t compressionQueue = 8;         // Frames waiting for the compressor before Push drops (or blocks)
+};
+
+// Counters of a SpinRawRecorder
+struct SpinRawRecorderStats {
+    uint64_t framesWritten = 0;    // Frames that reached the disk
+    uint64_t bytesWritten = 0;     // Record bytes written (including headers and padding)
+    uint64_t framesDropped = 0;    // Frames dropped because every chunk was waiting on the disk
+    uint64_t writeErrors = 0;      // Failed writes (their frames are lost and left out of the index)
+    uint64_t framesLost = 0;       // Frames in chunks that failed to write
+    uint64_t blockedNs = 0;        // Time spent waiting for a free chunk or a compression queue slot (blockWhenFull)
+    uint64_t rawBytes = 0;         // Pixel bytes of the recorded frames before compression
+    uint64_t storedBytes = 0;      // Pixel bytes actually stored
+    double compressionRatio = 1.0; // rawBytes over storedBytes
+    size_t chunksInFlight = 0;     // Chunks currently queued or being written
+    size_t peakChunksInFlight = 0; // Most chunks ever queued or being written at once
+    size_t chunkCount = 0;
+    double elapsedSeconds = 0.0;   // Since Open
+    double megabytesPerSecond = 0.0;
+    bool directIO = false;         // Whether the page cache is actually bypassed
+};
+
+// Writes raw frames to disk while they are being captured
+// Push copies a frame (header and pixels) into the current chunk, an aligned buffer of several megabytes. Full chunks go
+// to a pool of writer threads that write them at their final file offset, so the disk sees large aligned sequential
+// writes and capture never waits on I/O. When every chunk is waiting on the disk the frame is dropped and counted
+// (or Push waits, see blockWhenFull), which is the signal that the disk cannot keep up with the camera.
+// With compression on, Push only queues the frame, a compressor thread codes it (its tiles in parallel) and fills the
+// chunks. A full compression queue drops frames the same way, the signal that the cores cannot keep up.
+// Push must be called from one thread at a time (e.g. the camera's stream thread), Close may come from any other thread
+// and waits for a Push in progress.
+class SpinRawRecorder {
+public:
+    explicit SpinRawRecorder(const SpinRawRecorderConfig& config = SpinRawRecorderConfig());
+    ~SpinRawRecorder();
+
+    SpinRawRecorder(const SpinRawRecorder&) = delete;
+    SpinRawRecorder& operator=(const SpinRawRecorder&) = delete;
+
+    // maxFrameSize is the largest frame expected (e.g. the camera's PayloadSize), larger frames are dropped
+    void Open(const std::string& filename, size_t maxFrameSize = 0);
+    // Write out what is buffered, finish the file header and close the file
+    void Close();
+    bool IsOpen() const;
+
+    // Returns false when the frame was dropped
+    bool Push(const SpinImage& frame);
+    // Stream handler recording every frame (for SpinCamera::StartStream)
+    std::function<void(SpinImage&)> GetStreamHandler();
+
+    SpinRawRecorderStats GetStats() const;
+    void PrintStats() const;
+
+private:
+    struct Chunk {
+        unsigned char* data = nullptr;
+        size_t used = 0;        // Bytes filled
+        uint64_t offset = 0;    // File offset of the first byte
+        uint64_t frames = 0;    // Records in the chunk
+    };
+
+    // Copy a record into the current chunk (the producer side, Push or the compressor), returns false when dropped
+    bool AppendRecord(const SpinImage& frame, const unsigned char* data, uint64_t dataSize, uint64_t rawSize, bool wait);
+    void CompressorLoop();
+    void StopCompressor();
+
+    void AllocateChunks();
+    void FreeChunks();
+    // Hand the current chunk to the writers (producer side)
+    void Dispatch();
+    // Take a free chunk as the current one, returns false if none is free (and waiting is not allowed)
+    bool AcquireChunk(bool wait);
+    void WriterLoop();
+    bool WriteAt(const unsigned char* data, size_t size, uint64_t offset);
+    // Append the frame index after the last record (once the writers are done), returns the end of the file
+    uint64_t WriteIndex();
+    void WriteFileHeader();
+
+    SpinRawRecorderConfig config;
+    std::string filename;
+    int fd = -1;
+    bool directIO = false;
+    size_t chunkSize = 0;
+
+    std::vector<Chunk> chunks;
+    Chunk* current = nullptr;
+    uint64_t nextOffset = 0;       // File offset of the next record (producer side)
+    uint64_t nextSequence = 0;
+    uint64_t firstTimestamp = 0;
+    uint64_t lastTimestamp = 0;
+    bool warnedOversize = false;
+    std::deque<SpinRawFormat::IndexEntry> index;  // A deque, so growing it never copies what is already there
+    uint64_t indexOffset = 0;
+    std::mutex producerMutex;                        // Keeps Close from pulling the chunks out from under Push
+
+    mutable std::mutex mutex;
+    std::condition_variable chunkFree;
+    std::condition_variable chunkQueued;
+    std::deque<Chunk*> freeChunks;
+    std::deque<Chunk*> queuedChunks;
+    size_t chunksInFlight = 0;
+    size_t peakChunksInFlight = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> failedRanges;  // File offsets [first, last) of chunks that failed to write
+    bool stopping = false;
+    std::vector<std::thread> writers;
+
+    std::atomic<uint64_t> framesWritten{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> framesDropped{0};
+    std::atomic<uint64_t> writeErrors{0};
+    std::atomic<uint64_t> framesLost{0};
+    std::atomic<uint64_t> blockedNs{0};
+    std::atomic<uint64_t> rawBytes{0};
+    std::atomic<uint64_t> storedBytes{0};
+
+    // Frames waiting for the compressor
+    std::unique_ptr<SpinBayerCodec> codec;
+    std::mutex compressionMutex;
+    std::condition_variable frameQueued;
+    std::condition_variable frameTaken;
+    std::deque<SpinImage> compressionQueue;
+    bool compressorStopping = false;
+    std::thread compressor;
+    std::chrono::steady_clock::time_point openTime;
+};
+
+#endif // SPINNAKER_SDK_SPINRAWRECORDER_H
@@ -0,0 +1,135 @@
+#ifndef SPINNAKER_SDK_SPINSIMULATEDBACKEND_H
+#define SPINNAKER_SDK_SPINSIMULATEDBACKEND_H
+
+#include "Spinnaker.h"
+#include "SpinnakerSDK_SpinCameraBackend.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Description of the simulated camera
+struct SpinSimulatedCameraConfig {
+    int sensorWidth = 1440;
+    int sensorHeight = 1080;
+    std::string pixelFormat = "BayerRG8";   // Any SpinOption::PixelFormat name
+    double frameRate = 60.0;                // Frames per second, before the exposure time limit
+    double dropProbability = 0.0;           // Chance that a frame is lost in transport
+    double incompleteProbability = 0.0;     // Chance that a frame is delivered incomplete
+    uint32_t seed = 0;                      // Seed for the drop and incomplete injection
+    std::string serialNumber = "SIM00000";
+};
+
+// Camera backend that generates synthetic frames, for running without a camera attached (benchmarks, CI)
+// Frames are a moving gradient in the configured Bayer or Mono format, delivered at the configured frame rate.
+// The nodes touched by SpinCamera are emulated with their usual ranges, including the stream buffer count and
+// handling mode, so buffer starvation and frame loss behave like they do on a real camera.
+class SpinSimulatedBackend : public SpinCameraBackend {
+public:
+    explicit SpinSimulatedBackend(const SpinSimulatedCameraConfig& config = SpinSimulatedCameraConfig());
+    ~SpinSimulatedBackend() override;
+
+    // Camera setup and information
+    void Init() override;
+    void DeInit() override;
+    std::string GetSerialNumber() override;
+
+    // Acquisition
+    void BeginAcquisition() override;
+    void EndAcquisition() override;
+    SpinImage GetNextImage(uint64_t timeoutMs = kInfiniteTimeout) override;
+    void RegisterImageHandler(std::function<void(SpinImage&)> handler) override;
+    void UnregisterImageHandler() override;
+
+    // Node access
+    bool IsReadable(const std::string& node) override;
+    bool IsWritable(const std::string& node) override;
+    int64_t GetIntegerValue(const std::string& node) override;
+    int64_t GetIntegerMin(const std::string& node) override;
+    int64_t GetIntegerMax(const std::string& node) override;
+    void SetIntegerValue(const std::string& node, int64_t value) override;
+    double GetFloatValue(const std::string& node) override;
+    double GetFloatMin(const std::string& node) override;
+    double GetFloatMax(const std::string& node) override;
+    void SetFloatValue(const std::string& node, double value) override;
+    bool GetBooleanValue(const std::string& node) override;
+    void SetBooleanValue(const std::string& node, bool value) override;
+    std::string GetEnumerationValue(const std::string& node) override;
+    bool IsEnumerationEntryReadable(const std::string& node, const std::string& entry) override;
+    void SetEnumerationValue(const std::string& node, const std::string& entry) override;
+    void ExecuteCommand(const std::string& node) override;
+
+    // What the generator did since the last BeginAcquisition (to check the capture path against)
+    uint64_t GetGeneratedFrames() const;
+    uint64_t GetInjectedDrops() const;
+    uint64_t GetInjectedIncompletes() const;
+
+private:
+    enum class NodeType { Integer, Float, Boolean, Enumeration, Command };
+
+    struct Node {
+        NodeType type;
+        int64_t intValue = 0;
+        int64_t intMin = 0;
+        int64_t intMax = 0;
+        double floatValue = 0.0;
+        double floatMin = 0.0;
+        double floatMax = 0.0;
+        bool boolValue = false;
+        std::string enumValue;
+        std::vector<std::string> entries;
+        bool readOnly = false;
+        bool lockedWhileAcquiring = false;  // Geometry, format and buffer settings
+        std::string autoNode;               // Only writable while this enumeration is "Off"
+        std::string enableNode;             // Only writable while this boolean is true
+    };
+
+    // Buffers and queued frames of one acquisition, shared with the leases handed out
+    struct Stream;
+
+    void AddInteger(const std::string& name, int64_t value, int64_t min, int64_t max, bool lockedWhileAcquiring = false);
+    void AddFloat(const std::string& name, double value, double min, double max, const std::string& autoNode = "", const std::string& enableNode = "");
+    void AddBoolean(const std::string& name, bool value);
+    void AddEnumeration(const std::string& name, const std::string& value, const std::vector<std::string>& entries, bool lockedWhileAcquiring = false);
+    void AddCommand(const std::string& name);
+
+    // Node lookup (callers must hold nodeMutex), throws if the node is missing or of another type
+    Node& GetNode(const std::string& name, NodeType type);
+    bool IsWritableLocked(const std::string& name);
+    // Recompute the limits that depend on binning, decimation, exposure and pixel format
+    void UpdateDerivedNodes();
+
+    // Camera clock, nanoseconds since Init
+    uint64_t DeviceTime() const;
+
+    void GeneratorLoop(std::shared_ptr<Stream> stream);
+    void FillFrame(unsigned char* data, int width, int height, int bitsPerPixel, bool bayer, uint64_t frameID) const;
+
+    SpinSimulatedCameraConfig config;
+    bool initialized = false;
+    bool acquiring = false;  // Guarded by nodeMutex
+
+    std::mutex nodeMutex;
+    std::map<std::string, Node> nodes;
+    std::map<std::string, double> balanceRatios;  // BalanceRatio per BalanceRatioSelector entry
+    std::mt19937 random;
+
+    std::mutex streamMutex;          // Guards stream, which GetNextImage reads while another thread may end acquisition
+    std::shared_ptr<Stream> stream;
+    std::thread generator;
+    std::chrono::steady_clock::time_point clockStart;
+
+    std::mutex handlerMutex;
+    std::function<void(SpinImage&)> imageHandler;
+
+    std::atomic<uint64_t> generatedFrames{0};
+    std::atomic<uint64_t> injectedDrops{0};
+    std::atomic<uint64_t> injectedIncompletes{0};
+};
+
+#endif // SPINNAKER_SDK_SPINSIMULATEDBACKEND_H
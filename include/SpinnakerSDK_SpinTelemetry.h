@@ -0,0 +1,110 @@
+#ifndef SPINNAKER_SDK_SPINTELEMETRY_H
+#define SPINNAKER_SDK_SPINTELEMETRY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SpinImage;
+
+// Point-in-time copy of a SpinHistogram
+struct SpinHistogramSnapshot {
+    std::vector<uint64_t> buckets;  // Bucket i counts values in [2^i, 2^(i+1)) ns, bucket 0 also holds 0
+    uint64_t count = 0;
+    uint64_t sum = 0;               // ns
+    uint64_t max = 0;               // ns
+
+    double Mean() const;
+    // Upper bound of the bucket holding the given quantile (0..1), in ns
+    uint64_t Quantile(double quantile) const;
+};
+
+// Lock-free histogram of nanosecond durations in power-of-two buckets
+// Recording is a handful of relaxed atomic increments, so it is safe on the image event thread.
+class SpinHistogram {
+public:
+    static const size_t kBucketCount = 64;
+
+    SpinHistogram();
+    void Record(uint64_t valueNs);
+    SpinHistogramSnapshot Snapshot() const;
+    void Reset();
+
+private:
+    std::atomic<uint64_t> buckets[kBucketCount];
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+};
+
+// Point-in-time copy of a camera's SpinTelemetry
+struct SpinTelemetrySnapshot {
+    double elapsedSeconds = 0.0;     // Since the telemetry was created or reset
+    uint64_t deliveredFrames = 0;    // Complete frames handed to the application
+    uint64_t deliveredBytes = 0;
+    uint64_t incompleteFrames = 0;   // Frames the camera or transport could not complete
+    uint64_t lostFrames = 0;         // Frames the driver reports lost (StreamLostFrameCount)
+    uint64_t frameIDGaps = 0;        // Frame IDs skipped between consecutive frames
+    uint64_t acquisitions = 0;       // Number of acquisitions started
+    double framesPerSecond = 0.0;    // Delivered frames over the elapsed time
+    double megabytesPerSecond = 0.0; // Delivered bytes over the elapsed time (MB = 10^6 bytes)
+    SpinHistogramSnapshot frameInterval; // Device timestamp difference between consecutive frames
+    SpinHistogramSnapshot latency;       // Host arrival minus device timestamp (only once the camera clock is synchronized)
+};
+
+// Capture health counters of one camera, updated lock-free on the hot path and readable at any time
+// Frame ID and timestamp tracking assumes one producer at a time (the capture loop or the image event thread).
+class SpinTelemetry {
+public:
+    explicit SpinTelemetry(const std::string& cameraName = "camera");
+
+    // Hot path, called for every frame that arrives from the camera (complete or not)
+    void RecordFrame(const SpinImage& frame);
+    // Called when acquisition starts, frame IDs and the lost frame counter start over
+    void BeginAcquisition();
+    // Driver lost frame counter of the current acquisition
+    void SetLostFrames(uint64_t lostFrames);
+    // Camera clock minus host steady clock (ns), enables the latency histogram
+    void SetClockOffset(int64_t offset);
+
+    // Label used in the dumps (set it before streaming starts)
+    void SetCameraName(const std::string& cameraName);
+    std::string GetCameraName() const;
+
+    SpinTelemetrySnapshot Snapshot() const;
+    void Reset();
+
+    // Prometheus text exposition format, or a JSON object
+    std::string ToPrometheus() const;
+    std::string ToJson() const;
+    // Write the dump to a file (format chosen by extension: .json for JSON, anything else for Prometheus text)
+    bool WriteFile(const std::string& filename) const;
+    void PrintStats() const;
+
+private:
+    std::string cameraName;
+
+    std::atomic<int64_t> startTime{0};  // Host steady clock (ns)
+    std::atomic<uint64_t> deliveredFrames{0};
+    std::atomic<uint64_t> deliveredBytes{0};
+    std::atomic<uint64_t> incompleteFrames{0};
+    std::atomic<uint64_t> frameIDGaps{0};
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> previousLostFrames{0};  // Lost in acquisitions that already ended
+    std::atomic<uint64_t> currentLostFrames{0};
+
+    // Last frame seen, to measure gaps and intervals
+    std::atomic<bool> hasLastFrame{false};
+    std::atomic<uint64_t> lastFrameID{0};
+    std::atomic<uint64_t> lastTimestamp{0};
+
+    std::atomic<bool> clockSynchronized{false};
+    std::atomic<int64_t> clockOffset{0};
+
+    SpinHistogram frameInterval;
+    SpinHistogram latency;
+};
+
+#endif // SPINNAKER_SDK_SPINTELEMETRY_H
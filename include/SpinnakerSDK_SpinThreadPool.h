@@ -0,0 +1,40 @@
+#ifndef SPINNAKER_SDK_SPINTHREADPOOL_H
+#define SPINNAKER_SDK_SPINTHREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run submitted tasks in order of submission
+class SpinThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit SpinThreadPool(size_t threadCount = 0);
+    ~SpinThreadPool();
+
+    // Queue a task, the future reports its completion (and rethrows its exception on get())
+    std::future<void> Submit(std::function<void()> task);
+
+    // Run body(i) for every i in [0, count) on the pool and wait for all of them
+    // Every index runs even if some throw, the first exception is rethrown afterwards.
+    // Must not be called from one of the pool's own tasks (it would wait on itself).
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    size_t GetThreadCount() const;
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::packaged_task<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    bool stopping = false;
+};
+
+#endif // SPINNAKER_SDK_SPINTHREADPOOL_H
@@ -0,0 +1,48 @@
+#ifndef SPINNAKER_SDK_SPINTRIGGER_H
+#define SPINNAKER_SDK_SPINTRIGGER_H
+
+#include "SpinnakerSDK_SpinOption.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Software trigger that capture threads can block on, waking immediately when it is fired
+// The moment of firing is recorded on the host steady clock (see SpinCamera::HostToDeviceTime to compare it with frame timestamps).
+class SpinTrigger {
+public:
+    SpinTrigger(SpinOption::TriggerWaitPolicy policy = SpinOption::TriggerWaitPolicy::Block, int spin_time_us = 200);
+
+    // Fire the trigger, waking every waiting thread
+    void Fire();
+    // Re-arm the trigger so it can be waited on again
+    void Reset();
+
+    // Wait until the trigger fires
+    void Wait();
+    // Wait until the trigger fires or the timeout expires, returns whether the trigger fired
+    bool WaitFor(std::chrono::microseconds timeout);
+
+    bool IsFired() const;
+    void SetWaitPolicy(SpinOption::TriggerWaitPolicy policy, int spin_time_us = 200);
+
+    // Host steady clock time (ns) at which the trigger fired, 0 if it has not fired
+    uint64_t GetTriggerTime() const;
+
+    // Host steady clock time in ns, the clock GetTriggerTime() is measured on
+    static uint64_t Now();
+
+private:
+    bool Spin(std::chrono::steady_clock::time_point deadline) const;
+
+    SpinOption::TriggerWaitPolicy waitPolicy;
+    int spinTimeUs;
+
+    std::atomic<bool> fired{false};
+    std::atomic<uint64_t> triggerTime{0};
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+#endif // SPINNAKER_SDK_SPINTRIGGER_H
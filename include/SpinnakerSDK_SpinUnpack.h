@@ -0,0 +1,29 @@
+#ifndef SPINNAKER_SDK_SPINUNPACK_H
+#define SPINNAKER_SDK_SPINUNPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Unpacking of raw samples of 8, 10p, 12p and 16 bit frames
+// The packed formats are one LSB-first bit stream over the whole frame (10p: 4 samples in 5 bytes, 12p: 2 in 3), so a
+// frame is addressed by sample index and any run of samples can be unpacked, whether or not its rows start on a byte.
+// 16 bit samples are little-endian. Whole groups are unpacked 8 samples at a time with SSSE3 (when the CPU has it),
+// the ragged ends one by one.
+class SpinUnpacker {
+public:
+    // Samples firstSample to firstSample + count - 1 of the frame at data as 16 bit values, shifted left by shift bits
+    // (e.g. 16 - bitsPerPixel to fill the 16 bit range)
+    static void Unpack16(const unsigned char* data, int bitsPerPixel, size_t firstSample, size_t count, uint16_t* samples, int shift = 0);
+    // The same as 8 bit values, the top 8 bits of every sample or its entry in toneMap (1 << bitsPerPixel entries)
+    static void Unpack8(const unsigned char* data, int bitsPerPixel, size_t firstSample, size_t count, unsigned char* samples,
+                        const unsigned char* toneMap = nullptr);
+
+    // Tone map for Unpack8, the samples scaled to 8 bits with a gamma curve (1.0 is linear, below 1.0 lifts the shadows)
+    static std::vector<unsigned char> MakeToneMap(int bitsPerPixel, double gamma = 1.0);
+    // Bytes holding count samples from the start of a frame
+    static size_t GetPackedSize(int bitsPerPixel, size_t count);
+    static bool IsSupported(int bitsPerPixel);
+};
+
+#endif // SPINNAKER_SDK_SPINUNPACK_H
@@ -0,0 +1,114 @@
+#ifndef SPINNAKER_SDK_SPINVIDEOWRITER_H
+#define SPINNAKER_SDK_SPINVIDEOWRITER_H
+
+#include "SpinnakerSDK_SpinImage.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SpinVideoFormat {
+    enum class Container {
+        Y4M,       // YUV4MPEG2, 4:2:0 full range (mono frames as Cmono), readable by ffmpeg, mpv, x264 ... without options
+        RawVideo   // Bare rgb24 or gray frames back to back, the reader has to be told the size and pixel format
+    };
+}
+
+struct SpinVideoWriterConfig {
+    SpinVideoFormat::Container container = SpinVideoFormat::Container::Y4M;
+    double frameRate = 30.0;       // Stored in the Y4M header
+    size_t queueCapacity = 8;      // Frames waiting for the writer thread
+    bool blockWhenFull = true;     // Wait for the writer instead of dropping the frame
+    SpinDemosaicOptions demosaicOptions;  // How raw Bayer frames are demosaiced or unpacked (e.g. threadCount 0 to spread them over every core)
+};
+
+// Counters of a SpinVideoWriter
+struct SpinVideoWriterStats {
+    uint64_t framesWritten = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t framesDropped = 0;    // Frames dropped because the queue was full (or they did not match the first frame)
+    uint64_t writeErrors = 0;
+    size_t peakQueueDepth = 0;
+    double convertSeconds = 0.0;   // Time spent converting frames on the writer thread
+    double writeSeconds = 0.0;     // Time spent writing frames (waiting on the encoder when writing to a pipe)
+};
+
+// Streams frames to a video file or straight into an encoder, without intermediate images on disk
+// Push queues a reference to the frame, a background thread converts it (demosaic, colour conversion) into a reused
+// buffer and writes it out. With OpenPipe the frames go to an encoder's standard input, e.g.
+//     writer.OpenPipe(SpinVideoWriter::FfmpegCommand("video.mp4"));
+// Queued frames keep their image data alive, so a leased frame holds on to its driver buffer until it is written.
+// Push must be called from one thread at a time.
+class SpinVideoWriter {
+public:
+    explicit SpinVideoWriter(const SpinVideoWriterConfig& config = SpinVideoWriterConfig());
+    ~SpinVideoWriter();
+
+    SpinVideoWriter(const SpinVideoWriter&) = delete;
+    SpinVideoWriter& operator=(const SpinVideoWriter&) = delete;
+
+    // Write to a file
+    void Open(const std::string& filename);
+    // Write to the standard input of a shell command (e.g. an encoder)
+    void OpenPipe(const std::string& command);
+    // Write out the queued frames and close the output (waits for a piped encoder to finish)
+    void Close();
+    bool IsOpen() const;
+
+    // Returns false when the frame was dropped
+    bool Push(const SpinImage& frame);
+    // Stream handler writing every frame (for SpinCamera::StartStream)
+    std::function<void(SpinImage&)> GetStreamHandler();
+
+    SpinVideoWriterStats GetStats() const;
+    void PrintStats() const;
+
+    // ffmpeg command line encoding a Y4M stream from standard input to the given file
+    static std::string FfmpegCommand(const std::string& outputFilename, const std::string& codecOptions = "-c:v libx264 -preset veryfast -pix_fmt yuv420p");
+
+private:
+    void Start();
+    void WriterLoop();
+    // Convert a frame into frameBuffer, returns false if it cannot be written
+    bool Convert(const SpinImage& frame);
+    bool WriteHeader();
+    bool Write(const void* data, size_t size);
+
+    SpinVideoWriterConfig config;
+    std::string target;
+    FILE* output = nullptr;
+    bool pipe = false;
+
+    mutable std::mutex mutex;
+    std::condition_variable frameQueued;
+    std::condition_variable frameTaken;
+    std::deque<SpinImage> queue;
+    bool stopping = false;
+    std::thread writer;
+
+    // Writer thread only
+    Spinnaker::ImageProcessor imageProcessor;
+    std::vector<unsigned char> frameBuffer;  // Converted frame, reused for every frame
+    std::vector<unsigned char> rgbBuffer;    // Demosaiced or unpacked raw frame, reused for every frame
+    size_t frameSize = 0;
+    int width = 0;
+    int height = 0;
+    bool color = false;
+    bool headerWritten = false;
+
+    std::atomic<uint64_t> framesWritten{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> framesDropped{0};
+    std::atomic<uint64_t> writeErrors{0};
+    std::atomic<uint64_t> convertNs{0};
+    std::atomic<uint64_t> writeNs{0};
+    size_t peakQueueDepth = 0;
+};
+
+#endif // SPINNAKER_SDK_SPINVIDEOWRITER_H
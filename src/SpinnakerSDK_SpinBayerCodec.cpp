@@ -0,0 +1,413 @@
+#include "../include/SpinnakerSDK_SpinBayerCodec.h"
+#include "../include/SpinnakerSDK_SpinUnpack.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    const uint32_t kMagic = 0x31434253;          // "SBC1"
+    const uint16_t kVersion = 1;
+    const uint32_t kStoredTile = 0x80000000u;    // Set in the tile size table for tiles stored without compression
+    const int kEscapeLength = 24;                // Longest unary prefix, larger residuals are written in full
+
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t bitsPerPixel;
+        uint32_t width;
+        uint32_t height;
+        uint32_t tileRows;       // Full resolution rows per tile
+        uint32_t tileCount;
+        uint64_t dataSize;       // Bytes of the decoded frame
+        uint32_t tailSize;       // Bytes from the first one not filled by samples alone, stored as is (padding, chunk data)
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Header) == 40, "Bayer codec header must stay 40 bytes");
+
+    int RoundTileRows(int tileRows) {
+        // Two rows per plane row, and four plane rows keep every tile on a byte boundary in any packed format
+        tileRows = std::max(tileRows, 4);
+        return 2 * ((tileRows + 3) / 4 * 4);
+    }
+
+    // Inverse of SpinUnpacker::Unpack16, never writes at or past end
+    void Pack(const uint16_t* samples, size_t count, int bitsPerPixel, unsigned char* data, const unsigned char* end) {
+        if (bitsPerPixel == 8) {
+            for (size_t i = 0; i < count; ++i) {
+                data[i] = static_cast<unsigned char>(samples[i]);
+            }
+        } else if (bitsPerPixel == 16) {
+            for (size_t i = 0; i < count; ++i) {
+                data[2 * i] = static_cast<unsigned char>(samples[i]);
+                data[2 * i + 1] = static_cast<unsigned char>(samples[i] >> 8);
+            }
+        } else {
+            uint64_t bits = 0;
+            int bitCount = 0;
+            for (size_t i = 0; i < count; ++i) {
+                bits |= static_cast<uint64_t>(samples[i]) << bitCount;
+                bitCount += bitsPerPixel;
+                while (bitCount >= 8) {
+                    *data++ = static_cast<unsigned char>(bits);
+                    bits >>= 8;
+                    bitCount -= 8;
+                }
+            }
+            if (bitCount > 0 && data < end) {
+                *data = static_cast<unsigned char>(bits);
+            }
+        }
+    }
+
+    // Writes into a fixed buffer and only counts once it is full, a tile that gets that large is stored instead
+    class BitWriter {
+    public:
+        BitWriter(unsigned char* data, size_t capacity) : data(data), capacity(capacity) {}
+
+        // Append the low size bits of value (size <= 56), most significant first
+        void Put(uint64_t value, int size) {
+            bits = (bits << size) | value;
+            bitCount += size;
+            while (bitCount >= 8) {
+                bitCount -= 8;
+                if (position < capacity) {
+                    data[position] = static_cast<unsigned char>(bits >> bitCount);
+                }
+                position++;
+            }
+        }
+
+        // Bytes written, larger than the capacity if the data did not fit
+        size_t Flush() {
+            if (bitCount > 0) {
+                Put(0, 8 - bitCount);
+            }
+            return position;
+        }
+
+        bool Full() const {
+            return position >= capacity;
+        }
+
+    private:
+        unsigned char* data;
+        size_t capacity;
+        size_t position = 0;
+        uint64_t bits = 0;
+        int bitCount = 0;
+    };
+
+    class BitReader {
+    public:
+        BitReader(const unsigned char* data, size_t size) : data(data), end(data + size) {}
+
+        uint32_t Get(int size) {
+            if (size == 0) {
+                return 0;
+            }
+            Refill();
+            uint32_t value = static_cast<uint32_t>(bits >> (64 - size));
+            bits <<= size;
+            bitCount -= size;
+            return value;
+        }
+
+        // Zeros before the next one bit (which is consumed too)
+        int GetUnary() {
+            Refill();
+            int zeros = bits ? __builtin_clzll(bits) : 64;
+            if (zeros > kEscapeLength) throw std::runtime_error("[ ERROR ] Corrupt Bayer codec data.");
+            bits <<= zeros + 1;
+            bitCount -= zeros + 1;
+            return zeros;
+        }
+
+    private:
+        // Keep at least 57 bits buffered, reading zeros past the end
+        void Refill() {
+            while (bitCount <= 56) {
+                uint64_t byte = data < end ? *data++ : 0;
+                bits |= byte << (56 - bitCount);
+                bitCount += 8;
+            }
+        }
+
+        const unsigned char* data;
+        const unsigned char* end;
+        uint64_t bits = 0;
+        int bitCount = 0;
+    };
+
+    // Running estimate of the residual magnitude, picks the Rice parameter
+    struct RiceState {
+        uint32_t sum = 4;
+        uint32_t count = 1;
+
+        int Parameter() const {
+            int k = 0;
+            while ((count << k) < sum && k < 16) {
+                k++;
+            }
+            return k;
+        }
+
+        void Update(uint32_t value) {
+            sum += value;
+            if (++count == 64) {
+                sum >>= 1;
+                count >>= 1;
+            }
+        }
+    };
+
+    // Median edge detector of LOCO-I
+    inline int Predict(int a, int b, int c) {
+        const int low = std::min(a, b);
+        const int high = std::max(a, b);
+        if (c >= high) return low;
+        if (c <= low) return high;
+        return a + b - c;
+    }
+
+    // Visit every sample of the tile plane by plane with the prediction from its neighbours of the same colour (left,
+    // up and up-left, within the tile). The first row of a tile only has left neighbours, the first column only upper
+    // ones. Stops early once stop() says so after a row.
+    template <typename Sample, typename Visitor, typename Stop>
+    void ForEachPlaneSample(int width, int rows, int mid, Sample* samples, Visitor visit, Stop stop) {
+        for (int plane = 0; plane < 4; ++plane) {
+            const int planeY = plane >> 1;
+            const int planeX = plane & 1;
+            for (int y = planeY; y < rows; y += 2) {
+                Sample* row = samples + static_cast<size_t>(y) * width;
+                int x = planeX;
+                if (y < 2) {
+                    int left = mid;
+                    for (; x < width; x += 2) {
+                        visit(row[x], left);
+                        left = row[x];
+                    }
+                } else {
+                    const Sample* up = row - 2 * static_cast<size_t>(width);
+                    if (x < width) {
+                        visit(row[x], up[x]);
+                        x += 2;
+                    }
+                    for (; x < width; x += 2) {
+                        visit(row[x], Predict(row[x - 2], up[x], up[x - 2]));
+                    }
+                }
+                if (stop()) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // Returns the coded size, or more than capacity when the tile does not compress
+    size_t EncodeTile(const uint16_t* samples, int width, int rows, int bitsPerPixel, unsigned char* output, size_t capacity) {
+        BitWriter writer(output, capacity);
+        RiceState state;
+        ForEachPlaneSample(width, rows, 1 << (bitsPerPixel - 1), samples, [&](const uint16_t& sample, int prediction) {
+            const int residual = static_cast<int>(sample) - prediction;
+            const uint32_t value = residual >= 0 ? static_cast<uint32_t>(residual) << 1 : (static_cast<uint32_t>(-residual) << 1) - 1;
+            const int k = state.Parameter();
+            const uint32_t quotient = value >> k;
+            if (quotient < static_cast<uint32_t>(kEscapeLength)) {
+                // Unary quotient, the stop bit and the remainder in one go
+                writer.Put((uint64_t{1} << k) | (value & ((1u << k) - 1)), static_cast<int>(quotient) + 1 + k);
+            } else {
+                writer.Put((uint64_t{1} << (bitsPerPixel + 1)) | value, kEscapeLength + 1 + bitsPerPixel + 1);
+            }
+            state.Update(value);
+        }, [&writer]() { return writer.Full(); });
+        return writer.Flush();
+    }
+
+    void DecodeTile(const unsigned char* data, size_t size, int width, int rows, int bitsPerPixel, uint16_t* samples) {
+        BitReader reader(data, size);
+        RiceState state;
+        const uint32_t maxValue = (1u << bitsPerPixel) - 1;
+        ForEachPlaneSample(width, rows, 1 << (bitsPerPixel - 1), samples, [&](uint16_t& sample, int prediction) {
+            const int k = state.Parameter();
+            const int quotient = reader.GetUnary();
+            uint32_t value;
+            if (quotient < kEscapeLength) {
+                value = (static_cast<uint32_t>(quotient) << k) | reader.Get(k);
+            } else {
+                value = reader.Get(bitsPerPixel + 1);
+            }
+            const int residual = (value & 1) ? -static_cast<int>((value + 1) >> 1) : static_cast<int>(value >> 1);
+            const int decoded = prediction + residual;
+            // Only corrupt data gets here, keep the samples in range anyway
+            sample = static_cast<uint16_t>(std::min<uint32_t>(static_cast<uint32_t>(std::max(decoded, 0)), maxValue));
+            state.Update(value);
+        }, []() { return false; });
+    }
+}
+
+SpinBayerCodec::SpinBayerCodec(const SpinBayerCodecOptions& options) : options(options) {
+    // One pool for the life of the codec, so coding a frame does not start threads
+    size_t threadCount = options.threadCount > 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+    if (!options.pool && threadCount > 1) {
+        ownPool.reset(new SpinThreadPool(threadCount));
+    }
+}
+
+void SpinBayerCodec::ForEachTile(size_t tileCount, const std::function<void(size_t)>& body) {
+    SpinThreadPool* pool = options.pool ? options.pool : ownPool.get();
+    if (pool && tileCount > 1) {
+        pool->ParallelFor(tileCount, body);
+        return;
+    }
+    for (size_t i = 0; i < tileCount; ++i) {
+        body(i);
+    }
+}
+
+int SpinBayerCodec::GetBitsPerPixel(Spinnaker::PixelFormatEnums pixelFormat) {
+    switch (pixelFormat) {
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8:
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono8:
+            return 8;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p:
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono10p:
+            return 10;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p:
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono12p:
+            return 12;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16:
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono16:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t SpinBayerCodec::GetMaxEncodedSize(size_t size, int height, int tileRows) {
+    const int rows = RoundTileRows(tileRows);
+    const size_t tileCount = static_cast<size_t>((std::max(height, 1) + rows - 1) / rows);
+    return sizeof(Header) + tileCount * sizeof(uint32_t) + size;
+}
+
+void SpinBayerCodec::Encode(const SpinImage& frame, std::vector<unsigned char>& output) {
+    Encode(frame.GetData(), frame.GetDataSize(), frame.GetWidth(), frame.GetHeight(), frame.GetPixelFormat(), output);
+}
+
+void SpinBayerCodec::Encode(const unsigned char* data, size_t size, int width, int height, Spinnaker::PixelFormatEnums pixelFormat,
+                            std::vector<unsigned char>& output) {
+    const int bitsPerPixel = GetBitsPerPixel(pixelFormat);
+    if (bitsPerPixel == 0) throw std::runtime_error("[ ERROR ] Pixel format not supported by the Bayer codec.");
+    if (!data || width <= 0 || height <= 0) throw std::runtime_error("[ ERROR ] Invalid frame for the Bayer codec.");
+    const uint64_t totalBits = static_cast<uint64_t>(width) * height * bitsPerPixel;
+    if (size < (totalBits + 7) / 8) throw std::runtime_error("[ ERROR ] Frame is smaller than its size and pixel format imply.");
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.bitsPerPixel = static_cast<uint16_t>(bitsPerPixel);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.tileRows = static_cast<uint32_t>(RoundTileRows(options.tileRows));
+    header.tileCount = (header.height + header.tileRows - 1) / header.tileRows;
+    header.dataSize = size;
+    header.tailSize = static_cast<uint32_t>(size - totalBits / 8);
+
+    std::vector<std::vector<unsigned char>> tiles(header.tileCount);
+    std::vector<uint32_t> tileSizes(header.tileCount);
+    ForEachTile(header.tileCount, [&](size_t i) {
+        const int firstRow = static_cast<int>(i * header.tileRows);
+        const int rows = std::min(static_cast<int>(header.tileRows), height - firstRow);
+        const size_t firstByte = static_cast<size_t>(static_cast<uint64_t>(firstRow) * width * bitsPerPixel / 8);
+        const size_t sampleCount = static_cast<size_t>(width) * rows;
+        // The bits of a trailing partial byte are kept in the tail
+        const size_t rawSize = static_cast<size_t>(static_cast<uint64_t>(sampleCount) * bitsPerPixel / 8);
+
+        std::vector<uint16_t> samples(sampleCount);
+        SpinUnpacker::Unpack16(data + firstByte, bitsPerPixel, 0, sampleCount, samples.data());
+        tiles[i].resize(rawSize);
+        const size_t codedSize = EncodeTile(samples.data(), width, rows, bitsPerPixel, tiles[i].data(), rawSize);
+        if (codedSize >= rawSize) {
+            // Noise does not compress, storing it costs nothing extra
+            tiles[i].assign(data + firstByte, data + firstByte + rawSize);
+            tileSizes[i] = static_cast<uint32_t>(rawSize) | kStoredTile;
+        } else {
+            tiles[i].resize(codedSize);
+            tileSizes[i] = static_cast<uint32_t>(codedSize);
+        }
+    });
+
+    size_t encodedSize = sizeof(Header) + tileSizes.size() * sizeof(uint32_t) + header.tailSize;
+    for (const std::vector<unsigned char>& tile : tiles) {
+        encodedSize += tile.size();
+    }
+    output.resize(encodedSize);
+    unsigned char* out = output.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, tileSizes.data(), tileSizes.size() * sizeof(uint32_t));
+    out += tileSizes.size() * sizeof(uint32_t);
+    std::memcpy(out, data + size - header.tailSize, header.tailSize);
+    out += header.tailSize;
+    for (const std::vector<unsigned char>& tile : tiles) {
+        std::memcpy(out, tile.data(), tile.size());
+        out += tile.size();
+    }
+}
+
+size_t SpinBayerCodec::GetDecodedSize(const unsigned char* data, size_t size) {
+    Header header;
+    if (!data || size < sizeof(header)) throw std::runtime_error("[ ERROR ] Bayer codec data is truncated.");
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion) throw std::runtime_error("[ ERROR ] Not Bayer codec data.");
+    return static_cast<size_t>(header.dataSize);
+}
+
+void SpinBayerCodec::Decode(const unsigned char* data, size_t size, unsigned char* output, size_t outputSize) {
+    const size_t dataSize = GetDecodedSize(data, size);
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (outputSize < dataSize) throw std::runtime_error("[ ERROR ] Output buffer is too small for the decoded frame.");
+    const int width = static_cast<int>(header.width);
+    const int height = static_cast<int>(header.height);
+    const int bitsPerPixel = header.bitsPerPixel;
+    if (header.tileRows == 0 || header.tileCount != (header.height + header.tileRows - 1) / header.tileRows ||
+        static_cast<uint64_t>(width) * height * bitsPerPixel / 8 + header.tailSize != dataSize ||
+        (bitsPerPixel != 8 && bitsPerPixel != 10 && bitsPerPixel != 12 && bitsPerPixel != 16)) {
+        throw std::runtime_error("[ ERROR ] Corrupt Bayer codec header.");
+    }
+
+    // Locate the tiles
+    const size_t tableSize = header.tileCount * sizeof(uint32_t);
+    if (size < sizeof(header) + tableSize + header.tailSize) throw std::runtime_error("[ ERROR ] Bayer codec data is truncated.");
+    std::vector<uint32_t> tileSizes(header.tileCount);
+    std::memcpy(tileSizes.data(), data + sizeof(header), tableSize);
+    const unsigned char* tail = data + sizeof(header) + tableSize;
+    std::vector<size_t> tileOffsets(header.tileCount);
+    size_t offset = sizeof(header) + tableSize + header.tailSize;
+    for (size_t i = 0; i < header.tileCount; ++i) {
+        tileOffsets[i] = offset;
+        offset += tileSizes[i] & ~kStoredTile;
+    }
+    if (offset > size) throw std::runtime_error("[ ERROR ] Bayer codec data is truncated.");
+
+    ForEachTile(header.tileCount, [&](size_t i) {
+        const int firstRow = static_cast<int>(i * header.tileRows);
+        const int rows = std::min(static_cast<int>(header.tileRows), height - firstRow);
+        unsigned char* out = output + static_cast<size_t>(static_cast<uint64_t>(firstRow) * width * bitsPerPixel / 8);
+        const unsigned char* tile = data + tileOffsets[i];
+        const size_t tileSize = tileSizes[i] & ~kStoredTile;
+
+        if (tileSizes[i] & kStoredTile) {
+            std::memcpy(out, tile, std::min(tileSize, static_cast<size_t>(output + dataSize - header.tailSize - out)));
+            return;
+        }
+        std::vector<uint16_t> samples(static_cast<size_t>(width) * rows);
+        DecodeTile(tile, tileSize, width, rows, bitsPerPixel, samples.data());
+        Pack(samples.data(), samples.size(), bitsPerPixel, out, output + dataSize);
+    });
+
+    // The tail holds the bits of the last partial byte as well as anything past the pixels
+    std::memcpy(output + dataSize - header.tailSize, tail, header.tailSize);
+}
@@ -0,0 +1,441 @@
+#include "../include/SpinnakerSDK_SpinBayerStats.h"
+#include "../include/SpinnakerSDK_SpinUnpack.h"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SPIN_BAYERSTATS_SSE2 1
+#endif
+
+namespace {
+    // Steps of the SIMD loop before its 32 bit sums of squares are moved into the 64 bit totals
+    const int kFlushSteps = 4096;
+
+    struct Accumulator {
+        uint64_t sum[3] = {};
+        uint64_t sumOfSquares[3] = {};
+        int min[3] = {255, 255, 255};
+        int max[3] = {0, 0, 0};
+        uint64_t count = 0;
+
+        void Add(int channel, int value) {
+            sum[channel] += value;
+            sumOfSquares[channel] += static_cast<uint64_t>(value * value);
+            min[channel] = std::min(min[channel], value);
+            max[channel] = std::max(max[channel], value);
+        }
+    };
+
+    // Where the colour of a pixel is read from
+    struct Sites {
+        explicit Sites(const SpinSampleLayout& layout)
+            : bayer(layout.kind == SpinSampleLayout::Kind::Bayer), channels(layout.kind == SpinSampleLayout::Kind::RGB ? 3 : 1),
+              redX(layout.pattern == SpinBayer::Pattern::GRBG || layout.pattern == SpinBayer::Pattern::BGGR ? 1 : 0),
+              redY(layout.pattern == SpinBayer::Pattern::GBRG || layout.pattern == SpinBayer::Pattern::BGGR ? 1 : 0) {}
+
+        bool bayer;
+        int channels;  // Samples per pixel
+        int redX;      // Red site of every 2x2 quad of Bayer samples
+        int redY;
+    };
+
+    // The rows of a pixel's quad: the one with its red site, and the one with its blue site
+    // Grey and RGB pixels have the same row for both.
+    struct QuadRows {
+        const unsigned char* red;
+        const unsigned char* blue;
+        bool odd;  // The pixel is on the blue row
+    };
+
+    // Colour of one pixel, as GetPixelRGB gives it
+    inline void PixelColor(const Sites& sites, const QuadRows& rows, int x, int width, int& red, int& green, int& blue) {
+        if (!sites.bayer) {
+            const unsigned char* pixel = rows.red + static_cast<size_t>(x) * sites.channels;
+            red = pixel[0];
+            green = pixel[sites.channels > 1 ? 1 : 0];
+            blue = pixel[sites.channels > 1 ? 2 : 0];
+            return;
+        }
+        const int left = x & ~1;
+        const int redColumn = std::min(left + sites.redX, width - 1);
+        const int blueColumn = std::min(left + (sites.redX ^ 1), width - 1);
+        const int greenOnRedRow = rows.red[blueColumn];
+        const int greenOnBlueRow = rows.blue[redColumn];
+        const bool greenSite = ((x ^ sites.redX) & 1) != static_cast<int>(rows.odd);
+        red = rows.red[redColumn];
+        green = greenSite ? (rows.odd ? greenOnBlueRow : greenOnRedRow) : (greenOnRedRow + greenOnBlueRow) >> 1;
+        blue = rows.blue[blueColumn];
+    }
+
+    // 8 bit rows of a frame, straight from it or unpacked into one buffer per row parity (a quad's two rows)
+    class RowReader {
+    public:
+        RowReader(const unsigned char* data, size_t stride, int rowSamples, int height, int bitsPerPixel, const unsigned char* toneMap)
+            : data(data), stride(stride == 0 ? static_cast<size_t>(rowSamples) * (bitsPerPixel == 16 ? 2 : 1) : stride),
+              rowSamples(rowSamples), height(height), bitsPerPixel(bitsPerPixel), toneMap(toneMap), direct(bitsPerPixel == 8 && !toneMap),
+              stream(stride == 0 && bitsPerPixel != 8 && bitsPerPixel != 16) {
+            if (!SpinUnpacker::IsSupported(bitsPerPixel)) throw std::runtime_error("[ ERROR ] Unsupported bits per pixel for statistics.");
+            if (!direct) {
+                for (Slot& slot : slots) {
+                    slot.samples.resize(static_cast<size_t>(rowSamples));
+                }
+            }
+        }
+
+        const unsigned char* Row(int y) {
+            if (direct) {
+                return data + static_cast<size_t>(y) * stride;
+            }
+            Slot& slot = slots[y & 1];
+            if (slot.row != y) {
+                // Rows of whole bytes per sample and padded packed rows keep their stride, other packed ones are one stream
+                if (!stream) {
+                    SpinUnpacker::Unpack8(data + static_cast<size_t>(y) * stride, bitsPerPixel, 0, static_cast<size_t>(rowSamples), slot.samples.data(), toneMap);
+                } else {
+                    SpinUnpacker::Unpack8(data, bitsPerPixel, static_cast<size_t>(y) * rowSamples, static_cast<size_t>(rowSamples), slot.samples.data(), toneMap);
+                }
+                slot.row = y;
+            }
+            return slot.samples.data();
+        }
+
+        QuadRows GetQuadRows(const Sites& sites, int y) {
+            QuadRows rows;
+            if (!sites.bayer) {
+                rows.red = rows.blue = Row(y);
+                rows.odd = false;
+                return rows;
+            }
+            const int top = y & ~1;
+            rows.red = Row(std::min(top + sites.redY, height - 1));
+            rows.blue = Row(std::min(top + (sites.redY ^ 1), height - 1));
+            rows.odd = ((y ^ sites.redY) & 1) != 0;
+            return rows;
+        }
+
+    private:
+        struct Slot {
+            int row = -1;
+            std::vector<unsigned char> samples;
+        };
+
+        const unsigned char* data;
+        size_t stride;
+        int rowSamples;
+        int height;
+        int bitsPerPixel;
+        const unsigned char* toneMap;
+        bool direct;
+        bool stream;
+        Slot slots[2];
+    };
+
+    // One pixel, the reference the SIMD path has to match
+    inline void AddPixel(Accumulator& accumulator, const Sites& sites, const QuadRows& rows, int x, int width) {
+        int red, green, blue;
+        PixelColor(sites, rows, x, width, red, green, blue);
+        accumulator.Add(0, red);
+        accumulator.Add(1, green);
+        accumulator.Add(2, blue);
+        accumulator.count++;
+    }
+
+#ifdef SPIN_BAYERSTATS_SSE2
+    // Whole quads from an even x up to end, 8 at a time, returns the first column not done
+    // The samples are split into 16 bit lanes by their column parity, so every lane holds one quad's R, its two greens or
+    // its B. Red and blue count twice, both pixels of the quad on this row have them. redX picks the lanes red is in.
+    int RowSSE2(Accumulator& accumulator, const QuadRows& rows, int redX, int x, int end) {
+        if (x + 16 > end) {
+            return x;
+        }
+        const __m128i lowBytes = _mm_set1_epi16(0x00ff);
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i sums[3];
+        __m128i squares[3];
+        __m128i minimum[3];
+        __m128i maximum[3];
+        for (int channel = 0; channel < 3; ++channel) {
+            sums[channel] = _mm_setzero_si128();
+            squares[channel] = _mm_setzero_si128();
+            minimum[channel] = _mm_set1_epi16(255);
+            maximum[channel] = _mm_setzero_si128();
+        }
+
+        auto flush = [&]() {
+            const int weights[3] = {2, 1, 2};
+            for (int channel = 0; channel < 3; ++channel) {
+                alignas(16) uint32_t sumLanes[4];
+                alignas(16) uint32_t squareLanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(sumLanes), sums[channel]);
+                _mm_store_si128(reinterpret_cast<__m128i*>(squareLanes), squares[channel]);
+                for (int lane = 0; lane < 4; ++lane) {
+                    accumulator.sum[channel] += static_cast<uint64_t>(sumLanes[lane]) * weights[channel];
+                    accumulator.sumOfSquares[channel] += static_cast<uint64_t>(squareLanes[lane]) * weights[channel];
+                }
+                sums[channel] = _mm_setzero_si128();
+                squares[channel] = _mm_setzero_si128();
+            }
+        };
+
+        int steps = 0;
+        for (; x + 16 <= end; x += 16) {
+            const __m128i redRow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.red + x));
+            const __m128i blueRow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.blue + x));
+            const __m128i redRowEven = _mm_and_si128(redRow, lowBytes);
+            const __m128i redRowOdd = _mm_srli_epi16(redRow, 8);
+            const __m128i blueRowEven = _mm_and_si128(blueRow, lowBytes);
+            const __m128i blueRowOdd = _mm_srli_epi16(blueRow, 8);
+            const __m128i red = redX ? redRowOdd : redRowEven;
+            const __m128i greenOnRedRow = redX ? redRowEven : redRowOdd;
+            const __m128i greenOnBlueRow = redX ? blueRowOdd : blueRowEven;
+            const __m128i blue = redX ? blueRowEven : blueRowOdd;
+            const __m128i ownGreen = rows.odd ? greenOnBlueRow : greenOnRedRow;
+            const __m128i averageGreen = _mm_srli_epi16(_mm_add_epi16(greenOnRedRow, greenOnBlueRow), 1);
+
+            sums[0] = _mm_add_epi32(sums[0], _mm_madd_epi16(red, ones));
+            squares[0] = _mm_add_epi32(squares[0], _mm_madd_epi16(red, red));
+            sums[1] = _mm_add_epi32(sums[1], _mm_madd_epi16(_mm_add_epi16(ownGreen, averageGreen), ones));
+            squares[1] = _mm_add_epi32(squares[1], _mm_add_epi32(_mm_madd_epi16(ownGreen, ownGreen), _mm_madd_epi16(averageGreen, averageGreen)));
+            sums[2] = _mm_add_epi32(sums[2], _mm_madd_epi16(blue, ones));
+            squares[2] = _mm_add_epi32(squares[2], _mm_madd_epi16(blue, blue));
+
+            minimum[0] = _mm_min_epi16(minimum[0], red);
+            maximum[0] = _mm_max_epi16(maximum[0], red);
+            minimum[1] = _mm_min_epi16(minimum[1], _mm_min_epi16(ownGreen, averageGreen));
+            maximum[1] = _mm_max_epi16(maximum[1], _mm_max_epi16(ownGreen, averageGreen));
+            minimum[2] = _mm_min_epi16(minimum[2], blue);
+            maximum[2] = _mm_max_epi16(maximum[2], blue);
+
+            accumulator.count += 16;
+            if (++steps == kFlushSteps) {
+                flush();
+                steps = 0;
+            }
+        }
+        flush();
+
+        for (int channel = 0; channel < 3; ++channel) {
+            alignas(16) int16_t minimumLanes[8];
+            alignas(16) int16_t maximumLanes[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(minimumLanes), minimum[channel]);
+            _mm_store_si128(reinterpret_cast<__m128i*>(maximumLanes), maximum[channel]);
+            for (int lane = 0; lane < 8; ++lane) {
+                accumulator.min[channel] = std::min<int>(accumulator.min[channel], minimumLanes[lane]);
+                accumulator.max[channel] = std::max<int>(accumulator.max[channel], maximumLanes[lane]);
+            }
+        }
+        return x;
+    }
+#endif
+
+    // out[x] = above[x] + values[0] + ... + values[x], the running sum four lanes at a time
+    void PrefixRow(const uint32_t* values, const uint32_t* above, int width, uint32_t* out) {
+        int x = 0;
+        uint32_t running = 0;
+#ifdef SPIN_BAYERSTATS_SSE2
+        __m128i carry = _mm_setzero_si128();
+        for (; x + 4 <= width; x += 4) {
+            __m128i sum = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + x));
+            sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 4));
+            sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+            sum = _mm_add_epi32(sum, carry);
+            carry = _mm_shuffle_epi32(sum, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_add_epi32(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(above + x))));
+        }
+        running = static_cast<uint32_t>(_mm_cvtsi128_si32(carry));
+#endif
+        for (; x < width; ++x) {
+            running += values[x];
+            out[x] = above[x] + running;
+        }
+    }
+
+    // Columns x0 to x1 - 1 of one row: an odd first column alone, whole quads in vectors, what is left one by one
+    void AddRow(Accumulator& accumulator, const Sites& sites, const QuadRows& rows, int x0, int x1, int width) {
+        int x = x0;
+        if (sites.bayer) {
+            if ((x & 1) && x < x1) {
+                AddPixel(accumulator, sites, rows, x, width);
+                x++;
+            }
+#ifdef SPIN_BAYERSTATS_SSE2
+            x = RowSSE2(accumulator, rows, sites.redX, x, x + ((x1 - x) & ~1));
+#endif
+        }
+        for (; x < x1; ++x) {
+            AddPixel(accumulator, sites, rows, x, width);
+        }
+    }
+}
+
+void SpinBayerStats::Compute(const unsigned char* bayer, size_t bayerStride, int width, int height, const SpinRoi* rois, size_t count,
+                             SpinRoiStats* results, int bitsPerPixel, const unsigned char* toneMap, const SpinSampleLayout& layout) {
+    if (!bayer || width <= 0 || height <= 0) throw std::runtime_error("[ ERROR ] Invalid image for statistics.");
+    if (count > 0 && (!rois || !results)) throw std::runtime_error("[ ERROR ] No regions given for statistics.");
+    const Sites sites(layout);
+    RowReader reader(bayer, bayerStride, width * sites.channels, height, bitsPerPixel, toneMap);
+
+    // Clip the regions and order them by their first row, for the pass down the frame
+    std::vector<Accumulator> accumulators(count);
+    std::vector<size_t> order;
+    for (size_t i = 0; i < count; ++i) {
+        const SpinRoi& roi = rois[i];
+        SpinRoi clipped;
+        clipped.x = std::max(roi.x, 0);
+        clipped.y = std::max(roi.y, 0);
+        clipped.width = std::max(std::min(roi.x + roi.width, width) - clipped.x, 0);
+        clipped.height = std::max(std::min(roi.y + roi.height, height) - clipped.y, 0);
+        results[i] = SpinRoiStats();
+        results[i].roi = clipped;
+        if (clipped.width > 0 && clipped.height > 0) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [results](size_t a, size_t b) { return results[a].roi.y < results[b].roi.y; });
+
+    // Every row once, for each region crossing it, skipping rows no region covers
+    std::vector<size_t> active;
+    size_t next = 0;
+    int y = order.empty() ? height : results[order[0]].roi.y;
+    while (y < height && (next < order.size() || !active.empty())) {
+        while (next < order.size() && results[order[next]].roi.y <= y) {
+            active.push_back(order[next++]);
+        }
+        active.erase(std::remove_if(active.begin(), active.end(), [results, y](size_t i) {
+            return results[i].roi.y + results[i].roi.height <= y;
+        }), active.end());
+        if (active.empty()) {
+            if (next < order.size()) {
+                y = results[order[next]].roi.y;
+            }
+            continue;
+        }
+
+        const QuadRows rows = reader.GetQuadRows(sites, y);
+        for (size_t i : active) {
+            AddRow(accumulators[i], sites, rows, results[i].roi.x, results[i].roi.x + results[i].roi.width, width);
+        }
+        y++;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const Accumulator& accumulator = accumulators[i];
+        SpinRoiStats& result = results[i];
+        result.pixelCount = accumulator.count;
+        if (accumulator.count == 0) {
+            continue;
+        }
+        for (int channel = 0; channel < 3; ++channel) {
+            SpinChannelStats& stats = result.channels[channel];
+            stats.sum = accumulator.sum[channel];
+            stats.sumOfSquares = accumulator.sumOfSquares[channel];
+            stats.mean = static_cast<double>(stats.sum) / accumulator.count;
+            stats.variance = std::max(static_cast<double>(stats.sumOfSquares) / accumulator.count - stats.mean * stats.mean, 0.0);
+            stats.min = static_cast<unsigned char>(accumulator.min[channel]);
+            stats.max = static_cast<unsigned char>(accumulator.max[channel]);
+        }
+    }
+}
+
+std::vector<SpinRoiStats> SpinBayerStats::Compute(const unsigned char* bayer, size_t bayerStride, int width, int height,
+                                                  const std::vector<SpinRoi>& rois, int bitsPerPixel, const unsigned char* toneMap,
+                                                  const SpinSampleLayout& layout) {
+    std::vector<SpinRoiStats> results(rois.size());
+    Compute(bayer, bayerStride, width, height, rois.data(), rois.size(), results.data(), bitsPerPixel, toneMap, layout);
+    return results;
+}
+
+SpinBayerIntegralImage::SpinBayerIntegralImage(const unsigned char* bayer, size_t bayerStride, int width, int height, int bitsPerPixel,
+                                               const unsigned char* toneMap, const SpinSampleLayout& layout)
+    : width(width), height(height), tableStride(static_cast<size_t>(width) + 1) {
+    if (!bayer || width <= 0 || height <= 0) throw std::runtime_error("[ ERROR ] Invalid image for statistics.");
+    const Sites sites(layout);
+    RowReader reader(bayer, bayerStride, width * sites.channels, height, bitsPerPixel, toneMap);
+
+    std::vector<uint32_t> values[3];
+    for (int channel = 0; channel < 3; ++channel) {
+        tables[channel].assign(tableStride * (static_cast<size_t>(height) + 1), 0);
+        values[channel].resize(static_cast<size_t>(width));
+    }
+    for (int y = 0; y < height; ++y) {
+        const QuadRows rows = reader.GetQuadRows(sites, y);
+        // Whole Bayer quads without branches (the compiler vectorizes this), a last odd column and other layouts through
+        // PixelColor
+        const int pairedWidth = sites.bayer ? width & ~1 : 0;
+        const int redColumn = sites.redX;
+        const int blueColumn = sites.redX ^ 1;
+        // The green site of this row is in the blue column on the red row and in the red column on the blue row
+        const int greenColumn = rows.odd ? redColumn : blueColumn;
+        const unsigned char* ownGreen = (rows.odd ? rows.blue : rows.red) + greenColumn;
+        for (int x = 0; x < pairedWidth; x += 2) {
+            const uint32_t red = rows.red[x + redColumn];
+            const uint32_t blue = rows.blue[x + blueColumn];
+            const uint32_t averageGreen = (static_cast<uint32_t>(rows.red[x + blueColumn]) + rows.blue[x + redColumn]) >> 1;
+            values[0][x] = values[0][x + 1] = red;
+            values[1][x + greenColumn] = ownGreen[x];
+            values[1][x + (greenColumn ^ 1)] = averageGreen;
+            values[2][x] = values[2][x + 1] = blue;
+        }
+        for (int x = pairedWidth; x < width; ++x) {
+            int red, green, blue;
+            PixelColor(sites, rows, x, width, red, green, blue);
+            values[0][x] = static_cast<uint32_t>(red);
+            values[1][x] = static_cast<uint32_t>(green);
+            values[2][x] = static_cast<uint32_t>(blue);
+        }
+        for (int channel = 0; channel < 3; ++channel) {
+            uint32_t* table = tables[channel].data();
+            PrefixRow(values[channel].data(), table + static_cast<size_t>(y) * tableStride + 1, width, table + static_cast<size_t>(y + 1) * tableStride + 1);
+        }
+    }
+}
+
+void SpinBayerIntegralImage::GetSums(const SpinRoi& roi, uint64_t sums[3], uint64_t& pixelCount) const {
+    const int x0 = std::max(roi.x, 0);
+    const int y0 = std::max(roi.y, 0);
+    const int x1 = std::max(std::min(roi.x + roi.width, width), x0);
+    const int y1 = std::max(std::min(roi.y + roi.height, height), y0);
+    sums[0] = sums[1] = sums[2] = 0;
+    pixelCount = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+    if (pixelCount == 0) {
+        return;
+    }
+
+    // A 32 bit difference is exact while the true sum stays below 2^32, so at most this many rows at a time
+    const int stripRows = static_cast<int>(std::max<uint64_t>(0xffffffffull / 255 / static_cast<uint64_t>(x1 - x0), 1));
+    for (int top = y0; top < y1; top += stripRows) {
+        const int bottom = std::min(top + stripRows, y1);
+        for (int channel = 0; channel < 3; ++channel) {
+            const uint32_t* table = tables[channel].data();
+            const uint32_t* above = table + static_cast<size_t>(top) * tableStride;
+            const uint32_t* below = table + static_cast<size_t>(bottom) * tableStride;
+            sums[channel] += static_cast<uint32_t>(below[x1] - below[x0] - above[x1] + above[x0]);
+        }
+    }
+}
+
+void SpinBayerIntegralImage::GetAverage(const SpinRoi& roi, unsigned char& R, unsigned char& G, unsigned char& B) const {
+    uint64_t sums[3];
+    uint64_t pixelCount = 0;
+    GetSums(roi, sums, pixelCount);
+    if (pixelCount == 0) {
+        R = G = B = 0;
+        return;
+    }
+    R = static_cast<unsigned char>(sums[0] / pixelCount);
+    G = static_cast<unsigned char>(sums[1] / pixelCount);
+    B = static_cast<unsigned char>(sums[2] / pixelCount);
+}
+
+int SpinBayerIntegralImage::GetWidth() const {
+    return width;
+}
+
+int SpinBayerIntegralImage::GetHeight() const {
+    return height;
+}
+
+size_t SpinBayerIntegralImage::GetMemorySize() const {
+    return (tables[0].size() + tables[1].size() + tables[2].size()) * sizeof(uint32_t);
+}
@@ -0,0 +1,108 @@
+#include "../include/SpinnakerSDK_SpinBufferPolicy.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    // One buffer being filled by the camera and one being handed to the consumer
+    const int64_t kHeadroomBuffers = 2;
+    // Used when the frame rate cannot be read, matches the count the driver picks by itself
+    const int64_t kUnknownRateBuffers = 10;
+
+    std::string FormatMiB(size_t bytes) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MiB";
+        return text.str();
+    }
+}
+
+SpinBufferPolicy::SpinBufferPolicy(double stallToleranceMs, size_t memoryBudgetBytes) {
+    SetStallTolerance(stallToleranceMs);
+    SetMemoryBudget(memoryBudgetBytes);
+}
+
+void SpinBufferPolicy::SetStallTolerance(double stallToleranceMs) {
+    if (!(stallToleranceMs >= 0.0)) throw std::runtime_error("[ ERROR ] Stall tolerance must not be negative.");
+    this->stallToleranceMs = stallToleranceMs;
+}
+
+void SpinBufferPolicy::SetMemoryBudget(size_t memoryBudgetBytes) {
+    if (memoryBudgetBytes == 0) throw std::runtime_error("[ ERROR ] Memory budget must not be zero.");
+    this->memoryBudgetBytes = memoryBudgetBytes;
+}
+
+double SpinBufferPolicy::GetStallTolerance() const {
+    return stallToleranceMs;
+}
+
+size_t SpinBufferPolicy::GetMemoryBudget() const {
+    return memoryBudgetBytes;
+}
+
+SpinBufferDecision SpinBufferPolicy::Decide(int64_t payloadSize, double frameRate, size_t heldFrames, int64_t minCount, int64_t maxCount) const {
+    SpinBufferDecision decision;
+    decision.payloadSize = std::max<int64_t>(payloadSize, 0);
+    decision.frameRate = frameRate > 0.0 ? frameRate : 0.0;
+    decision.heldBuffers = static_cast<int64_t>(heldFrames);
+
+    std::ostringstream rationale;
+
+    // Frames that arrive while the consumer is stalled need a buffer each
+    int64_t wanted = 0;
+    if (decision.frameRate > 0.0) {
+        decision.stallBuffers = static_cast<int64_t>(std::ceil(decision.frameRate * stallToleranceMs / 1000.0));
+        wanted = decision.stallBuffers + kHeadroomBuffers + decision.heldBuffers;
+        rationale << decision.stallBuffers << " for a " << stallToleranceMs << " ms stall at " << std::fixed << std::setprecision(1)
+                  << decision.frameRate << std::defaultfloat << " fps + " << kHeadroomBuffers << " headroom";
+    } else {
+        decision.stallBuffers = kUnknownRateBuffers;
+        wanted = kUnknownRateBuffers + decision.heldBuffers;
+        rationale << kUnknownRateBuffers << " (frame rate unknown)";
+    }
+    if (decision.heldBuffers > 0) {
+        rationale << " + " << decision.heldBuffers << " held by the caller";
+    }
+
+    // Stay within the memory budget, but never below what the held frames and the headroom need to keep streaming
+    int64_t count = wanted;
+    if (decision.payloadSize > 0) {
+        const int64_t affordable = static_cast<int64_t>(memoryBudgetBytes / static_cast<size_t>(decision.payloadSize));
+        if (affordable < wanted) {
+            count = std::max(affordable, decision.heldBuffers + kHeadroomBuffers);
+            decision.limitedByMemory = true;
+            rationale << ", capped by the " << FormatMiB(memoryBudgetBytes) << " memory budget";
+            if (count > affordable) {
+                rationale << " (exceeded to cover the held frames)";
+            }
+        }
+    } else {
+        rationale << ", payload size unknown so the memory budget is not applied";
+    }
+
+    // The camera's own limits come last
+    const int64_t unclamped = count;
+    count = std::min(std::max(count, std::max<int64_t>(minCount, 1)), std::max<int64_t>(maxCount, 1));
+    if (count != unclamped) {
+        rationale << ", clamped to the camera limit of " << count;
+    }
+    decision.bufferCount = count;
+    decision.memoryBytes = static_cast<size_t>(count) * static_cast<size_t>(decision.payloadSize);
+
+    // Stall the chosen count actually absorbs
+    const int64_t spare = std::max<int64_t>(count - kHeadroomBuffers - decision.heldBuffers, 0);
+    decision.stallToleranceMs = decision.frameRate > 0.0 ? spare * 1000.0 / decision.frameRate : 0.0;
+
+    std::ostringstream summary;
+    summary << count << " buffers";
+    if (decision.payloadSize > 0) {
+        summary << " x " << decision.payloadSize << " bytes (" << FormatMiB(decision.memoryBytes) << ")";
+    }
+    summary << ": " << rationale.str();
+    if (decision.frameRate > 0.0 && (decision.limitedByMemory || count != unclamped)) {
+        summary << ", absorbs " << std::fixed << std::setprecision(0) << decision.stallToleranceMs << " ms";
+    }
+    decision.rationale = summary.str();
+    return decision;
+}
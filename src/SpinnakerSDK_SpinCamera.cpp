@@ -1,48 +1,101 @@
 #include "../include/SpinnakerSDK_SpinCamera.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include "../include/SpinnakerSDK_SpinHardwareBackend.h"
 
-using namespace Spinnaker;
-using namespace GenApi;
+// Apply the ownership mode to a frame leased from the backend
+// Copied frames are detached here, which hands the backend buffer straight back
+static SpinImage TakeImage(const SpinImage& leasedImage, SpinOption::ImageOwnership ownership, const std::shared_ptr<SpinFramePool>& pool) {
+    if (ownership == SpinOption::ImageOwnership::Copy) {
+        return leasedImage.Detach(pool);
+    }
+    return leasedImage;
+}
+
+// Receives frames from the backend's image thread and forwards them to a user callback or queue
+class SpinCamera::StreamEventHandler {
+public:
+    StreamEventHandler(std::function<void(SpinImage&)> handler, SpinOption::ImageOwnership ownership, std::shared_ptr<SpinFramePool> pool)
+        : handler(handler), queue(nullptr), ownership(ownership), pool(pool) {}
+    StreamEventHandler(SpinQueue<SpinImage>& queue, SpinOption::ImageOwnership ownership, std::shared_ptr<SpinFramePool> pool)
+        : queue(&queue), ownership(ownership), pool(pool) {}
+
+    void OnImageEvent(SpinImage& image) {
+        if (image.IsIncomplete()) {
+            SPIN_LOG_ERROR("Image incomplete with image status ", image.GetImageStatus());
+            return;
+        }
+
+        SpinImage frame = TakeImage(image, ownership, pool);
+
+        if (queue) {
+            if (!queue->TryPush(std::move(frame))) {
+                droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            handler(frame);
+        }
+    }
+
+    uint64_t GetDroppedFrames() const {
+        return droppedFrames.load(std::memory_order_relaxed);
+    }
 
-SpinCamera::SpinCamera() : pCam(nullptr), system(nullptr), nodeMap(nullptr) {}
+private:
+    std::function<void(SpinImage&)> handler;
+    SpinQueue<SpinImage>* queue;
+    SpinOption::ImageOwnership ownership;
+    std::shared_ptr<SpinFramePool> pool;
+    std::atomic<uint64_t> droppedFrames{0};
+};
+
+SpinCamera::SpinCamera() : backend(nullptr) {}
 
 SpinCamera::~SpinCamera() {
-    Shutdown();
+    try {
+        Shutdown();
+    } catch (const std::exception& e) {
+        SPIN_LOG_ERROR("Failed to shut down the camera: ", e.what());
+    }
 }
 
 void SpinCamera::Initialize(int camera_index) {
-    // Get the instance of the camera
-    system = System::GetInstance();
-    camList = system->GetCameras();
-    if (camList.GetSize() == 0) {
-        throw std::runtime_error("[ ERROR ] No cameras found.");
-    }
-    pCam = camList.GetByIndex(camera_index);
+    Initialize(std::unique_ptr<SpinCameraBackend>(new SpinHardwareBackend(camera_index)));
+}
 
-    // Initialize the camera
-    pCam->Init();
+// Open the camera with the given serial number, independent of the order the cameras were enumerated in
+void SpinCamera::Initialize(const std::string& serial_number) {
+    Initialize(std::unique_ptr<SpinCameraBackend>(new SpinHardwareBackend(serial_number)));
+}
 
-    // Retrieve and set node map
-    nodeMap = &pCam->GetNodeMap();
-    if (nodeMap == nullptr) {
-        throw std::runtime_error("[ ERROR ] Failed to get node map.");
-    }
+// Use any camera backend, e.g. a SpinSimulatedBackend to run without hardware
+void SpinCamera::Initialize(std::unique_ptr<SpinCameraBackend>&& camera_backend) {
+    if (!camera_backend) throw std::runtime_error("[ ERROR ] No camera backend given.");
+    Shutdown();
+    camera_backend->Init();
+    backend = std::move(camera_backend);
 
-    // Retrieve and set the TLStreamNodeMap
-    streamNodeMap = &pCam->GetTLStreamNodeMap();
-    if (streamNodeMap == nullptr) {
-        throw std::runtime_error("[ ERROR ] Failed to get stream node map.");
+    // Label the telemetry with the serial number, cameras keep it across re-initialization otherwise
+    std::string serialNumber = backend->GetSerialNumber();
+    if (!serialNumber.empty()) {
+        telemetry->SetCameraName(serialNumber);
     }
 }
 
+SpinCameraBackend* SpinCamera::GetBackend() const {
+    return backend.get();
+}
+
 void SpinCamera::StartAcquisition() {
-    if (!pCam) throw std::runtime_error("[ ERROR ] Unable to start camera Acquisition");
-    pCam->BeginAcquisition();
+    if (!backend) throw std::runtime_error("[ ERROR ] Unable to start camera Acquisition");
+    telemetry->BeginAcquisition();
+    backend->BeginAcquisition();
     acquisitionActive = true;
 }
 
 void SpinCamera::StopAcquisition() {
-    if (!pCam) throw std::runtime_error("[ ERROR ] Unable to end camera Acquisition");
-    pCam->EndAcquisition();
+    if (!backend) throw std::runtime_error("[ ERROR ] Unable to end camera Acquisition");
+    UpdateLostFrames();
+    backend->EndAcquisition();
     acquisitionActive = false;
 }
 
@@ -59,12 +112,12 @@ void SpinCamera::CaptureSingleFrame(SpinImage& capturedImage) {
     }
 
     // Capture image from the camera
-    if (pCam) {
-        Spinnaker::ImagePtr rawImage = pCam->GetNextImage();
-        if (rawImage->IsIncomplete()) {
-            std::cerr << "[ ERROR ] Image incomplete with image status " << rawImage->GetImageStatus() << std::endl;
+    if (backend) {
+        SpinImage rawImage = NextImage();
+        if (rawImage.IsIncomplete()) {
+            SPIN_LOG_ERROR("Image incomplete with image status ", rawImage.GetImageStatus());
         } else {
-            capturedImage = SpinImage(rawImage);
+            capturedImage = TakeImage(rawImage, imageOwnership, framePool);
         }
     }
 
@@ -100,25 +153,23 @@ void SpinCamera::CaptureSingleFrameOnTrigger(SpinImage& capturedImage, std::atom
     // auto triggerTime = std::chrono::high_resolution_clock::now();
 
     // Capture and release the image that was being acquired DURING the trigger
-    Spinnaker::ImagePtr preTriggerImage;
-    if (pCam) {
-        preTriggerImage = pCam->GetNextImage();
-        if (preTriggerImage->IsIncomplete()) {
-            std::cerr << "[ ERROR ] Pre-trigger image incomplete with image status " << preTriggerImage->GetImageStatus() << std::endl;
+    SpinImage preTriggerImage(nullptr);
+    if (backend) {
+        preTriggerImage = NextImage();
+        if (preTriggerImage.IsIncomplete()) {
+            SPIN_LOG_ERROR("Pre-trigger image incomplete with image status ", preTriggerImage.GetImageStatus());
         }
-        // Release the image
-        preTriggerImage->Release();
     }
 
     // Capture the image immediately after the trigger
     // This is the first "Legal" image in a situation where the trigger effectively begins aquisition (starts exposure)
-    Spinnaker::ImagePtr postTriggerImage;
-    if (pCam) {
-        postTriggerImage = pCam->GetNextImage();
-        if (postTriggerImage->IsIncomplete()) {
-            std::cerr << "[ ERROR ] Post-trigger image incomplete with image status " << postTriggerImage->GetImageStatus() << std::endl;
+    SpinImage postTriggerImage(nullptr);
+    if (backend) {
+        postTriggerImage = NextImage();
+        if (postTriggerImage.IsIncomplete()) {
+            SPIN_LOG_ERROR("Post-trigger image incomplete with image status ", postTriggerImage.GetImageStatus());
         } else {
-            capturedImage = SpinImage(postTriggerImage);
+            capturedImage = TakeImage(postTriggerImage, imageOwnership, framePool);
         }
     }
 
@@ -128,7 +179,7 @@ void SpinCamera::CaptureSingleFrameOnTrigger(SpinImage& capturedImage, std::atom
     // Calculate and print the duration between the trigger and the image capture
     // double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(captureTime - triggerTime).count();
     // std::cout << "Duration from trigger to image capture: " << duration/1000000 << " ms" << std::endl;
-    // double duration2 = postTriggerImage->GetTimeStamp() - preTriggerImage->GetTimeStamp();
+    // double duration2 = postTriggerImage.GetTimeStamp() - preTriggerImage.GetTimeStamp();
     // std::cout << "Duration between image timestamps: " << duration2/1000000 << " ms" << std::endl;
 
     // Stop acquisition if it was started by this function
@@ -137,32 +188,163 @@ void SpinCamera::CaptureSingleFrameOnTrigger(SpinImage& capturedImage, std::atom
     }
 }
 
-void SpinCamera::CaptureContinuousFrames(std::vector<SpinImage>& frames, int numFrames) {
-    // Ensure frames vector is empty
-    frames.clear();
+// Same as above, but the capture thread sleeps on the trigger instead of polling it, and wakes the moment it fires.
+// The trigger time is mapped onto the camera clock, so the returned frame is the first one exposed after the trigger.
+bool SpinCamera::CaptureSingleFrameOnTrigger(SpinImage& capturedImage, SpinTrigger& trigger, std::chrono::milliseconds timeout) {
+    // With pre-roll the frame is picked from those already buffered, no need to wait for the next exposure
+    if (preRollBuffer) {
+        std::vector<SpinImage> window;
+        if (!CaptureFrameWindowOnTrigger(window, trigger, 0, 0, timeout)) {
+            return false;
+        }
+        capturedImage = window.front();
+        return true;
+    }
 
-    // Set the buffer count mode to manual
-    CEnumerationPtr ptrStreamBufferCountMode = streamNodeMap->GetNode("StreamBufferCountMode");
-    if (IsWritable(ptrStreamBufferCountMode)) {
-        CEnumEntryPtr ptrStreamBufferCountModeManual = ptrStreamBufferCountMode->GetEntryByName("Manual");
-        if (IsReadable(ptrStreamBufferCountModeManual)) {
-            ptrStreamBufferCountMode->SetIntValue(ptrStreamBufferCountModeManual->GetValue());
-            std::cout << "Stream Buffer Count Mode set to manual" << std::endl;
-        } else {
-            std::cout << "[ WARNING ] Unable to read buffer count mode manual entry." << std::endl;
+    // Start acquisition if not already active
+    bool startedAcquisition = false;
+    if (!acquisitionActive) {
+        // Set acquisition mode to continuous
+        SetAcquisitionMode(SpinOption::AcquisitionMode::Continuous);
+        // Set buffer handling mode to NewestOnly
+        SetBufferHandlingMode(SpinOption::BufferHandlingMode::NewestOnly);
+        StartAcquisition();
+        startedAcquisition = true;
+    }
+
+    // Line up the host and camera clocks now, while nothing is waiting on us
+    bool clockAvailable = SynchronizeClock();
+
+    // Wait for the trigger to fire, then give the frames after it as long again
+    bool captured = false;
+    const bool fired = trigger.WaitFor(timeout);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    // Next frame within what is left of the timeout, false once it has run out (or acquisition stopped)
+    auto nextImage = [this, deadline](SpinImage& image) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
         }
-    } else {
-        std::cout << "[ WARNING ] Unable to set buffer count mode to manual." << std::endl;
+        try {
+            image = NextImage(static_cast<uint64_t>(remaining.count()));
+            return true;
+        } catch (const std::exception& e) {
+            SPIN_LOG_DEBUG("Stopped waiting for a frame after the trigger: ", e.what());
+            return false;
+        }
+    };
+
+    if (!fired) {
+        SPIN_LOG_WARNING("Trigger did not fire within ", timeout.count(), " ms.");
+    } else if (backend && clockAvailable) {
+        // Skip every frame whose exposure started before the trigger
+        const uint64_t triggerDeviceTime = HostToDeviceTime(trigger.GetTriggerTime());
+        SpinImage rawImage(nullptr);
+        while (!captured && nextImage(rawImage)) {
+            if (rawImage.IsIncomplete()) {
+                SPIN_LOG_ERROR("Image incomplete with image status ", rawImage.GetImageStatus());
+            } else if (rawImage.GetTimeStamp() >= triggerDeviceTime) {
+                capturedImage = TakeImage(rawImage, imageOwnership, framePool);
+                captured = true;
+            }
+            // Frames exposed before the trigger are dropped, which hands their buffers back
+        }
+    } else if (backend) {
+        // Without a camera clock, release the image that was being acquired DURING the trigger
+        SpinImage preTriggerImage(nullptr);
+        if (nextImage(preTriggerImage) && preTriggerImage.IsIncomplete()) {
+            SPIN_LOG_ERROR("Pre-trigger image incomplete with image status ", preTriggerImage.GetImageStatus());
+        }
+
+        // and keep the image immediately after it
+        SpinImage postTriggerImage(nullptr);
+        if (nextImage(postTriggerImage)) {
+            if (postTriggerImage.IsIncomplete()) {
+                SPIN_LOG_ERROR("Post-trigger image incomplete with image status ", postTriggerImage.GetImageStatus());
+            } else {
+                capturedImage = TakeImage(postTriggerImage, imageOwnership, framePool);
+                captured = true;
+            }
+        }
+    }
+    if (fired && backend && !captured) {
+        SPIN_LOG_WARNING("No complete frame arrived within ", timeout.count(), " ms of the trigger.");
     }
 
-    // Set the buffer count to a reasonable value
-    int64_t bufferCount = 100;
-    CIntegerPtr ptrBufferCount = streamNodeMap->GetNode("StreamBufferCountManual");
-    if (IsWritable(ptrBufferCount)) {
-        ptrBufferCount->SetValue(bufferCount);
-        std::cout << "Buffer count set to: " << bufferCount << std::endl;
+    // Stop acquisition if it was started by this function
+    if (startedAcquisition) {
+        StopAcquisition();
+    }
+    return captured;
+}
+
+// Keep the last numFrames frames in a ring while acquisition runs
+// NOTE: This streams in the background, so StartStream cannot be used at the same time
+void SpinCamera::EnablePreRoll(size_t numFrames) {
+    if (streamHandler) throw std::runtime_error("[ ERROR ] Unable to enable pre-roll while a stream is running");
+
+    preRollBuffer.reset(new SpinPreRollBuffer(numFrames));
+    SpinPreRollBuffer* buffer = preRollBuffer.get();
+    StartStream([buffer](SpinImage& frame) {
+        buffer->Push(frame);
+    });
+    SPIN_LOG_INFO("Pre-roll enabled with ", numFrames, " frames");
+}
+
+void SpinCamera::DisablePreRoll() {
+    if (!preRollBuffer) {
+        return;
+    }
+    StopStream();
+    preRollBuffer.reset();
+}
+
+// Wait for the trigger, then return the buffered frame whose timestamp is closest to it,
+// along with up to framesBefore earlier and framesAfter later frames (oldest first)
+bool SpinCamera::CaptureFrameWindowOnTrigger(std::vector<SpinImage>& frames, SpinTrigger& trigger, size_t framesBefore, size_t framesAfter,
+                                             std::chrono::milliseconds timeout) {
+    if (!preRollBuffer) throw std::runtime_error("[ ERROR ] Pre-roll is not enabled");
+    frames.clear();
+
+    // Line up the host and camera clocks now, while nothing is waiting on us
+    bool clockAvailable = SynchronizeClock();
+
+    // Wait for the trigger to fire
+    if (!trigger.WaitFor(timeout)) {
+        SPIN_LOG_WARNING("Trigger did not fire within ", timeout.count(), " ms.");
+        return false;
+    }
+
+    // Without a camera clock, the newest frame at the time of the trigger is the best estimate
+    uint64_t triggerDeviceTime = 0;
+    if (clockAvailable) {
+        triggerDeviceTime = HostToDeviceTime(trigger.GetTriggerTime());
     } else {
-        std::cout << "[ WARNING ] Unable to set buffer count." << std::endl;
+        std::vector<SpinImage> newest = preRollBuffer->GetWindow(UINT64_MAX, 0, 0);
+        triggerDeviceTime = newest.empty() ? 0 : newest.front().GetTimeStamp();
+    }
+
+    // Wait until the closest frame is known and enough frames after it have arrived
+    std::chrono::milliseconds framesTimeout(1000 * (framesAfter + 1));
+    if (!preRollBuffer->WaitForFramesAfter(triggerDeviceTime, framesAfter, framesTimeout)) {
+        SPIN_LOG_WARNING("Timed out waiting for frames after the trigger, returning what is buffered.");
+    }
+    frames = preRollBuffer->GetWindow(triggerDeviceTime, framesBefore, framesAfter);
+    return !frames.empty();
+}
+
+void SpinCamera::CaptureContinuousFrames(std::vector<SpinImage>& frames, int numFrames) {
+    // Ensure frames vector is empty, and large enough to never reallocate mid-capture
+    frames.clear();
+    frames.reserve(numFrames);
+
+    // Size the stream buffers for the frame size and rate (plus one per leased frame)
+    const size_t heldFrames = imageOwnership == SpinOption::ImageOwnership::Lease ? static_cast<size_t>(std::max(numFrames, 0)) : 0;
+    int64_t bufferCount = ApplyBufferPolicy(heldFrames).bufferCount;
+
+    // Leased frames each keep a stream buffer until they are destroyed
+    if (imageOwnership == SpinOption::ImageOwnership::Lease && numFrames >= bufferCount) {
+        SPIN_LOG_WARNING("Leasing ", numFrames, " frames with only ", bufferCount, " stream buffers, capture will stall once the buffers run out.");
     }
 
     // Start acquisition if not already active
@@ -178,27 +360,33 @@ void SpinCamera::CaptureContinuousFrames(std::vector<SpinImage>& frames, int num
 
     // Capture the specified number of frames
     for (int i = 1; i <= numFrames; ++i) {
-        if (pCam) {
-            Spinnaker::ImagePtr rawImage = pCam->GetNextImage(1000);
-            if (rawImage->IsIncomplete()) {
-                std::cerr << "[ ERROR ] Image incomplete with image status " << rawImage->GetImageStatus() << std::endl;
+        if (backend) {
+            SpinImage rawImage = NextImage(1000);
+            if (rawImage.IsIncomplete()) {
+                SPIN_LOG_ERROR("Image incomplete with image status ", rawImage.GetImageStatus());
             } else {
-                frames.emplace_back(rawImage);
+                frames.push_back(TakeImage(rawImage, imageOwnership, framePool));
                 // frames[i].PrintAllImageInformation();
-                std::cout << "Image number " << i << " complete" << std::endl;
-                // Release image
-                rawImage->Release();
+                SPIN_LOG_DEBUG("Image number ", i, " complete");
             }
         }
     }
 
+    // Report how the frame pool coped with the capture
+    if (framePool) {
+        SpinFramePoolStats poolStats = framePool->GetStats();
+        if (poolStats.exhaustions > 0 || poolStats.oversizeRequests > 0) {
+            SPIN_LOG_WARNING("Frame pool could not serve ", poolStats.exhaustions + poolStats.oversizeRequests, " frames, they were heap allocated instead.");
+        }
+    }
+
     // Retrieve and print the number of lost frames
-    CIntegerPtr ptrLostFrameCount = streamNodeMap->GetNode("StreamLostFrameCount");
-    if (IsReadable(ptrLostFrameCount)) {
-        int64_t lostFrameCount = ptrLostFrameCount->GetValue();
-        std::cout << "Number of lost frames: " << lostFrameCount << std::endl;
+    if (backend && backend->IsReadable("StreamLostFrameCount")) {
+        int64_t lostFrameCount = backend->GetIntegerValue("StreamLostFrameCount");
+        telemetry->SetLostFrames(static_cast<uint64_t>(std::max<int64_t>(lostFrameCount, 0)));
+        SPIN_LOG_INFO("Number of lost frames: ", lostFrameCount);
     } else {
-        std::cout << "[ WARNING ] Unable to retrieve lost frame count." << std::endl;
+        SPIN_LOG_WARNING("Unable to retrieve lost frame count.");
     }
 
     // Stop acquisition if it was started by this function
@@ -207,21 +395,162 @@ void SpinCamera::CaptureContinuousFrames(std::vector<SpinImage>& frames, int num
     }
 }
 
+// Start delivering every frame to the handler as soon as it arrives
+// NOTE: The handler runs on the camera's event thread, keep it short or hand the frame off
+void SpinCamera::StartStream(std::function<void(SpinImage&)> handler) {
+    if (!backend) throw std::runtime_error("[ ERROR ] Unable to start stream, camera not initialized");
+    if (streamHandler) throw std::runtime_error("[ ERROR ] Stream already running");
+
+    streamHandler.reset(new StreamEventHandler(handler, imageOwnership, framePool));
+    BeginStream();
+}
+
+// Start pushing every frame into a bounded queue, frames are dropped (and counted) while the queue is full
+void SpinCamera::StartStream(SpinQueue<SpinImage>& queue) {
+    if (!backend) throw std::runtime_error("[ ERROR ] Unable to start stream, camera not initialized");
+    if (streamHandler) throw std::runtime_error("[ ERROR ] Stream already running");
+
+    streamHandler.reset(new StreamEventHandler(queue, imageOwnership, framePool));
+    BeginStream();
+}
+
+void SpinCamera::BeginStream() {
+    StreamEventHandler* handler = streamHandler.get();
+    SpinTelemetry* stats = telemetry.get();
+    backend->RegisterImageHandler([handler, stats](SpinImage& frame) {
+        stats->RecordFrame(frame);
+        handler->OnImageEvent(frame);
+    });
+    streamDroppedFrames = 0;
+
+    // Start acquisition if not already active
+    streamStartedAcquisition = false;
+    if (!acquisitionActive) {
+        // Set acquisition mode to continuous
+        SetAcquisitionMode(SpinOption::AcquisitionMode::Continuous);
+        // Deliver frames in the order they were captured, with enough buffers to ride out handler stalls
+        SetBufferHandlingMode(SpinOption::BufferHandlingMode::OldestFirst);
+        // A pre-roll of leased frames keeps that many buffers busy at all times
+        ApplyBufferPolicy(preRollBuffer && imageOwnership == SpinOption::ImageOwnership::Lease ? preRollBuffer->Capacity() : 0);
+        StartAcquisition();
+        streamStartedAcquisition = true;
+    }
+}
+
+void SpinCamera::StopStream() {
+    if (!streamHandler) {
+        return;
+    }
+
+    // Stop acquisition if it was started by the stream
+    if (streamStartedAcquisition && acquisitionActive) {
+        StopAcquisition();
+    }
+    streamStartedAcquisition = false;
+
+    if (backend) {
+        backend->UnregisterImageHandler();
+    }
+    if (streamHandler->GetDroppedFrames() > 0) {
+        SPIN_LOG_WARNING("Stream dropped ", streamHandler->GetDroppedFrames(), " frames because the queue was full.");
+    }
+    streamDroppedFrames = streamHandler->GetDroppedFrames();
+    streamHandler.reset();
+}
+
+std::shared_ptr<SpinTelemetry> SpinCamera::GetTelemetry() {
+    if (acquisitionActive) {
+        UpdateLostFrames();
+    }
+    return telemetry;
+}
+
+SpinImage SpinCamera::NextImage(uint64_t timeoutMs) {
+    SpinImage image = backend->GetNextImage(timeoutMs);
+    telemetry->RecordFrame(image);
+    return image;
+}
+
+// Copy the driver's lost frame counter of the running acquisition into the telemetry
+void SpinCamera::UpdateLostFrames() {
+    try {
+        if (backend && backend->IsReadable("StreamLostFrameCount")) {
+            telemetry->SetLostFrames(static_cast<uint64_t>(std::max<int64_t>(backend->GetIntegerValue("StreamLostFrameCount"), 0)));
+        }
+    } catch (const std::exception& e) {
+        SPIN_LOG_WARNING("Unable to retrieve lost frame count: ", e.what());
+    }
+}
+
+bool SpinCamera::IsStreaming() const {
+    return streamHandler != nullptr;
+}
+
+uint64_t SpinCamera::GetStreamDroppedFrames() const {
+    return streamHandler ? streamHandler->GetDroppedFrames() : streamDroppedFrames;
+}
+
 void SpinCamera::Shutdown() {
-    // Ensure not aquiring
+    ReleaseBackend();
+}
+
+std::unique_ptr<SpinCameraBackend> SpinCamera::ReleaseBackend() {
+    // Ensure not streaming or aquiring
+    DisablePreRoll();
+    StopStream();
     if (acquisitionActive) {
         StopAcquisition();
     }
     
-    if (pCam) {
-        pCam->DeInit();
-        pCam = nullptr;
+    if (backend) {
+        backend->DeInit();
+    }
+    return std::move(backend);
+}
+
+// Latch the camera clock and record its offset from the host steady clock
+// The latch is bracketed by two host timestamps, the midpoint is taken as the moment it happened.
+bool SpinCamera::SynchronizeClock() {
+    // Ensure nodemap exists
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
+        return false;
+    }
+
+    if (!backend->IsWritable("TimestampLatch") || !backend->IsReadable("TimestampLatchValue")) {
+        SPIN_LOG_WARNING("Unable to latch camera timestamp, trigger times cannot be mapped onto frame timestamps.");
+        return false;
+    }
+
+    try {
+        const uint64_t hostBefore = SpinTrigger::Now();
+        backend->ExecuteCommand("TimestampLatch");
+        const uint64_t hostAfter = SpinTrigger::Now();
+        const int64_t deviceTime = backend->GetIntegerValue("TimestampLatchValue");
+        deviceClockOffset = deviceTime - static_cast<int64_t>(hostBefore + (hostAfter - hostBefore) / 2);
+        clockSynchronized = true;
+        telemetry->SetClockOffset(deviceClockOffset);
+    } catch (const std::exception& e) {
+        SPIN_LOG_ERROR("Exception caught while latching camera timestamp: ", e.what());
+        return false;
+    }
+    return true;
+}
+
+// Convert a host steady clock time (e.g. SpinTrigger::GetTriggerTime) to the camera clock used by frame timestamps
+uint64_t SpinCamera::HostToDeviceTime(uint64_t host_time_ns) const {
+    if (!clockSynchronized) {
+        SPIN_LOG_WARNING("Camera clock not synchronized, call SynchronizeClock first.");
     }
-    camList.Clear();
-    if (system) {
-        system->ReleaseInstance();
-        system = nullptr;
+    return static_cast<uint64_t>(static_cast<int64_t>(host_time_ns) + deviceClockOffset);
+}
+
+// Camera clock minus host steady clock (ns), e.g. to put frames of several cameras on one clock
+int64_t SpinCamera::GetClockOffset() const {
+    if (!clockSynchronized) {
+        SPIN_LOG_WARNING("Camera clock not synchronized, call SynchronizeClock first.");
     }
+    return deviceClockOffset;
 }
 
 void SpinCamera::SetDefaultSettings() {
@@ -251,7 +580,8 @@ void SpinCamera::SetAutoSettings() {
 }
 
 void SpinCamera::PrintSettings() {
-    if (!nodeMap) {
+    SpinLogger::Instance().BeginReport();
+    if (!backend) {
         std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
         return;
     }
@@ -260,134 +590,108 @@ void SpinCamera::PrintSettings() {
 
     try {
         // Pixel Format
-        CEnumerationPtr ptrPixelFormat = nodeMap->GetNode("PixelFormat");
-        if (IsReadable(ptrPixelFormat)) {
-            CEnumEntryPtr ptrPixelFormatEntry = ptrPixelFormat->GetCurrentEntry();
-            std::string pixelFormat = std::string(ptrPixelFormatEntry->GetSymbolic().c_str());
+        if (backend->IsReadable("PixelFormat")) {
+            std::string pixelFormat = backend->GetEnumerationValue("PixelFormat");
             std::cout << "Pixel Format: " << pixelFormat << std::endl;
         } else {
             std::cout << "[ WARNING ] Pixel format not readable." << std::endl;
         }
 
         // Binning
-        CIntegerPtr ptrBinningHorizontal = nodeMap->GetNode("BinningHorizontal");
-        CIntegerPtr ptrBinningVertical = nodeMap->GetNode("BinningVertical");
-        if (IsReadable(ptrBinningHorizontal) && IsReadable(ptrBinningVertical)) {
-            int binningHorizontal = ptrBinningHorizontal->GetValue();
-            int binningVertical = ptrBinningVertical->GetValue();
+        if (backend->IsReadable("BinningHorizontal") && backend->IsReadable("BinningVertical")) {
+            int binningHorizontal = backend->GetIntegerValue("BinningHorizontal");
+            int binningVertical = backend->GetIntegerValue("BinningVertical");
             std::cout << "Binning (Horizontal x Vertical): " << binningHorizontal << " x " << binningVertical << std::endl;
         } else {
             std::cout << "[ WARNING ] Binning values not readable." << std::endl;
         }
 
         // Decimation
-        CIntegerPtr ptrDecimationHorizontal = nodeMap->GetNode("DecimationHorizontal");
-        CIntegerPtr ptrDecimationVertical = nodeMap->GetNode("DecimationVertical");
-        if (IsReadable(ptrDecimationHorizontal) && IsReadable(ptrDecimationVertical)) {
-            int decimationHorizontal = ptrDecimationHorizontal->GetValue();
-            int decimationVertical = ptrDecimationVertical->GetValue();
+        if (backend->IsReadable("DecimationHorizontal") && backend->IsReadable("DecimationVertical")) {
+            int decimationHorizontal = backend->GetIntegerValue("DecimationHorizontal");
+            int decimationVertical = backend->GetIntegerValue("DecimationVertical");
             std::cout << "Decimation (Horizontal x Vertical): " << decimationHorizontal << " x " << decimationVertical << std::endl;
         } else {
             std::cout << "[ WARNING ] Decimation values not readable." << std::endl;
         }
 
         // Exposure Time
-        CEnumerationPtr ptrExposureAuto = nodeMap->GetNode("ExposureAuto");
-        if (IsReadable(ptrExposureAuto)) {
-            CEnumEntryPtr ptrExposureAutoEntry = ptrExposureAuto->GetCurrentEntry();
-            std::string exposureAuto = std::string(ptrExposureAutoEntry->GetSymbolic().c_str());
+        if (backend->IsReadable("ExposureAuto")) {
+            std::string exposureAuto = backend->GetEnumerationValue("ExposureAuto");
             std::cout << "Exposure Auto: " << exposureAuto << std::endl;
         }
-        CFloatPtr ptrExposureTime = nodeMap->GetNode("ExposureTime");
-        if (IsReadable(ptrExposureTime)) {
-            double exposureTime = ptrExposureTime->GetValue();
+        if (backend->IsReadable("ExposureTime")) {
+            double exposureTime = backend->GetFloatValue("ExposureTime");
             std::cout << "Exposure Time: " << exposureTime << " microseconds" << std::endl;
         } else {
             std::cout << "[ WARNING ] Exposure time not readable." << std::endl;
         }
 
         // Image Dimensions
-        CIntegerPtr ptrWidth = nodeMap->GetNode("Width");
-        CIntegerPtr ptrHeight = nodeMap->GetNode("Height");
-        if (IsReadable(ptrWidth) && IsReadable(ptrHeight)) {
-            int width = ptrWidth->GetValue();
-            int height = ptrHeight->GetValue();
+        if (backend->IsReadable("Width") && backend->IsReadable("Height")) {
+            int width = backend->GetIntegerValue("Width");
+            int height = backend->GetIntegerValue("Height");
             std::cout << "Image Dimensions (Width x Height): " << width << " x " << height << std::endl;
         } else {
             std::cout << "[ WARNING ] Image dimensions not readable." << std::endl;
         }
 
         // Gain Sensitivity
-        CEnumerationPtr ptrGainAuto = nodeMap->GetNode("GainAuto");
-        if (IsReadable(ptrGainAuto)) {
-            CEnumEntryPtr ptrGainAutoEntry = ptrGainAuto->GetCurrentEntry();
-            std::string gainAuto = std::string(ptrGainAutoEntry->GetSymbolic().c_str());
+        if (backend->IsReadable("GainAuto")) {
+            std::string gainAuto = backend->GetEnumerationValue("GainAuto");
             std::cout << "Gain Auto: " << gainAuto << std::endl;
         }
-        CFloatPtr ptrGain = nodeMap->GetNode("Gain");
-        if (IsReadable(ptrGain)) {
-            float gain = ptrGain->GetValue();
+        if (backend->IsReadable("Gain")) {
+            float gain = backend->GetFloatValue("Gain");
             std::cout << "Gain Sensitivity: " << gain << " dB" << std::endl;
         } else {
             std::cout << "[ WARNING ] Gain sensitivity not readable." << std::endl;
         }
 
         // Gamma Correction
-        CBooleanPtr ptrGammaEnabled = nodeMap->GetNode("GammaEnable");
-        if (IsReadable(ptrGammaEnabled)) {
-            bool gammaEnabled = ptrGammaEnabled->GetValue();
+        if (backend->IsReadable("GammaEnable")) {
+            bool gammaEnabled = backend->GetBooleanValue("GammaEnable");
             std::cout << "Gamma Enabled: " << (gammaEnabled ? "True" : "False") << std::endl;
         }
-        CFloatPtr ptrGamma = nodeMap->GetNode("Gamma");
-        if (IsReadable(ptrGamma)) {
-            float gamma = ptrGamma->GetValue();
+        if (backend->IsReadable("Gamma")) {
+            float gamma = backend->GetFloatValue("Gamma");
             std::cout << "Gamma Correction: " << gamma << std::endl;
         } else {
             std::cout << "[ WARNING ] Gamma correction not readable." << std::endl;
         }
 
         // Black Level
-        CEnumerationPtr ptrBlackLevelAuto = nodeMap->GetNode("BlackLevelAuto");
-        if (IsReadable(ptrBlackLevelAuto)) {
-            CEnumEntryPtr ptrBlackLevelAutoEntry = ptrBlackLevelAuto->GetCurrentEntry();
-            std::string blackLevelAuto = std::string(ptrBlackLevelAutoEntry->GetSymbolic().c_str());
+        if (backend->IsReadable("BlackLevelAuto")) {
+            std::string blackLevelAuto = backend->GetEnumerationValue("BlackLevelAuto");
             std::cout << "Black Level Auto: " << blackLevelAuto << std::endl;
         }
-        CFloatPtr ptrBlackLevel = nodeMap->GetNode("BlackLevel");
-        if (IsReadable(ptrBlackLevel)) {
-            float blackLevel = ptrBlackLevel->GetValue();
+        if (backend->IsReadable("BlackLevel")) {
+            float blackLevel = backend->GetFloatValue("BlackLevel");
             std::cout << "Black Level: " << blackLevel << std::endl;
         } else {
             std::cout << "[ WARNING ] Black level not readable." << std::endl;
         }
 
         // White Balance Ratios
-        CEnumerationPtr ptrBalanceWhiteAuto = nodeMap->GetNode("BalanceWhiteAuto");
-        if (IsReadable(ptrBalanceWhiteAuto)) {
-            CEnumEntryPtr ptrBalanceWhiteAutoEntry = ptrBalanceWhiteAuto->GetCurrentEntry();
-            std::string balanceWhiteAuto = std::string(ptrBalanceWhiteAutoEntry->GetSymbolic().c_str());
+        if (backend->IsReadable("BalanceWhiteAuto")) {
+            std::string balanceWhiteAuto = backend->GetEnumerationValue("BalanceWhiteAuto");
             std::cout << "Balance White Auto: " << balanceWhiteAuto << std::endl;
         }
 
-        CEnumerationPtr ptrBalanceRatioSelector = nodeMap->GetNode("BalanceRatioSelector");
-        if (IsWritable(ptrBalanceRatioSelector)) {
+        if (backend->IsWritable("BalanceRatioSelector")) {
             // Red Balance Ratio
-            CEnumEntryPtr ptrRed = ptrBalanceRatioSelector->GetEntryByName("Red");
-            if (IsReadable(ptrRed)) {
-                ptrBalanceRatioSelector->SetIntValue(ptrRed->GetValue());
-                CFloatPtr ptrRedBalance = nodeMap->GetNode("BalanceRatio");
-                if (IsReadable(ptrRedBalance)) {
-                    float redBalance = ptrRedBalance->GetValue();
+            if (backend->IsEnumerationEntryReadable("BalanceRatioSelector", "Red")) {
+                backend->SetEnumerationValue("BalanceRatioSelector", "Red");
+                if (backend->IsReadable("BalanceRatio")) {
+                    float redBalance = backend->GetFloatValue("BalanceRatio");
                     std::cout << "Red Balance Ratio: " << redBalance << std::endl;
                 }
             }
             // Blue Balance Ratio
-            CEnumEntryPtr ptrBlue = ptrBalanceRatioSelector->GetEntryByName("Blue");
-            if (IsReadable(ptrBlue)) {
-                ptrBalanceRatioSelector->SetIntValue(ptrBlue->GetValue());
-                CFloatPtr ptrBlueBalance = nodeMap->GetNode("BalanceRatio");
-                if (IsReadable(ptrBlueBalance)) {
-                    float blueBalance = ptrBlueBalance->GetValue();
+            if (backend->IsEnumerationEntryReadable("BalanceRatioSelector", "Blue")) {
+                backend->SetEnumerationValue("BalanceRatioSelector", "Blue");
+                if (backend->IsReadable("BalanceRatio")) {
+                    float blueBalance = backend->GetFloatValue("BalanceRatio");
                     std::cout << "Blue Balance Ratio: " << blueBalance << std::endl;
                 }
             }
@@ -396,7 +700,7 @@ void SpinCamera::PrintSettings() {
         }
 
 
-    } catch (const Spinnaker::Exception& e) {
+    } catch (const std::exception& e) {
         std::cout << "[ ERROR ] Exception caught while reading settings: " << e.what() << std::endl;
     }
 
@@ -404,6 +708,123 @@ void SpinCamera::PrintSettings() {
 
 }
 
+void SpinCamera::SetImageOwnership(SpinOption::ImageOwnership ownership) {
+    imageOwnership = ownership;
+    if (ownership == SpinOption::ImageOwnership::Lease) {
+        SPIN_LOG_INFO("Image ownership set to Lease (zero-copy)");
+    } else {
+        SPIN_LOG_INFO("Image ownership set to Copy");
+    }
+}
+
+// Preallocate frameCount buffers sized for the current Width, Height and PixelFormat, and copy captured frames into them
+std::shared_ptr<SpinFramePool> SpinCamera::CreateFramePool(size_t frameCount, bool useHugePages, bool lockMemory) {
+    // Bits per pixel of every supported pixel format
+    const std::unordered_map<std::string, int> PixelFormat_bits = {
+        {"BayerRG8",   8},
+        {"BayerRG10p", 10},
+        {"BayerRG12p", 12},
+        {"BayerRG16",  16},
+        {"Mono8",      8},
+        {"Mono10p",    10},
+        {"Mono12p",    12},
+        {"Mono16",     16}
+    };
+
+    // Ensure nodemap exists
+    if (!backend) {
+        throw std::runtime_error("[ ERROR ] Unable to create frame pool, node map is not initialized.");
+    }
+
+    // Read the current frame geometry
+    if (!backend->IsReadable("Width") || !backend->IsReadable("Height") || !backend->IsReadable("PixelFormat")) {
+        throw std::runtime_error("[ ERROR ] Unable to create frame pool, image dimensions or pixel format not readable.");
+    }
+    const size_t width = static_cast<size_t>(backend->GetIntegerValue("Width"));
+    const size_t height = static_cast<size_t>(backend->GetIntegerValue("Height"));
+    const std::string formatStr = backend->GetEnumerationValue("PixelFormat");
+
+    // Unknown formats are sized for the widest supported one
+    int bitsPerPixel = 16;
+    auto option = PixelFormat_bits.find(formatStr);
+    if (option != PixelFormat_bits.end()) {
+        bitsPerPixel = option->second;
+    } else {
+        SPIN_LOG_WARNING("Unknown pixel format ", formatStr, ", sizing frame pool for 16 bits per pixel.");
+    }
+    size_t frameSize = (width * height * bitsPerPixel + 7) / 8;
+
+    // The payload can be larger than the pixels alone (e.g. chunk data)
+    if (backend->IsReadable("PayloadSize") && static_cast<size_t>(backend->GetIntegerValue("PayloadSize")) > frameSize) {
+        frameSize = static_cast<size_t>(backend->GetIntegerValue("PayloadSize"));
+    }
+
+    framePool = SpinFramePool::Create(frameCount, frameSize, useHugePages, lockMemory);
+    SPIN_LOG_INFO("Frame pool created with ", frameCount, " frames of ", frameSize, " bytes (", width, "x", height, " ", formatStr, ")");
+    return framePool;
+}
+
+void SpinCamera::SetFramePool(std::shared_ptr<SpinFramePool> pool) {
+    framePool = pool;
+}
+
+std::shared_ptr<SpinFramePool> SpinCamera::GetFramePool() const {
+    return framePool;
+}
+
+// Policy used by continuous captures and streams to pick the stream buffer count
+void SpinCamera::SetBufferPolicy(const SpinBufferPolicy& policy) {
+    bufferPolicy = policy;
+}
+
+const SpinBufferPolicy& SpinCamera::GetBufferPolicy() const {
+    return bufferPolicy;
+}
+
+// Choose the stream buffer count for the current frame size and rate, and apply it (takes effect on the next acquisition start)
+SpinBufferDecision SpinCamera::ApplyBufferPolicy(size_t heldFrames) {
+    if (!backend) throw std::runtime_error("[ ERROR ] Unable to set buffer count, camera not initialized");
+
+    int64_t payloadSize = 0;
+    if (backend->IsReadable("PayloadSize")) {
+        payloadSize = backend->GetIntegerValue("PayloadSize");
+    } else {
+        SPIN_LOG_WARNING("Unable to read payload size.");
+    }
+
+    double frameRate = 0.0;
+    if (backend->IsReadable("AcquisitionResultingFrameRate")) {
+        frameRate = backend->GetFloatValue("AcquisitionResultingFrameRate");
+    } else if (backend->IsReadable("AcquisitionFrameRate")) {
+        frameRate = backend->GetFloatValue("AcquisitionFrameRate");
+    } else {
+        SPIN_LOG_WARNING("Unable to read frame rate.");
+    }
+
+    if (!backend->IsWritable("StreamBufferCountMode") || !backend->IsEnumerationEntryReadable("StreamBufferCountMode", "Manual")) {
+        SPIN_LOG_WARNING("Unable to set buffer count mode to manual.");
+        bufferDecision = bufferPolicy.Decide(payloadSize, frameRate, heldFrames);
+        return bufferDecision;
+    }
+    backend->SetEnumerationValue("StreamBufferCountMode", "Manual");
+
+    if (!backend->IsWritable("StreamBufferCountManual")) {
+        SPIN_LOG_WARNING("Unable to set buffer count.");
+        bufferDecision = bufferPolicy.Decide(payloadSize, frameRate, heldFrames);
+        return bufferDecision;
+    }
+    bufferDecision = bufferPolicy.Decide(payloadSize, frameRate, heldFrames,
+                                         backend->GetIntegerMin("StreamBufferCountManual"), backend->GetIntegerMax("StreamBufferCountManual"));
+    backend->SetIntegerValue("StreamBufferCountManual", bufferDecision.bufferCount);
+    SPIN_LOG_INFO("Buffer count set to: ", bufferDecision.rationale);
+    return bufferDecision;
+}
+
+// Last buffer count chosen by ApplyBufferPolicy, with its rationale
+const SpinBufferDecision& SpinCamera::GetBufferDecision() const {
+    return bufferDecision;
+}
+
 void SpinCamera::SetAcquisitionMode(SpinOption::AcquisitionMode mode) {
 
     // All legal options
@@ -414,36 +835,34 @@ void SpinCamera::SetAcquisitionMode(SpinOption::AcquisitionMode mode) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Ensure Acquisition Mode is available to be written to
-    CEnumerationPtr ptrAcquisitionMode = nodeMap->GetNode("AcquisitionMode");
-    if (!IsAvailable(ptrAcquisitionMode) || !IsWritable(ptrAcquisitionMode)) {
-        std::cout << "[ WARNING ] Unable to set acquisition mode (node retrieval)." << std::endl;
+    if (!backend->IsWritable("AcquisitionMode")) {
+        SPIN_LOG_WARNING("Unable to set acquisition mode (node retrieval).");
         return;
     }
 
     // Get the mode string from the map
     auto option = AcquisitionMode_legal.find(mode);
     if (option == AcquisitionMode_legal.end()) {
-        std::cout << "[ WARNING ] Invalid acquisition mode." << std::endl;
+        SPIN_LOG_WARNING("Invalid acquisition mode.");
         return;
     }
     const std::string& modeStr = option->second;
 
     // Apply user selected mode
-    CEnumEntryPtr ptrAcquisitionModeEntry = ptrAcquisitionMode->GetEntryByName(modeStr.c_str());
-    if (!IsReadable(ptrAcquisitionModeEntry)) {
-        std::cout << "[ WARNING ] Unable to set acquisition mode (entry retrieval)." << std::endl;
+    if (!backend->IsEnumerationEntryReadable("AcquisitionMode", modeStr)) {
+        SPIN_LOG_WARNING("Unable to set acquisition mode (entry retrieval).");
     } else {
         try {
-            ptrAcquisitionMode->SetIntValue(ptrAcquisitionModeEntry->GetValue());
-            std::cout << "Acquisition mode set to " << modeStr << std::endl;
-        } catch (const Spinnaker::Exception& e) {
-            std::cout << "[ ERROR ] Exception caught while setting acquisition mode: " << e.what() << std::endl;
+            backend->SetEnumerationValue("AcquisitionMode", modeStr);
+            SPIN_LOG_INFO("Acquisition mode set to ", modeStr);
+        } catch (const std::exception& e) {
+            SPIN_LOG_ERROR("Exception caught while setting acquisition mode: ", e.what());
         }
     }
 }
@@ -458,36 +877,34 @@ void SpinCamera::SetBufferHandlingMode(SpinOption::BufferHandlingMode mode) {
     };
 
     // Ensure TLStreamNodeMap exists
-    if (!streamNodeMap) {
-        std::cout << "[ WARNING ] Stream node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Stream node map is not initialized.");
         return;
     }
 
     // Ensure Buffer Handling Mode is available to be written to
-    CEnumerationPtr ptrBufferHandlingMode = streamNodeMap->GetNode("StreamBufferHandlingMode");
-    if (!IsAvailable(ptrBufferHandlingMode) || !IsWritable(ptrBufferHandlingMode)) {
-        std::cout << "[ WARNING ] Unable to set buffer handling mode (node retrieval)." << std::endl;
+    if (!backend->IsWritable("StreamBufferHandlingMode")) {
+        SPIN_LOG_WARNING("Unable to set buffer handling mode (node retrieval).");
         return;
     }
 
     // Get the mode string from the map
     auto option = BufferHandlingMode_legal.find(mode);
     if (option == BufferHandlingMode_legal.end()) {
-        std::cout << "[ WARNING ] Invalid buffer handling mode." << std::endl;
+        SPIN_LOG_WARNING("Invalid buffer handling mode.");
         return;
     }
     const std::string& modeStr = option->second;
 
     // Apply user selected mode
-    CEnumEntryPtr ptrBufferHandlingModeEntry = ptrBufferHandlingMode->GetEntryByName(modeStr.c_str());
-    if (!IsReadable(ptrBufferHandlingModeEntry)) {
-        std::cout << "[ WARNING ] Unable to set buffer handling mode (entry retrieval)." << std::endl;
+    if (!backend->IsEnumerationEntryReadable("StreamBufferHandlingMode", modeStr)) {
+        SPIN_LOG_WARNING("Unable to set buffer handling mode (entry retrieval).");
     } else {
         try {
-            ptrBufferHandlingMode->SetIntValue(ptrBufferHandlingModeEntry->GetValue());
-            std::cout << "Buffer handling mode set to " << modeStr << std::endl;
-        } catch (const Spinnaker::Exception& e) {
-            std::cout << "[ ERROR ] Exception caught while setting buffer handling mode: " << e.what() << std::endl;
+            backend->SetEnumerationValue("StreamBufferHandlingMode", modeStr);
+            SPIN_LOG_INFO("Buffer handling mode set to ", modeStr);
+        } catch (const std::exception& e) {
+            SPIN_LOG_ERROR("Exception caught while setting buffer handling mode: ", e.what());
         }
     }
 
@@ -508,36 +925,34 @@ void SpinCamera::SetPixelFormat(SpinOption::PixelFormat format) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Ensure Pixel Format is available to be written to
-    CEnumerationPtr ptrPixelFormat = nodeMap->GetNode("PixelFormat");
-    if (!IsAvailable(ptrPixelFormat) || !IsWritable(ptrPixelFormat)) {
-        std::cout << "[ WARNING ] Unable to set pixel format (node retrieval)." << std::endl;
+    if (!backend->IsWritable("PixelFormat")) {
+        SPIN_LOG_WARNING("Unable to set pixel format (node retrieval).");
         return;
     }
 
     // Get the format string from the map
     auto option = PixelFormat_legal.find(format);
     if (option == PixelFormat_legal.end()) {
-        std::cout << "[ WARNING ] Invalid pixel format." << std::endl;
+        SPIN_LOG_WARNING("Invalid pixel format.");
         return;
     }
     const std::string& formatStr = option->second;
 
     // Apply user selected format
-    CEnumEntryPtr ptrPixelFormatEntry = ptrPixelFormat->GetEntryByName(formatStr.c_str());
-    if (!IsReadable(ptrPixelFormatEntry)) {
-        std::cout << "[ WARNING ] Unable to set pixel format (entry retrieval)." << std::endl;
+    if (!backend->IsEnumerationEntryReadable("PixelFormat", formatStr)) {
+        SPIN_LOG_WARNING("Unable to set pixel format (entry retrieval).");
     } else {
         try {
-            ptrPixelFormat->SetIntValue(ptrPixelFormatEntry->GetValue());
-            std::cout << "Pixel format set to " << formatStr << std::endl;
-        } catch (const Spinnaker::Exception& e) {
-            std::cout << "[ ERROR ] Exception caught while setting pixel format: " << e.what() << std::endl;
+            backend->SetEnumerationValue("PixelFormat", formatStr);
+            SPIN_LOG_INFO("Pixel format set to ", formatStr);
+        } catch (const std::exception& e) {
+            SPIN_LOG_ERROR("Exception caught while setting pixel format: ", e.what());
         }
     }
 }
@@ -552,33 +967,31 @@ void SpinCamera::SetBinning(SpinOption::Binning user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Get the selected binning value from the map
     auto option = Binning_legal.find(user_option);
     if (option == Binning_legal.end()) {
-        std::cout << "[ WARNING ] Invalid pixel format." << std::endl;
+        SPIN_LOG_WARNING("Invalid pixel format.");
         return;
     }
     const int& selected_value = option->second;
 
     // Apply user-selected value
-    CIntegerPtr ptrBinningHorizontalValue = nodeMap->GetNode("BinningHorizontal");
-    CIntegerPtr ptrBinningVerticalValue = nodeMap->GetNode("BinningVertical");
-    if (IsAvailable(ptrBinningHorizontalValue) && IsWritable(ptrBinningHorizontalValue)) {
-        ptrBinningHorizontalValue->SetValue(selected_value);
-        std::cout << "Binning horizontal set to: " << selected_value << std::endl;
+    if (backend->IsWritable("BinningHorizontal")) {
+        backend->SetIntegerValue("BinningHorizontal", selected_value);
+        SPIN_LOG_INFO("Binning horizontal set to: ", selected_value);
     } else {
-        std::cout << "[ WARNING ] Unable to set BinningHorizontal (node retrieval)." << std::endl;
+        SPIN_LOG_WARNING("Unable to set BinningHorizontal (node retrieval).");
     }
-    if (IsAvailable(ptrBinningVerticalValue) && IsWritable(ptrBinningVerticalValue)) {
-        ptrBinningVerticalValue->SetValue(selected_value);
-        std::cout << "Binning vertical set to: " << selected_value << std::endl;
+    if (backend->IsWritable("BinningVertical")) {
+        backend->SetIntegerValue("BinningVertical", selected_value);
+        SPIN_LOG_INFO("Binning vertical set to: ", selected_value);
     } else {
-        std::cout << "[ WARNING ] Unable to set BinningVertical (node retrieval)." << std::endl;
+        SPIN_LOG_WARNING("Unable to set BinningVertical (node retrieval).");
     }
 }
 
@@ -592,33 +1005,31 @@ void SpinCamera::SetDecimation(SpinOption::Decimation user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Get the selected decimation value from the map
     auto option = Decimation_legal.find(user_option);
     if (option == Decimation_legal.end()) {
-        std::cout << "[ WARNING ] Invalid decimation option." << std::endl;
+        SPIN_LOG_WARNING("Invalid decimation option.");
         return;
     }
     const int& decimation = option->second;
 
     // Apply user-selected value
-    CIntegerPtr ptrDecimationHorizontal = nodeMap->GetNode("DecimationHorizontal");
-    CIntegerPtr ptrDecimationVertical = nodeMap->GetNode("DecimationVertical");
-    if (IsAvailable(ptrDecimationHorizontal) && IsWritable(ptrDecimationHorizontal)) {
-        ptrDecimationHorizontal->SetValue(decimation);
-        std::cout << "Decimation horizontal set to: " << decimation << std::endl;
+    if (backend->IsWritable("DecimationHorizontal")) {
+        backend->SetIntegerValue("DecimationHorizontal", decimation);
+        SPIN_LOG_INFO("Decimation horizontal set to: ", decimation);
     } else {
-        std::cout << "[ WARNING ] Unable to set DecimationHorizontal (node retrieval)." << std::endl;
+        SPIN_LOG_WARNING("Unable to set DecimationHorizontal (node retrieval).");
     }
-    if (IsAvailable(ptrDecimationVertical) && IsWritable(ptrDecimationVertical)) {
-        ptrDecimationVertical->SetValue(decimation);
-        std::cout << "Decimation vertical set to: " << decimation << std::endl;
+    if (backend->IsWritable("DecimationVertical")) {
+        backend->SetIntegerValue("DecimationVertical", decimation);
+        SPIN_LOG_INFO("Decimation vertical set to: ", decimation);
     } else {
-        std::cout << "[ WARNING ] Unable to set DecimationVertical (node retrieval)." << std::endl;
+        SPIN_LOG_WARNING("Unable to set DecimationVertical (node retrieval).");
     }
 }
 
@@ -662,113 +1073,106 @@ void SpinCamera::SetExposureTime(SpinOption::ExposureTime user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Get the selected exposure time value from the map
     auto option = ExposureTime_legal.find(user_option);
     if (option == ExposureTime_legal.end()) {
-        std::cout << "[ WARNING ] Invalid exposure time option." << std::endl;
+        SPIN_LOG_WARNING("Invalid exposure time option.");
         return;
     }
     const double& exposureTime = option->second;
 
     // Set exposure mode to auto or manual based on user option
-    CEnumerationPtr ptrExposureAuto = nodeMap->GetNode("ExposureAuto");
-    if (IsReadable(ptrExposureAuto) && IsWritable(ptrExposureAuto)) {
+    if (backend->IsReadable("ExposureAuto") && backend->IsWritable("ExposureAuto")) {
         if (user_option == SpinOption::ExposureTime::Auto) {
             // Attempt to enable automatic exposure
-            CEnumEntryPtr ptrExposureAutoOn = ptrExposureAuto->GetEntryByName("Continuous");
-            if (IsReadable(ptrExposureAutoOn)) {
-                ptrExposureAuto->SetIntValue(ptrExposureAutoOn->GetValue());
-                std::cout << "Auto Exposure Enabled" << std::endl;
+            if (backend->IsEnumerationEntryReadable("ExposureAuto", "Continuous")) {
+                backend->SetEnumerationValue("ExposureAuto", "Continuous");
+                SPIN_LOG_INFO("Auto Exposure Enabled");
             } else {
-                std::cout << "[ WARNING ] Unable to enable automatic exposure" << std::endl;
+                SPIN_LOG_WARNING("Unable to enable automatic exposure");
             }
             // Return since auto mode was selected
             return;
         } else {
             // Attempt to disable automatic exposure
-            CEnumEntryPtr ptrExposureAutoOff = ptrExposureAuto->GetEntryByName("Off");
-            if (IsReadable(ptrExposureAutoOff)) {
-                ptrExposureAuto->SetIntValue(ptrExposureAutoOff->GetValue());
-                std::cout << "Manual Exposure Enabled (Automatic exposure disabled)" << std::endl;
+            if (backend->IsEnumerationEntryReadable("ExposureAuto", "Off")) {
+                backend->SetEnumerationValue("ExposureAuto", "Off");
+                SPIN_LOG_INFO("Manual Exposure Enabled (Automatic exposure disabled)");
             } else {
-                std::cout << "[ WARNING ] Unable to disable automatic exposure (enable manual exposure)" << std::endl;
+                SPIN_LOG_WARNING("Unable to disable automatic exposure (enable manual exposure)");
             }
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set exposure mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set exposure mode");
     }
 
     // Apply user-selected exposure time
-    CFloatPtr ptrExposureTime = nodeMap->GetNode("ExposureTime");
-    if (IsAvailable(ptrExposureTime) && IsWritable(ptrExposureTime)) {
+    if (backend->IsWritable("ExposureTime")) {
         double finalExposureTime = exposureTime;
 
         // Ensure exposure time is within allowable range
-        const double exposureTimeMax = ptrExposureTime->GetMax();
-        const double exposureTimeMin = ptrExposureTime->GetMin();
+        const double exposureTimeMax = backend->GetFloatMax("ExposureTime");
+        const double exposureTimeMin = backend->GetFloatMin("ExposureTime");
         if (exposureTime > exposureTimeMax) {
             finalExposureTime = exposureTimeMax;
-            std::cout << "[ NOTE ] Selected exposure time exceeds maximum, setting to max allowable: " << finalExposureTime << " microseconds." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected exposure time exceeds maximum, setting to max allowable: ", finalExposureTime, " microseconds.");
         } else if (exposureTime < exposureTimeMin) {
             finalExposureTime = exposureTimeMin;
-            std::cout << "[ NOTE ] Selected exposure time is below minimum, setting to min allowable: " << finalExposureTime << " microseconds." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected exposure time is below minimum, setting to min allowable: ", finalExposureTime, " microseconds.");
         } else {
             finalExposureTime = exposureTime;
         }
 
         // Perform the actual value set
-        ptrExposureTime->SetValue(finalExposureTime);
-        std::cout << "Exposure time set to " << finalExposureTime << " microseconds." << std::endl;
+        backend->SetFloatValue("ExposureTime", finalExposureTime);
+        SPIN_LOG_INFO("Exposure time set to ", finalExposureTime, " microseconds.");
     } else {
-        std::cout << "[ WARNING ] Exposure time setting not available." << std::endl;
+        SPIN_LOG_WARNING("Exposure time setting not available.");
     }
 }
 
 void SpinCamera::SetExposureTime(double user_exposure_time) {
     
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Ensure automatic exposure is off to allow manual setting
-    CEnumerationPtr ptrExposureAuto = nodeMap->GetNode("ExposureAuto");
-    if (IsReadable(ptrExposureAuto) && IsWritable(ptrExposureAuto)) {
+    if (backend->IsReadable("ExposureAuto") && backend->IsWritable("ExposureAuto")) {
         // Attempt to disable automatic exposure
-        CEnumEntryPtr ptrExposureAutoOff = ptrExposureAuto->GetEntryByName("Off");
-        if (IsReadable(ptrExposureAutoOff)) {
-            ptrExposureAuto->SetIntValue(ptrExposureAutoOff->GetValue());
-            std::cout << "Manual Exposure Enabled (Automatic exposure disabled)" << std::endl;
+        if (backend->IsEnumerationEntryReadable("ExposureAuto", "Off")) {
+            backend->SetEnumerationValue("ExposureAuto", "Off");
+            SPIN_LOG_INFO("Manual Exposure Enabled (Automatic exposure disabled)");
         } else {
-            std::cout << "[ WARNING ] Unable to disable automatic exposure (enable manual exposure)" << std::endl;
+            SPIN_LOG_WARNING("Unable to disable automatic exposure (enable manual exposure)");
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set exposure mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set exposure mode");
     }
 
     // Apply user-selected exposure time
-    CFloatPtr ptrExposureTime = nodeMap->GetNode("ExposureTime");
-    if (IsAvailable(ptrExposureTime) && IsWritable(ptrExposureTime)) {
-        const double exposureTimeMax = ptrExposureTime->GetMax();
-        const double exposureTimeMin = ptrExposureTime->GetMin();
+    if (backend->IsWritable("ExposureTime")) {
+        const double exposureTimeMax = backend->GetFloatMax("ExposureTime");
+        const double exposureTimeMin = backend->GetFloatMin("ExposureTime");
         if (user_exposure_time > exposureTimeMax) {
             user_exposure_time = exposureTimeMax;
-            std::cout << "[ NOTE ] Provided exposure time exceeds maximum limit, setting to max value of " << exposureTimeMax << " microseconds." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Provided exposure time exceeds maximum limit, setting to max value of ", exposureTimeMax, " microseconds.");
         }
         if (user_exposure_time < exposureTimeMin) {
             user_exposure_time = exposureTimeMin;
-            std::cout << "[ NOTE ] Provided exposure time exceeds minimum limit, setting to min value of " << exposureTimeMin << " microseconds." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Provided exposure time exceeds minimum limit, setting to min value of ", exposureTimeMin, " microseconds.");
         }
-        ptrExposureTime->SetValue(user_exposure_time);
-        std::cout << "Exposure time set to " << user_exposure_time << " microseconds." << std::endl;
+        backend->SetFloatValue("ExposureTime", user_exposure_time);
+        SPIN_LOG_INFO("Exposure time set to ", user_exposure_time, " microseconds.");
     } else {
-        std::cout << "[ WARNING ] Exposure time setting not available." << std::endl;
+        SPIN_LOG_WARNING("Exposure time setting not available.");
     }
 }
 
@@ -788,41 +1192,37 @@ void SpinCamera::SetImageDimensions(SpinOption::ImageDimensions user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Start by clearing any current image dimentions / offsets
-    CIntegerPtr ptrWidth = nodeMap->GetNode("Width");
-    CIntegerPtr ptrHeight = nodeMap->GetNode("Height");
-    CIntegerPtr ptrWidthOffset = nodeMap->GetNode("OffsetX");
-    CIntegerPtr ptrHeightOffset = nodeMap->GetNode("OffsetY");
-    if (IsAvailable(ptrWidthOffset) && IsWritable(ptrWidthOffset)) {
-        ptrWidthOffset->SetValue(0);
+    if (backend->IsWritable("OffsetX")) {
+        backend->SetIntegerValue("OffsetX", 0);
     } else {
-        std::cout << "[ WARNING ] Width offset setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Width offset setting not able to be cleared.");
     }
-    if (IsAvailable(ptrHeightOffset) && IsWritable(ptrHeightOffset)) {
-        ptrHeightOffset->SetValue(0);
+    if (backend->IsWritable("OffsetY")) {
+        backend->SetIntegerValue("OffsetY", 0);
     } else {
-        std::cout << "[ WARNING ] Height offset setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Height offset setting not able to be cleared.");
     }
-    if (IsAvailable(ptrWidth) && IsWritable(ptrWidth)) {
-        ptrWidth->SetValue(static_cast<int>(ptrWidth->GetMax()));
+    if (backend->IsWritable("Width")) {
+        backend->SetIntegerValue("Width", static_cast<int>(backend->GetIntegerMax("Width")));
     } else {
-        std::cout << "[ WARNING ] Width setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Width setting not able to be cleared.");
     }
-    if (IsAvailable(ptrHeight) && IsWritable(ptrHeight)) {
-        ptrHeight->SetValue(static_cast<int>(ptrHeight->GetMax()));
+    if (backend->IsWritable("Height")) {
+        backend->SetIntegerValue("Height", static_cast<int>(backend->GetIntegerMax("Height")));
     } else {
-        std::cout << "[ WARNING ] Height setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Height setting not able to be cleared.");
     }
 
     // Get the selected image dimensions from the map
     auto option = ImageDimensions_legal.find(user_option);
     if (option == ImageDimensions_legal.end()) {
-        std::cout << "[ WARNING ] Invalid image dimensions option." << std::endl;
+        SPIN_LOG_WARNING("Invalid image dimensions option.");
         return;
     }
     const std::pair<int, int>& dimensions = option->second;
@@ -834,116 +1234,110 @@ void SpinCamera::SetImageDimensions(SpinOption::ImageDimensions user_option) {
     int finalHeight = height;
 
     // Retrieve node pointers for sensor width and height
-    CIntegerPtr ptrSensorWidth = nodeMap->GetNode("SensorWidth");
-    CIntegerPtr ptrSensorHeight = nodeMap->GetNode("SensorHeight");
 
     // If the sensor width and height nodes are available, use them
     int sensorWidth = 0;
     int sensorHeight = 0;
-    if (IsAvailable(ptrSensorWidth) && IsReadable(ptrSensorWidth)) {
-        sensorWidth = static_cast<int>(ptrSensorWidth->GetValue());
-    } else if (IsAvailable(ptrWidth) && IsReadable(ptrWidth)) {
+    if (backend->IsReadable("SensorWidth")) {
+        sensorWidth = static_cast<int>(backend->GetIntegerValue("SensorWidth"));
+    } else if (backend->IsReadable("Width")) {
         // Fallback to using the max value of the Width node if SensorWidth is not available
-        sensorWidth = static_cast<int>(ptrWidth->GetMax());
+        sensorWidth = static_cast<int>(backend->GetIntegerMax("Width"));
     }
 
-    if (IsAvailable(ptrSensorHeight) && IsReadable(ptrSensorHeight)) {
-        sensorHeight = static_cast<int>(ptrSensorHeight->GetValue());
-    } else if (IsAvailable(ptrHeight) && IsReadable(ptrHeight)) {
+    if (backend->IsReadable("SensorHeight")) {
+        sensorHeight = static_cast<int>(backend->GetIntegerValue("SensorHeight"));
+    } else if (backend->IsReadable("Height")) {
         // Fallback to using the max value of the Height node if SensorHeight is not available
-        sensorHeight = static_cast<int>(ptrHeight->GetMax());
+        sensorHeight = static_cast<int>(backend->GetIntegerMax("Height"));
     }
 
     // Apply user-selected width
-    if (IsAvailable(ptrWidth) && IsWritable(ptrWidth)) {
-        const int widthMax = static_cast<int>(ptrWidth->GetMax());
-        const int widthMin = static_cast<int>(ptrWidth->GetMin());
+    if (backend->IsWritable("Width")) {
+        const int widthMax = static_cast<int>(backend->GetIntegerMax("Width"));
+        const int widthMin = static_cast<int>(backend->GetIntegerMin("Width"));
 
         if (width > widthMax) {
             finalWidth = widthMax;
-            std::cout << "[ NOTE ] Selected width exceeds maximum, setting to max allowable: " << finalWidth << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected width exceeds maximum, setting to max allowable: ", finalWidth, ".");
         } else if (width < widthMin) {
             finalWidth = widthMin;
-            std::cout << "[ NOTE ] Selected width is below minimum, setting to min allowable: " << finalWidth << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected width is below minimum, setting to min allowable: ", finalWidth, ".");
         }
 
-        ptrWidth->SetValue(finalWidth);
-        std::cout << "Width set to " << finalWidth << "." << std::endl;
+        backend->SetIntegerValue("Width", finalWidth);
+        SPIN_LOG_INFO("Width set to ", finalWidth, ".");
     } else {
-        std::cout << "[ WARNING ] Width setting not available." << std::endl;
+        SPIN_LOG_WARNING("Width setting not available.");
     }
 
     // Apply user-selected height
-    if (IsAvailable(ptrHeight) && IsWritable(ptrHeight)) {
-        const int heightMax = static_cast<int>(ptrHeight->GetMax());
-        const int heightMin = static_cast<int>(ptrHeight->GetMin());
+    if (backend->IsWritable("Height")) {
+        const int heightMax = static_cast<int>(backend->GetIntegerMax("Height"));
+        const int heightMin = static_cast<int>(backend->GetIntegerMin("Height"));
 
         if (height > heightMax) {
             finalHeight = heightMax;
-            std::cout << "[ NOTE ] Selected height exceeds maximum, setting to max allowable: " << finalHeight << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected height exceeds maximum, setting to max allowable: ", finalHeight, ".");
         } else if (height < heightMin) {
             finalHeight = heightMin;
-            std::cout << "[ NOTE ] Selected height is below minimum, setting to min allowable: " << finalHeight << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected height is below minimum, setting to min allowable: ", finalHeight, ".");
         }
 
-        ptrHeight->SetValue(finalHeight);
-        std::cout << "Height set to " << finalHeight << "." << std::endl;
+        backend->SetIntegerValue("Height", finalHeight);
+        SPIN_LOG_INFO("Height set to ", finalHeight, ".");
     } else {
-        std::cout << "[ WARNING ] Height setting not available." << std::endl;
+        SPIN_LOG_WARNING("Height setting not available.");
     }
 
     // Calculate and set width offset
-    if (IsAvailable(ptrWidthOffset) && IsWritable(ptrWidthOffset)) {
+    if (backend->IsWritable("OffsetX")) {
         int offsetX = (sensorWidth - finalWidth) / 2;
 
-        ptrWidthOffset->SetValue(offsetX);
-        std::cout << "Width offset set to " << offsetX << "." << std::endl;
+        backend->SetIntegerValue("OffsetX", offsetX);
+        SPIN_LOG_INFO("Width offset set to ", offsetX, ".");
     } else {
-        std::cout << "[ WARNING ] Width offset setting not available." << std::endl;
+        SPIN_LOG_WARNING("Width offset setting not available.");
     }
 
     // Calculate and set height offset
-    if (IsAvailable(ptrHeightOffset) && IsWritable(ptrHeightOffset)) {
+    if (backend->IsWritable("OffsetY")) {
         int offsetY = (sensorHeight - finalHeight) / 2;
 
-        ptrHeightOffset->SetValue(offsetY);
-        std::cout << "Height offset set to " << offsetY << "." << std::endl;
+        backend->SetIntegerValue("OffsetY", offsetY);
+        SPIN_LOG_INFO("Height offset set to ", offsetY, ".");
     } else {
-        std::cout << "[ WARNING ] Height offset setting not available." << std::endl;
+        SPIN_LOG_WARNING("Height offset setting not available.");
     }
 }
 
 void SpinCamera::SetImageDimensions(int user_width, int user_height, int user_width_offset, int user_height_offset) {
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Start by clearing any current image dimentions / offsets
-    CIntegerPtr ptrWidth = nodeMap->GetNode("Width");
-    CIntegerPtr ptrHeight = nodeMap->GetNode("Height");
-    CIntegerPtr ptrWidthOffset = nodeMap->GetNode("OffsetX");
-    CIntegerPtr ptrHeightOffset = nodeMap->GetNode("OffsetY");
-    if (IsAvailable(ptrWidthOffset) && IsWritable(ptrWidthOffset)) {
-        ptrWidthOffset->SetValue(0);
+    if (backend->IsWritable("OffsetX")) {
+        backend->SetIntegerValue("OffsetX", 0);
     } else {
-        std::cout << "[ WARNING ] Width offset setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Width offset setting not able to be cleared.");
     }
-    if (IsAvailable(ptrHeightOffset) && IsWritable(ptrHeightOffset)) {
-        ptrHeightOffset->SetValue(0);
+    if (backend->IsWritable("OffsetY")) {
+        backend->SetIntegerValue("OffsetY", 0);
     } else {
-        std::cout << "[ WARNING ] Height offset setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Height offset setting not able to be cleared.");
     }
-    if (IsAvailable(ptrWidth) && IsWritable(ptrWidth)) {
-        ptrWidth->SetValue(static_cast<int>(ptrWidth->GetMax()));
+    if (backend->IsWritable("Width")) {
+        backend->SetIntegerValue("Width", static_cast<int>(backend->GetIntegerMax("Width")));
     } else {
-        std::cout << "[ WARNING ] Width setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Width setting not able to be cleared.");
     }
-    if (IsAvailable(ptrHeight) && IsWritable(ptrHeight)) {
-        ptrHeight->SetValue(static_cast<int>(ptrHeight->GetMax()));
+    if (backend->IsWritable("Height")) {
+        backend->SetIntegerValue("Height", static_cast<int>(backend->GetIntegerMax("Height")));
     } else {
-        std::cout << "[ WARNING ] Height setting not able to be cleared." << std::endl;
+        SPIN_LOG_WARNING("Height setting not able to be cleared.");
     }
 
     // Get width and height
@@ -953,67 +1347,65 @@ void SpinCamera::SetImageDimensions(int user_width, int user_height, int user_wi
     int finalHeight = height;
 
     // Retrieve node pointers for sensor width and height
-    CIntegerPtr ptrSensorWidth = nodeMap->GetNode("SensorWidth");
-    CIntegerPtr ptrSensorHeight = nodeMap->GetNode("SensorHeight");
 
     // If the sensor width and height nodes are available, use them
     int sensorWidth = 0;
     int sensorHeight = 0;
-    if (IsAvailable(ptrSensorWidth) && IsReadable(ptrSensorWidth)) {
-        sensorWidth = static_cast<int>(ptrSensorWidth->GetValue());
-    } else if (IsAvailable(ptrWidth) && IsReadable(ptrWidth)) {
+    if (backend->IsReadable("SensorWidth")) {
+        sensorWidth = static_cast<int>(backend->GetIntegerValue("SensorWidth"));
+    } else if (backend->IsReadable("Width")) {
         // Fallback to using the max value of the Width node if SensorWidth is not available
-        sensorWidth = static_cast<int>(ptrWidth->GetMax());
+        sensorWidth = static_cast<int>(backend->GetIntegerMax("Width"));
     }
 
-    if (IsAvailable(ptrSensorHeight) && IsReadable(ptrSensorHeight)) {
-        sensorHeight = static_cast<int>(ptrSensorHeight->GetValue());
-    } else if (IsAvailable(ptrHeight) && IsReadable(ptrHeight)) {
+    if (backend->IsReadable("SensorHeight")) {
+        sensorHeight = static_cast<int>(backend->GetIntegerValue("SensorHeight"));
+    } else if (backend->IsReadable("Height")) {
         // Fallback to using the max value of the Height node if SensorHeight is not available
-        sensorHeight = static_cast<int>(ptrHeight->GetMax());
+        sensorHeight = static_cast<int>(backend->GetIntegerMax("Height"));
     }
 
     // Apply user-selected width
-    if (IsAvailable(ptrWidth) && IsWritable(ptrWidth)) {
-        const int widthMax = static_cast<int>(ptrWidth->GetMax());
-        const int widthMin = static_cast<int>(ptrWidth->GetMin());
+    if (backend->IsWritable("Width")) {
+        const int widthMax = static_cast<int>(backend->GetIntegerMax("Width"));
+        const int widthMin = static_cast<int>(backend->GetIntegerMin("Width"));
 
         if (width > widthMax) {
             finalWidth = widthMax;
-            std::cout << "[ NOTE ] Selected width exceeds maximum, setting to max allowable: " << finalWidth << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected width exceeds maximum, setting to max allowable: ", finalWidth, ".");
         } else if (width < widthMin) {
             finalWidth = widthMin;
-            std::cout << "[ NOTE ] Selected width is below minimum, setting to min allowable: " << finalWidth << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected width is below minimum, setting to min allowable: ", finalWidth, ".");
         }
 
-        ptrWidth->SetValue(finalWidth);
-        std::cout << "Width set to " << finalWidth << "." << std::endl;
+        backend->SetIntegerValue("Width", finalWidth);
+        SPIN_LOG_INFO("Width set to ", finalWidth, ".");
     } else {
-        std::cout << "[ WARNING ] Width setting not available." << std::endl;
+        SPIN_LOG_WARNING("Width setting not available.");
     }
 
     // Apply user-selected height
-    if (IsAvailable(ptrHeight) && IsWritable(ptrHeight)) {
-        const int heightMax = static_cast<int>(ptrHeight->GetMax());
-        const int heightMin = static_cast<int>(ptrHeight->GetMin());
+    if (backend->IsWritable("Height")) {
+        const int heightMax = static_cast<int>(backend->GetIntegerMax("Height"));
+        const int heightMin = static_cast<int>(backend->GetIntegerMin("Height"));
 
         if (height > heightMax) {
             finalHeight = heightMax;
-            std::cout << "[ NOTE ] Selected height exceeds maximum, setting to max allowable: " << finalHeight << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected height exceeds maximum, setting to max allowable: ", finalHeight, ".");
         } else if (height < heightMin) {
             finalHeight = heightMin;
-            std::cout << "[ NOTE ] Selected height is below minimum, setting to min allowable: " << finalHeight << "." << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected height is below minimum, setting to min allowable: ", finalHeight, ".");
         }
 
-        ptrHeight->SetValue(finalHeight);
-        std::cout << "Height set to " << finalHeight << "." << std::endl;
+        backend->SetIntegerValue("Height", finalHeight);
+        SPIN_LOG_INFO("Height set to ", finalHeight, ".");
     } else {
-        std::cout << "[ WARNING ] Height setting not available." << std::endl;
+        SPIN_LOG_WARNING("Height setting not available.");
     }
 
 
     // Calculate and set width offset
-    if (IsAvailable(ptrWidthOffset) && IsWritable(ptrWidthOffset)) {
+    if (backend->IsWritable("OffsetX")) {
         int offsetX;
 
         // Default is to center the frame
@@ -1023,14 +1415,14 @@ void SpinCamera::SetImageDimensions(int user_width, int user_height, int user_wi
             offsetX = user_width_offset;
         }
         
-        ptrWidthOffset->SetValue(offsetX);
-        std::cout << "Width offset set to " << offsetX << "." << std::endl;
+        backend->SetIntegerValue("OffsetX", offsetX);
+        SPIN_LOG_INFO("Width offset set to ", offsetX, ".");
     } else {
-        std::cout << "[ WARNING ] Width offset setting not available." << std::endl;
+        SPIN_LOG_WARNING("Width offset setting not available.");
     }
 
     // Calculate and set height offset
-    if (IsAvailable(ptrHeightOffset) && IsWritable(ptrHeightOffset)) {
+    if (backend->IsWritable("OffsetY")) {
         int offsetY;
 
         // Default is to center the frame
@@ -1040,10 +1432,10 @@ void SpinCamera::SetImageDimensions(int user_width, int user_height, int user_wi
             offsetY = user_height_offset;
         }
 
-        ptrHeightOffset->SetValue(offsetY);
-        std::cout << "Height offset set to " << offsetY << "." << std::endl;
+        backend->SetIntegerValue("OffsetY", offsetY);
+        SPIN_LOG_INFO("Height offset set to ", offsetY, ".");
     } else {
-        std::cout << "[ WARNING ] Height offset setting not available." << std::endl;
+        SPIN_LOG_WARNING("Height offset setting not available.");
     }
     
 }
@@ -1078,110 +1470,103 @@ void SpinCamera::SetGainSensitivity(SpinOption::GainSensitivity user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Get the selected gain sensitivity value from the map
     auto option = GainSensitivity_legal.find(user_option);
     if (option == GainSensitivity_legal.end()) {
-        std::cout << "[ WARNING ] Invalid gain sensitivity option." << std::endl;
+        SPIN_LOG_WARNING("Invalid gain sensitivity option.");
         return;
     }
     const float& gainSensitivity = option->second;
 
     // Set gain mode to auto or manual based on user option
-    CEnumerationPtr ptrGainAuto = nodeMap->GetNode("GainAuto");
-    if (IsReadable(ptrGainAuto) && IsWritable(ptrGainAuto)) {
+    if (backend->IsReadable("GainAuto") && backend->IsWritable("GainAuto")) {
         if (user_option == SpinOption::GainSensitivity::Auto) {
             // Attempt to enable automatic gain
-            CEnumEntryPtr ptrGainAutoOn = ptrGainAuto->GetEntryByName("Continuous");
-            if (IsReadable(ptrGainAutoOn)) {
-                ptrGainAuto->SetIntValue(ptrGainAutoOn->GetValue());
-                std::cout << "Auto Gain Enabled" << std::endl;
+            if (backend->IsEnumerationEntryReadable("GainAuto", "Continuous")) {
+                backend->SetEnumerationValue("GainAuto", "Continuous");
+                SPIN_LOG_INFO("Auto Gain Enabled");
             } else {
-                std::cout << "[ WARNING ] Unable to enable automatic gain" << std::endl;
+                SPIN_LOG_WARNING("Unable to enable automatic gain");
             }
             // Return since auto mode was selected
             return;
         } else {
             // Attempt to disable automatic gain
-            CEnumEntryPtr ptrGainAutoOff = ptrGainAuto->GetEntryByName("Off");
-            if (IsReadable(ptrGainAutoOff)) {
-                ptrGainAuto->SetIntValue(ptrGainAutoOff->GetValue());
-                std::cout << "Manual Gain Enabled (Automatic gain disabled)" << std::endl;
+            if (backend->IsEnumerationEntryReadable("GainAuto", "Off")) {
+                backend->SetEnumerationValue("GainAuto", "Off");
+                SPIN_LOG_INFO("Manual Gain Enabled (Automatic gain disabled)");
             } else {
-                std::cout << "[ WARNING ] Unable to disable automatic gain (enable manual gain)" << std::endl;
+                SPIN_LOG_WARNING("Unable to disable automatic gain (enable manual gain)");
             }
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set gain mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set gain mode");
     }
 
     // Apply user-selected gain sensitivity
-    CFloatPtr ptrGain = nodeMap->GetNode("Gain");
-    if (IsAvailable(ptrGain) && IsWritable(ptrGain)) {
-        const float gainMax = static_cast<float>(ptrGain->GetMax());
-        const float gainMin = static_cast<float>(ptrGain->GetMin());
+    if (backend->IsWritable("Gain")) {
+        const float gainMax = static_cast<float>(backend->GetFloatMax("Gain"));
+        const float gainMin = static_cast<float>(backend->GetFloatMin("Gain"));
         float finalGainSensitivity = gainSensitivity;
 
         if (gainSensitivity > gainMax) {
             finalGainSensitivity = gainMax;
-            std::cout << "[ NOTE ] Selected gain sensitivity exceeds maximum, setting to max allowable: " << finalGainSensitivity << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gain sensitivity exceeds maximum, setting to max allowable: ", finalGainSensitivity);
         } else if (gainSensitivity < gainMin) {
             finalGainSensitivity = gainMin;
-            std::cout << "[ NOTE ] Selected gain sensitivity is below minimum, setting to min allowable: " << finalGainSensitivity << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gain sensitivity is below minimum, setting to min allowable: ", finalGainSensitivity);
         }
 
-        ptrGain->SetValue(finalGainSensitivity);
-        std::cout << "Gain sensitivity set to " << finalGainSensitivity << std::endl;
+        backend->SetFloatValue("Gain", finalGainSensitivity);
+        SPIN_LOG_INFO("Gain sensitivity set to ", finalGainSensitivity);
     } else {
-        std::cout << "[ WARNING ] Gain sensitivity setting not available" << std::endl;
+        SPIN_LOG_WARNING("Gain sensitivity setting not available");
     }
 }
 
 void SpinCamera::SetGainSensitivity(float user_gain_sensitivity) {
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Ensure automatic gain is off to allow manual setting
-    CEnumerationPtr ptrGainAuto = nodeMap->GetNode("GainAuto");
-    if (IsReadable(ptrGainAuto) && IsWritable(ptrGainAuto)) {
+    if (backend->IsReadable("GainAuto") && backend->IsWritable("GainAuto")) {
         // Attempt to disable automatic gain
-        CEnumEntryPtr ptrGainAutoOff = ptrGainAuto->GetEntryByName("Off");
-        if (IsReadable(ptrGainAutoOff)) {
-            ptrGainAuto->SetIntValue(ptrGainAutoOff->GetValue());
-            std::cout << "Manual Gain Enabled (Automatic gain disabled)" << std::endl;
+        if (backend->IsEnumerationEntryReadable("GainAuto", "Off")) {
+            backend->SetEnumerationValue("GainAuto", "Off");
+            SPIN_LOG_INFO("Manual Gain Enabled (Automatic gain disabled)");
         } else {
-            std::cout << "[ WARNING ] Unable to disable automatic gain (enable manual gain)" << std::endl;
+            SPIN_LOG_WARNING("Unable to disable automatic gain (enable manual gain)");
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set gain mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set gain mode");
     }
 
     // Apply user-selected gain sensitivity
-    CFloatPtr ptrGain = nodeMap->GetNode("Gain");
-    if (IsAvailable(ptrGain) && IsWritable(ptrGain)) {
-        const float gainMax = static_cast<float>(ptrGain->GetMax());
-        const float gainMin = static_cast<float>(ptrGain->GetMin());
+    if (backend->IsWritable("Gain")) {
+        const float gainMax = static_cast<float>(backend->GetFloatMax("Gain"));
+        const float gainMin = static_cast<float>(backend->GetFloatMin("Gain"));
         float finalGainSensitivity = user_gain_sensitivity;
 
         if (user_gain_sensitivity > gainMax) {
             finalGainSensitivity = gainMax;
-            std::cout << "[ NOTE ] Selected gain sensitivity exceeds maximum, setting to max allowable: " << finalGainSensitivity << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gain sensitivity exceeds maximum, setting to max allowable: ", finalGainSensitivity);
         } else if (user_gain_sensitivity < gainMin) {
             finalGainSensitivity = gainMin;
-            std::cout << "[ NOTE ] Selected gain sensitivity is below minimum, setting to min allowable: " << finalGainSensitivity << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gain sensitivity is below minimum, setting to min allowable: ", finalGainSensitivity);
         }
 
-        ptrGain->SetValue(finalGainSensitivity);
-        std::cout << "Gain sensitivity set to " << finalGainSensitivity << std::endl;
+        backend->SetFloatValue("Gain", finalGainSensitivity);
+        SPIN_LOG_INFO("Gain sensitivity set to ", finalGainSensitivity);
     } else {
-        std::cout << "[ WARNING ] Gain sensitivity setting not available" << std::endl;
+        SPIN_LOG_WARNING("Gain sensitivity setting not available");
     }
 }
 
@@ -1205,92 +1590,88 @@ void SpinCamera::SetGammaCorrection(SpinOption::GammaCorrection user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Get the selected gamma correction value from the map
     auto option = GammaCorrection_legal.find(user_option);
     if (option == GammaCorrection_legal.end()) {
-        std::cout << "[ WARNING ] Invalid gamma correction option." << std::endl;
+        SPIN_LOG_WARNING("Invalid gamma correction option.");
         return;
     }
     const float& gammaValue = option->second;
 
     // Either enable or disable gamma based on user input
-    CBooleanPtr ptrGammaEnabled = nodeMap->GetNode("GammaEnable");
-    if (IsAvailable(ptrGammaEnabled) && IsWritable(ptrGammaEnabled)) {
+    if (backend->IsWritable("GammaEnable")) {
         if (user_option == SpinOption::GammaCorrection::Disable) {
-            ptrGammaEnabled->SetValue(false);
-            std::cout << "Gamma disabled" << std::endl;
+            backend->SetBooleanValue("GammaEnable", false);
+            SPIN_LOG_INFO("Gamma disabled");
             return;
         } else {
-            ptrGammaEnabled->SetValue(true);
-            std::cout << "Gamma enabled" << std::endl;
+            backend->SetBooleanValue("GammaEnable", true);
+            SPIN_LOG_INFO("Gamma enabled");
         }
     } else {
-        std::cout << "[ WARNING ] Unable to enable/disable gamma correction" << std::endl;
+        SPIN_LOG_WARNING("Unable to enable/disable gamma correction");
     }
 
     // Apply user-selected gamma correction
-    CFloatPtr ptrGamma = nodeMap->GetNode("Gamma");
-    if (IsAvailable(ptrGamma) && IsWritable(ptrGamma)) {
-        const float gammaMax = static_cast<float>(ptrGamma->GetMax());
-        const float gammaMin = static_cast<float>(ptrGamma->GetMin());
+    if (backend->IsWritable("Gamma")) {
+        const float gammaMax = static_cast<float>(backend->GetFloatMax("Gamma"));
+        const float gammaMin = static_cast<float>(backend->GetFloatMin("Gamma"));
         float finalGammaValue = gammaValue;
 
         if (gammaValue > gammaMax) {
             finalGammaValue = gammaMax;
-            std::cout << "[ NOTE ] Selected gamma value exceeds maximum, setting to max allowable: " << finalGammaValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gamma value exceeds maximum, setting to max allowable: ", finalGammaValue);
         } else if (gammaValue < gammaMin) {
             finalGammaValue = gammaMin;
-            std::cout << "[ NOTE ] Selected gamma value is below minimum, setting to min allowable: " << finalGammaValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gamma value is below minimum, setting to min allowable: ", finalGammaValue);
         }
 
-        ptrGamma->SetValue(finalGammaValue);
-        std::cout << "Gamma correction set to " << finalGammaValue << std::endl;
+        backend->SetFloatValue("Gamma", finalGammaValue);
+        SPIN_LOG_INFO("Gamma correction set to ", finalGammaValue);
     } else {
-        std::cout << "[ WARNING ] Gamma correction setting not available" << std::endl;
+        SPIN_LOG_WARNING("Gamma correction setting not available");
     }
 }
 
 void SpinCamera::SetGammaCorrection(float user_gamma_value) {
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Enable gamma
-    CBooleanPtr ptrGammaEnabled = nodeMap->GetNode("GammaEnable");
-    if (IsAvailable(ptrGammaEnabled) && IsWritable(ptrGammaEnabled)) {
-        ptrGammaEnabled->SetValue(true);
-        std::cout << "Gamma enabled" << std::endl;
+    if (backend->IsWritable("GammaEnable")) {
+        backend->SetBooleanValue("GammaEnable", true);
+        SPIN_LOG_INFO("Gamma enabled");
     } else {
-        std::cout << "[ WARNING ] Unable to enable gamma correction" << std::endl;
+        SPIN_LOG_WARNING("Unable to enable gamma correction");
         return;
     }
 
     // Apply user-selected gamma correction
-    CFloatPtr ptrGamma = nodeMap->GetNode("Gamma");
-    if (IsAvailable(ptrGamma) && IsWritable(ptrGamma)) {
-        const float gammaMax = static_cast<float>(ptrGamma->GetMax());
-        const float gammaMin = static_cast<float>(ptrGamma->GetMin());
+    if (backend->IsWritable("Gamma")) {
+        const float gammaMax = static_cast<float>(backend->GetFloatMax("Gamma"));
+        const float gammaMin = static_cast<float>(backend->GetFloatMin("Gamma"));
         float finalGammaValue = user_gamma_value;
 
         if (user_gamma_value > gammaMax) {
             finalGammaValue = gammaMax;
-            std::cout << "[ NOTE ] Selected gamma value exceeds maximum, setting to max allowable: " << finalGammaValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gamma value exceeds maximum, setting to max allowable: ", finalGammaValue);
         } else if (user_gamma_value < gammaMin) {
             finalGammaValue = gammaMin;
-            std::cout << "[ NOTE ] Selected gamma value is below minimum, setting to min allowable: " << finalGammaValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected gamma value is below minimum, setting to min allowable: ", finalGammaValue);
         }
 
-        ptrGamma->SetValue(finalGammaValue);
-        std::cout << "Gamma correction set to " << finalGammaValue << std::endl;
+        backend->SetFloatValue("Gamma", finalGammaValue);
+        SPIN_LOG_INFO("Gamma correction set to ", finalGammaValue);
     } else {
-        std::cout << "[ WARNING ] Gamma correction setting not available" << std::endl;
+        SPIN_LOG_WARNING("Gamma correction setting not available");
     }
 }
 
@@ -1310,92 +1691,87 @@ void SpinCamera::SetBlackLevel(SpinOption::BlackLevel user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Get the selected black level value from the map
     auto option = BlackLevel_legal.find(user_option);
     if (option == BlackLevel_legal.end()) {
-        std::cout << "[ WARNING ] Invalid black level option." << std::endl;
+        SPIN_LOG_WARNING("Invalid black level option.");
         return;
     }
     const float& blackLevelValue = option->second;
 
     // Apply user-selected black level correction
-    CFloatPtr ptrBlackLevel = nodeMap->GetNode("BlackLevel");
-    if (IsAvailable(ptrBlackLevel) && IsWritable(ptrBlackLevel)) {
-        const float blackLevelMax = static_cast<float>(ptrBlackLevel->GetMax());
-        const float blackLevelMin = static_cast<float>(ptrBlackLevel->GetMin());
+    if (backend->IsWritable("BlackLevel")) {
+        const float blackLevelMax = static_cast<float>(backend->GetFloatMax("BlackLevel"));
+        const float blackLevelMin = static_cast<float>(backend->GetFloatMin("BlackLevel"));
         float finalBlackLevelValue = blackLevelValue;
 
         if (blackLevelValue > blackLevelMax) {
             finalBlackLevelValue = blackLevelMax;
-            std::cout << "[ NOTE ] Selected black level value exceeds maximum, setting to max allowable: " << finalBlackLevelValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected black level value exceeds maximum, setting to max allowable: ", finalBlackLevelValue);
         } else if (blackLevelValue < blackLevelMin) {
             finalBlackLevelValue = blackLevelMin;
-            std::cout << "[ NOTE ] Selected black level value is below minimum, setting to min allowable: " << finalBlackLevelValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected black level value is below minimum, setting to min allowable: ", finalBlackLevelValue);
         }
 
-        ptrBlackLevel->SetValue(finalBlackLevelValue);
-        std::cout << "Black level correction set to " << finalBlackLevelValue << std::endl;
+        backend->SetFloatValue("BlackLevel", finalBlackLevelValue);
+        SPIN_LOG_INFO("Black level correction set to ", finalBlackLevelValue);
     } else {
-        std::cout << "[ WARNING ] Black level correction setting not available" << std::endl;
+        SPIN_LOG_WARNING("Black level correction setting not available");
     }
 }
 
 void SpinCamera::SetBlackLevel(float user_black_level_value) {
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Enable black level
-    CBooleanPtr ptrBlackLevelEnabled = nodeMap->GetNode("BlackLevelEnable");
-    if (IsAvailable(ptrBlackLevelEnabled) && IsWritable(ptrBlackLevelEnabled)) {
-        ptrBlackLevelEnabled->SetValue(true);
-        std::cout << "Black level correction enabled" << std::endl;
+    if (backend->IsWritable("BlackLevelEnable")) {
+        backend->SetBooleanValue("BlackLevelEnable", true);
+        SPIN_LOG_INFO("Black level correction enabled");
     } else {
-        std::cout << "[ WARNING ] Unable to enable black level correction" << std::endl;
+        SPIN_LOG_WARNING("Unable to enable black level correction");
         return;
     }
     
     // Set black level mode to auto or manual based on user option
-    CEnumerationPtr ptrBlackLevelAuto = nodeMap->GetNode("BlackLevelAuto");
-    if (IsReadable(ptrBlackLevelAuto) && IsWritable(ptrBlackLevelAuto)) {
+    if (backend->IsReadable("BlackLevelAuto") && backend->IsWritable("BlackLevelAuto")) {
         // Attempt to disable automatic black level
-        CEnumEntryPtr ptrBlackLevelAutoOff = ptrBlackLevelAuto->GetEntryByName("Off");
-        if (IsReadable(ptrBlackLevelAutoOff)) {
-            ptrBlackLevelAuto->SetIntValue(ptrBlackLevelAutoOff->GetValue());
-            std::cout << "Manual Black Level Enabled (Automatic black level disabled)" << std::endl;
+        if (backend->IsEnumerationEntryReadable("BlackLevelAuto", "Off")) {
+            backend->SetEnumerationValue("BlackLevelAuto", "Off");
+            SPIN_LOG_INFO("Manual Black Level Enabled (Automatic black level disabled)");
         } else {
-            std::cout << "[ WARNING ] Unable to disable automatic black level (enable manual black level)" << std::endl;
+            SPIN_LOG_WARNING("Unable to disable automatic black level (enable manual black level)");
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set black level mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set black level mode");
     }
 
     // Apply user-selected black level correction
-    CFloatPtr ptrBlackLevel = nodeMap->GetNode("BlackLevel");
-    if (IsAvailable(ptrBlackLevel) && IsWritable(ptrBlackLevel)) {
-        const float blackLevelMax = static_cast<float>(ptrBlackLevel->GetMax());
-        const float blackLevelMin = static_cast<float>(ptrBlackLevel->GetMin());
+    if (backend->IsWritable("BlackLevel")) {
+        const float blackLevelMax = static_cast<float>(backend->GetFloatMax("BlackLevel"));
+        const float blackLevelMin = static_cast<float>(backend->GetFloatMin("BlackLevel"));
         float finalBlackLevelValue = user_black_level_value;
 
         if (user_black_level_value > blackLevelMax) {
             finalBlackLevelValue = blackLevelMax;
-            std::cout << "[ NOTE ] Selected black level value exceeds maximum, setting to max allowable: " << finalBlackLevelValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected black level value exceeds maximum, setting to max allowable: ", finalBlackLevelValue);
         } else if (user_black_level_value < blackLevelMin) {
             finalBlackLevelValue = blackLevelMin;
-            std::cout << "[ NOTE ] Selected black level value is below minimum, setting to min allowable: " << finalBlackLevelValue << std::endl;
+            SPIN_LOG_INFO("[ NOTE ] Selected black level value is below minimum, setting to min allowable: ", finalBlackLevelValue);
         }
 
-        ptrBlackLevel->SetValue(finalBlackLevelValue);
-        std::cout << "Black level correction set to " << finalBlackLevelValue << std::endl;
+        backend->SetFloatValue("BlackLevel", finalBlackLevelValue);
+        SPIN_LOG_INFO("Black level correction set to ", finalBlackLevelValue);
     } else {
-        std::cout << "[ WARNING ] Black level correction setting not available" << std::endl;
+        SPIN_LOG_WARNING("Black level correction setting not available");
     }
 }
 
@@ -1419,100 +1795,90 @@ void SpinCamera::SetRedBalanceRatio(SpinOption::RedBalanceRatio user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Set white balance mode to auto or manual based on user option
-    CEnumerationPtr ptrBalanceWhiteAuto = nodeMap->GetNode("BalanceWhiteAuto");
-    if (IsReadable(ptrBalanceWhiteAuto) && IsWritable(ptrBalanceWhiteAuto)) {
+    if (backend->IsReadable("BalanceWhiteAuto") && backend->IsWritable("BalanceWhiteAuto")) {
         if (user_option == SpinOption::RedBalanceRatio::Auto) {
             // Attempt to enable automatic white balance
-            CEnumEntryPtr ptrBalanceWhiteAutoOn = ptrBalanceWhiteAuto->GetEntryByName("Continuous");
-            if (IsReadable(ptrBalanceWhiteAutoOn)) {
-                ptrBalanceWhiteAuto->SetIntValue(ptrBalanceWhiteAutoOn->GetValue());
-                std::cout << "Auto White Balance Enabled" << std::endl;
+            if (backend->IsEnumerationEntryReadable("BalanceWhiteAuto", "Continuous")) {
+                backend->SetEnumerationValue("BalanceWhiteAuto", "Continuous");
+                SPIN_LOG_INFO("Auto White Balance Enabled");
             } else {
-                std::cout << "[ WARNING ] Unable to enable automatic white balance" << std::endl;
+                SPIN_LOG_WARNING("Unable to enable automatic white balance");
             }
             return;
         } else {
             // Attempt to disable automatic white balance
-            CEnumEntryPtr ptrBalanceWhiteAutoOff = ptrBalanceWhiteAuto->GetEntryByName("Off");
-            if (IsReadable(ptrBalanceWhiteAutoOff)) {
-                ptrBalanceWhiteAuto->SetIntValue(ptrBalanceWhiteAutoOff->GetValue());
-                std::cout << "Manual White Balance Enabled (Automatic white balance disabled)" << std::endl;
+            if (backend->IsEnumerationEntryReadable("BalanceWhiteAuto", "Off")) {
+                backend->SetEnumerationValue("BalanceWhiteAuto", "Off");
+                SPIN_LOG_INFO("Manual White Balance Enabled (Automatic white balance disabled)");
             } else {
-                std::cout << "[ WARNING ] Unable to disable automatic white balance (enable manual white balance)" << std::endl;
+                SPIN_LOG_WARNING("Unable to disable automatic white balance (enable manual white balance)");
             }
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set white balance mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set white balance mode");
     }
 
     // Set balance ratio selector to red
-    CEnumerationPtr ptrBalanceRatioSelector = nodeMap->GetNode("BalanceRatioSelector");
-    if (IsWritable(ptrBalanceRatioSelector)) {
-        CEnumEntryPtr ptrRed = ptrBalanceRatioSelector->GetEntryByName("Red");
-        if (IsReadable(ptrRed)) {
-            ptrBalanceRatioSelector->SetIntValue(ptrRed->GetValue());
+    if (backend->IsWritable("BalanceRatioSelector")) {
+        if (backend->IsEnumerationEntryReadable("BalanceRatioSelector", "Red")) {
+            backend->SetEnumerationValue("BalanceRatioSelector", "Red");
         } else {
-            std::cout << "[ WARNING ] Unable to find or access BalanceRatioSelector Red" << std::endl;
+            SPIN_LOG_WARNING("Unable to find or access BalanceRatioSelector Red");
             return;
         }
 
         // Get the selected red balance ratio value from the map
         auto option = RedBalanceRatio_legal.find(user_option);
         if (option == RedBalanceRatio_legal.end()) {
-            std::cout << "[ WARNING ] Invalid red balance ratio option." << std::endl;
+            SPIN_LOG_WARNING("Invalid red balance ratio option.");
             return;
         }
         const float& redBalanceValue = option->second;
 
         // Apply user-selected red balance ratio
-        CFloatPtr ptrRedBalance = nodeMap->GetNode("BalanceRatio");
-        if (IsAvailable(ptrRedBalance) && IsWritable(ptrRedBalance)) {
-            ptrRedBalance->SetValue(redBalanceValue);
-            std::cout << "Red balance ratio set to " << redBalanceValue << std::endl;
+        if (backend->IsWritable("BalanceRatio")) {
+            backend->SetFloatValue("BalanceRatio", redBalanceValue);
+            SPIN_LOG_INFO("Red balance ratio set to ", redBalanceValue);
         } else {
-            std::cout << "[ WARNING ] Red balance ratio setting not available" << std::endl;
+            SPIN_LOG_WARNING("Red balance ratio setting not available");
         }
     } else {
-        std::cout << "[ WARNING ] BalanceRatioSelector not available" << std::endl;
+        SPIN_LOG_WARNING("BalanceRatioSelector not available");
     }
 }
 
 void SpinCamera::SetRedBalanceRatio(float user_option) {
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Ensure automatic white balance is off to allow manual setting
-    CEnumerationPtr ptrBalanceWhiteAuto = nodeMap->GetNode("BalanceWhiteAuto");
-    if (IsReadable(ptrBalanceWhiteAuto) && IsWritable(ptrBalanceWhiteAuto)) {
+    if (backend->IsReadable("BalanceWhiteAuto") && backend->IsWritable("BalanceWhiteAuto")) {
         // Attempt to disable automatic white balance
-        CEnumEntryPtr ptrBalanceWhiteAutoOff = ptrBalanceWhiteAuto->GetEntryByName("Off");
-        if (IsReadable(ptrBalanceWhiteAutoOff)) {
-            ptrBalanceWhiteAuto->SetIntValue(ptrBalanceWhiteAutoOff->GetValue());
-            std::cout << "Manual White Balance Enabled (Automatic white balance disabled)" << std::endl;
+        if (backend->IsEnumerationEntryReadable("BalanceWhiteAuto", "Off")) {
+            backend->SetEnumerationValue("BalanceWhiteAuto", "Off");
+            SPIN_LOG_INFO("Manual White Balance Enabled (Automatic white balance disabled)");
         } else {
-            std::cout << "[ WARNING ] Unable to disable automatic white balance (enable manual white balance)" << std::endl;
+            SPIN_LOG_WARNING("Unable to disable automatic white balance (enable manual white balance)");
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set white balance mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set white balance mode");
     }
 
     // Set balance ratio selector to red
-    CEnumerationPtr ptrBalanceRatioSelector = nodeMap->GetNode("BalanceRatioSelector");
-    if (IsWritable(ptrBalanceRatioSelector)) {
-        CEnumEntryPtr ptrRed = ptrBalanceRatioSelector->GetEntryByName("Red");
-        if (IsReadable(ptrRed)) {
-            ptrBalanceRatioSelector->SetIntValue(ptrRed->GetValue());
+    if (backend->IsWritable("BalanceRatioSelector")) {
+        if (backend->IsEnumerationEntryReadable("BalanceRatioSelector", "Red")) {
+            backend->SetEnumerationValue("BalanceRatioSelector", "Red");
         } else {
-            std::cout << "[ WARNING ] Unable to find or access BalanceRatioSelector Red" << std::endl;
+            SPIN_LOG_WARNING("Unable to find or access BalanceRatioSelector Red");
             return;
         }
 
@@ -1520,15 +1886,14 @@ void SpinCamera::SetRedBalanceRatio(float user_option) {
         const float& redBalanceValue = user_option;
 
         // Apply user-selected red balance ratio
-        CFloatPtr ptrRedBalance = nodeMap->GetNode("BalanceRatio");
-        if (IsAvailable(ptrRedBalance) && IsWritable(ptrRedBalance)) {
-            ptrRedBalance->SetValue(redBalanceValue);
-            std::cout << "Red balance ratio set to " << redBalanceValue << std::endl;
+        if (backend->IsWritable("BalanceRatio")) {
+            backend->SetFloatValue("BalanceRatio", redBalanceValue);
+            SPIN_LOG_INFO("Red balance ratio set to ", redBalanceValue);
         } else {
-            std::cout << "[ WARNING ] Red balance ratio setting not available" << std::endl;
+            SPIN_LOG_WARNING("Red balance ratio setting not available");
         }
     } else {
-        std::cout << "[ WARNING ] BalanceRatioSelector not available" << std::endl;
+        SPIN_LOG_WARNING("BalanceRatioSelector not available");
     }
 }
 
@@ -1552,101 +1917,91 @@ void SpinCamera::SetBlueBalanceRatio(SpinOption::BlueBalanceRatio user_option) {
     };
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Set white balance mode to auto or manual based on user option
-    CEnumerationPtr ptrBalanceWhiteAuto = nodeMap->GetNode("BalanceWhiteAuto");
-    if (IsReadable(ptrBalanceWhiteAuto) && IsWritable(ptrBalanceWhiteAuto)) {
+    if (backend->IsReadable("BalanceWhiteAuto") && backend->IsWritable("BalanceWhiteAuto")) {
         if (user_option == SpinOption::BlueBalanceRatio::Auto) {
             // Attempt to enable automatic white balance
-            CEnumEntryPtr ptrBalanceWhiteAutoOn = ptrBalanceWhiteAuto->GetEntryByName("Continuous");
-            if (IsReadable(ptrBalanceWhiteAutoOn)) {
-                ptrBalanceWhiteAuto->SetIntValue(ptrBalanceWhiteAutoOn->GetValue());
-                std::cout << "Auto White Balance Enabled" << std::endl;
+            if (backend->IsEnumerationEntryReadable("BalanceWhiteAuto", "Continuous")) {
+                backend->SetEnumerationValue("BalanceWhiteAuto", "Continuous");
+                SPIN_LOG_INFO("Auto White Balance Enabled");
             } else {
-                std::cout << "[ WARNING ] Unable to enable automatic white balance" << std::endl;
+                SPIN_LOG_WARNING("Unable to enable automatic white balance");
             }
             return;
         } else {
             // Attempt to disable automatic white balance
-            CEnumEntryPtr ptrBalanceWhiteAutoOff = ptrBalanceWhiteAuto->GetEntryByName("Off");
-            if (IsReadable(ptrBalanceWhiteAutoOff)) {
-                ptrBalanceWhiteAuto->SetIntValue(ptrBalanceWhiteAutoOff->GetValue());
-                std::cout << "Manual White Balance Enabled (Automatic white balance disabled)" << std::endl;
+            if (backend->IsEnumerationEntryReadable("BalanceWhiteAuto", "Off")) {
+                backend->SetEnumerationValue("BalanceWhiteAuto", "Off");
+                SPIN_LOG_INFO("Manual White Balance Enabled (Automatic white balance disabled)");
             } else {
-                std::cout << "[ WARNING ] Unable to disable automatic white balance (enable manual white balance)" << std::endl;
+                SPIN_LOG_WARNING("Unable to disable automatic white balance (enable manual white balance)");
             }
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set white balance mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set white balance mode");
     }
 
     // Set balance ratio selector to blue
-    CEnumerationPtr ptrBalanceRatioSelector = nodeMap->GetNode("BalanceRatioSelector");
-    if (IsWritable(ptrBalanceRatioSelector)) {
-        CEnumEntryPtr ptrBlue = ptrBalanceRatioSelector->GetEntryByName("Blue");
-        if (IsReadable(ptrBlue)) {
-            ptrBalanceRatioSelector->SetIntValue(ptrBlue->GetValue());
+    if (backend->IsWritable("BalanceRatioSelector")) {
+        if (backend->IsEnumerationEntryReadable("BalanceRatioSelector", "Blue")) {
+            backend->SetEnumerationValue("BalanceRatioSelector", "Blue");
         } else {
-            std::cout << "[ WARNING ] Unable to find or access BalanceRatioSelector Blue" << std::endl;
+            SPIN_LOG_WARNING("Unable to find or access BalanceRatioSelector Blue");
             return;
         }
 
         // Get the selected blue balance ratio value from the map
         auto option = BlueBalanceRatio_legal.find(user_option);
         if (option == BlueBalanceRatio_legal.end()) {
-            std::cout << "[ WARNING ] Invalid blue balance ratio option." << std::endl;
+            SPIN_LOG_WARNING("Invalid blue balance ratio option.");
             return;
         }
         const float& blueBalanceValue = option->second;
 
         // Apply user-selected blue balance ratio
-        CFloatPtr ptrBlueBalance = nodeMap->GetNode("BalanceRatio");
-        if (IsAvailable(ptrBlueBalance) && IsWritable(ptrBlueBalance)) {
-            ptrBlueBalance->SetValue(blueBalanceValue);
-            std::cout << "Blue balance ratio set to " << blueBalanceValue << std::endl;
+        if (backend->IsWritable("BalanceRatio")) {
+            backend->SetFloatValue("BalanceRatio", blueBalanceValue);
+            SPIN_LOG_INFO("Blue balance ratio set to ", blueBalanceValue);
         } else {
-            std::cout << "[ WARNING ] Blue balance ratio setting not available" << std::endl;
+            SPIN_LOG_WARNING("Blue balance ratio setting not available");
         }
     } else {
-        std::cout << "[ WARNING ] BalanceRatioSelector not available" << std::endl;
+        SPIN_LOG_WARNING("BalanceRatioSelector not available");
     }
 }
 
 void SpinCamera::SetBlueBalanceRatio(float user_option) {
 
     // Ensure nodemap exists
-    if (!nodeMap) {
-        std::cout << "[ WARNING ] Node map is not initialized." << std::endl;
+    if (!backend) {
+        SPIN_LOG_WARNING("Node map is not initialized.");
         return;
     }
 
     // Ensure automatic white balance is off to allow manual setting
-    CEnumerationPtr ptrBalanceWhiteAuto = nodeMap->GetNode("BalanceWhiteAuto");
-    if (IsReadable(ptrBalanceWhiteAuto) && IsWritable(ptrBalanceWhiteAuto)) {
+    if (backend->IsReadable("BalanceWhiteAuto") && backend->IsWritable("BalanceWhiteAuto")) {
         // Attempt to disable automatic white balance
-        CEnumEntryPtr ptrBalanceWhiteAutoOff = ptrBalanceWhiteAuto->GetEntryByName("Off");
-        if (IsReadable(ptrBalanceWhiteAutoOff)) {
-            ptrBalanceWhiteAuto->SetIntValue(ptrBalanceWhiteAutoOff->GetValue());
-            std::cout << "Manual White Balance Enabled (Automatic white balance disabled)" << std::endl;
+        if (backend->IsEnumerationEntryReadable("BalanceWhiteAuto", "Off")) {
+            backend->SetEnumerationValue("BalanceWhiteAuto", "Off");
+            SPIN_LOG_INFO("Manual White Balance Enabled (Automatic white balance disabled)");
         } else {
-            std::cout << "[ WARNING ] Unable to disable automatic white balance (enable manual white balance)" << std::endl;
+            SPIN_LOG_WARNING("Unable to disable automatic white balance (enable manual white balance)");
         }
     } else {
-        std::cout << "[ WARNING ] Unable to set white balance mode" << std::endl;
+        SPIN_LOG_WARNING("Unable to set white balance mode");
     }
 
     // Set balance ratio selector to blue
-    CEnumerationPtr ptrBalanceRatioSelector = nodeMap->GetNode("BalanceRatioSelector");
-    if (IsWritable(ptrBalanceRatioSelector)) {
-        CEnumEntryPtr ptrBlue = ptrBalanceRatioSelector->GetEntryByName("Blue");
-        if (IsReadable(ptrBlue)) {
-            ptrBalanceRatioSelector->SetIntValue(ptrBlue->GetValue());
+    if (backend->IsWritable("BalanceRatioSelector")) {
+        if (backend->IsEnumerationEntryReadable("BalanceRatioSelector", "Blue")) {
+            backend->SetEnumerationValue("BalanceRatioSelector", "Blue");
         } else {
-            std::cout << "[ WARNING ] Unable to find or access BalanceRatioSelector Blue" << std::endl;
+            SPIN_LOG_WARNING("Unable to find or access BalanceRatioSelector Blue");
             return;
         }
 
@@ -1654,14 +2009,13 @@ void SpinCamera::SetBlueBalanceRatio(float user_option) {
         const float& blueBalanceValue = user_option;
 
         // Apply user-selected blue balance ratio
-        CFloatPtr ptrBlueBalance = nodeMap->GetNode("BalanceRatio");
-        if (IsAvailable(ptrBlueBalance) && IsWritable(ptrBlueBalance)) {
-            ptrBlueBalance->SetValue(blueBalanceValue);
-            std::cout << "Blue balance ratio set to " << blueBalanceValue << std::endl;
+        if (backend->IsWritable("BalanceRatio")) {
+            backend->SetFloatValue("BalanceRatio", blueBalanceValue);
+            SPIN_LOG_INFO("Blue balance ratio set to ", blueBalanceValue);
         } else {
-            std::cout << "[ WARNING ] Blue balance ratio setting not available" << std::endl;
+            SPIN_LOG_WARNING("Blue balance ratio setting not available");
         }
     } else {
-        std::cout << "[ WARNING ] BalanceRatioSelector not available" << std::endl;
+        SPIN_LOG_WARNING("BalanceRatioSelector not available");
     }
 }
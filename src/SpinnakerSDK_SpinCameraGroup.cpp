@@ -0,0 +1,190 @@
+#include "../include/SpinnakerSDK_SpinCameraGroup.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+SpinCameraGroup::SpinCameraGroup(size_t threadCount) : threadCount(threadCount) {}
+
+SpinCameraGroup::~SpinCameraGroup() {
+    // A camera failing to shut down must not take the process with it
+    try {
+        Shutdown();
+    } catch (const std::exception& e) {
+        SPIN_LOG_ERROR("Failed to shut down the camera group: ", e.what());
+    }
+}
+
+void SpinCameraGroup::AddCamera(int camera_index) {
+    Member member;
+    member.name = "index " + std::to_string(camera_index);
+    member.cameraIndex = camera_index;
+    members.push_back(std::move(member));
+}
+
+void SpinCameraGroup::AddCamera(const std::string& serial_number) {
+    Member member;
+    member.name = serial_number;
+    member.serialNumber = serial_number;
+    members.push_back(std::move(member));
+}
+
+void SpinCameraGroup::AddCamera(std::unique_ptr<SpinCameraBackend> camera_backend) {
+    if (!camera_backend) throw std::runtime_error("[ ERROR ] No camera backend given.");
+    Member member;
+    member.name = "backend " + std::to_string(members.size());
+    member.backend = std::move(camera_backend);
+    member.ownBackend = true;
+    members.push_back(std::move(member));
+}
+
+SpinThreadPool& SpinCameraGroup::GetPool() {
+    // Created on first use, when the number of cameras is known
+    if (!pool) {
+        pool.reset(new SpinThreadPool(threadCount > 0 ? threadCount : std::max<size_t>(members.size(), 1)));
+    }
+    return *pool;
+}
+
+std::vector<SpinCameraGroupResult> SpinCameraGroup::Initialize(std::function<void(SpinCamera&)> configure) {
+    std::vector<SpinCameraGroupResult> results(members.size());
+
+    GetPool().ParallelFor(members.size(), [this, &results, &configure](size_t i) {
+        Member& member = members[i];
+        SpinCameraGroupResult& result = results[i];
+        result.camera = member.name;
+        if (member.ready) {
+            result.success = true;
+            return;
+        }
+
+        try {
+            // Open the camera
+            auto initStart = std::chrono::steady_clock::now();
+            member.camera.reset(new SpinCamera());
+            if (member.backend) {
+                member.camera->Initialize(std::move(member.backend));
+            } else if (!member.serialNumber.empty()) {
+                member.camera->Initialize(member.serialNumber);
+            } else {
+                member.camera->Initialize(member.cameraIndex);
+            }
+            result.initTimeMs = MillisecondsSince(initStart);
+
+            // Name the camera by its serial number from now on
+            std::string serialNumber = member.camera->GetBackend()->GetSerialNumber();
+            if (!serialNumber.empty()) {
+                result.camera = member.name = serialNumber;
+            }
+
+            // Apply the configuration
+            auto configStart = std::chrono::steady_clock::now();
+            if (configure) {
+                configure(*member.camera);
+            }
+            result.configTimeMs = MillisecondsSince(configStart);
+
+            member.ready = true;
+            result.success = true;
+        } catch (const std::exception& e) {
+            // A member added with a backend gets it back, so Initialize can be retried
+            if (member.ownBackend && member.camera && !member.backend) {
+                try {
+                    member.backend = member.camera->ReleaseBackend();
+                } catch (const std::exception& releaseError) {
+                    SPIN_LOG_WARNING("Camera ", member.name, " failed to release its backend: ", releaseError.what());
+                }
+            }
+            member.camera.reset();
+            result.error = e.what();
+        }
+    });
+    return results;
+}
+
+std::vector<SpinCameraGroupResult> SpinCameraGroup::ForEach(std::function<void(SpinCamera&)> operation) {
+    std::vector<SpinCameraGroupResult> results(members.size());
+
+    GetPool().ParallelFor(members.size(), [this, &results, &operation](size_t i) {
+        Member& member = members[i];
+        SpinCameraGroupResult& result = results[i];
+        result.camera = member.name;
+        if (!member.ready) {
+            result.error = "Camera not initialized";
+            return;
+        }
+
+        try {
+            auto start = std::chrono::steady_clock::now();
+            operation(*member.camera);
+            result.configTimeMs = MillisecondsSince(start);
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+    });
+    return results;
+}
+
+void SpinCameraGroup::Shutdown() {
+    if (members.empty()) {
+        return;
+    }
+    GetPool().ParallelFor(members.size(), [this](size_t i) {
+        Member& member = members[i];
+        member.ready = false;
+        if (member.camera) {
+            // The camera goes even when shutting it down fails
+            std::unique_ptr<SpinCamera> camera = std::move(member.camera);
+            if (member.ownBackend) {
+                member.backend = camera->ReleaseBackend();
+            } else {
+                camera->Shutdown();
+            }
+        }
+    });
+}
+
+size_t SpinCameraGroup::Size() const {
+    return members.size();
+}
+
+bool SpinCameraGroup::IsReady(size_t index) const {
+    return index < members.size() && members[index].ready;
+}
+
+SpinCamera& SpinCameraGroup::GetCamera(size_t index) {
+    if (!IsReady(index)) throw std::runtime_error("[ ERROR ] Camera " + std::to_string(index) + " of the group is not initialized");
+    return *members[index].camera;
+}
+
+SpinCamera& SpinCameraGroup::operator[](size_t index) {
+    return GetCamera(index);
+}
+
+void SpinCameraGroup::PrintResults(const std::vector<SpinCameraGroupResult>& results) {
+    SpinLogger::Instance().BeginReport();
+    std::ios::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+
+    std::cout << "===== Camera Group =====" << std::endl;
+    for (const SpinCameraGroupResult& result : results) {
+        std::cout << std::left << std::setw(16) << result.camera << std::right;
+        if (result.success) {
+            std::cout << " init " << std::fixed << std::setprecision(1) << result.initTimeMs << " ms, config " << result.configTimeMs << " ms" << std::endl;
+        } else {
+            std::cout << " [ ERROR ] " << result.error << std::endl;
+        }
+    }
+    std::cout << "========================" << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
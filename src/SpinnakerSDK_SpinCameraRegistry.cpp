@@ -0,0 +1,129 @@
+#include "../include/SpinnakerSDK_SpinCameraRegistry.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <iostream>
+#include <stdexcept>
+
+using namespace Spinnaker;
+using namespace GenApi;
+
+SpinCameraRegistry& SpinCameraRegistry::Instance() {
+    static SpinCameraRegistry registry;
+    return registry;
+}
+
+SpinCameraRegistry::~SpinCameraRegistry() {
+    // Cameras still open (e.g. owned by static objects destroyed after the registry) need the system, so it is left alone
+    if (!openCameras.empty()) {
+        SPIN_LOG_WARNING("Spinnaker system not released, ", openCameras.size(), " cameras still open at exit.");
+        return;
+    }
+    // Listing cameras without ever opening one keeps the system alive until exit, a destructor must not throw though
+    try {
+        ReleaseSystemIfUnused();
+    } catch (const std::exception& e) {
+        SPIN_LOG_ERROR("Failed to release the Spinnaker system: ", e.what());
+    }
+}
+
+void SpinCameraRegistry::Enumerate() {
+    if (!system) {
+        system = System::GetInstance();
+    }
+    camList = system->GetCameras();
+
+    // Cache every camera by its serial number
+    serialNumbers.clear();
+    cameras.clear();
+    for (unsigned int i = 0; i < camList.GetSize(); ++i) {
+        CameraPtr pCam = camList.GetByIndex(i);
+        CStringPtr ptrSerialNumber = pCam->GetTLDeviceNodeMap().GetNode("DeviceSerialNumber");
+        std::string serialNumber = IsReadable(ptrSerialNumber) ? std::string(ptrSerialNumber->GetValue().c_str()) : "";
+        if (serialNumber.empty()) {
+            // Without a serial number the camera can still be opened by index
+            serialNumber = "index:" + std::to_string(i);
+        }
+        serialNumbers.push_back(serialNumber);
+        cameras[serialNumber] = pCam;
+    }
+    enumerated = true;
+}
+
+Spinnaker::CameraPtr SpinCameraRegistry::Open(const std::string& serial_number) {
+    auto found = cameras.find(serial_number);
+    if (found == cameras.end()) {
+        throw std::runtime_error("[ ERROR ] No camera with serial number " + serial_number + " found.");
+    }
+    if (openCameras.count(serial_number) > 0) {
+        throw std::runtime_error("[ ERROR ] Camera " + serial_number + " is already open.");
+    }
+    openCameras.insert(serial_number);
+    return found->second;
+}
+
+void SpinCameraRegistry::ReleaseSystemIfUnused() {
+    if (!openCameras.empty()) {
+        return;
+    }
+    // Every CameraPtr must be gone before the system instance is released
+    cameras.clear();
+    serialNumbers.clear();
+    camList.Clear();
+    enumerated = false;
+    if (system) {
+        system->ReleaseInstance();
+        system = nullptr;
+    }
+}
+
+Spinnaker::CameraPtr SpinCameraRegistry::OpenCamera(int camera_index, std::string& serial_number) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enumerated) {
+        Enumerate();
+    }
+    if (serialNumbers.empty()) {
+        throw std::runtime_error("[ ERROR ] No cameras found.");
+    }
+    if (camera_index < 0 || camera_index >= static_cast<int>(serialNumbers.size())) {
+        throw std::runtime_error("[ ERROR ] Camera index " + std::to_string(camera_index) + " out of range, " + std::to_string(serialNumbers.size()) + " cameras found.");
+    }
+    serial_number = serialNumbers[camera_index];
+    return Open(serial_number);
+}
+
+Spinnaker::CameraPtr SpinCameraRegistry::OpenCamera(const std::string& serial_number) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enumerated) {
+        Enumerate();
+    }
+    // The camera may have been plugged in since the last enumeration
+    if (cameras.find(serial_number) == cameras.end()) {
+        Enumerate();
+    }
+    return Open(serial_number);
+}
+
+void SpinCameraRegistry::CloseCamera(const std::string& serial_number) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (openCameras.erase(serial_number) == 0) {
+        SPIN_LOG_WARNING("Camera ", serial_number, " was not open.");
+        return;
+    }
+    ReleaseSystemIfUnused();
+}
+
+std::vector<std::string> SpinCameraRegistry::GetSerialNumbers() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enumerated) {
+        Enumerate();
+    }
+    return serialNumbers;
+}
+
+size_t SpinCameraRegistry::GetCameraCount() {
+    return GetSerialNumbers().size();
+}
+
+void SpinCameraRegistry::Refresh() {
+    std::lock_guard<std::mutex> lock(mutex);
+    Enumerate();
+}
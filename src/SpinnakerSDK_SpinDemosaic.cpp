@@ -0,0 +1,617 @@
+#include "../include/SpinnakerSDK_SpinDemosaic.h"
+#include "../include/SpinnakerSDK_SpinThreadPool.h"
+#include "../include/SpinnakerSDK_SpinUnpack.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SPIN_DEMOSAIC_SSE2 1
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SPIN_DEMOSAIC_AVX2 1  // Compiled for AVX2 function by function, used only when the CPU has it
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SPIN_DEMOSAIC_NEON 1
+#endif
+
+namespace {
+    const int kMaxTaps = 25;
+    const int kLanes = 16;
+    const size_t kBandCacheBytes = 256 * 1024;
+
+    // Taps of one output channel along a row, weights in sixteenths
+    // Even and odd columns are different colour sites, so every tap has two weights. They alternate across the lanes of
+    // a vector, which only ever starts on an even column.
+    struct RowFilter {
+        int tapCount = 0;
+        int dy[kMaxTaps];
+        int dx[kMaxTaps];
+        alignas(32) int16_t weights[kMaxTaps][kLanes];
+    };
+
+    struct FilterSet {
+        RowFilter rows[2][3];  // [row parity][R, G, B]
+    };
+
+    // Colour sites of the RGGB pattern, 2 * (y & 1) + (x & 1)
+    enum Site { RedSite, GreenRedRowSite, GreenBlueRowSite, BlueSite };
+
+    class KernelBuilder {
+    public:
+        int weights[4][3][5][5] = {};  // [site][channel][dy + 2][dx + 2]
+
+        void Add(int site, int channel, int dy, int dx, int weight) {
+            weights[site][channel][dy + 2][dx + 2] += weight;
+        }
+        void Horizontal(int site, int channel, int distance, int weight) {
+            Add(site, channel, 0, -distance, weight);
+            Add(site, channel, 0, distance, weight);
+        }
+        void Vertical(int site, int channel, int distance, int weight) {
+            Add(site, channel, -distance, 0, weight);
+            Add(site, channel, distance, 0, weight);
+        }
+        void Cross(int site, int channel, int distance, int weight) {
+            Horizontal(site, channel, distance, weight);
+            Vertical(site, channel, distance, weight);
+        }
+        void Diagonal(int site, int channel, int weight) {
+            Add(site, channel, -1, -1, weight);
+            Add(site, channel, -1, 1, weight);
+            Add(site, channel, 1, -1, weight);
+            Add(site, channel, 1, 1, weight);
+        }
+    };
+
+    FilterSet BuildFilters(SpinDemosaicing::Method method) {
+        KernelBuilder k;
+        // Every site keeps its own colour
+        k.Add(RedSite, 0, 0, 0, 16);
+        k.Add(GreenRedRowSite, 1, 0, 0, 16);
+        k.Add(GreenBlueRowSite, 1, 0, 0, 16);
+        k.Add(BlueSite, 2, 0, 0, 16);
+
+        if (method == SpinDemosaicing::Method::Bilinear) {
+            k.Cross(RedSite, 1, 1, 4);
+            k.Diagonal(RedSite, 2, 4);
+            k.Horizontal(GreenRedRowSite, 0, 1, 8);
+            k.Vertical(GreenRedRowSite, 2, 1, 8);
+            k.Vertical(GreenBlueRowSite, 0, 1, 8);
+            k.Horizontal(GreenBlueRowSite, 2, 1, 8);
+            k.Diagonal(BlueSite, 0, 4);
+            k.Cross(BlueSite, 1, 1, 4);
+        } else {
+            // Malvar, He and Cutler, "High-quality linear interpolation for demosaicing of Bayer-patterned color images" (2004)
+            for (int site : {RedSite, BlueSite}) {
+                // Green at red and blue
+                k.Add(site, 1, 0, 0, 8);
+                k.Cross(site, 1, 1, 4);
+                k.Cross(site, 1, 2, -2);
+                // The opposite colour sits on the diagonals
+                const int opposite = site == RedSite ? 2 : 0;
+                k.Add(site, opposite, 0, 0, 12);
+                k.Diagonal(site, opposite, 4);
+                k.Cross(site, opposite, 2, -3);
+            }
+            // At green sites one colour is left and right, the other above and below
+            const int greenChannels[2][2] = {{0, 2}, {2, 0}};  // [site - GreenRedRowSite][along the row, along the column]
+            for (int site : {GreenRedRowSite, GreenBlueRowSite}) {
+                const int alongRow = greenChannels[site - GreenRedRowSite][0];
+                const int alongColumn = greenChannels[site - GreenRedRowSite][1];
+                k.Add(site, alongRow, 0, 0, 10);
+                k.Horizontal(site, alongRow, 1, 8);
+                k.Horizontal(site, alongRow, 2, -2);
+                k.Diagonal(site, alongRow, -2);
+                k.Vertical(site, alongRow, 2, 1);
+                k.Add(site, alongColumn, 0, 0, 10);
+                k.Vertical(site, alongColumn, 1, 8);
+                k.Vertical(site, alongColumn, 2, -2);
+                k.Diagonal(site, alongColumn, -2);
+                k.Horizontal(site, alongColumn, 2, 1);
+            }
+        }
+
+        FilterSet filters;
+        for (int parity = 0; parity < 2; ++parity) {
+            for (int channel = 0; channel < 3; ++channel) {
+                RowFilter& filter = filters.rows[parity][channel];
+                const int (*even)[5] = k.weights[2 * parity][channel];
+                const int (*odd)[5] = k.weights[2 * parity + 1][channel];
+                for (int dy = -2; dy <= 2; ++dy) {
+                    for (int dx = -2; dx <= 2; ++dx) {
+                        if (even[dy + 2][dx + 2] == 0 && odd[dy + 2][dx + 2] == 0) {
+                            continue;
+                        }
+                        const int tap = filter.tapCount++;
+                        filter.dy[tap] = dy;
+                        filter.dx[tap] = dx;
+                        for (int lane = 0; lane < kLanes; ++lane) {
+                            filter.weights[tap][lane] = static_cast<int16_t>((lane & 1) ? odd[dy + 2][dx + 2] : even[dy + 2][dx + 2]);
+                        }
+                    }
+                }
+            }
+        }
+        return filters;
+    }
+
+    const FilterSet& GetFilters(SpinDemosaicing::Method method) {
+        static const FilterSet bilinear = BuildFilters(SpinDemosaicing::Method::Bilinear);
+        static const FilterSet malvarHeCutler = BuildFilters(SpinDemosaicing::Method::MalvarHeCutler);
+        return method == SpinDemosaicing::Method::MalvarHeCutler ? malvarHeCutler : bilinear;
+    }
+
+    // Mirror around the first and last sample, which keeps the colour of the site
+    inline int Reflect(int i, int size) {
+        if (i < 0) {
+            i = -i;
+        }
+        if (i >= size) {
+            i = 2 * size - 2 - i;
+        }
+        return std::min(std::max(i, 0), size - 1);
+    }
+
+    // One pixel, the reference every SIMD path has to match
+    inline void PixelScalar(const RowFilter* filters, const unsigned char* const* rows, int x, int width, unsigned char* out) {
+        const int lane = x & 1;
+        const bool interior = x >= 2 && x + 2 < width;
+        for (int channel = 0; channel < 3; ++channel) {
+            const RowFilter& filter = filters[channel];
+            int sum = 8;
+            for (int tap = 0; tap < filter.tapCount; ++tap) {
+                const int column = interior ? x + filter.dx[tap] : Reflect(x + filter.dx[tap], width);
+                sum += filter.weights[tap][lane] * rows[filter.dy[tap] + 2][column];
+            }
+            out[channel] = static_cast<unsigned char>(std::min(std::max(sum >> 4, 0), 255));
+        }
+    }
+
+    // The SIMD rows take an even x and stop before end, which leaves room for the two columns they read past a vector.
+    // They return the first column they did not do.
+#ifdef SPIN_DEMOSAIC_SSE2
+    int RowSSE2(const RowFilter* filters, const unsigned char* const* rows, int x, int end, unsigned char* out) {
+        alignas(16) unsigned char planes[3][16];
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i rounding = _mm_set1_epi16(8);
+        for (; x + 16 <= end; x += 16, out += 48) {
+            for (int channel = 0; channel < 3; ++channel) {
+                const RowFilter& filter = filters[channel];
+                __m128i low = rounding;
+                __m128i high = rounding;
+                for (int tap = 0; tap < filter.tapCount; ++tap) {
+                    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[filter.dy[tap] + 2] + x + filter.dx[tap]));
+                    const __m128i weights = _mm_load_si128(reinterpret_cast<const __m128i*>(filter.weights[tap]));
+                    low = _mm_add_epi16(low, _mm_mullo_epi16(_mm_unpacklo_epi8(samples, zero), weights));
+                    high = _mm_add_epi16(high, _mm_mullo_epi16(_mm_unpackhi_epi8(samples, zero), weights));
+                }
+                _mm_store_si128(reinterpret_cast<__m128i*>(planes[channel]), _mm_packus_epi16(_mm_srai_epi16(low, 4), _mm_srai_epi16(high, 4)));
+            }
+            // SSE2 has no byte shuffle, interleave by hand
+            for (int i = 0; i < 16; ++i) {
+                out[3 * i] = planes[0][i];
+                out[3 * i + 1] = planes[1][i];
+                out[3 * i + 2] = planes[2][i];
+            }
+        }
+        return x;
+    }
+#endif
+
+#ifdef SPIN_DEMOSAIC_AVX2
+    // pshufb masks interleaving 16 R, G and B bytes into 48 RGB bytes, [output block][channel]
+    struct InterleaveMasks {
+        alignas(16) unsigned char masks[3][3][16];
+        InterleaveMasks() {
+            for (int block = 0; block < 3; ++block) {
+                for (int channel = 0; channel < 3; ++channel) {
+                    for (int i = 0; i < 16; ++i) {
+                        const int byte = 16 * block + i;
+                        masks[block][channel][i] = byte % 3 == channel ? static_cast<unsigned char>(byte / 3) : 0x80;
+                    }
+                }
+            }
+        }
+    };
+    const InterleaveMasks kInterleave;
+
+    __attribute__((target("avx2"))) int RowAVX2(const RowFilter* filters, const unsigned char* const* rows, int x, int end, unsigned char* out) {
+        const __m256i rounding = _mm256_set1_epi16(8);
+        for (; x + 16 <= end; x += 16, out += 48) {
+            __m128i planes[3];
+            for (int channel = 0; channel < 3; ++channel) {
+                const RowFilter& filter = filters[channel];
+                __m256i sum = rounding;
+                for (int tap = 0; tap < filter.tapCount; ++tap) {
+                    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[filter.dy[tap] + 2] + x + filter.dx[tap]));
+                    const __m256i weights = _mm256_load_si256(reinterpret_cast<const __m256i*>(filter.weights[tap]));
+                    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(_mm256_cvtepu8_epi16(samples), weights));
+                }
+                sum = _mm256_srai_epi16(sum, 4);
+                planes[channel] = _mm_packus_epi16(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            }
+            for (int block = 0; block < 3; ++block) {
+                __m128i rgb = _mm_setzero_si128();
+                for (int channel = 0; channel < 3; ++channel) {
+                    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(kInterleave.masks[block][channel]));
+                    rgb = _mm_or_si128(rgb, _mm_shuffle_epi8(planes[channel], mask));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * block), rgb);
+            }
+        }
+        return x;
+    }
+#endif
+
+#ifdef SPIN_DEMOSAIC_NEON
+    int RowNEON(const RowFilter* filters, const unsigned char* const* rows, int x, int end, unsigned char* out) {
+        for (; x + 8 <= end; x += 8, out += 24) {
+            uint8x8x3_t rgb;
+            for (int channel = 0; channel < 3; ++channel) {
+                const RowFilter& filter = filters[channel];
+                int16x8_t sum = vdupq_n_s16(8);
+                for (int tap = 0; tap < filter.tapCount; ++tap) {
+                    const int16x8_t samples = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(rows[filter.dy[tap] + 2] + x + filter.dx[tap])));
+                    sum = vmlaq_s16(sum, samples, vld1q_s16(filter.weights[tap]));
+                }
+                rgb.val[channel] = vqshrun_n_s16(sum, 4);
+            }
+            vst3_u8(out, rgb);
+        }
+        return x;
+    }
+#endif
+
+    int RowSimd(SpinDemosaicing::Isa isa, const RowFilter* filters, const unsigned char* const* rows, int x, int end, unsigned char* out) {
+        switch (isa) {
+#ifdef SPIN_DEMOSAIC_AVX2
+            case SpinDemosaicing::Isa::AVX2:
+                return RowAVX2(filters, rows, x, end, out);
+#endif
+#ifdef SPIN_DEMOSAIC_SSE2
+            case SpinDemosaicing::Isa::SSE2:
+                return RowSSE2(filters, rows, x, end, out);
+#endif
+#ifdef SPIN_DEMOSAIC_NEON
+            case SpinDemosaicing::Isa::NEON:
+                return RowNEON(filters, rows, x, end, out);
+#endif
+            default:
+                return x;
+        }
+    }
+
+    // One pool per thread count for the whole process, so demosaicing every frame does not start threads
+    SpinThreadPool& GetSharedPool(size_t threadCount) {
+        static std::mutex mutex;
+        static std::map<size_t, std::unique_ptr<SpinThreadPool>> pools;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<SpinThreadPool>& pool = pools[threadCount];
+        if (!pool) {
+            pool.reset(new SpinThreadPool(threadCount));
+        }
+        return *pool;
+    }
+
+    bool IsSupported(SpinDemosaicing::Isa isa) {
+        switch (isa) {
+            case SpinDemosaicing::Isa::Scalar:
+                return true;
+#ifdef SPIN_DEMOSAIC_SSE2
+            case SpinDemosaicing::Isa::SSE2:
+                return true;
+#endif
+#ifdef SPIN_DEMOSAIC_AVX2
+            case SpinDemosaicing::Isa::AVX2:
+                return __builtin_cpu_supports("avx2");
+#endif
+#ifdef SPIN_DEMOSAIC_NEON
+            case SpinDemosaicing::Isa::NEON:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+}
+
+SpinDemosaicing::Isa SpinDemosaicer::ResolveIsa(SpinDemosaicing::Isa isa) {
+    if (isa != SpinDemosaicing::Isa::Auto && IsSupported(isa)) {
+        return isa;
+    }
+    static const SpinDemosaicing::Isa best = [] {
+        for (SpinDemosaicing::Isa candidate : {SpinDemosaicing::Isa::AVX2, SpinDemosaicing::Isa::SSE2, SpinDemosaicing::Isa::NEON}) {
+            if (IsSupported(candidate)) {
+                return candidate;
+            }
+        }
+        return SpinDemosaicing::Isa::Scalar;
+    }();
+    return best;
+}
+
+const char* SpinDemosaicer::GetIsaName(SpinDemosaicing::Isa isa) {
+    switch (isa) {
+        case SpinDemosaicing::Isa::Auto:
+            return "Auto";
+        case SpinDemosaicing::Isa::Scalar:
+            return "Scalar";
+        case SpinDemosaicing::Isa::SSE2:
+            return "SSE2";
+        case SpinDemosaicing::Isa::AVX2:
+            return "AVX2";
+        case SpinDemosaicing::Isa::NEON:
+            return "NEON";
+    }
+    return "Unknown";
+}
+
+int SpinDemosaicer::GetBandRows(int width, const SpinDemosaicOptions& options) {
+    if (options.bandRows > 0) {
+        return options.bandRows;
+    }
+    // One raw and one RGB row per row of the band
+    const size_t rowBytes = static_cast<size_t>(std::max(width, 1)) * 4;
+    return std::max(static_cast<int>(kBandCacheBytes / rowBytes), 8);
+}
+
+namespace {
+    void CheckRegion(const unsigned char* bayer, int width, int height, int x, int y, int regionWidth, int regionHeight, const unsigned char* rgb) {
+        if (!bayer || !rgb || width <= 0 || height <= 0) throw std::runtime_error("[ ERROR ] Invalid image for demosaicing.");
+        if (x < 0 || y < 0 || regionWidth < 0 || regionHeight < 0 || x + regionWidth > width || y + regionHeight > height) {
+            throw std::runtime_error("[ ERROR ] Demosaic region out of range.");
+        }
+    }
+
+    // Rows y0 to y0 + regionHeight - 1, columns x0 to x0 + regionWidth - 1, on the calling thread
+    // bayer holds the frame from row bayerFirstRow on (a band of it when unpacked, with the two rows around it).
+    void DemosaicBlock(const unsigned char* bayer, size_t bayerStride, int width, int height, int x0, int y0, int regionWidth, int regionHeight,
+                       unsigned char* rgb, size_t rgbStride, const SpinDemosaicOptions& options, int bayerFirstRow = 0) {
+        if (bayerStride == 0) {
+            bayerStride = static_cast<size_t>(width);
+        }
+        if (rgbStride == 0) {
+            rgbStride = static_cast<size_t>(regionWidth) * 3;
+        }
+
+        const FilterSet& filters = GetFilters(options.method);
+        const SpinDemosaicing::Isa isa = SpinDemosaicer::ResolveIsa(options.isa);
+        const int x1 = x0 + regionWidth;
+        for (int y = y0; y < y0 + regionHeight; ++y) {
+            const unsigned char* rows[5];
+            for (int i = 0; i < 5; ++i) {
+                rows[i] = bayer + static_cast<size_t>(Reflect(y + i - 2, height) - bayerFirstRow) * bayerStride;
+            }
+            const RowFilter* rowFilters = filters.rows[y & 1];
+            unsigned char* out = rgb + static_cast<size_t>(y - y0) * rgbStride;
+
+            // Mirrored borders and an odd first column on the scalar path, everything in between in vectors
+            int x = x0;
+            for (; x < x1 && (x < 2 || (x & 1)); ++x) {
+                PixelScalar(rowFilters, rows, x, width, out + 3 * (x - x0));
+            }
+            x = RowSimd(isa, rowFilters, rows, x, std::min(x1, width - 2), out + 3 * (x - x0));
+            for (; x < x1; ++x) {
+                PixelScalar(rowFilters, rows, x, width, out + 3 * (x - x0));
+            }
+        }
+    }
+}
+
+void SpinDemosaicer::Demosaic(const unsigned char* bayer, size_t bayerStride, int width, int height, unsigned char* rgb, size_t rgbStride,
+                              const SpinDemosaicOptions& options) {
+    DemosaicRegion(bayer, bayerStride, width, height, 0, 0, width, height, rgb, rgbStride, options);
+}
+
+void SpinDemosaicer::DemosaicRegion(const unsigned char* bayer, size_t bayerStride, int width, int height, int x, int y, int regionWidth,
+                                    int regionHeight, unsigned char* rgb, size_t rgbStride, const SpinDemosaicOptions& options) {
+    CheckRegion(bayer, width, height, x, y, regionWidth, regionHeight, rgb);
+    const int bandRows = GetBandRows(regionWidth, options);
+    const size_t bandCount = regionHeight > 0 ? static_cast<size_t>((regionHeight + bandRows - 1) / bandRows) : 0;
+    if ((options.threadCount == 1 && !options.pool) || bandCount <= 1) {
+        DemosaicBlock(bayer, bayerStride, width, height, x, y, regionWidth, regionHeight, rgb, rgbStride, options);
+        return;
+    }
+
+    if (rgbStride == 0) {
+        rgbStride = static_cast<size_t>(regionWidth) * 3;
+    }
+    SpinThreadPool& pool = options.pool ? *options.pool : GetSharedPool(options.threadCount);
+    pool.ParallelFor(bandCount, [&](size_t band) {
+        const int firstRow = static_cast<int>(band) * bandRows;
+        const int rowCount = std::min(bandRows, regionHeight - firstRow);
+        DemosaicBlock(bayer, bayerStride, width, height, x, y + firstRow, regionWidth, rowCount, rgb + static_cast<size_t>(firstRow) * rgbStride,
+                      rgbStride, options);
+    });
+}
+
+void SpinDemosaicer::DemosaicPacked(const unsigned char* data, size_t dataStride, int bitsPerPixel, int width, int height, unsigned char* rgb,
+                                    size_t rgbStride, const SpinDemosaicOptions& options) {
+    CheckRegion(data, width, height, 0, 0, width, height, rgb);
+    if (!SpinUnpacker::IsSupported(bitsPerPixel)) throw std::runtime_error("[ ERROR ] Unsupported bits per pixel for demosaicing.");
+    if (rgbStride == 0) {
+        rgbStride = static_cast<size_t>(width) * 3;
+    }
+
+    // Each band unpacks the rows its filters read, two above and two below it (mirrored rows at the edges fall inside them)
+    const int bandRows = GetBandRows(width, options);
+    const size_t bandCount = static_cast<size_t>((height + bandRows - 1) / bandRows);
+    auto demosaicBand = [&](size_t band) {
+        const int firstRow = static_cast<int>(band) * bandRows;
+        const int rowCount = std::min(bandRows, height - firstRow);
+        const int firstUnpacked = std::max(firstRow - 2, 0);
+        const int endUnpacked = std::min(firstRow + rowCount + 2, height);
+        thread_local std::vector<unsigned char> samples;
+        samples.resize(static_cast<size_t>(endUnpacked - firstUnpacked) * width);
+        if (dataStride == 0) {
+            SpinUnpacker::Unpack8(data, bitsPerPixel, static_cast<size_t>(firstUnpacked) * width, samples.size(), samples.data(), options.toneMap);
+        } else {
+            for (int row = firstUnpacked; row < endUnpacked; ++row) {
+                SpinUnpacker::Unpack8(data + static_cast<size_t>(row) * dataStride, bitsPerPixel, 0, static_cast<size_t>(width),
+                                      samples.data() + static_cast<size_t>(row - firstUnpacked) * width, options.toneMap);
+            }
+        }
+        DemosaicBlock(samples.data(), static_cast<size_t>(width), width, height, 0, firstRow, width, rowCount,
+                      rgb + static_cast<size_t>(firstRow) * rgbStride, rgbStride, options, firstUnpacked);
+    };
+    if ((options.threadCount == 1 && !options.pool) || bandCount <= 1) {
+        for (size_t band = 0; band < bandCount; ++band) {
+            demosaicBand(band);
+        }
+        return;
+    }
+    SpinThreadPool& pool = options.pool ? *options.pool : GetSharedPool(options.threadCount);
+    pool.ParallelFor(bandCount, demosaicBand);
+}
+
+void SpinDemosaicer::DemosaicRows(const unsigned char* bayer, size_t bayerStride, int width, int height, int firstRow, int rowCount,
+                                  unsigned char* rgb, size_t rgbStride, const SpinDemosaicOptions& options) {
+    CheckRegion(bayer, width, height, 0, firstRow, width, rowCount, rgb);
+    DemosaicBlock(bayer, bayerStride, width, height, 0, firstRow, width, rowCount, rgb, rgbStride, options);
+}
+
+SpinDemosaicCache::SpinDemosaicCache(const unsigned char* bayer, size_t bayerStride, int width, int height, int tileSize)
+    : bayer(bayer), bayerStride(bayerStride == 0 ? static_cast<size_t>(width) : bayerStride), width(width), height(height) {
+    if (!bayer || width <= 0 || height <= 0) throw std::runtime_error("[ ERROR ] Invalid image for demosaicing.");
+    // Even, so the vectors of every tile start on an even column
+    this->tileSize = std::max((tileSize + 1) & ~1, 8);
+    tilesX = (width + this->tileSize - 1) / this->tileSize;
+    tilesY = (height + this->tileSize - 1) / this->tileSize;
+    tileDone.assign(static_cast<size_t>(tilesX) * tilesY, 0);
+    tileKept.assign(tileDone.size(), 0);
+}
+
+unsigned char* SpinDemosaicCache::Region(int x, int y, int regionWidth, int regionHeight, const SpinDemosaicOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!rgb) {
+        rgb.reset(new unsigned char[static_cast<size_t>(width) * height * 3]);
+    }
+    if (options.method != method) {
+        // Kept tiles hold more than the demosaiced pixels (e.g. a drawing), they stay as they are
+        for (size_t i = 0; i < tileDone.size(); ++i) {
+            if (tileDone[i] && !tileKept[i]) {
+                tileDone[i] = 0;
+                tilesDone--;
+            }
+        }
+        method = options.method;
+    }
+
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(x + regionWidth, width);
+    const int y1 = std::min(y + regionHeight, height);
+    if (x0 >= x1 || y0 >= y1) {
+        return rgb.get();
+    }
+    const int firstTileX = x0 / tileSize;
+    const int lastTileX = (x1 - 1) / tileSize;
+    const int firstTileY = y0 / tileSize;
+    const int lastTileY = (y1 - 1) / tileSize;
+    const size_t stride = GetStride();
+
+    // A rectangle of tiles, clipped to the frame
+    auto demosaicTiles = [&](int firstX, int lastX, int firstY, int lastY) {
+        const int left = firstX * tileSize;
+        const int top = firstY * tileSize;
+        const int right = std::min((lastX + 1) * tileSize, width);
+        const int bottom = std::min((lastY + 1) * tileSize, height);
+        SpinDemosaicer::DemosaicRegion(bayer, bayerStride, width, height, left, top, right - left, bottom - top,
+                                       rgb.get() + static_cast<size_t>(top) * stride + static_cast<size_t>(left) * 3, stride, options);
+        for (int ty = firstY; ty <= lastY; ++ty) {
+            for (int tx = firstX; tx <= lastX; ++tx) {
+                tileDone[static_cast<size_t>(ty) * tilesX + tx] = 1;
+            }
+        }
+        tilesDone += static_cast<size_t>(lastX - firstX + 1) * (lastY - firstY + 1);
+    };
+
+    // Nothing of the rectangle done yet (e.g. a first full frame): in one go, with the bands and threads of the options
+    bool anyDone = false;
+    for (int ty = firstTileY; ty <= lastTileY && !anyDone; ++ty) {
+        for (int tx = firstTileX; tx <= lastTileX && !anyDone; ++tx) {
+            anyDone = tileDone[static_cast<size_t>(ty) * tilesX + tx] != 0;
+        }
+    }
+    if (!anyDone) {
+        demosaicTiles(firstTileX, lastTileX, firstTileY, lastTileY);
+        return rgb.get();
+    }
+
+    // Otherwise the runs of missing tiles, row of tiles by row of tiles
+    for (int ty = firstTileY; ty <= lastTileY; ++ty) {
+        int tx = firstTileX;
+        while (tx <= lastTileX) {
+            if (tileDone[static_cast<size_t>(ty) * tilesX + tx]) {
+                tx++;
+                continue;
+            }
+            int runEnd = tx;
+            while (runEnd + 1 <= lastTileX && !tileDone[static_cast<size_t>(ty) * tilesX + runEnd + 1]) {
+                runEnd++;
+            }
+            demosaicTiles(tx, runEnd, ty, ty);
+            tx = runEnd + 1;
+        }
+    }
+    return rgb.get();
+}
+
+unsigned char* SpinDemosaicCache::Frame(const SpinDemosaicOptions& options) {
+    return Region(0, 0, width, height, options);
+}
+
+void SpinDemosaicCache::Keep(int x, int y, int regionWidth, int regionHeight) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(x + regionWidth, width);
+    const int y1 = std::min(y + regionHeight, height);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    for (int tileY = y0 / tileSize; tileY <= (y1 - 1) / tileSize; ++tileY) {
+        for (int tileX = x0 / tileSize; tileX <= (x1 - 1) / tileSize; ++tileX) {
+            tileKept[static_cast<size_t>(tileY) * tilesX + tileX] = 1;
+        }
+    }
+}
+
+void SpinDemosaicCache::Reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::fill(tileDone.begin(), tileDone.end(), 0);
+    std::fill(tileKept.begin(), tileKept.end(), 0);
+    tilesDone = 0;
+}
+
+int SpinDemosaicCache::GetWidth() const {
+    return width;
+}
+
+int SpinDemosaicCache::GetHeight() const {
+    return height;
+}
+
+size_t SpinDemosaicCache::GetStride() const {
+    return static_cast<size_t>(width) * 3;
+}
+
+size_t SpinDemosaicCache::GetTileCount() const {
+    return tileDone.size();
+}
+
+size_t SpinDemosaicCache::GetTilesDone() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tilesDone;
+}
+
+bool SpinDemosaicCache::IsComplete() const {
+    return GetTilesDone() == GetTileCount();
+}
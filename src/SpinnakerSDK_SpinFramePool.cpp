@@ -0,0 +1,156 @@
+#include "../include/SpinnakerSDK_SpinFramePool.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#if defined(__APPLE__)
+#include <mach/vm_statistics.h>
+#endif
+
+namespace {
+    const size_t kPageSize = 4096;
+    const size_t kHugePageSize = 2 * 1024 * 1024;
+
+    size_t RoundUp(size_t value, size_t multiple) {
+        return ((value + multiple - 1) / multiple) * multiple;
+    }
+}
+
+std::shared_ptr<SpinFramePool> SpinFramePool::Create(size_t frameCount, size_t frameSize, bool useHugePages, bool lockMemory) {
+    return std::shared_ptr<SpinFramePool>(new SpinFramePool(frameCount, frameSize, useHugePages, lockMemory));
+}
+
+SpinFramePool::SpinFramePool(size_t frameCount, size_t frameSize, bool useHugePages, bool lockMemory)
+    : frameCount(frameCount), frameSize(frameSize) {
+    if (frameCount == 0 || frameSize == 0) {
+        throw std::runtime_error("[ ERROR ] Frame pool needs at least one frame of non-zero size.");
+    }
+
+    // Every frame starts on its own page
+    frameStride = RoundUp(frameSize, kPageSize);
+    mappedSize = frameStride * frameCount;
+
+    // Try to back the pool with huge pages, falling back to regular pages
+    void* mapped = MAP_FAILED;
+    if (useHugePages) {
+        size_t hugeSize = RoundUp(mappedSize, kHugePageSize);
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        mapped = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#elif defined(__APPLE__) && defined(VM_FLAGS_SUPERPAGE_SIZE_ANY)
+        mapped = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_ANY, 0);
+#endif
+        if (mapped != MAP_FAILED) {
+            mappedSize = hugeSize;
+            stats.hugePages = true;
+        }
+    }
+    if (mapped == MAP_FAILED) {
+        mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("[ ERROR ] Unable to allocate frame pool memory.");
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // Transparent huge pages are the next best thing
+        if (useHugePages && madvise(mapped, mappedSize, MADV_HUGEPAGE) == 0) {
+            stats.hugePages = true;
+        }
+#endif
+        if (useHugePages && !stats.hugePages) {
+            SPIN_LOG_WARNING("Huge pages unavailable, frame pool uses regular pages.");
+        }
+    }
+    memory = static_cast<unsigned char*>(mapped);
+
+    // Pin the pool in RAM so it can never be paged out mid-capture
+    if (lockMemory) {
+        if (mlock(memory, mappedSize) == 0) {
+            stats.locked = true;
+        } else {
+            SPIN_LOG_WARNING("Unable to lock frame pool memory (check RLIMIT_MEMLOCK).");
+        }
+    }
+
+    // Touch every page now so the first frames do not pay for page faults
+    memset(memory, 0, mappedSize);
+
+    freeFrames.reserve(frameCount);
+    for (size_t i = frameCount; i > 0; --i) {
+        freeFrames.push_back(memory + (i - 1) * frameStride);
+    }
+
+    stats.capacity = frameCount;
+    stats.frameSize = frameSize;
+}
+
+SpinFramePool::~SpinFramePool() {
+    if (memory) {
+        if (stats.locked) {
+            munlock(memory, mappedSize);
+        }
+        munmap(memory, mappedSize);
+    }
+}
+
+std::shared_ptr<unsigned char> SpinFramePool::Acquire(size_t size) {
+    unsigned char* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (size > frameSize) {
+            stats.oversizeRequests++;
+            return nullptr;
+        }
+        if (freeFrames.empty()) {
+            stats.exhaustions++;
+            return nullptr;
+        }
+        frame = freeFrames.back();
+        freeFrames.pop_back();
+        stats.acquisitions++;
+        stats.inUse++;
+        if (stats.inUse > stats.highWaterMark) {
+            stats.highWaterMark = stats.inUse;
+        }
+    }
+
+    // The buffer keeps the pool alive until it has been returned
+    std::shared_ptr<SpinFramePool> self = shared_from_this();
+    return std::shared_ptr<unsigned char>(frame, [self](unsigned char* returned) {
+        self->Return(returned);
+    });
+}
+
+void SpinFramePool::Return(unsigned char* frame) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeFrames.push_back(frame);
+    stats.inUse--;
+}
+
+size_t SpinFramePool::GetFrameSize() const {
+    return frameSize;
+}
+
+size_t SpinFramePool::GetFrameCount() const {
+    return frameCount;
+}
+
+SpinFramePoolStats SpinFramePool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void SpinFramePool::PrintStats() const {
+    SpinLogger::Instance().BeginReport();
+    SpinFramePoolStats current = GetStats();
+    std::cout << "===== Frame Pool =====" << std::endl;
+    std::cout << "Frames: " << current.capacity << " x " << current.frameSize << " bytes" << std::endl;
+    std::cout << "Huge Pages: " << (current.hugePages ? "Yes" : "No") << std::endl;
+    std::cout << "Locked: " << (current.locked ? "Yes" : "No") << std::endl;
+    std::cout << "In Use: " << current.inUse << std::endl;
+    std::cout << "High Water Mark: " << current.highWaterMark << std::endl;
+    std::cout << "Acquisitions: " << current.acquisitions << std::endl;
+    std::cout << "Exhaustions: " << current.exhaustions << std::endl;
+    std::cout << "Oversize Requests: " << current.oversizeRequests << std::endl;
+    std::cout << "======================" << std::endl;
+}
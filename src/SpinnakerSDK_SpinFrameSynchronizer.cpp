@@ -0,0 +1,172 @@
+#include "../include/SpinnakerSDK_SpinFrameSynchronizer.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+SpinFrameSynchronizer::SpinFrameSynchronizer(size_t cameraCount, std::chrono::nanoseconds tolerance, size_t queueCapacity)
+    : tolerance(tolerance.count()) {
+    if (cameraCount == 0) {
+        throw std::runtime_error("[ ERROR ] Frame synchronizer needs at least one camera.");
+    }
+    if (tolerance.count() < 0) {
+        throw std::runtime_error("[ ERROR ] Frame synchronizer tolerance must not be negative.");
+    }
+    cameras.reserve(cameraCount);
+    for (size_t i = 0; i < cameraCount; ++i) {
+        cameras.push_back(CreateCameraState(queueCapacity));
+    }
+}
+
+SpinFrameSynchronizer::CameraStatePtr SpinFrameSynchronizer::CreateCameraState(size_t queueCapacity) {
+    void* memory = nullptr;
+    if (posix_memalign(&memory, alignof(CameraState), sizeof(CameraState)) != 0) {
+        throw std::bad_alloc();
+    }
+    try {
+        return CameraStatePtr(new (memory) CameraState(queueCapacity));
+    } catch (...) {
+        free(memory);
+        throw;
+    }
+}
+
+void SpinFrameSynchronizer::CameraStateDeleter::operator()(CameraState* state) const {
+    state->~CameraState();
+    free(state);
+}
+
+SpinFrameSynchronizer::CameraState& SpinFrameSynchronizer::Camera(size_t camera) const {
+    if (camera >= cameras.size()) {
+        throw std::runtime_error("[ ERROR ] Frame synchronizer has no camera " + std::to_string(camera));
+    }
+    return *cameras[camera];
+}
+
+void SpinFrameSynchronizer::SetClockOffset(size_t camera, int64_t offset) {
+    Camera(camera).clockOffset.store(offset, std::memory_order_relaxed);
+}
+
+bool SpinFrameSynchronizer::Push(size_t camera, const SpinImage& frame) {
+    CameraState& state = Camera(camera);
+    if (!state.queue.TryPush(frame)) {
+        state.droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    state.receivedFrames.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::function<void(SpinImage&)> SpinFrameSynchronizer::GetStreamHandler(size_t camera) {
+    Camera(camera);
+    return [this, camera](SpinImage& frame) {
+        Push(camera, frame);
+    };
+}
+
+bool SpinFrameSynchronizer::TryGetFrameSet(SpinFrameSet& frameSet) {
+    while (true) {
+        // Every camera needs a candidate frame before anything can be matched
+        for (CameraStatePtr& state : cameras) {
+            if (state->hasPending) {
+                continue;
+            }
+            if (!state->queue.TryPop(state->pending)) {
+                return false;
+            }
+            state->hasPending = true;
+            state->pendingTime = static_cast<int64_t>(state->pending.GetTimeStamp()) - state->clockOffset.load(std::memory_order_relaxed);
+        }
+
+        int64_t latest = cameras.front()->pendingTime;
+        for (const CameraStatePtr& state : cameras) {
+            latest = std::max(latest, state->pendingTime);
+        }
+
+        // Frames too far behind the latest candidate can never be matched, since every camera's frames only get newer
+        bool discarded = false;
+        for (CameraStatePtr& state : cameras) {
+            if (latest - state->pendingTime > tolerance) {
+                state->pending = SpinImage(nullptr);
+                state->hasPending = false;
+                state->unmatchedFrames.fetch_add(1, std::memory_order_relaxed);
+                discarded = true;
+            }
+        }
+        if (!discarded) {
+            break;
+        }
+    }
+
+    // All candidates lie within the tolerance of each other
+    int64_t earliest = cameras.front()->pendingTime;
+    int64_t latest = earliest;
+    frameSet.frames.resize(cameras.size(), SpinImage(nullptr));
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        CameraState& state = *cameras[i];
+        earliest = std::min(earliest, state.pendingTime);
+        latest = std::max(latest, state.pendingTime);
+        frameSet.frames[i] = std::move(state.pending);
+        state.pending = SpinImage(nullptr);
+        state.hasPending = false;
+    }
+    frameSet.timestamp = static_cast<uint64_t>(earliest);
+    frameSet.skew = static_cast<uint64_t>(latest - earliest);
+    matchedSets.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool SpinFrameSynchronizer::GetFrameSet(SpinFrameSet& frameSet, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!TryGetFrameSet(frameSet)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+void SpinFrameSynchronizer::Clear() {
+    SpinImage frame(nullptr);
+    for (CameraStatePtr& state : cameras) {
+        while (state->queue.TryPop(frame)) {
+        }
+        state->pending = SpinImage(nullptr);
+        state->hasPending = false;
+    }
+}
+
+size_t SpinFrameSynchronizer::GetCameraCount() const {
+    return cameras.size();
+}
+
+uint64_t SpinFrameSynchronizer::GetMatchedSets() const {
+    return matchedSets.load(std::memory_order_relaxed);
+}
+
+SpinFrameSynchronizerCameraStats SpinFrameSynchronizer::GetCameraStats(size_t camera) const {
+    const CameraState& state = Camera(camera);
+    SpinFrameSynchronizerCameraStats stats;
+    stats.receivedFrames = state.receivedFrames.load(std::memory_order_relaxed);
+    stats.droppedFrames = state.droppedFrames.load(std::memory_order_relaxed);
+    stats.unmatchedFrames = state.unmatchedFrames.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SpinFrameSynchronizer::PrintStats() const {
+    SpinLogger::Instance().BeginReport();
+    std::cout << "===== Frame Synchronizer =====" << std::endl;
+    std::cout << "Tolerance: " << tolerance << " ns" << std::endl;
+    std::cout << "Matched Sets: " << GetMatchedSets() << std::endl;
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        SpinFrameSynchronizerCameraStats stats = GetCameraStats(i);
+        std::cout << "Camera " << i << ": " << stats.receivedFrames << " received, " << stats.droppedFrames << " dropped, "
+                  << stats.unmatchedFrames << " unmatched" << std::endl;
+    }
+    std::cout << "==============================" << std::endl;
+}
@@ -0,0 +1,229 @@
+#include "../include/SpinnakerSDK_SpinHardwareBackend.h"
+#include <stdexcept>
+
+using namespace Spinnaker;
+using namespace GenApi;
+
+// Receives images from the Spinnaker event thread and hands them to the registered handler as leases
+class SpinHardwareBackend::ImageHandler : public ImageEventHandler {
+public:
+    explicit ImageHandler(std::function<void(SpinImage&)> handler) : handler(handler) {}
+
+    void OnImageEvent(ImagePtr image) override {
+        SpinImage frame(image, SpinOption::ImageOwnership::Lease);
+        handler(frame);
+    }
+
+private:
+    std::function<void(SpinImage&)> handler;
+};
+
+SpinHardwareBackend::SpinHardwareBackend(int camera_index)
+    : cameraIndex(camera_index), pCam(nullptr), nodeMap(nullptr), streamNodeMap(nullptr) {}
+
+SpinHardwareBackend::SpinHardwareBackend(const std::string& serial_number)
+    : cameraIndex(-1), requestedSerialNumber(serial_number), pCam(nullptr), nodeMap(nullptr), streamNodeMap(nullptr) {}
+
+SpinHardwareBackend::~SpinHardwareBackend() {
+    DeInit();
+}
+
+void SpinHardwareBackend::Init() {
+    // Get the camera from the shared registry
+    if (requestedSerialNumber.empty()) {
+        pCam = SpinCameraRegistry::Instance().OpenCamera(cameraIndex, registryKey);
+    } else {
+        pCam = SpinCameraRegistry::Instance().OpenCamera(requestedSerialNumber);
+        registryKey = requestedSerialNumber;
+    }
+
+    // Initialize the camera
+    try {
+        // The registry names cameras without a serial number by index, those report an empty serial number
+        CStringPtr ptrSerialNumber = pCam->GetTLDeviceNodeMap().GetNode("DeviceSerialNumber");
+        serialNumber = Spinnaker::GenApi::IsReadable(ptrSerialNumber) ? std::string(ptrSerialNumber->GetValue().c_str()) : "";
+
+        pCam->Init();
+
+        // Retrieve and set node map
+        nodeMap = &pCam->GetNodeMap();
+        if (nodeMap == nullptr) {
+            throw std::runtime_error("[ ERROR ] Failed to get node map.");
+        }
+
+        // Retrieve and set the TLStreamNodeMap
+        streamNodeMap = &pCam->GetTLStreamNodeMap();
+        if (streamNodeMap == nullptr) {
+            throw std::runtime_error("[ ERROR ] Failed to get stream node map.");
+        }
+    } catch (...) {
+        DeInit();
+        throw;
+    }
+}
+
+void SpinHardwareBackend::DeInit() {
+    UnregisterImageHandler();
+    if (pCam) {
+        if (pCam->IsInitialized()) {
+            pCam->DeInit();
+        }
+        pCam = nullptr;
+        SpinCameraRegistry::Instance().CloseCamera(registryKey);
+    }
+    nodeMap = nullptr;
+    streamNodeMap = nullptr;
+
+    // The next Init opens the camera again, by index the index is looked up again
+    registryKey.clear();
+    serialNumber.clear();
+}
+
+std::string SpinHardwareBackend::GetSerialNumber() {
+    if (!pCam) throw std::runtime_error("[ ERROR ] Camera not initialized");
+    return serialNumber;
+}
+
+void SpinHardwareBackend::BeginAcquisition() {
+    if (!pCam) throw std::runtime_error("[ ERROR ] Unable to start camera Acquisition");
+    pCam->BeginAcquisition();
+}
+
+void SpinHardwareBackend::EndAcquisition() {
+    if (!pCam) throw std::runtime_error("[ ERROR ] Unable to end camera Acquisition");
+    pCam->EndAcquisition();
+}
+
+SpinImage SpinHardwareBackend::GetNextImage(uint64_t timeoutMs) {
+    if (!pCam) throw std::runtime_error("[ ERROR ] Camera not initialized");
+    ImagePtr rawImage = (timeoutMs == kInfiniteTimeout) ? pCam->GetNextImage() : pCam->GetNextImage(timeoutMs);
+    return SpinImage(rawImage, SpinOption::ImageOwnership::Lease);
+}
+
+void SpinHardwareBackend::RegisterImageHandler(std::function<void(SpinImage&)> handler) {
+    if (!pCam) throw std::runtime_error("[ ERROR ] Camera not initialized");
+    UnregisterImageHandler();
+    imageHandler.reset(new ImageHandler(handler));
+    pCam->RegisterEventHandler(*imageHandler);
+}
+
+void SpinHardwareBackend::UnregisterImageHandler() {
+    if (!imageHandler) {
+        return;
+    }
+    if (pCam) {
+        pCam->UnregisterEventHandler(*imageHandler);
+    }
+    imageHandler.reset();
+}
+
+CNodePtr SpinHardwareBackend::FindNode(const std::string& node) {
+    if (!nodeMap || !streamNodeMap) {
+        throw std::runtime_error("[ ERROR ] Node map is not initialized.");
+    }
+    CNodePtr ptrNode = nodeMap->GetNode(node.c_str());
+    if (!IsAvailable(ptrNode)) {
+        ptrNode = streamNodeMap->GetNode(node.c_str());
+    }
+    return ptrNode;
+}
+
+bool SpinHardwareBackend::IsReadable(const std::string& node) {
+    CNodePtr ptrNode = FindNode(node);
+    return IsAvailable(ptrNode) && Spinnaker::GenApi::IsReadable(ptrNode);
+}
+
+bool SpinHardwareBackend::IsWritable(const std::string& node) {
+    CNodePtr ptrNode = FindNode(node);
+    return IsAvailable(ptrNode) && Spinnaker::GenApi::IsWritable(ptrNode);
+}
+
+int64_t SpinHardwareBackend::GetIntegerValue(const std::string& node) {
+    CIntegerPtr ptrInteger = FindNode(node);
+    if (!IsAvailable(ptrInteger)) throw std::runtime_error("[ ERROR ] Integer node " + node + " not available");
+    return ptrInteger->GetValue();
+}
+
+int64_t SpinHardwareBackend::GetIntegerMin(const std::string& node) {
+    CIntegerPtr ptrInteger = FindNode(node);
+    if (!IsAvailable(ptrInteger)) throw std::runtime_error("[ ERROR ] Integer node " + node + " not available");
+    return ptrInteger->GetMin();
+}
+
+int64_t SpinHardwareBackend::GetIntegerMax(const std::string& node) {
+    CIntegerPtr ptrInteger = FindNode(node);
+    if (!IsAvailable(ptrInteger)) throw std::runtime_error("[ ERROR ] Integer node " + node + " not available");
+    return ptrInteger->GetMax();
+}
+
+void SpinHardwareBackend::SetIntegerValue(const std::string& node, int64_t value) {
+    CIntegerPtr ptrInteger = FindNode(node);
+    if (!IsAvailable(ptrInteger)) throw std::runtime_error("[ ERROR ] Integer node " + node + " not available");
+    ptrInteger->SetValue(value);
+}
+
+double SpinHardwareBackend::GetFloatValue(const std::string& node) {
+    CFloatPtr ptrFloat = FindNode(node);
+    if (!IsAvailable(ptrFloat)) throw std::runtime_error("[ ERROR ] Float node " + node + " not available");
+    return ptrFloat->GetValue();
+}
+
+double SpinHardwareBackend::GetFloatMin(const std::string& node) {
+    CFloatPtr ptrFloat = FindNode(node);
+    if (!IsAvailable(ptrFloat)) throw std::runtime_error("[ ERROR ] Float node " + node + " not available");
+    return ptrFloat->GetMin();
+}
+
+double SpinHardwareBackend::GetFloatMax(const std::string& node) {
+    CFloatPtr ptrFloat = FindNode(node);
+    if (!IsAvailable(ptrFloat)) throw std::runtime_error("[ ERROR ] Float node " + node + " not available");
+    return ptrFloat->GetMax();
+}
+
+void SpinHardwareBackend::SetFloatValue(const std::string& node, double value) {
+    CFloatPtr ptrFloat = FindNode(node);
+    if (!IsAvailable(ptrFloat)) throw std::runtime_error("[ ERROR ] Float node " + node + " not available");
+    ptrFloat->SetValue(value);
+}
+
+bool SpinHardwareBackend::GetBooleanValue(const std::string& node) {
+    CBooleanPtr ptrBoolean = FindNode(node);
+    if (!IsAvailable(ptrBoolean)) throw std::runtime_error("[ ERROR ] Boolean node " + node + " not available");
+    return ptrBoolean->GetValue();
+}
+
+void SpinHardwareBackend::SetBooleanValue(const std::string& node, bool value) {
+    CBooleanPtr ptrBoolean = FindNode(node);
+    if (!IsAvailable(ptrBoolean)) throw std::runtime_error("[ ERROR ] Boolean node " + node + " not available");
+    ptrBoolean->SetValue(value);
+}
+
+std::string SpinHardwareBackend::GetEnumerationValue(const std::string& node) {
+    CEnumerationPtr ptrEnumeration = FindNode(node);
+    if (!IsAvailable(ptrEnumeration)) throw std::runtime_error("[ ERROR ] Enumeration node " + node + " not available");
+    CEnumEntryPtr ptrEntry = ptrEnumeration->GetCurrentEntry();
+    return std::string(ptrEntry->GetSymbolic().c_str());
+}
+
+bool SpinHardwareBackend::IsEnumerationEntryReadable(const std::string& node, const std::string& entry) {
+    CEnumerationPtr ptrEnumeration = FindNode(node);
+    if (!IsAvailable(ptrEnumeration)) {
+        return false;
+    }
+    CEnumEntryPtr ptrEntry = ptrEnumeration->GetEntryByName(entry.c_str());
+    return IsAvailable(ptrEntry) && Spinnaker::GenApi::IsReadable(ptrEntry);
+}
+
+void SpinHardwareBackend::SetEnumerationValue(const std::string& node, const std::string& entry) {
+    CEnumerationPtr ptrEnumeration = FindNode(node);
+    if (!IsAvailable(ptrEnumeration)) throw std::runtime_error("[ ERROR ] Enumeration node " + node + " not available");
+    CEnumEntryPtr ptrEntry = ptrEnumeration->GetEntryByName(entry.c_str());
+    if (!IsAvailable(ptrEntry)) throw std::runtime_error("[ ERROR ] Entry " + entry + " of " + node + " not available");
+    ptrEnumeration->SetIntValue(ptrEntry->GetValue());
+}
+
+void SpinHardwareBackend::ExecuteCommand(const std::string& node) {
+    CCommandPtr ptrCommand = FindNode(node);
+    if (!IsAvailable(ptrCommand)) throw std::runtime_error("[ ERROR ] Command node " + node + " not available");
+    ptrCommand->Execute();
+}
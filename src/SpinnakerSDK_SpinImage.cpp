@@ -1,22 +1,301 @@
 #include "../include/SpinnakerSDK_SpinImage.h"
+#include "../include/SpinnakerSDK_SpinBayerCodec.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include "../include/SpinnakerSDK_SpinThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
 
-SpinImage::SpinImage(Spinnaker::ImagePtr rawImage) : rawImage(rawImage), demosaicedImage(nullptr) {
+namespace {
+    // Bytes per pixel of the formats with one (the ones SpinImageView shows), 0 for packed or unknown formats
+    size_t GetPixelBytes(Spinnaker::PixelFormatEnums pixelFormat) {
+        switch (pixelFormat) {
+            case Spinnaker::PixelFormatEnums::PixelFormat_Mono8:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGR8:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGB8:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerBG8:
+                return 1;
+            case Spinnaker::PixelFormatEnums::PixelFormat_Mono16:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGR16:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGB16:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerBG16:
+                return 2;
+            case Spinnaker::PixelFormatEnums::PixelFormat_RGB8:
+                return 3;
+            case Spinnaker::PixelFormatEnums::PixelFormat_RGB16:
+                return 6;
+            default:
+                return 0;
+        }
+    }
+
+    // How SpinBayerStats reads the samples of a format and how deep they are, throws for formats without colours it knows
+    SpinSampleLayout GetSampleLayout(Spinnaker::PixelFormatEnums pixelFormat, int& bitsPerSample) {
+        SpinSampleLayout layout;
+        bitsPerSample = 8;
+        switch (pixelFormat) {
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16:
+                bitsPerSample = 16;
+                // fall through
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8:
+                layout.pattern = SpinBayer::Pattern::RGGB;
+                break;
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGR16:
+                bitsPerSample = 16;
+                // fall through
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGR8:
+                layout.pattern = SpinBayer::Pattern::GRBG;
+                break;
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGB16:
+                bitsPerSample = 16;
+                // fall through
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerGB8:
+                layout.pattern = SpinBayer::Pattern::GBRG;
+                break;
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerBG16:
+                bitsPerSample = 16;
+                // fall through
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerBG8:
+                layout.pattern = SpinBayer::Pattern::BGGR;
+                break;
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p:
+            case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p:
+                bitsPerSample = SpinBayerCodec::GetBitsPerPixel(pixelFormat);
+                break;
+            case Spinnaker::PixelFormatEnums::PixelFormat_Mono8:
+            case Spinnaker::PixelFormatEnums::PixelFormat_Mono10p:
+            case Spinnaker::PixelFormatEnums::PixelFormat_Mono12p:
+            case Spinnaker::PixelFormatEnums::PixelFormat_Mono16:
+                bitsPerSample = SpinBayerCodec::GetBitsPerPixel(pixelFormat);
+                layout.kind = SpinSampleLayout::Kind::Mono;
+                break;
+            case Spinnaker::PixelFormatEnums::PixelFormat_RGB16:
+                bitsPerSample = 16;
+                // fall through
+            case Spinnaker::PixelFormatEnums::PixelFormat_RGB8:
+                layout.kind = SpinSampleLayout::Kind::RGB;
+                break;
+            default:
+                throw std::runtime_error("[ ERROR ] Pixel format not supported for colour statistics.");
+        }
+        return layout;
+    }
+
+    // Bytes per row without padding
+    size_t GetTightStride(Spinnaker::PixelFormatEnums pixelFormat, int width) {
+        const size_t pixelBytes = GetPixelBytes(pixelFormat);
+        if (pixelBytes > 0) {
+            return pixelBytes * width;
+        }
+        const int bitsPerPixel = SpinBayerCodec::GetBitsPerPixel(pixelFormat);
+        return SpinUnpacker::GetPackedSize(bitsPerPixel > 0 ? bitsPerPixel : 8, static_cast<size_t>(width));
+    }
+}
+
+SpinImage::SpinImage(Spinnaker::ImagePtr rawImage, SpinOption::ImageOwnership ownership, const std::shared_ptr<SpinFramePool>& pool)
+    : rawImage(rawImage), demosaicedImage(nullptr), incomplete(false), imageStatus(0), imageSize(0), leased(false), readOnly(false) {
     if (rawImage) {
         imageWidth = rawImage->GetWidth();
         imageHeight = rawImage->GetHeight();
-        size_t imageSize = rawImage->GetBufferSize();
-        imageData.resize(imageSize);
-        memcpy(imageData.data(), rawImage->GetData(), imageSize);
+        pixelFormat = static_cast<Spinnaker::PixelFormatEnums>(rawImage->GetPixelFormat());
+        timestamp = rawImage->GetTimeStamp();
+        frameID = rawImage->GetFrameID();
+        incomplete = rawImage->IsIncomplete();
+        imageStatus = static_cast<int>(rawImage->GetImageStatus());
+        imageSize = rawImage->GetBufferSize();
+        imageStride = rawImage->GetStride();
+        if (imageStride == 0) {
+            imageStride = GetTightStride(pixelFormat, imageWidth);
+        }
+        unsigned char* driverData = static_cast<unsigned char*>(rawImage->GetData());
+
+        if (ownership == SpinOption::ImageOwnership::Lease) {
+            // Reference the driver buffer directly, it is handed back to the stream when the last copy of this image goes away
+            imageData = std::shared_ptr<unsigned char>(driverData, [rawImage](unsigned char*) mutable {
+                rawImage->Release();
+            });
+            leased = true;
+        } else {
+            if (pool) {
+                imageData = pool->Acquire(imageSize);
+            }
+            if (!imageData) {
+                imageData = std::shared_ptr<unsigned char>(new unsigned char[imageSize], std::default_delete<unsigned char[]>());
+            }
+            memcpy(imageData.get(), driverData, imageSize);
+        }
     } else {
         imageWidth = 0;
         imageHeight = 0;
+        imageStride = 0;
+        pixelFormat = Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8;
+        timestamp = 0;
+        frameID = 0;
     }
 }
 
+SpinImage::SpinImage(unsigned char* data, size_t size, int width, int height, Spinnaker::PixelFormatEnums pixelFormat,
+                     std::function<void()> releaseHook, uint64_t timestamp, uint64_t frameID, size_t stride)
+    : rawImage(nullptr), demosaicedImage(nullptr), imageWidth(width), imageHeight(height), imageStride(stride ? stride : GetTightStride(pixelFormat, width)),
+      pixelFormat(pixelFormat),
+      timestamp(timestamp), frameID(frameID), incomplete(false), imageStatus(0), imageSize(size), leased(true), readOnly(false) {
+    imageData = std::shared_ptr<unsigned char>(data, [releaseHook](unsigned char*) {
+        if (releaseHook) {
+            releaseHook();
+        }
+    });
+}
+
 SpinImage::~SpinImage() {
     // Destructor
 }
 
+// Create an independent copy of the image data (in a pool buffer when one is given and available)
+// This is the way to keep a leased frame around without holding on to its driver buffer
+SpinImage SpinImage::Detach(const std::shared_ptr<SpinFramePool>& pool) const {
+    SpinImage detached(*this);
+    if (imageData) {
+        detached.imageData = nullptr;
+        if (pool) {
+            detached.imageData = pool->Acquire(imageSize);
+        }
+        if (!detached.imageData) {
+            detached.imageData = std::shared_ptr<unsigned char>(new unsigned char[imageSize], std::default_delete<unsigned char[]>());
+        }
+        memcpy(detached.imageData.get(), imageData.get(), imageSize);
+    }
+    detached.leased = false;
+    detached.readOnly = false;
+    // The tiles still to do would read the old buffer
+    detached.demosaicCache = nullptr;
+    return detached;
+}
+
+bool SpinImage::IsLeased() const {
+    return leased;
+}
+
+const unsigned char* SpinImage::GetData() const {
+    return imageData.get();
+}
+
+size_t SpinImage::GetDataSize() const {
+    return imageData ? imageSize : 0;
+}
+
+int SpinImage::GetWidth() const {
+    return imageWidth;
+}
+
+int SpinImage::GetHeight() const {
+    return imageHeight;
+}
+
+size_t SpinImage::GetStride() const {
+    return imageStride;
+}
+
+Spinnaker::PixelFormatEnums SpinImage::GetPixelFormat() const {
+    return pixelFormat;
+}
+
+uint64_t SpinImage::GetTimeStamp() const {
+    return timestamp;
+}
+
+uint64_t SpinImage::GetFrameID() const {
+    return frameID;
+}
+
+bool SpinImage::IsIncomplete() const {
+    return incomplete;
+}
+
+int SpinImage::GetImageStatus() const {
+    return imageStatus;
+}
+
+int SpinImage::GetBitsPerPixel() const {
+    return SpinBayerCodec::GetBitsPerPixel(pixelFormat);
+}
+
+bool SpinImage::HasAllSamples() const {
+    const size_t rowBytes = GetTightStride(pixelFormat, imageWidth);
+    if (imageStride < rowBytes) {
+        return false;
+    }
+    if (GetPaddedStride() > 0 && imageHeight > 0) {
+        return imageData && imageSize >= imageStride * (imageHeight - 1) + rowBytes;
+    }
+    const int bitsPerPixel = GetBitsPerPixel();
+    return imageData && imageSize >= SpinUnpacker::GetPackedSize(bitsPerPixel > 0 ? bitsPerPixel : 8, static_cast<size_t>(imageWidth) * imageHeight);
+}
+
+size_t SpinImage::GetPaddedStride() const {
+    return imageStride != GetTightStride(pixelFormat, imageWidth) ? imageStride : 0;
+}
+
+void SpinImage::CheckView(Spinnaker::PixelFormatEnums viewFormat, size_t pixelBytes) const {
+    if (viewFormat != pixelFormat) {
+        throw std::runtime_error("[ ERROR ] Image view format does not match the pixel format of the image.");
+    }
+    if (imageHeight > 0 && (!imageData || imageStride < pixelBytes * imageWidth || imageSize < imageStride * (imageHeight - 1) + pixelBytes * imageWidth)) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid or empty.");
+    }
+}
+
+void SpinImage::UnpackTo8(unsigned char* samples, const unsigned char* toneMap) const {
+    if (GetBitsPerPixel() == 0 || !HasAllSamples()) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid, empty or not raw samples.");
+    }
+    if (GetPaddedStride() > 0) {
+        // Padded rows one at a time
+        for (int y = 0; y < imageHeight; ++y) {
+            SpinUnpacker::Unpack8(imageData.get() + y * imageStride, GetBitsPerPixel(), 0, imageWidth, samples + static_cast<size_t>(y) * imageWidth, toneMap);
+        }
+        return;
+    }
+    SpinUnpacker::Unpack8(imageData.get(), GetBitsPerPixel(), 0, static_cast<size_t>(imageWidth) * imageHeight, samples, toneMap);
+}
+
+void SpinImage::UnpackTo16(uint16_t* samples, int shift) const {
+    if (GetBitsPerPixel() == 0 || !HasAllSamples()) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid, empty or not raw samples.");
+    }
+    if (GetPaddedStride() > 0) {
+        for (int y = 0; y < imageHeight; ++y) {
+            SpinUnpacker::Unpack16(imageData.get() + y * imageStride, GetBitsPerPixel(), 0, imageWidth, samples + static_cast<size_t>(y) * imageWidth, shift);
+        }
+        return;
+    }
+    SpinUnpacker::Unpack16(imageData.get(), GetBitsPerPixel(), 0, static_cast<size_t>(imageWidth) * imageHeight, samples, shift);
+}
+
+void SpinImage::MarkIncomplete(int status) {
+    incomplete = true;
+    imageStatus = status;
+}
+
+void SpinImage::MarkReadOnly() {
+    readOnly = true;
+}
+
+bool SpinImage::IsReadOnly() const {
+    return readOnly;
+}
+
+void SpinImage::MakeWritable() {
+    if (readOnly) {
+        *this = Detach();
+    }
+}
+
 // Convert nanoseconds to a more readable format (hh:mm:ss.xxxxxxxxx)
 std::string ConvertTimestampToReadableFormat(uint64_t timestamp) {
     // Convert timestamp to total seconds
@@ -36,6 +315,7 @@ std::string ConvertTimestampToReadableFormat(uint64_t timestamp) {
 }
 
 void SpinImage::PrintAllImageInformation() {
+    SpinLogger::Instance().BeginReport();
     if (!rawImage) {
         std::cerr << "Raw image is invalid." << std::endl;
         return;
@@ -71,6 +351,7 @@ void SpinImage::PrintAllImageInformation() {
 }
 
 void SpinImage::PrintSimpleImageInformation() {
+    SpinLogger::Instance().BeginReport();
     if (!rawImage) {
         std::cerr << "Raw image is invalid." << std::endl;
         return;
@@ -86,16 +367,13 @@ void SpinImage::PrintSimpleImageInformation() {
 }
 
 void SpinImage::Demosaic() {
-    if (!rawImage || imageData.empty()) {
-        std::cerr << "Raw image is invalid or empty." << std::endl;
+    if (!imageData || imageSize == 0) {
+        SPIN_LOG_ERROR("Raw image is invalid or empty.");
         return;
     }
 
-    // Determine the pixel format of the image being demosaiced
-    Spinnaker::PixelFormatEnums pixelFormat = static_cast<Spinnaker::PixelFormatEnums>(rawImage->GetPixelFormat());
-
     // Create a copy of the image to process
-    Spinnaker::ImagePtr imageCopy = Spinnaker::Image::Create(imageWidth, imageHeight, 0, 0, rawImage->GetPixelFormat(), imageData.data());
+    Spinnaker::ImagePtr imageCopy = Spinnaker::Image::Create(imageWidth, imageHeight, 0, 0, pixelFormat, imageData.get());
 
     // Approriately process (demoasaic) the image
     switch (pixelFormat) {
@@ -124,82 +402,409 @@ void SpinImage::Demosaic() {
             demosaicedImage = imageProcessor.Convert(imageCopy, Spinnaker::PixelFormatEnums::PixelFormat_Mono16);
             break;
         default:
-            std::cerr << "Unsupported pixel format for demosaicing." << std::endl;
+            SPIN_LOG_ERROR("Unsupported pixel format for demosaicing.");
             return;
     }
 }
 
-void SpinImage::SaveImage(const std::string& filename, Spinnaker::ImageFileFormat format) {
+void SpinImage::DemosaicInto(unsigned char* rgb, size_t rgbStride, const SpinDemosaicOptions& options) const {
+    if (!HasAllSamples()) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid or empty.");
+    }
+    if (pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8) {
+        SpinDemosaicer::Demosaic(imageData.get(), imageStride, imageWidth, imageHeight, rgb, rgbStride, options);
+    } else if (pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p || pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p ||
+               pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16) {
+        SpinDemosaicer::DemosaicPacked(imageData.get(), GetPaddedStride(), GetBitsPerPixel(), imageWidth, imageHeight, rgb, rgbStride, options);
+    } else {
+        throw std::runtime_error("[ ERROR ] Native demosaicing only supports BayerRG8, 10p, 12p and 16.");
+    }
+}
+
+SpinImage SpinImage::DemosaicToRGB8(const std::shared_ptr<SpinFramePool>& pool, const SpinDemosaicOptions& options) const {
+    const size_t size = static_cast<size_t>(imageWidth) * imageHeight * 3;
+    std::shared_ptr<unsigned char> buffer;
+    if (pool) {
+        buffer = pool->Acquire(size);
+    }
+    if (!buffer) {
+        buffer = std::shared_ptr<unsigned char>(new unsigned char[size], std::default_delete<unsigned char[]>());
+    }
+    DemosaicInto(buffer.get(), 0, options);
+
+    // The image holds the buffer until its last copy is gone
+    SpinImage rgb(buffer.get(), size, imageWidth, imageHeight, Spinnaker::PixelFormatEnums::PixelFormat_RGB8,
+                  [buffer]() {}, timestamp, frameID);
+    if (incomplete) {
+        rgb.MarkIncomplete(imageStatus);
+    }
+    return rgb;
+}
+
+unsigned char* SpinImage::DemosaicRegion(int x, int y, int width, int height, const SpinDemosaicOptions& options) {
+    if (!HasAllSamples()) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid or empty.");
+    }
+    if (pixelFormat != Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8) {
+        throw std::runtime_error("[ ERROR ] Native demosaicing only supports BayerRG8.");
+    }
+    if (!demosaicCache) {
+        demosaicCache = std::make_shared<SpinDemosaicCache>(imageData.get(), imageStride, imageWidth, imageHeight);
+    }
+    return demosaicCache->Region(x, y, width, height, options);
+}
+
+Spinnaker::ImagePtr SpinImage::GetColorImage() {
     if (demosaicedImage) {
-        demosaicedImage->Save(filename.c_str(), format);
+        return demosaicedImage;
+    }
+    if (pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8 && HasAllSamples()) {
+        // Finish the tiles (only the ones no region asked for yet)
+        unsigned char* rgb = DemosaicRegion(0, 0, imageWidth, imageHeight);
+        return Spinnaker::Image::Create(imageWidth, imageHeight, 0, 0, Spinnaker::PixelFormatEnums::PixelFormat_RGB8, rgb);
+    }
+    Demosaic();
+    return demosaicedImage;
+}
+
+void SpinImage::SaveImage(const std::string& filename, Spinnaker::ImageFileFormat format) {
+    Spinnaker::ImagePtr colorImage = GetColorImage();
+    if (!colorImage) {
+        SPIN_LOG_ERROR("Unable to save ", filename, ", the image could not be demosaiced.");
+        return;
+    }
+    colorImage->Save(filename.c_str(), format);
+}
+
+SpinPixelBuffer SpinImage::GetEncoderPixels(Spinnaker::ImagePtr& converted, std::vector<unsigned char>& storage) {
+    if (!imageData || imageSize == 0) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid or empty.");
+    }
+    const bool mono = pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono8 || pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono10p ||
+                      pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono12p || pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono16;
+
+    SpinPixelBuffer pixels;
+    pixels.width = imageWidth;
+    pixels.height = imageHeight;
+    pixels.channels = mono ? 1 : 3;
+    if (pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono8 || pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_RGB8) {
+        // Already what the encoders take
+        pixels.data = imageData.get();
+        pixels.stride = imageStride;
+        return pixels;
+    }
+
+    // Reuse the demosaiced image when it is 8 bits already, finish the native tiles of BayerRG8, unpack and demosaic the
+    // other raw formats natively into storage, convert the rest straight to 8 bits
+    if (demosaicedImage && pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8) {
+        converted = demosaicedImage;
+    } else if (pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8) {
+        pixels.data = DemosaicRegion(0, 0, imageWidth, imageHeight);
+        return pixels;
+    } else if (GetBitsPerPixel() > 0) {
+        storage.resize(static_cast<size_t>(imageWidth) * imageHeight * pixels.channels);
+        if (mono) {
+            UnpackTo8(storage.data());
+        } else {
+            DemosaicInto(storage.data());
+        }
+        pixels.data = storage.data();
+        return pixels;
     } else {
-        Demosaic();
-        SaveImage(filename, format);
+        Spinnaker::ImagePtr imageCopy = Spinnaker::Image::Create(imageWidth, imageHeight, 0, 0, pixelFormat, imageData.get());
+        converted = imageProcessor.Convert(imageCopy, mono ? Spinnaker::PixelFormatEnums::PixelFormat_Mono8 : Spinnaker::PixelFormatEnums::PixelFormat_RGB8);
+    }
+    if (!converted) {
+        throw std::runtime_error("[ ERROR ] Unable to convert the image to 8 bits for encoding.");
+    }
+    pixels.data = static_cast<const unsigned char*>(converted->GetData());
+    pixels.stride = converted->GetStride();
+    return pixels;
+}
+
+void SpinImage::SaveImage(const std::string& filename, const SpinEncodeOptions& options) {
+    Spinnaker::ImagePtr converted;
+    std::vector<unsigned char> storage;
+    SpinPixelBuffer pixels = GetEncoderPixels(converted, storage);
+    SpinImageEncoder::Save(filename, pixels, options);
+}
+
+void SpinImage::EncodeImage(const SpinEncodeOptions& options, std::vector<unsigned char>& output) {
+    Spinnaker::ImagePtr converted;
+    std::vector<unsigned char> storage;
+    SpinPixelBuffer pixels = GetEncoderPixels(converted, storage);
+    SpinImageEncoder::Create(options.codec == SpinEncoding::Codec::Auto ? SpinEncoding::Codec::Png : options.codec)->Encode(pixels, options, output);
+}
+
+namespace {
+    // The pattern must hold exactly one integer conversion (%d, %04d, %u ...), anything else would read garbage
+    void ValidateFilenamePattern(const std::string& pattern) {
+        int conversions = 0;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            if (pattern[i] != '%') {
+                continue;
+            }
+            if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+                i++;
+                continue;
+            }
+            size_t j = i + 1;
+            while (j < pattern.size() && std::strchr("-+ 0#", pattern[j])) j++;
+            while (j < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[j]))) j++;
+            if (j >= pattern.size() || !std::strchr("diu", pattern[j])) {
+                throw std::runtime_error("[ ERROR ] Unsupported conversion in filename pattern " + pattern);
+            }
+            conversions++;
+            i = j;
+        }
+        if (conversions != 1) throw std::runtime_error("[ ERROR ] Filename pattern " + pattern + " needs exactly one image number (e.g. %04d)");
+    }
+
+    std::string FormatFilename(const std::string& pattern, size_t index) {
+        std::vector<char> buffer(pattern.size() + 32);
+        int size = std::snprintf(buffer.data(), buffer.size(), pattern.c_str(), static_cast<int>(index));
+        if (size < 0) throw std::runtime_error("[ ERROR ] Unable to format filename pattern " + pattern);
+        if (static_cast<size_t>(size) >= buffer.size()) {
+            buffer.resize(static_cast<size_t>(size) + 1);
+            std::snprintf(buffer.data(), buffer.size(), pattern.c_str(), static_cast<int>(index));
+        }
+        return std::string(buffer.data(), static_cast<size_t>(size));
+    }
+}
+
+std::vector<SpinImageSaveResult> SpinImage::SaveImages(SpinImage* images, size_t count, const std::string& filenamePattern,
+                                                       const SpinImageSaveOptions& options) {
+    ValidateFilenamePattern(filenamePattern);
+    std::vector<SpinImageSaveResult> results(count);
+    for (size_t i = 0; i < count; ++i) {
+        results[i].filename = FormatFilename(filenamePattern, options.firstIndex + i);
+    }
+    if (count == 0) {
+        return results;
+    }
+
+    // Every worker holds at most one demosaiced image, so the worker count is the in-flight bound
+    size_t threadCount = options.threadCount > 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+    if (options.maxInFlight > 0) {
+        threadCount = std::min(threadCount, options.maxInFlight);
+    }
+    SpinThreadPool pool(std::min(threadCount, count));
+
+    SpinEncodeOptions encodeOptions = options.encodeOptions;
+    if (encodeOptions.threadCount == 0 && !encodeOptions.pool) {
+        encodeOptions.threadCount = 1;
+    }
+
+    pool.ParallelFor(count, [images, &results, &options, &encodeOptions](size_t i) {
+        SpinImage& image = images[i];
+        SpinImageSaveResult& result = results[i];
+        const bool wasDemosaiced = static_cast<bool>(image.demosaicedImage) || static_cast<bool>(image.demosaicCache);
+        try {
+            if (options.useEncoder) {
+                image.SaveImage(result.filename, encodeOptions);
+                result.success = true;
+                return;
+            }
+            Spinnaker::ImagePtr colorImage = image.GetColorImage();
+            if (!colorImage) {
+                result.error = "Image could not be demosaiced";
+                return;
+            }
+            colorImage->Save(result.filename.c_str(), options.format);
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        // Free the colour copy right away, unless it was there before or the caller wants it
+        if (!wasDemosaiced && !options.keepDemosaiced) {
+            image.demosaicedImage = nullptr;
+            image.demosaicCache = nullptr;
+        }
+    });
+
+    for (const SpinImageSaveResult& result : results) {
+        if (!result.success) {
+            SPIN_LOG_ERROR("Unable to save ", result.filename, ": ", result.error);
+        }
+    }
+    return results;
+}
+
+std::vector<SpinImageSaveResult> SpinImage::SaveImages(std::vector<SpinImage>& images, const std::string& filenamePattern,
+                                                       const SpinImageSaveOptions& options) {
+    return SaveImages(images.data(), images.size(), filenamePattern, options);
+}
+
+namespace {
+    // Red outline of the square of half size squareSize around (x, y), clipped to the image
+    template <typename Format>
+    void DrawSquare(const SpinImageView<Format>& view, int x, int y, int squareSize) {
+        const typename Format::Sample full = std::numeric_limits<typename Format::Sample>::max();
+        const typename Format::Sample red[3] = {full, 0, 0};
+        const int side = 2 * squareSize + 1;
+        view.Fill(x - squareSize, y - squareSize, side, 1, red);  // Top
+        view.Fill(x - squareSize, y + squareSize, side, 1, red);  // Bottom
+        view.Fill(x - squareSize, y - squareSize, 1, side, red);  // Left
+        view.Fill(x + squareSize, y - squareSize, 1, side, red);  // Right
+    }
+
+    // The colour of a pixel from a typed view, samples deeper than 8 bits keep their top 8 before the greens of a Bayer quad
+    // are averaged (as in SpinBayerStats)
+    template <typename View>
+    void ReadPixel(const View& view, int x, int y, unsigned char& R, unsigned char& G, unsigned char& B) {
+        typename View::Value red, green, blue;
+        view.GetRGB(x, y, red, green, blue, 8 * (sizeof(typename View::Value) - 1));
+        R = static_cast<unsigned char>(red);
+        G = static_cast<unsigned char>(green);
+        B = static_cast<unsigned char>(blue);
     }
 }
 
 void SpinImage::DrawRedSquare(int x, int y, int squareSize) {
+    // A BayerRG8 frame only needs the tiles under the square, anything else is demosaiced whole
+    if (!demosaicedImage && pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8) {
+        unsigned char* rgb = DemosaicRegion(x - squareSize, y - squareSize, 2 * squareSize + 1, 2 * squareSize + 1);
+        DrawSquare(SpinImageView<SpinPixel::RGB8>(rgb, imageWidth, imageHeight), x, y, squareSize);
+        // Asking for another demosaicing method later must not paint over the square
+        demosaicCache->Keep(x - squareSize, y - squareSize, 2 * squareSize + 1, 2 * squareSize + 1);
+        return;
+    }
     if (!demosaicedImage) {
         Demosaic();
-    }
-    unsigned char* imgData = static_cast<unsigned char*>(demosaicedImage->GetData());
-
-    for (int i = -squareSize; i <= squareSize; ++i) {
-        for (int j = -squareSize; j <= squareSize; ++j) {
-            if (i == -squareSize || i == squareSize || j == -squareSize || j == squareSize) {
-                int currentX = x + i;
-                int currentY = y + j;
-                if (currentX >= 0 && currentX < imageWidth && currentY >= 0 && currentY < imageHeight) {
-                    int index = (currentY * imageWidth + currentX) * 3;
-                    imgData[index] = 255;     // R
-                    imgData[index + 1] = 0;   // G
-                    imgData[index + 2] = 0;   // B
-                }
-            }
+        if (!demosaicedImage) {
+            return;
         }
     }
+
+    // Through a view of the demosaiced image's own layout and stride
+    unsigned char* data = static_cast<unsigned char*>(demosaicedImage->GetData());
+    const int width = static_cast<int>(demosaicedImage->GetWidth());
+    const int height = static_cast<int>(demosaicedImage->GetHeight());
+    switch (static_cast<Spinnaker::PixelFormatEnums>(demosaicedImage->GetPixelFormat())) {
+        case Spinnaker::PixelFormatEnums::PixelFormat_RGB8:
+            DrawSquare(SpinImageView<SpinPixel::RGB8>(data, width, height, demosaicedImage->GetStride()), x, y, squareSize);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_RGB16:
+            DrawSquare(SpinImageView<SpinPixel::RGB16>(data, width, height, demosaicedImage->GetStride()), x, y, squareSize);
+            break;
+        default:
+            SPIN_LOG_WARNING("Unable to draw a red square, the demosaiced image is not 8 or 16 bit RGB.");
+            break;
+    }
 }
 
 void SpinImage::GetPixelRGB(int x, int y, unsigned char& R, unsigned char& G, unsigned char& B) {
-    unsigned char* buffer = imageData.data();
-    int rowStride = imageWidth;
-
-    // Determine the Bayer pattern based on the position
-    if (x % 2 == 0 && y % 2 == 0) { // Red pixel
-        R = buffer[y * rowStride + x];
-        G = (buffer[y * rowStride + (x + 1)] + buffer[(y + 1) * rowStride + x]) / 2;
-        B = buffer[(y + 1) * rowStride + (x + 1)];
-    } else if (x % 2 == 1 && y % 2 == 0) { // Green pixel on Red row
-        G = buffer[y * rowStride + x];
-        R = buffer[y * rowStride + (x - 1)];
-        B = buffer[(y + 1) * rowStride + x];
-    } else if (x % 2 == 0 && y % 2 == 1) { // Green pixel on Blue row
-        G = buffer[y * rowStride + x];
-        R = buffer[(y - 1) * rowStride + x];
-        B = buffer[y * rowStride + (x + 1)];
-    } else { // Blue pixel
-        B = buffer[y * rowStride + x];
-        G = (buffer[y * rowStride + (x - 1)] + buffer[(y - 1) * rowStride + x]) / 2;
-        R = buffer[(y - 1) * rowStride + (x - 1)];
+    if (x < 0 || y < 0 || x >= imageWidth || y >= imageHeight) {
+        throw std::runtime_error("[ ERROR ] Pixel is outside the image.");
+    }
+
+    // The format is decided once here, the views read the pixel with their own fixed layout (read-only, so read-only data
+    // is never copied for it)
+    const SpinImage& image = *this;
+    switch (pixelFormat) {
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8:
+            ReadPixel(image.GetView<SpinPixel::BayerRG8>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerGR8:
+            ReadPixel(image.GetView<SpinPixel::BayerGR8>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerGB8:
+            ReadPixel(image.GetView<SpinPixel::BayerGB8>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerBG8:
+            ReadPixel(image.GetView<SpinPixel::BayerBG8>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16:
+            ReadPixel(image.GetView<SpinPixel::BayerRG16>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerGR16:
+            ReadPixel(image.GetView<SpinPixel::BayerGR16>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerGB16:
+            ReadPixel(image.GetView<SpinPixel::BayerGB16>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerBG16:
+            ReadPixel(image.GetView<SpinPixel::BayerBG16>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono8:
+            ReadPixel(image.GetView<SpinPixel::Mono8>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono16:
+            ReadPixel(image.GetView<SpinPixel::Mono16>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_RGB8:
+            ReadPixel(image.GetView<SpinPixel::RGB8>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_RGB16:
+            ReadPixel(image.GetView<SpinPixel::RGB16>(), x, y, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p:
+        case Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p:
+            // Packed samples have no byte of their own, a one pixel region unpacks just the rows around it
+            CalculateAverageColor(x, y, 1, 1, R, G, B);
+            break;
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono10p:
+        case Spinnaker::PixelFormatEnums::PixelFormat_Mono12p:
+            if (!HasAllSamples()) {
+                throw std::runtime_error("[ ERROR ] Raw image is invalid or empty.");
+            }
+            if (GetPaddedStride() > 0) {
+                SpinUnpacker::Unpack8(imageData.get() + static_cast<size_t>(y) * imageStride, GetBitsPerPixel(), static_cast<size_t>(x), 1, &R);
+            } else {
+                SpinUnpacker::Unpack8(imageData.get(), GetBitsPerPixel(), static_cast<size_t>(y) * imageWidth + x, 1, &R);
+            }
+            G = B = R;
+            break;
+        default:
+            throw std::runtime_error("[ ERROR ] Pixel format not supported by GetPixelRGB.");
     }
 }
 
 void SpinImage::CalculateAverageColor(int x, int y, int width, int height, unsigned char& R, unsigned char& G, unsigned char& B) {
-    unsigned long long totalR = 0, totalG = 0, totalB = 0;
-    int count = 0;
+    SpinRoi roi;
+    roi.x = x;
+    roi.y = y;
+    roi.width = width;
+    roi.height = height;
+    if (integralImage) {
+        integralImage->GetAverage(roi, R, G, B);
+        return;
+    }
+    const SpinRoiStats stats = CalculateRoiStats({roi})[0];
+    if (stats.pixelCount == 0) {
+        R = G = B = 0;
+        return;
+    }
+    R = static_cast<unsigned char>(stats.channels[0].sum / stats.pixelCount);
+    G = static_cast<unsigned char>(stats.channels[1].sum / stats.pixelCount);
+    B = static_cast<unsigned char>(stats.channels[2].sum / stats.pixelCount);
+}
 
-    for (int i = x; i < x + width; ++i) {
-        for (int j = y; j < y + height; ++j) {
-            unsigned char r, g, b;
-            GetPixelRGB(i, j, r, g, b);
-            totalR += r;
-            totalG += g;
-            totalB += b;
-            count++;
-        }
+SpinSampleLayout SpinImage::GetStatsLayout(int& bitsPerSample) const {
+    const SpinSampleLayout layout = GetSampleLayout(pixelFormat, bitsPerSample);
+    // Whole bytes per pixel are read row by row with the stride, packed samples as one stream
+    const size_t pixelBytes = GetPixelBytes(pixelFormat);
+    if (pixelBytes > 0) {
+        CheckView(pixelFormat, pixelBytes);
+    } else if (!HasAllSamples()) {
+        throw std::runtime_error("[ ERROR ] Raw image is invalid or empty.");
     }
+    return layout;
+}
+
+std::vector<SpinRoiStats> SpinImage::CalculateRoiStats(const std::vector<SpinRoi>& rois, const unsigned char* toneMap) const {
+    int bitsPerSample = 8;
+    const SpinSampleLayout layout = GetStatsLayout(bitsPerSample);
+    return SpinBayerStats::Compute(imageData.get(), GetPaddedStride(), imageWidth, imageHeight, rois, bitsPerSample, toneMap, layout);
+}
+
+void SpinImage::BuildIntegralImage(const unsigned char* toneMap) {
+    int bitsPerSample = 8;
+    const SpinSampleLayout layout = GetStatsLayout(bitsPerSample);
+    integralImage = std::make_shared<SpinBayerIntegralImage>(imageData.get(), GetPaddedStride(), imageWidth, imageHeight, bitsPerSample,
+                                                             toneMap, layout);
+}
 
-    R = static_cast<unsigned char>(totalR / count);
-    G = static_cast<unsigned char>(totalG / count);
-    B = static_cast<unsigned char>(totalB / count);
+std::shared_ptr<const SpinBayerIntegralImage> SpinImage::GetIntegralImage() const {
+    return integralImage;
 }
\ No newline at end of file
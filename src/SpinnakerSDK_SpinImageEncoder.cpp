@@ -0,0 +1,91 @@
+#include "../include/SpinnakerSDK_SpinImageEncoder.h"
+#include "../include/SpinnakerSDK_SpinJpegEncoder.h"
+#include "../include/SpinnakerSDK_SpinPngEncoder.h"
+#include "../include/SpinnakerSDK_SpinThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+std::unique_ptr<SpinImageEncoder> SpinImageEncoder::Create(SpinEncoding::Codec codec, const std::string& filename) {
+    if (codec == SpinEncoding::Codec::Auto) {
+        std::string extension;
+        size_t dot = filename.find_last_of('.');
+        if (dot != std::string::npos) {
+            extension = filename.substr(dot + 1);
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        }
+        if (extension == "jpg" || extension == "jpeg") {
+            codec = SpinEncoding::Codec::Jpeg;
+        } else if (extension.empty() || extension == "png") {
+            codec = SpinEncoding::Codec::Png;
+        } else {
+            throw std::runtime_error("[ ERROR ] No encoder for " + filename + ", use .png or .jpg");
+        }
+    }
+
+    switch (codec) {
+        case SpinEncoding::Codec::Png:
+            return std::unique_ptr<SpinImageEncoder>(new SpinPngEncoder());
+        case SpinEncoding::Codec::Jpeg:
+            return std::unique_ptr<SpinImageEncoder>(new SpinJpegEncoder());
+        default:
+            throw std::runtime_error("[ ERROR ] Unknown image codec.");
+    }
+}
+
+void SpinImageEncoder::Save(const std::string& filename, const SpinPixelBuffer& pixels, const SpinEncodeOptions& options) {
+    std::vector<unsigned char> encoded;
+    Create(options.codec, filename)->Encode(pixels, options, encoded);
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("[ ERROR ] Unable to open " + filename + " for writing: " + std::strerror(errno));
+    }
+    bool written = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+    written = (fclose(file) == 0) && written;
+    if (!written) {
+        throw std::runtime_error("[ ERROR ] Unable to write " + filename + ": " + std::strerror(errno));
+    }
+}
+
+std::unique_ptr<SpinThreadPool> SpinImageEncoder::CreateStripPool(size_t stripCount, SpinEncodeOptions& options) {
+    if (options.pool) {
+        return nullptr;
+    }
+    size_t threadCount = options.threadCount > 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, stripCount);
+    if (threadCount <= 1) {
+        return nullptr;
+    }
+    std::unique_ptr<SpinThreadPool> pool(new SpinThreadPool(threadCount));
+    options.pool = pool.get();
+    return pool;
+}
+
+void SpinImageEncoder::ForEachStrip(size_t stripCount, const SpinEncodeOptions& options, const std::function<void(size_t)>& body) {
+    if (options.pool) {
+        options.pool->ParallelFor(stripCount, body);
+        return;
+    }
+    for (size_t i = 0; i < stripCount; ++i) {
+        body(i);
+    }
+}
+
+int SpinImageEncoder::StripRows(int height, int rowMultiple, const SpinEncodeOptions& options) {
+    int rows = static_cast<int>(options.stripRows);
+    if (rows <= 0) {
+        // A few strips per thread evens out strips that compress at different speeds
+        size_t threadCount = options.pool ? options.pool->GetThreadCount()
+                                          : (options.threadCount > 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency()));
+        rows = threadCount <= 1 ? height : static_cast<int>((height + 4 * threadCount - 1) / (4 * threadCount));
+        // Very small strips cost more in per-strip overhead than they gain
+        rows = std::max(rows, 64);
+    }
+    rows = (rows + rowMultiple - 1) / rowMultiple * rowMultiple;
+    return std::max(rows, rowMultiple);
+}
@@ -0,0 +1,455 @@
+#include "../include/SpinnakerSDK_SpinJpegEncoder.h"
+#include "../include/SpinnakerSDK_SpinThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // Natural (row major) index of every zigzag position
+    const unsigned char kZigzag[64] = {
+        0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
+
+    // Quantization tables from Annex K of the JPEG standard (row major), scaled by the quality
+    const unsigned char kLuminanceQuantization[64] = {
+        16, 11, 10, 16, 24,  40,  51,  61,
+        12, 12, 14, 19, 26,  58,  60,  55,
+        14, 13, 16, 24, 40,  57,  69,  56,
+        14, 17, 22, 29, 51,  87,  80,  62,
+        18, 22, 37, 56, 68,  109, 103, 77,
+        24, 35, 55, 64, 81,  104, 113, 92,
+        49, 64, 78, 87, 103, 121, 120, 101,
+        72, 92, 95, 98, 112, 100, 103, 99};
+    const unsigned char kChrominanceQuantization[64] = {
+        17, 18, 24, 47, 99, 99, 99, 99,
+        18, 21, 26, 66, 99, 99, 99, 99,
+        24, 26, 56, 99, 99, 99, 99, 99,
+        47, 66, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99};
+
+    // Huffman tables from Annex K: number of codes of each length (1 to 16 bits), then the symbols in code order
+    const unsigned char kDcLuminanceBits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+    const unsigned char kDcChrominanceBits[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+    const unsigned char kDcValues[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    const unsigned char kAcLuminanceBits[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+    const unsigned char kAcLuminanceValues[162] = {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71,
+        0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72,
+        0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37,
+        0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+        0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83,
+        0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3,
+        0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+        0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa};
+    const unsigned char kAcChrominanceBits[16] = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+    const unsigned char kAcChrominanceValues[162] = {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22,
+        0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1,
+        0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36,
+        0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+        0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+        0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a,
+        0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+        0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+        0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa};
+
+    // Scale factors of the AAN DCT, folded into the quantization divisors
+    const float kAanScale[8] = {1.0f, 1.387039845f, 1.306562965f, 1.175875602f, 1.0f, 0.785694958f, 0.541196100f, 0.275899379f};
+
+    struct HuffmanTable {
+        uint16_t code[256];
+        uint8_t size[256];
+    };
+
+    HuffmanTable BuildHuffmanTable(const unsigned char* bits, const unsigned char* values) {
+        HuffmanTable table;
+        std::memset(&table, 0, sizeof(table));
+        uint16_t code = 0;
+        size_t k = 0;
+        for (int length = 1; length <= 16; ++length) {
+            for (int n = 0; n < bits[length - 1]; ++n, ++k) {
+                table.code[values[k]] = code++;
+                table.size[values[k]] = static_cast<uint8_t>(length);
+            }
+            code <<= 1;
+        }
+        return table;
+    }
+
+    // Quantization table in file order (zigzag) and the matching divisors for the AAN output (row major)
+    struct Quantization {
+        unsigned char table[64];
+        float divisor[64];
+    };
+
+    Quantization BuildQuantization(const unsigned char* base, int quality) {
+        Quantization quantization;
+        // The IJG quality scaling, so quality numbers mean what they mean in other tools
+        const int scale = quality < 50 ? 5000 / quality : 200 - 2 * quality;
+        for (int i = 0; i < 64; ++i) {
+            int value = (base[kZigzag[i]] * scale + 50) / 100;
+            quantization.table[i] = static_cast<unsigned char>(std::min(std::max(value, 1), 255));
+        }
+        for (int i = 0; i < 64; ++i) {
+            const int natural = kZigzag[i];
+            quantization.divisor[natural] = quantization.table[i] * kAanScale[natural / 8] * kAanScale[natural % 8] * 8.0f;
+        }
+        return quantization;
+    }
+
+    // Appends entropy coded bits, stuffing a zero after every 0xFF byte
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<unsigned char>& output) : output(output) {}
+
+        void Put(uint32_t bits, int size) {
+            buffer = (buffer << size) | (bits & ((1u << size) - 1));
+            count += size;
+            while (count >= 8) {
+                unsigned char byte = static_cast<unsigned char>(buffer >> (count - 8));
+                output.push_back(byte);
+                if (byte == 0xFF) {
+                    output.push_back(0);
+                }
+                count -= 8;
+            }
+            buffer &= (1u << count) - 1;
+        }
+
+        // Pad the last byte with ones, as the standard asks before a marker
+        void Flush() {
+            if (count > 0) {
+                Put((1u << (8 - count)) - 1, 8 - count);
+            }
+        }
+
+    private:
+        std::vector<unsigned char>& output;
+        uint32_t buffer = 0;
+        int count = 0;
+    };
+
+    // Arai, Agui and Nakajima float DCT, in place on a row major 8x8 block (output scaled by kAanScale)
+    void ForwardDct(float* block) {
+        for (int pass = 0; pass < 2; ++pass) {
+            // Rows in the first pass, columns in the second
+            const int step = pass == 0 ? 1 : 8;
+            const int next = pass == 0 ? 8 : 1;
+            for (int line = 0; line < 8; ++line) {
+                float* d = block + line * next;
+                float tmp0 = d[0] + d[7 * step];
+                float tmp7 = d[0] - d[7 * step];
+                float tmp1 = d[1 * step] + d[6 * step];
+                float tmp6 = d[1 * step] - d[6 * step];
+                float tmp2 = d[2 * step] + d[5 * step];
+                float tmp5 = d[2 * step] - d[5 * step];
+                float tmp3 = d[3 * step] + d[4 * step];
+                float tmp4 = d[3 * step] - d[4 * step];
+
+                // Even part
+                float tmp10 = tmp0 + tmp3;
+                float tmp13 = tmp0 - tmp3;
+                float tmp11 = tmp1 + tmp2;
+                float tmp12 = tmp1 - tmp2;
+                d[0] = tmp10 + tmp11;
+                d[4 * step] = tmp10 - tmp11;
+                float z1 = (tmp12 + tmp13) * 0.707106781f;
+                d[2 * step] = tmp13 + z1;
+                d[6 * step] = tmp13 - z1;
+
+                // Odd part
+                tmp10 = tmp4 + tmp5;
+                tmp11 = tmp5 + tmp6;
+                tmp12 = tmp6 + tmp7;
+                float z5 = (tmp10 - tmp12) * 0.382683433f;
+                float z2 = 0.541196100f * tmp10 + z5;
+                float z4 = 1.306562965f * tmp12 + z5;
+                float z3 = tmp11 * 0.707106781f;
+                float z11 = tmp7 + z3;
+                float z13 = tmp7 - z3;
+                d[5 * step] = z13 + z2;
+                d[3 * step] = z13 - z2;
+                d[1 * step] = z11 + z4;
+                d[7 * step] = z11 - z4;
+            }
+        }
+    }
+
+    int BitLength(int value) {
+        int length = 0;
+        value = std::abs(value);
+        while (value) {
+            length++;
+            value >>= 1;
+        }
+        return length;
+    }
+
+    void EncodeBlock(BitWriter& writer, float* block, const Quantization& quantization, int& dcPrediction,
+                     const HuffmanTable& dc, const HuffmanTable& ac) {
+        ForwardDct(block);
+        int coefficients[64];
+        for (int i = 0; i < 64; ++i) {
+            const int natural = kZigzag[i];
+            float value = block[natural] / quantization.divisor[natural];
+            coefficients[i] = static_cast<int>(value < 0.0f ? value - 0.5f : value + 0.5f);
+        }
+
+        // DC as the difference to the previous block of the same component
+        int difference = coefficients[0] - dcPrediction;
+        dcPrediction = coefficients[0];
+        int category = BitLength(difference);
+        writer.Put(dc.code[category], dc.size[category]);
+        if (category > 0) {
+            writer.Put(static_cast<uint32_t>(difference < 0 ? difference - 1 : difference), category);
+        }
+
+        // AC as (zero run, size) symbols
+        int run = 0;
+        for (int i = 1; i < 64; ++i) {
+            if (coefficients[i] == 0) {
+                run++;
+                continue;
+            }
+            while (run > 15) {
+                writer.Put(ac.code[0xF0], ac.size[0xF0]);
+                run -= 16;
+            }
+            category = BitLength(coefficients[i]);
+            int symbol = (run << 4) | category;
+            writer.Put(ac.code[symbol], ac.size[symbol]);
+            writer.Put(static_cast<uint32_t>(coefficients[i] < 0 ? coefficients[i] - 1 : coefficients[i]), category);
+            run = 0;
+        }
+        if (run > 0) {
+            writer.Put(ac.code[0x00], ac.size[0x00]);
+        }
+    }
+
+    void PutUint16(std::vector<unsigned char>& output, int value) {
+        output.push_back(static_cast<unsigned char>(value >> 8));
+        output.push_back(static_cast<unsigned char>(value));
+    }
+
+    void PutMarker(std::vector<unsigned char>& output, unsigned char marker, int length) {
+        output.push_back(0xFF);
+        output.push_back(marker);
+        if (length > 0) {
+            PutUint16(output, length);
+        }
+    }
+
+    void PutHuffmanTable(std::vector<unsigned char>& output, int tableClassAndId, const unsigned char* bits, const unsigned char* values, size_t valueCount) {
+        output.push_back(static_cast<unsigned char>(tableClassAndId));
+        output.insert(output.end(), bits, bits + 16);
+        output.insert(output.end(), values, values + valueCount);
+    }
+
+    struct Tables {
+        Quantization luminance;
+        Quantization chrominance;
+        HuffmanTable dcLuminance;
+        HuffmanTable acLuminance;
+        HuffmanTable dcChrominance;
+        HuffmanTable acChrominance;
+    };
+
+    // Encode the MCU rows [firstRow, lastRow), each followed by a restart marker unless it is the last row of the image
+    void EncodeRows(const SpinPixelBuffer& pixels, size_t stride, bool subsampling, const Tables& tables,
+                    int firstRow, int lastRow, int mcuRows, std::vector<unsigned char>& output) {
+        const int mcuSize = subsampling ? 16 : 8;
+        const int mcuColumns = (pixels.width + mcuSize - 1) / mcuSize;
+        const bool color = pixels.channels == 3;
+        BitWriter writer(output);
+
+        float y[256];
+        float cb[256];
+        float cr[256];
+        float block[64];
+        for (int mcuRow = firstRow; mcuRow < lastRow; ++mcuRow) {
+            int dcY = 0;
+            int dcCb = 0;
+            int dcCr = 0;
+            for (int mcuColumn = 0; mcuColumn < mcuColumns; ++mcuColumn) {
+                // Fetch the MCU, repeating the last row and column past the edge of the image
+                for (int row = 0; row < mcuSize; ++row) {
+                    const int sy = std::min(mcuRow * mcuSize + row, pixels.height - 1);
+                    const unsigned char* line = pixels.data + static_cast<size_t>(sy) * stride;
+                    for (int column = 0; column < mcuSize; ++column) {
+                        const int sx = std::min(mcuColumn * mcuSize + column, pixels.width - 1);
+                        const int i = row * mcuSize + column;
+                        if (color) {
+                            const float r = line[3 * sx];
+                            const float g = line[3 * sx + 1];
+                            const float b = line[3 * sx + 2];
+                            y[i] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+                            cb[i] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+                            cr[i] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+                        } else {
+                            y[i] = line[sx] - 128.0f;
+                        }
+                    }
+                }
+
+                // Luminance, one block or the four blocks of a 16x16 MCU
+                for (int by = 0; by < mcuSize; by += 8) {
+                    for (int bx = 0; bx < mcuSize; bx += 8) {
+                        for (int row = 0; row < 8; ++row) {
+                            std::memcpy(block + row * 8, y + (by + row) * mcuSize + bx, 8 * sizeof(float));
+                        }
+                        EncodeBlock(writer, block, tables.luminance, dcY, tables.dcLuminance, tables.acLuminance);
+                    }
+                }
+                if (!color) {
+                    continue;
+                }
+
+                // Chrominance, averaged over 2x2 pixels when subsampling
+                float* planes[2] = {cb, cr};
+                int* predictions[2] = {&dcCb, &dcCr};
+                for (int plane = 0; plane < 2; ++plane) {
+                    const float* source = planes[plane];
+                    if (subsampling) {
+                        for (int row = 0; row < 8; ++row) {
+                            for (int column = 0; column < 8; ++column) {
+                                const float* p = source + (2 * row) * 16 + 2 * column;
+                                block[row * 8 + column] = 0.25f * (p[0] + p[1] + p[16] + p[17]);
+                            }
+                        }
+                    } else {
+                        std::memcpy(block, source, 64 * sizeof(float));
+                    }
+                    EncodeBlock(writer, block, tables.chrominance, *predictions[plane], tables.dcChrominance, tables.acChrominance);
+                }
+            }
+
+            writer.Flush();
+            if (mcuRow + 1 < mcuRows) {
+                output.push_back(0xFF);
+                output.push_back(static_cast<unsigned char>(0xD0 + (mcuRow & 7)));
+            }
+        }
+    }
+}
+
+void SpinJpegEncoder::Encode(const SpinPixelBuffer& pixels, const SpinEncodeOptions& options, std::vector<unsigned char>& output) {
+    if (!pixels.data || pixels.width <= 0 || pixels.height <= 0 || (pixels.channels != 1 && pixels.channels != 3)) {
+        throw std::runtime_error("[ ERROR ] Invalid image for JPEG encoding.");
+    }
+    if (pixels.width > 65535 || pixels.height > 65535) {
+        throw std::runtime_error("[ ERROR ] Image is too large for JPEG.");
+    }
+    if (options.jpegQuality < 1 || options.jpegQuality > 100) {
+        throw std::runtime_error("[ ERROR ] JPEG quality must be between 1 and 100.");
+    }
+
+    const bool color = pixels.channels == 3;
+    const bool subsampling = color && options.jpegSubsampling;
+    const size_t stride = pixels.stride > 0 ? pixels.stride : static_cast<size_t>(pixels.width) * pixels.channels;
+    const int mcuSize = subsampling ? 16 : 8;
+    const int mcuColumns = (pixels.width + mcuSize - 1) / mcuSize;
+    const int mcuRows = (pixels.height + mcuSize - 1) / mcuSize;
+    if (mcuColumns > 65535) {
+        throw std::runtime_error("[ ERROR ] Image is too wide for a one row JPEG restart interval.");
+    }
+
+    Tables tables;
+    tables.luminance = BuildQuantization(kLuminanceQuantization, options.jpegQuality);
+    tables.chrominance = BuildQuantization(kChrominanceQuantization, options.jpegQuality);
+    tables.dcLuminance = BuildHuffmanTable(kDcLuminanceBits, kDcValues);
+    tables.acLuminance = BuildHuffmanTable(kAcLuminanceBits, kAcLuminanceValues);
+    tables.dcChrominance = BuildHuffmanTable(kDcChrominanceBits, kDcValues);
+    tables.acChrominance = BuildHuffmanTable(kAcChrominanceBits, kAcChrominanceValues);
+
+    // Entropy code strips of whole MCU rows in parallel
+    const int stripRows = StripRows(pixels.height, mcuSize, options) / mcuSize;
+    const size_t stripCount = static_cast<size_t>((mcuRows + stripRows - 1) / stripRows);
+    std::vector<std::vector<unsigned char>> strips(stripCount);
+    SpinEncodeOptions stripOptions = options;
+    std::unique_ptr<SpinThreadPool> stripPool = CreateStripPool(stripCount, stripOptions);
+    ForEachStrip(stripCount, stripOptions, [&](size_t i) {
+        const int firstRow = static_cast<int>(i) * stripRows;
+        const int lastRow = std::min(firstRow + stripRows, mcuRows);
+        strips[i].reserve(static_cast<size_t>(lastRow - firstRow) * mcuSize * stride / 4);
+        EncodeRows(pixels, stride, subsampling, tables, firstRow, lastRow, mcuRows, strips[i]);
+    });
+
+    output.clear();
+    size_t dataSize = 0;
+    for (const std::vector<unsigned char>& strip : strips) {
+        dataSize += strip.size();
+    }
+    output.reserve(dataSize + 1024);
+
+    PutMarker(output, 0xD8, 0);  // Start of image
+
+    // JFIF header, no thumbnail
+    PutMarker(output, 0xE0, 16);
+    const unsigned char jfif[] = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+    output.insert(output.end(), jfif, jfif + sizeof(jfif));
+
+    PutMarker(output, 0xDB, color ? 2 + 2 * 65 : 2 + 65);
+    output.push_back(0);
+    output.insert(output.end(), tables.luminance.table, tables.luminance.table + 64);
+    if (color) {
+        output.push_back(1);
+        output.insert(output.end(), tables.chrominance.table, tables.chrominance.table + 64);
+    }
+
+    // Baseline frame: luminance sampled 2x2 against chrominance when subsampling
+    const int components = color ? 3 : 1;
+    PutMarker(output, 0xC0, 8 + 3 * components);
+    output.push_back(8);
+    PutUint16(output, pixels.height);
+    PutUint16(output, pixels.width);
+    output.push_back(static_cast<unsigned char>(components));
+    output.push_back(1);
+    output.push_back(subsampling ? 0x22 : 0x11);
+    output.push_back(0);
+    if (color) {
+        output.push_back(2);
+        output.push_back(0x11);
+        output.push_back(1);
+        output.push_back(3);
+        output.push_back(0x11);
+        output.push_back(1);
+    }
+
+    PutMarker(output, 0xC4, 2 + (1 + 16 + 12) + (1 + 16 + 162) + (color ? (1 + 16 + 12) + (1 + 16 + 162) : 0));
+    PutHuffmanTable(output, 0x00, kDcLuminanceBits, kDcValues, 12);
+    PutHuffmanTable(output, 0x10, kAcLuminanceBits, kAcLuminanceValues, 162);
+    if (color) {
+        PutHuffmanTable(output, 0x01, kDcChrominanceBits, kDcValues, 12);
+        PutHuffmanTable(output, 0x11, kAcChrominanceBits, kAcChrominanceValues, 162);
+    }
+
+    // One restart interval per MCU row
+    PutMarker(output, 0xDD, 4);
+    PutUint16(output, mcuColumns);
+
+    PutMarker(output, 0xDA, 6 + 2 * components);
+    output.push_back(static_cast<unsigned char>(components));
+    output.push_back(1);
+    output.push_back(0x00);
+    if (color) {
+        output.push_back(2);
+        output.push_back(0x11);
+        output.push_back(3);
+        output.push_back(0x11);
+    }
+    output.push_back(0);
+    output.push_back(63);
+    output.push_back(0);
+
+    for (const std::vector<unsigned char>& strip : strips) {
+        output.insert(output.end(), strip.begin(), strip.end());
+    }
+    PutMarker(output, 0xD9, 0);  // End of image
+}
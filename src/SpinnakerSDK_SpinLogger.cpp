@@ -0,0 +1,203 @@
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+SpinLogger& SpinLogger::Instance() {
+    // Never destroyed, so messages logged from static destructors still have somewhere to go
+    static SpinLogger* logger = new SpinLogger();
+    return *logger;
+}
+
+SpinLogger::SpinLogger() : cells(new Cell[kRingSize]) {
+    static_assert((kRingSize & (kRingSize - 1)) == 0, "Log ring size must be a power of two");
+    for (size_t i = 0; i < kRingSize; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    running.store(true);
+    drainThread = std::thread(&SpinLogger::DrainLoop, this);
+    std::atexit([] { SpinLogger::Instance().Shutdown(); });
+}
+
+uint64_t SpinLogger::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void SpinLogger::SetLevel(SpinLogLevel level) {
+    runtimeLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+SpinLogLevel SpinLogger::GetLevel() const {
+    return static_cast<SpinLogLevel>(runtimeLevel.load(std::memory_order_relaxed));
+}
+
+void SpinLogger::SetSink(std::function<void(const SpinLogMessage&)> sink) {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    this->sink = sink;
+}
+
+const char* SpinLogger::LevelPrefix(SpinLogLevel level) {
+    switch (level) {
+        case SpinLogLevel::Debug:
+            return "[ DEBUG ] ";
+        case SpinLogLevel::Warning:
+            return "[ WARNING ] ";
+        case SpinLogLevel::Error:
+            return "[ ERROR ] ";
+        default:
+            return "";
+    }
+}
+
+void SpinLogger::AddText(Record& record, const char* value, size_t size) {
+    // Truncate to whatever room is left in the record
+    size = std::min(size, kMaxTextSize - record.textSize);
+    Argument& argument = NextArgument(record, Argument::Type::Text);
+    argument.text.offset = record.textSize;
+    argument.text.size = static_cast<uint16_t>(size);
+    std::memcpy(record.text + record.textSize, value, size);
+    record.textSize = static_cast<uint16_t>(record.textSize + size);
+}
+
+void SpinLogger::Push(const Record& record) {
+    // Once the logger thread is gone, write straight away
+    if (!running.load(std::memory_order_acquire)) {
+        Write(SpinLogMessage{record.level, record.timestamp, Format(record)});
+        return;
+    }
+
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[position & (kRingSize - 1)];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            // The cell is free for this position, claim it
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The ring is full
+            droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    cell->record = record;
+    cell->sequence.store(position + 1, std::memory_order_release);
+}
+
+std::string SpinLogger::Format(const Record& record) const {
+    std::ostringstream text;
+    for (size_t i = 0; i < record.argumentCount; ++i) {
+        const Argument& argument = record.arguments[i];
+        switch (argument.type) {
+            case Argument::Type::Literal:
+                text << argument.literal;
+                break;
+            case Argument::Type::Text:
+                text.write(record.text + argument.text.offset, argument.text.size);
+                break;
+            case Argument::Type::Signed:
+                text << argument.signedValue;
+                break;
+            case Argument::Type::Unsigned:
+                text << argument.unsignedValue;
+                break;
+            case Argument::Type::Float:
+                text << argument.floatValue;
+                break;
+            case Argument::Type::Bool:
+                text << argument.boolValue;
+                break;
+            case Argument::Type::Char:
+                text << argument.charValue;
+                break;
+            case Argument::Type::Pointer:
+                text << argument.pointerValue;
+                break;
+        }
+    }
+    return text.str();
+}
+
+void SpinLogger::Write(const SpinLogMessage& message) {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    if (sink) {
+        sink(message);
+    } else if (message.level == SpinLogLevel::Error) {
+        std::cerr << LevelPrefix(message.level) << message.text << '\n';
+    } else {
+        std::cout << LevelPrefix(message.level) << message.text << '\n';
+    }
+}
+
+size_t SpinLogger::Drain() {
+    size_t written = 0;
+    Record record;
+    while (true) {
+        const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell& cell = cells[position & (kRingSize - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;
+        }
+        record = cell.record;
+        // Hand the cell back to the producers for the next lap around the ring
+        cell.sequence.store(position + kRingSize, std::memory_order_release);
+        dequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+        Write(SpinLogMessage{record.level, record.timestamp, Format(record)});
+        writtenPosition.store(position + 1, std::memory_order_release);
+        written++;
+    }
+
+    const uint64_t dropped = droppedMessages.load(std::memory_order_relaxed);
+    if (dropped > reportedDrops) {
+        Write(SpinLogMessage{SpinLogLevel::Warning, Now(), "Logger dropped " + std::to_string(dropped - reportedDrops) + " messages (ring buffer full)."});
+        reportedDrops = dropped;
+        written++;
+    }
+
+    // One flush per batch instead of one per line
+    if (written > 0) {
+        std::cout.flush();
+    }
+    return written;
+}
+
+void SpinLogger::DrainLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (Drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void SpinLogger::Flush() {
+    const size_t target = enqueuePosition.load(std::memory_order_acquire);
+    while (running.load(std::memory_order_acquire) && writtenPosition.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void SpinLogger::BeginReport() {
+    Flush();
+}
+
+uint64_t SpinLogger::GetDroppedMessages() const {
+    return droppedMessages.load(std::memory_order_relaxed);
+}
+
+void SpinLogger::Shutdown() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+    // Whatever was queued before the thread stopped
+    Drain();
+}
@@ -0,0 +1,228 @@
+#include "../include/SpinnakerSDK_SpinPngEncoder.h"
+#include "../include/SpinnakerSDK_SpinThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace {
+    const size_t kWindowSize = 32768;  // Deflate history, primed from the previous strip
+    const size_t kMaxChunkSize = 1u << 30;
+
+    void PutUint32(std::vector<unsigned char>& output, uint32_t value) {
+        output.push_back(static_cast<unsigned char>(value >> 24));
+        output.push_back(static_cast<unsigned char>(value >> 16));
+        output.push_back(static_cast<unsigned char>(value >> 8));
+        output.push_back(static_cast<unsigned char>(value));
+    }
+
+    void WriteChunk(std::vector<unsigned char>& output, const char* type, const unsigned char* data, size_t size) {
+        PutUint32(output, static_cast<uint32_t>(size));
+        size_t start = output.size();
+        output.insert(output.end(), type, type + 4);
+        output.insert(output.end(), data, data + size);
+        PutUint32(output, static_cast<uint32_t>(crc32(0, output.data() + start, static_cast<uInt>(size + 4))));
+    }
+
+    unsigned char Paeth(int a, int b, int c) {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc) return static_cast<unsigned char>(a);
+        if (pb <= pc) return static_cast<unsigned char>(b);
+        return static_cast<unsigned char>(c);
+    }
+
+    // Filter one row into out, the first byte being the filter type (previous is null for the first row of the image)
+    void FilterRow(SpinEncoding::PngFilter filter, const unsigned char* row, const unsigned char* previous, size_t rowBytes, size_t bpp, unsigned char* out) {
+        out[0] = static_cast<unsigned char>(filter);
+        unsigned char* filtered = out + 1;
+        switch (filter) {
+            case SpinEncoding::PngFilter::None:
+                std::memcpy(filtered, row, rowBytes);
+                break;
+            case SpinEncoding::PngFilter::Sub:
+                std::memcpy(filtered, row, bpp);
+                for (size_t i = bpp; i < rowBytes; ++i) {
+                    filtered[i] = static_cast<unsigned char>(row[i] - row[i - bpp]);
+                }
+                break;
+            case SpinEncoding::PngFilter::Up:
+                if (!previous) {
+                    std::memcpy(filtered, row, rowBytes);
+                    break;
+                }
+                for (size_t i = 0; i < rowBytes; ++i) {
+                    filtered[i] = static_cast<unsigned char>(row[i] - previous[i]);
+                }
+                break;
+            case SpinEncoding::PngFilter::Average:
+                for (size_t i = 0; i < rowBytes; ++i) {
+                    int left = i >= bpp ? row[i - bpp] : 0;
+                    int up = previous ? previous[i] : 0;
+                    filtered[i] = static_cast<unsigned char>(row[i] - ((left + up) >> 1));
+                }
+                break;
+            case SpinEncoding::PngFilter::Paeth:
+                for (size_t i = 0; i < rowBytes; ++i) {
+                    int left = i >= bpp ? row[i - bpp] : 0;
+                    int up = previous ? previous[i] : 0;
+                    int upLeft = (i >= bpp && previous) ? previous[i - bpp] : 0;
+                    filtered[i] = static_cast<unsigned char>(row[i] - Paeth(left, up, upLeft));
+                }
+                break;
+            default:
+                throw std::runtime_error("[ ERROR ] Invalid PNG filter.");
+        }
+    }
+
+    // Sum of the filtered bytes taken as signed, the usual estimate of how well a row compresses
+    uint64_t FilterCost(const unsigned char* filtered, size_t rowBytes) {
+        uint64_t cost = 0;
+        for (size_t i = 1; i <= rowBytes; ++i) {
+            cost += static_cast<uint64_t>(std::abs(static_cast<int>(static_cast<signed char>(filtered[i]))));
+        }
+        return cost;
+    }
+
+    void FilterAdaptive(const unsigned char* row, const unsigned char* previous, size_t rowBytes, size_t bpp, unsigned char* out, std::vector<unsigned char>& scratch) {
+        scratch.resize(rowBytes + 1);
+        uint64_t bestCost = UINT64_MAX;
+        const SpinEncoding::PngFilter filters[] = {SpinEncoding::PngFilter::None, SpinEncoding::PngFilter::Sub, SpinEncoding::PngFilter::Up,
+                                                   SpinEncoding::PngFilter::Average, SpinEncoding::PngFilter::Paeth};
+        for (SpinEncoding::PngFilter filter : filters) {
+            FilterRow(filter, row, previous, rowBytes, bpp, scratch.data());
+            uint64_t cost = FilterCost(scratch.data(), rowBytes);
+            if (cost < bestCost) {
+                bestCost = cost;
+                std::memcpy(out, scratch.data(), rowBytes + 1);
+            }
+        }
+    }
+
+    struct Strip {
+        int firstRow = 0;
+        int rowCount = 0;
+        size_t offset = 0;   // Of the strip in the filtered image
+        size_t size = 0;
+        std::vector<unsigned char> compressed;
+        uLong adler = 1;
+    };
+}
+
+void SpinPngEncoder::Encode(const SpinPixelBuffer& pixels, const SpinEncodeOptions& options, std::vector<unsigned char>& output) {
+    if (!pixels.data || pixels.width <= 0 || pixels.height <= 0 || (pixels.channels != 1 && pixels.channels != 3)) {
+        throw std::runtime_error("[ ERROR ] Invalid image for PNG encoding.");
+    }
+    if (options.pngCompressionLevel < 0 || options.pngCompressionLevel > 9) {
+        throw std::runtime_error("[ ERROR ] PNG compression level must be between 0 and 9.");
+    }
+
+    const size_t bpp = static_cast<size_t>(pixels.channels);
+    const size_t rowBytes = static_cast<size_t>(pixels.width) * bpp;
+    const size_t stride = pixels.stride > 0 ? pixels.stride : rowBytes;
+    const size_t filteredRowBytes = rowBytes + 1;
+
+    const int stripRows = StripRows(pixels.height, 1, options);
+    std::vector<Strip> strips;
+    for (int row = 0; row < pixels.height; row += stripRows) {
+        Strip strip;
+        strip.firstRow = row;
+        strip.rowCount = std::min(stripRows, pixels.height - row);
+        strip.offset = static_cast<size_t>(row) * filteredRowBytes;
+        strip.size = static_cast<size_t>(strip.rowCount) * filteredRowBytes;
+        strips.push_back(std::move(strip));
+    }
+
+    // Both passes below run on the same threads
+    SpinEncodeOptions stripOptions = options;
+    std::unique_ptr<SpinThreadPool> stripPool = CreateStripPool(strips.size(), stripOptions);
+
+    // Filter every strip first, so each strip can prime its compressor with the end of the one before it
+    std::vector<unsigned char> filtered(static_cast<size_t>(pixels.height) * filteredRowBytes);
+    ForEachStrip(strips.size(), stripOptions, [&](size_t i) {
+        const Strip& strip = strips[i];
+        std::vector<unsigned char> scratch;
+        for (int y = strip.firstRow; y < strip.firstRow + strip.rowCount; ++y) {
+            const unsigned char* row = pixels.data + static_cast<size_t>(y) * stride;
+            const unsigned char* previous = y > 0 ? row - stride : nullptr;
+            unsigned char* out = filtered.data() + static_cast<size_t>(y) * filteredRowBytes;
+            if (options.pngFilter == SpinEncoding::PngFilter::Adaptive) {
+                FilterAdaptive(row, previous, rowBytes, bpp, out, scratch);
+            } else {
+                FilterRow(options.pngFilter, row, previous, rowBytes, bpp, out);
+            }
+        }
+    });
+
+    ForEachStrip(strips.size(), stripOptions, [&](size_t i) {
+        Strip& strip = strips[i];
+        const bool last = i + 1 == strips.size();
+        const unsigned char* input = filtered.data() + strip.offset;
+
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, options.pngCompressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("[ ERROR ] Unable to initialize PNG compression.");
+        }
+        if (i > 0) {
+            size_t dictionarySize = std::min(kWindowSize, strip.offset);
+            deflateSetDictionary(&stream, input - dictionarySize, static_cast<uInt>(dictionarySize));
+        }
+
+        // Room for the worst case plus the sync flush marker
+        strip.compressed.resize(deflateBound(&stream, static_cast<uLong>(strip.size)) + 64);
+        stream.next_in = const_cast<Bytef*>(input);
+        stream.avail_in = static_cast<uInt>(strip.size);
+        stream.next_out = strip.compressed.data();
+        stream.avail_out = static_cast<uInt>(strip.compressed.size());
+        // Only the last strip finishes the stream, the others end on a byte boundary so they can be concatenated
+        int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+        bool ok = last ? result == Z_STREAM_END : (result == Z_OK && stream.avail_in == 0);
+        strip.compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        if (!ok) {
+            throw std::runtime_error("[ ERROR ] PNG compression failed.");
+        }
+        strip.adler = adler32(1, input, static_cast<uInt>(strip.size));
+    });
+
+    // zlib stream: header, the strips back to back, checksum of all the filtered data
+    std::vector<unsigned char> zlibStream;
+    size_t compressedSize = 6;
+    for (const Strip& strip : strips) {
+        compressedSize += strip.compressed.size();
+    }
+    zlibStream.reserve(compressedSize);
+    const int level = options.pngCompressionLevel;
+    zlibStream.push_back(0x78);
+    zlibStream.push_back(level < 2 ? 0x01 : (level < 6 ? 0x5E : (level == 6 ? 0x9C : 0xDA)));
+    uLong adler = 1;
+    for (const Strip& strip : strips) {
+        zlibStream.insert(zlibStream.end(), strip.compressed.begin(), strip.compressed.end());
+        adler = adler32_combine(adler, strip.adler, static_cast<z_off_t>(strip.size));
+    }
+    PutUint32(zlibStream, static_cast<uint32_t>(adler));
+
+    output.clear();
+    output.reserve(zlibStream.size() + 64);
+    const unsigned char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    output.insert(output.end(), signature, signature + sizeof(signature));
+
+    std::vector<unsigned char> header;
+    PutUint32(header, static_cast<uint32_t>(pixels.width));
+    PutUint32(header, static_cast<uint32_t>(pixels.height));
+    header.push_back(8);                             // Bit depth
+    header.push_back(pixels.channels == 3 ? 2 : 0);  // Colour type: RGB or grey
+    header.push_back(0);                             // Deflate
+    header.push_back(0);                             // Adaptive filtering
+    header.push_back(0);                             // No interlace
+    WriteChunk(output, "IHDR", header.data(), header.size());
+
+    for (size_t offset = 0; offset < zlibStream.size(); offset += kMaxChunkSize) {
+        WriteChunk(output, "IDAT", zlibStream.data() + offset, std::min(kMaxChunkSize, zlibStream.size() - offset));
+    }
+    WriteChunk(output, "IEND", nullptr, 0);
+}
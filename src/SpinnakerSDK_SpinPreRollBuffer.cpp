@@ -0,0 +1,112 @@
+#include "../include/SpinnakerSDK_SpinPreRollBuffer.h"
+#include <algorithm>
+#include <stdexcept>
+
+SpinPreRollBuffer::SpinPreRollBuffer(size_t capacity) {
+    if (capacity == 0) {
+        throw std::runtime_error("[ ERROR ] Pre-roll buffer needs room for at least one frame.");
+    }
+    frames.assign(capacity, SpinImage(nullptr));
+}
+
+void SpinPreRollBuffer::Push(const SpinImage& frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames[head] = frame;
+        head = (head + 1) % frames.size();
+        if (count < frames.size()) {
+            count++;
+        }
+    }
+    frameArrived.notify_all();
+}
+
+void SpinPreRollBuffer::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Drop the references so leased or pooled buffers are handed back
+    for (SpinImage& frame : frames) {
+        frame = SpinImage(nullptr);
+    }
+    head = 0;
+    count = 0;
+}
+
+const SpinImage& SpinPreRollBuffer::At(size_t index) const {
+    return frames[(head + frames.size() - count + index) % frames.size()];
+}
+
+size_t SpinPreRollBuffer::ClosestIndex(uint64_t timestamp) const {
+    // Binary search for the first frame at or after the timestamp
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (At(middle).GetTimeStamp() < timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (low == count) {
+        return count - 1;
+    }
+    if (low == 0) {
+        return 0;
+    }
+
+    // Pick the nearer of the frames on either side (ties go to the frame after the timestamp)
+    const uint64_t distanceAfter = At(low).GetTimeStamp() - timestamp;
+    const uint64_t distanceBefore = timestamp - At(low - 1).GetTimeStamp();
+    return distanceAfter <= distanceBefore ? low : low - 1;
+}
+
+bool SpinPreRollBuffer::FindClosest(uint64_t timestamp, SpinImage& frame) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) {
+        return false;
+    }
+    frame = At(ClosestIndex(timestamp));
+    return true;
+}
+
+std::vector<SpinImage> SpinPreRollBuffer::GetWindow(uint64_t timestamp, size_t framesBefore, size_t framesAfter) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SpinImage> window;
+    if (count == 0) {
+        return window;
+    }
+
+    const size_t closest = ClosestIndex(timestamp);
+    const size_t first = closest >= framesBefore ? closest - framesBefore : 0;
+    const size_t last = std::min(closest + framesAfter, count - 1);
+    window.reserve(last - first + 1);
+    for (size_t i = first; i <= last; ++i) {
+        window.push_back(At(i));
+    }
+    return window;
+}
+
+size_t SpinPreRollBuffer::FramesFromClosest(uint64_t timestamp) const {
+    // Until a frame at or past the timestamp arrives, the closest frame may still change
+    if (count == 0 || At(count - 1).GetTimeStamp() < timestamp) {
+        return 0;
+    }
+    return count - ClosestIndex(timestamp);
+}
+
+bool SpinPreRollBuffer::WaitForFramesAfter(uint64_t timestamp, size_t framesAfter, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex);
+    return frameArrived.wait_for(lock, timeout, [this, timestamp, framesAfter] {
+        return FramesFromClosest(timestamp) > framesAfter;
+    });
+}
+
+size_t SpinPreRollBuffer::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+size_t SpinPreRollBuffer::Capacity() const {
+    return frames.size();
+}
@@ -0,0 +1,264 @@
+#include "../include/SpinnakerSDK_SpinRawReader.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // madvise wants a page aligned start, and pages can be larger than the 4096 byte record alignment
+    void Advise(unsigned char* base, uint64_t start, uint64_t end, int advice) {
+        const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        start -= start % pageSize;
+        if (end > start) {
+            madvise(base + start, static_cast<size_t>(end - start), advice);
+        }
+    }
+}
+
+SpinRawReader::Mapping::~Mapping() {
+    if (data) {
+        munmap(data, size);
+    }
+}
+
+SpinRawReader::SpinRawReader() : header() {}
+
+SpinRawReader::SpinRawReader(const std::string& filename) : header() {
+    Open(filename);
+}
+
+void SpinRawReader::Open(const std::string& filename) {
+    Close();
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("[ ERROR ] Unable to open " + filename + ": " + std::strerror(errno));
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<uint64_t>(status.st_size) < SpinRawFormat::kBlockSize) {
+        ::close(fd);
+        throw std::runtime_error("[ ERROR ] " + filename + " is not a raw recording.");
+    }
+
+    // Read-only, so the mapping is backed by the file alone and never counts against the commit charge
+    std::shared_ptr<Mapping> newMapping = std::make_shared<Mapping>();
+    newMapping->size = static_cast<size_t>(status.st_size);
+    void* data = mmap(nullptr, newMapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("[ ERROR ] Unable to map " + filename + ": " + std::strerror(errno));
+    }
+    newMapping->data = static_cast<unsigned char*>(data);
+
+    std::memcpy(&header, newMapping->data, sizeof(header));
+    if (header.magic != SpinRawFormat::kFileMagic) {
+        throw std::runtime_error("[ ERROR ] " + filename + " is not a raw recording.");
+    }
+    if (header.version != SpinRawFormat::kVersion) {
+        throw std::runtime_error("[ ERROR ] " + filename + " has unsupported raw format version " + std::to_string(header.version));
+    }
+
+    if (header.compression == static_cast<uint32_t>(SpinRawFormat::Compression::BayerLossless)) {
+        codec.reset(new SpinBayerCodec());
+    } else if (header.compression != static_cast<uint32_t>(SpinRawFormat::Compression::None)) {
+        throw std::runtime_error("[ ERROR ] " + filename + " uses unsupported compression " + std::to_string(header.compression));
+    }
+
+    this->filename = filename;
+    mapping = newMapping;
+    LoadIndex();
+
+    sorted = true;
+    for (size_t i = 1; i < frameCount && sorted; ++i) {
+        sorted = index[i].timestamp >= index[i - 1].timestamp;
+    }
+    if (!sorted) {
+        SPIN_LOG_WARNING("Timestamps in ", filename, " are not in order, timestamp lookups will be slow.");
+    }
+}
+
+void SpinRawReader::LoadIndex() {
+    const uint64_t indexBytes = header.indexCount * sizeof(SpinRawFormat::IndexEntry);
+    if (header.indexOffset == 0 || header.indexOffset % SpinRawFormat::kBlockSize != 0 ||
+        header.indexOffset + indexBytes > mapping->size) {
+        SPIN_LOG_WARNING(filename, " has no frame index (the recording was not closed), scanning its frames.");
+        RebuildIndex();
+        return;
+    }
+
+    index = reinterpret_cast<const SpinRawFormat::IndexEntry*>(mapping->data + header.indexOffset);
+    frameCount = static_cast<size_t>(header.indexCount);
+    storedIndex = true;
+    // The index is read once front to back, the frames in whatever order the caller likes
+    Advise(mapping->data, header.indexOffset, header.indexOffset + indexBytes, MADV_WILLNEED);
+    Advise(mapping->data, 0, header.indexOffset, MADV_RANDOM);
+}
+
+void SpinRawReader::RebuildIndex() {
+    // Walk the records until the data runs out or stops making sense (e.g. a partly written chunk)
+    rebuiltIndex.clear();
+    uint64_t offset = SpinRawFormat::kBlockSize;
+    while (offset + sizeof(SpinRawFormat::FrameHeader) <= mapping->size) {
+        SpinRawFormat::FrameHeader frameHeader;
+        std::memcpy(&frameHeader, mapping->data + offset, sizeof(frameHeader));
+        const bool compressed = frameHeader.magic == SpinRawFormat::kCompressedFrameMagic;
+        if ((frameHeader.magic != SpinRawFormat::kFrameMagic && !compressed) || frameHeader.sequence != rebuiltIndex.size() ||
+            frameHeader.recordSize == 0 || frameHeader.recordSize % SpinRawFormat::kBlockSize != 0 ||
+            frameHeader.headerSize + frameHeader.dataSize > frameHeader.recordSize ||
+            offset + frameHeader.recordSize > mapping->size) {
+            break;
+        }
+        uint64_t rawSize = 0;
+        if (compressed) {
+            try {
+                rawSize = SpinBayerCodec::GetDecodedSize(mapping->data + offset + frameHeader.headerSize, static_cast<size_t>(frameHeader.dataSize));
+            } catch (const std::exception&) {
+                break;
+            }
+        }
+
+        SpinRawFormat::IndexEntry entry = {};
+        entry.offset = offset;
+        entry.dataSize = frameHeader.dataSize;
+        entry.frameID = frameHeader.frameID;
+        entry.timestamp = frameHeader.timestamp;
+        entry.width = frameHeader.width;
+        entry.height = frameHeader.height;
+        entry.stride = frameHeader.height > 0 ? static_cast<uint32_t>((rawSize > 0 ? rawSize : frameHeader.dataSize) / frameHeader.height) : 0;
+        entry.pixelFormat = frameHeader.pixelFormat;
+        entry.imageStatus = frameHeader.imageStatus;
+        entry.headerSize = frameHeader.headerSize;
+        entry.rawSize = rawSize;
+        rebuiltIndex.push_back(entry);
+        offset += frameHeader.recordSize;
+    }
+
+    index = rebuiltIndex.data();
+    frameCount = rebuiltIndex.size();
+    storedIndex = false;
+    if (frameCount > 0) {
+        header.firstTimestamp = rebuiltIndex.front().timestamp;
+        header.lastTimestamp = rebuiltIndex.back().timestamp;
+    }
+    header.frameCount = frameCount;
+}
+
+void SpinRawReader::Close() {
+    // Frames still out there keep their own reference to the mapping
+    mapping.reset();
+    index = nullptr;
+    frameCount = 0;
+    rebuiltIndex.clear();
+    storedIndex = false;
+    sorted = true;
+    codec.reset();
+    header = SpinRawFormat::FileHeader();
+}
+
+bool SpinRawReader::IsOpen() const {
+    return mapping != nullptr;
+}
+
+size_t SpinRawReader::GetFrameCount() const {
+    return frameCount;
+}
+
+uint64_t SpinRawReader::GetFirstTimestamp() const {
+    return header.firstTimestamp;
+}
+
+uint64_t SpinRawReader::GetLastTimestamp() const {
+    return header.lastTimestamp;
+}
+
+bool SpinRawReader::HasStoredIndex() const {
+    return storedIndex;
+}
+
+const SpinRawFormat::IndexEntry& SpinRawReader::GetIndexEntry(size_t frame) const {
+    if (frame >= frameCount) throw std::runtime_error("[ ERROR ] Frame " + std::to_string(frame) + " is out of range (" + std::to_string(frameCount) + " frames)");
+    return index[frame];
+}
+
+SpinImage SpinRawReader::GetFrame(size_t frame) const {
+    const SpinRawFormat::IndexEntry& entry = GetIndexEntry(frame);
+    if (entry.offset + entry.headerSize + entry.dataSize > mapping->size) {
+        throw std::runtime_error("[ ERROR ] Frame " + std::to_string(frame) + " of " + filename + " is truncated");
+    }
+
+    if (entry.rawSize > 0) {
+        if (!codec) throw std::runtime_error("[ ERROR ] Frame " + std::to_string(frame) + " of " + filename + " is compressed in an uncompressed recording");
+        unsigned char* pixels = new unsigned char[entry.rawSize];
+        try {
+            codec->Decode(mapping->data + entry.offset + entry.headerSize, static_cast<size_t>(entry.dataSize), pixels, static_cast<size_t>(entry.rawSize));
+        } catch (...) {
+            delete[] pixels;
+            throw;
+        }
+        SpinImage image(pixels, static_cast<size_t>(entry.rawSize), static_cast<int>(entry.width), static_cast<int>(entry.height),
+                        static_cast<Spinnaker::PixelFormatEnums>(entry.pixelFormat),
+                        [pixels]() { delete[] pixels; }, entry.timestamp, entry.frameID, entry.stride);
+        if (entry.imageStatus != 0) {
+            image.MarkIncomplete(entry.imageStatus);
+        }
+        return image;
+    }
+
+    std::shared_ptr<Mapping> frameMapping = mapping;
+    SpinImage image(mapping->data + entry.offset + entry.headerSize, static_cast<size_t>(entry.dataSize),
+                    static_cast<int>(entry.width), static_cast<int>(entry.height),
+                    static_cast<Spinnaker::PixelFormatEnums>(entry.pixelFormat),
+                    [frameMapping]() {}, entry.timestamp, entry.frameID, entry.stride);
+    image.MarkReadOnly();
+    if (entry.imageStatus != 0) {
+        image.MarkIncomplete(entry.imageStatus);
+    }
+    return image;
+}
+
+size_t SpinRawReader::FindFrame(uint64_t timestamp) const {
+    if (sorted) {
+        const SpinRawFormat::IndexEntry* found = std::lower_bound(index, index + frameCount, timestamp,
+            [](const SpinRawFormat::IndexEntry& entry, uint64_t value) { return entry.timestamp < value; });
+        return static_cast<size_t>(found - index);
+    }
+    for (size_t i = 0; i < frameCount; ++i) {
+        if (index[i].timestamp >= timestamp) {
+            return i;
+        }
+    }
+    return frameCount;
+}
+
+std::vector<SpinImage> SpinRawReader::GetFrames(uint64_t startTimestamp, uint64_t endTimestamp) const {
+    std::vector<SpinImage> frames;
+    if (sorted) {
+        for (size_t i = FindFrame(startTimestamp); i < frameCount && index[i].timestamp < endTimestamp; ++i) {
+            frames.push_back(GetFrame(i));
+        }
+    } else {
+        for (size_t i = 0; i < frameCount; ++i) {
+            if (index[i].timestamp >= startTimestamp && index[i].timestamp < endTimestamp) {
+                frames.push_back(GetFrame(i));
+            }
+        }
+    }
+    return frames;
+}
+
+void SpinRawReader::Prefetch(size_t firstFrame, size_t frameCount) const {
+    if (firstFrame >= this->frameCount || frameCount == 0) {
+        return;
+    }
+    const size_t lastFrame = std::min(firstFrame + frameCount, this->frameCount) - 1;
+    const uint64_t start = index[firstFrame].offset;
+    const uint64_t end = index[lastFrame].offset + index[lastFrame].headerSize + index[lastFrame].dataSize;
+    if (end <= mapping->size) {
+        Advise(mapping->data, start, end, MADV_WILLNEED);
+    }
+}
@@ -0,0 +1,538 @@
+#include "../include/SpinnakerSDK_SpinRawRecorder.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SpinRawRecorder::SpinRawRecorder(const SpinRawRecorderConfig& config) : config(config) {
+    if (config.chunkCount == 0 || config.writerThreads == 0) {
+        throw std::runtime_error("[ ERROR ] Raw recorder needs at least one chunk and one writer thread.");
+    }
+    if (config.compression != SpinRawFormat::Compression::None && config.compression != SpinRawFormat::Compression::BayerLossless) {
+        throw std::runtime_error("[ ERROR ] Unknown raw recording compression.");
+    }
+    if (config.compression != SpinRawFormat::Compression::None && config.compressionQueue == 0) {
+        throw std::runtime_error("[ ERROR ] Raw recorder compression needs a queue of at least one frame.");
+    }
+}
+
+SpinRawRecorder::~SpinRawRecorder() {
+    try {
+        Close();
+    } catch (const std::exception& e) {
+        SPIN_LOG_ERROR("Exception caught while closing raw recording: ", e.what());
+    }
+}
+
+void SpinRawRecorder::Open(const std::string& filename, size_t maxFrameSize) {
+    if (fd >= 0) throw std::runtime_error("[ ERROR ] Raw recorder is already recording to " + this->filename);
+
+    // Open for direct I/O where the platform and file system allow it
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    directIO = false;
+#ifdef O_DIRECT
+    if (config.directIO) {
+        fd = open(filename.c_str(), flags | O_DIRECT, 0644);
+        directIO = fd >= 0;
+    }
+#endif
+    if (fd < 0) {
+        fd = open(filename.c_str(), flags, 0644);
+    }
+    if (fd < 0) {
+        throw std::runtime_error("[ ERROR ] Unable to open " + filename + " for recording: " + std::strerror(errno));
+    }
+#ifdef F_NOCACHE
+    if (config.directIO) {
+        directIO = fcntl(fd, F_NOCACHE, 1) == 0;
+    }
+#endif
+    if (config.directIO && !directIO) {
+        SPIN_LOG_WARNING("Direct I/O unavailable for ", filename, ", recording through the page cache.");
+    }
+
+    // Reserve the space up front, so the file system does not have to find blocks mid-recording
+    if (config.preallocateBytes > 0) {
+        int result = 0;
+#if defined(__linux__)
+        result = posix_fallocate(fd, 0, static_cast<off_t>(config.preallocateBytes));
+#elif defined(F_PREALLOCATE)
+        fstore_t store = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(config.preallocateBytes), 0};
+        if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+            store.fst_flags = F_ALLOCATEALL;
+            result = fcntl(fd, F_PREALLOCATE, &store) == -1 ? errno : 0;
+        }
+#endif
+        if (result != 0) {
+            SPIN_LOG_WARNING("Unable to preallocate ", config.preallocateBytes, " bytes for ", filename, ": ", std::strerror(result));
+        }
+    }
+
+    this->filename = filename;
+    chunkSize = std::max<size_t>(config.chunkSize, SpinRawFormat::RecordSize(maxFrameSize));
+    chunkSize = (chunkSize + SpinRawFormat::kBlockSize - 1) / SpinRawFormat::kBlockSize * SpinRawFormat::kBlockSize;
+    try {
+        AllocateChunks();
+    } catch (...) {
+        ::close(fd);
+        fd = -1;
+        throw;
+    }
+
+    nextOffset = SpinRawFormat::kBlockSize;
+    nextSequence = 0;
+    firstTimestamp = 0;
+    lastTimestamp = 0;
+    warnedOversize = false;
+    index.clear();
+    indexOffset = 0;
+    failedRanges.clear();
+    framesWritten = 0;
+    bytesWritten = 0;
+    framesDropped = 0;
+    writeErrors = 0;
+    framesLost = 0;
+    blockedNs = 0;
+    rawBytes = 0;
+    storedBytes = 0;
+    peakChunksInFlight = 0;
+    stopping = false;
+    openTime = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < config.writerThreads; ++i) {
+        writers.emplace_back(&SpinRawRecorder::WriterLoop, this);
+    }
+    if (config.compression == SpinRawFormat::Compression::BayerLossless) {
+        codec.reset(new SpinBayerCodec(config.codecOptions));
+        compressionQueue.clear();
+        compressorStopping = false;
+        compressor = std::thread(&SpinRawRecorder::CompressorLoop, this);
+    }
+    SPIN_LOG_INFO("Recording raw frames to ", filename, " (", config.chunkCount, " chunks of ", chunkSize, " bytes, ",
+                  config.writerThreads, " writers", directIO ? ", direct I/O" : "", codec ? ", compressed)" : ")");
+}
+
+void SpinRawRecorder::AllocateChunks() {
+    chunks.assign(config.chunkCount, Chunk());
+    freeChunks.clear();
+    queuedChunks.clear();
+    chunksInFlight = 0;
+    for (Chunk& chunk : chunks) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, SpinRawFormat::kBlockSize, chunkSize) != 0) {
+            FreeChunks();
+            throw std::runtime_error("[ ERROR ] Unable to allocate raw recorder chunks.");
+        }
+        // Touch every page now rather than on the first frame
+        std::memset(memory, 0, chunkSize);
+        chunk.data = static_cast<unsigned char*>(memory);
+        freeChunks.push_back(&chunk);
+    }
+}
+
+void SpinRawRecorder::FreeChunks() {
+    for (Chunk& chunk : chunks) {
+        free(chunk.data);
+        chunk.data = nullptr;
+    }
+    chunks.clear();
+    freeChunks.clear();
+    queuedChunks.clear();
+    current = nullptr;
+}
+
+bool SpinRawRecorder::IsOpen() const {
+    return fd >= 0;
+}
+
+bool SpinRawRecorder::AcquireChunk(bool wait) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (freeChunks.empty()) {
+        if (!wait) {
+            return false;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        chunkFree.wait(lock, [this] { return !freeChunks.empty(); });
+        blockedNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()),
+                            std::memory_order_relaxed);
+    }
+    current = freeChunks.front();
+    freeChunks.pop_front();
+    current->used = 0;
+    current->frames = 0;
+    current->offset = nextOffset;
+    return true;
+}
+
+void SpinRawRecorder::Dispatch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queuedChunks.push_back(current);
+        chunksInFlight++;
+        peakChunksInFlight = std::max(peakChunksInFlight, chunksInFlight);
+    }
+    current = nullptr;
+    chunkQueued.notify_one();
+}
+
+bool SpinRawRecorder::Push(const SpinImage& frame) {
+    std::lock_guard<std::mutex> producerLock(producerMutex);
+    if (fd < 0) {
+        return false;
+    }
+    if (!codec) {
+        return AppendRecord(frame, frame.GetData(), frame.GetDataSize(), 0, config.blockWhenFull);
+    }
+
+    // The compressor works on a copy, so leased buffers go back to the camera right away
+    SpinImage queued = frame.IsLeased() ? frame.Detach() : frame;
+    {
+        std::unique_lock<std::mutex> lock(compressionMutex);
+        if (compressionQueue.size() >= config.compressionQueue) {
+            if (!config.blockWhenFull) {
+                framesDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            frameTaken.wait(lock, [this] { return compressionQueue.size() < config.compressionQueue; });
+            blockedNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()),
+                                std::memory_order_relaxed);
+        }
+        compressionQueue.push_back(queued);
+    }
+    frameQueued.notify_one();
+    return true;
+}
+
+void SpinRawRecorder::CompressorLoop() {
+    std::vector<unsigned char> encoded;
+    while (true) {
+        std::unique_lock<std::mutex> lock(compressionMutex);
+        frameQueued.wait(lock, [this] { return compressorStopping || !compressionQueue.empty(); });
+        if (compressionQueue.empty()) {
+            return;
+        }
+        SpinImage frame = compressionQueue.front();
+        compressionQueue.pop_front();
+        lock.unlock();
+        frameTaken.notify_one();
+
+        // Frames the codec cannot handle, or that would not fit a chunk, are stored as they are
+        bool compressed = false;
+        if (frame.GetDataSize() > 0 && SpinBayerCodec::GetBitsPerPixel(frame.GetPixelFormat()) > 0) {
+            try {
+                codec->Encode(frame, encoded);
+                compressed = encoded.size() < frame.GetDataSize() && SpinRawFormat::RecordSize(encoded.size()) <= chunkSize;
+            } catch (const std::exception& e) {
+                SPIN_LOG_DEBUG("Frame ", frame.GetFrameID(), " stored uncompressed: ", e.what());
+            }
+        }
+        // Waiting for a chunk here is fine, Push drops once the queue in front of the compressor is full
+        if (compressed) {
+            AppendRecord(frame, encoded.data(), encoded.size(), frame.GetDataSize(), true);
+        } else {
+            AppendRecord(frame, frame.GetData(), frame.GetDataSize(), 0, true);
+        }
+    }
+}
+
+void SpinRawRecorder::StopCompressor() {
+    if (!compressor.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(compressionMutex);
+        compressorStopping = true;
+    }
+    frameQueued.notify_all();
+    compressor.join();
+    codec.reset();
+}
+
+bool SpinRawRecorder::AppendRecord(const SpinImage& frame, const unsigned char* data, uint64_t dataSize, uint64_t rawSize, bool wait) {
+    const uint64_t recordSize = SpinRawFormat::RecordSize(dataSize);
+    if (recordSize > chunkSize) {
+        if (!warnedOversize) {
+            SPIN_LOG_WARNING("Frame of ", dataSize, " bytes does not fit the raw recorder chunks, pass the frame size to Open.");
+            warnedOversize = true;
+        }
+        framesDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Move on to the next chunk once this one is full
+    if (current && current->used + recordSize > chunkSize) {
+        Dispatch();
+    }
+    if (!current && !AcquireChunk(wait)) {
+        // Every chunk is still waiting on the disk
+        framesDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    unsigned char* record = current->data + current->used;
+    SpinRawFormat::FrameHeader header = {};
+    header.magic = rawSize > 0 ? SpinRawFormat::kCompressedFrameMagic : SpinRawFormat::kFrameMagic;
+    header.headerSize = sizeof(SpinRawFormat::FrameHeader);
+    header.recordSize = recordSize;
+    header.dataSize = dataSize;
+    header.frameID = frame.GetFrameID();
+    header.timestamp = frame.GetTimeStamp();
+    header.width = static_cast<uint32_t>(frame.GetWidth());
+    header.height = static_cast<uint32_t>(frame.GetHeight());
+    header.pixelFormat = static_cast<int32_t>(frame.GetPixelFormat());
+    header.imageStatus = frame.IsIncomplete() ? frame.GetImageStatus() : 0;
+    header.sequence = nextSequence;
+    std::memcpy(record, &header, sizeof(header));
+    if (dataSize > 0) {
+        std::memcpy(record + sizeof(header), data, dataSize);
+    }
+    // Zero the padding so recordings are reproducible
+    std::memset(record + sizeof(header) + dataSize, 0, recordSize - sizeof(header) - dataSize);
+
+    SpinRawFormat::IndexEntry entry = {};
+    entry.offset = nextOffset;
+    entry.dataSize = dataSize;
+    entry.frameID = header.frameID;
+    entry.timestamp = header.timestamp;
+    entry.width = header.width;
+    entry.height = header.height;
+    entry.stride = static_cast<uint32_t>(frame.GetStride());
+    entry.pixelFormat = header.pixelFormat;
+    entry.imageStatus = header.imageStatus;
+    entry.headerSize = header.headerSize;
+    entry.rawSize = rawSize;
+    index.push_back(entry);
+    rawBytes.fetch_add(rawSize > 0 ? rawSize : dataSize, std::memory_order_relaxed);
+    storedBytes.fetch_add(dataSize, std::memory_order_relaxed);
+
+    current->used += recordSize;
+    current->frames++;
+    nextOffset += recordSize;
+    if (nextSequence == 0) {
+        firstTimestamp = header.timestamp;
+    }
+    lastTimestamp = header.timestamp;
+    nextSequence++;
+    return true;
+}
+
+std::function<void(SpinImage&)> SpinRawRecorder::GetStreamHandler() {
+    return [this](SpinImage& frame) {
+        Push(frame);
+    };
+}
+
+void SpinRawRecorder::WriterLoop() {
+    while (true) {
+        Chunk* chunk = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            chunkQueued.wait(lock, [this] { return stopping || !queuedChunks.empty(); });
+            if (queuedChunks.empty()) {
+                return;
+            }
+            chunk = queuedChunks.front();
+            queuedChunks.pop_front();
+        }
+
+        const bool written = WriteAt(chunk->data, chunk->used, chunk->offset);
+        if (written) {
+            framesWritten.fetch_add(chunk->frames, std::memory_order_relaxed);
+            bytesWritten.fetch_add(chunk->used, std::memory_order_relaxed);
+        } else {
+            writeErrors.fetch_add(1, std::memory_order_relaxed);
+            framesLost.fetch_add(chunk->frames, std::memory_order_relaxed);
+            SPIN_LOG_ERROR("Unable to write ", chunk->frames, " raw frames to ", filename, ": ", std::strerror(errno));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // The chunk's frames are a hole in the file now, the index must not point at them
+            if (!written) {
+                failedRanges.emplace_back(chunk->offset, chunk->offset + chunk->used);
+            }
+            freeChunks.push_back(chunk);
+            chunksInFlight--;
+        }
+        chunkFree.notify_one();
+    }
+}
+
+bool SpinRawRecorder::WriteAt(const unsigned char* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        const ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+uint64_t SpinRawRecorder::WriteIndex() {
+    // Frames of chunks that never reached the disk are left out, the first and last timestamps are those of frames kept
+    if (!failedRanges.empty()) {
+        index.erase(std::remove_if(index.begin(), index.end(), [this](const SpinRawFormat::IndexEntry& entry) {
+            return std::any_of(failedRanges.begin(), failedRanges.end(), [&entry](const std::pair<uint64_t, uint64_t>& range) {
+                return entry.offset >= range.first && entry.offset < range.second;
+            });
+        }), index.end());
+        firstTimestamp = index.empty() ? 0 : index.front().timestamp;
+        lastTimestamp = index.empty() ? 0 : index.back().timestamp;
+    }
+
+    // The writers are stopped, so their chunks serve as aligned staging buffers
+    indexOffset = nextOffset;
+    const size_t entriesPerChunk = chunkSize / sizeof(SpinRawFormat::IndexEntry);
+    unsigned char* buffer = chunks.front().data;
+    uint64_t offset = indexOffset;
+    auto entry = index.begin();
+    while (entry != index.end()) {
+        size_t count = 0;
+        for (; count < entriesPerChunk && entry != index.end(); ++count, ++entry) {
+            std::memcpy(buffer + count * sizeof(SpinRawFormat::IndexEntry), &*entry, sizeof(SpinRawFormat::IndexEntry));
+        }
+        // Direct I/O writes whole blocks, the excess is trimmed off again by Close
+        const size_t size = count * sizeof(SpinRawFormat::IndexEntry);
+        const size_t paddedSize = (size + SpinRawFormat::kBlockSize - 1) / SpinRawFormat::kBlockSize * SpinRawFormat::kBlockSize;
+        std::memset(buffer + size, 0, paddedSize - size);
+        if (!WriteAt(buffer, paddedSize, offset)) {
+            writeErrors.fetch_add(1, std::memory_order_relaxed);
+            SPIN_LOG_ERROR("Unable to write the frame index of ", filename, ": ", std::strerror(errno));
+            indexOffset = 0;
+            return nextOffset;
+        }
+        offset += size;
+    }
+    return offset;
+}
+
+void SpinRawRecorder::WriteFileHeader() {
+    // The header block goes through the same (possibly direct) descriptor, so it needs an aligned buffer too
+    void* memory = nullptr;
+    if (posix_memalign(&memory, SpinRawFormat::kBlockSize, SpinRawFormat::kBlockSize) != 0) {
+        throw std::runtime_error("[ ERROR ] Unable to allocate raw recording header.");
+    }
+    std::memset(memory, 0, SpinRawFormat::kBlockSize);
+
+    SpinRawFormat::FileHeader header = {};
+    header.magic = SpinRawFormat::kFileMagic;
+    header.version = SpinRawFormat::kVersion;
+    header.headerSize = SpinRawFormat::kBlockSize;
+    header.blockSize = SpinRawFormat::kBlockSize;
+    header.compression = static_cast<uint32_t>(config.compression);
+    header.frameCount = nextSequence - framesLost.load();
+    header.dataSize = nextOffset - SpinRawFormat::kBlockSize;
+    header.firstTimestamp = firstTimestamp;
+    header.lastTimestamp = lastTimestamp;
+    header.indexOffset = indexOffset;
+    header.indexCount = indexOffset > 0 ? index.size() : 0;
+    std::memcpy(memory, &header, sizeof(header));
+
+    const bool written = WriteAt(static_cast<unsigned char*>(memory), SpinRawFormat::kBlockSize, 0);
+    free(memory);
+    if (!written) {
+        writeErrors.fetch_add(1, std::memory_order_relaxed);
+        SPIN_LOG_ERROR("Unable to write the header of ", filename, ": ", std::strerror(errno));
+    }
+}
+
+void SpinRawRecorder::Close() {
+    std::lock_guard<std::mutex> producerLock(producerMutex);
+    if (fd < 0) {
+        return;
+    }
+
+    // Compress what is still queued first, it ends up in the chunks
+    StopCompressor();
+
+    // Queue the last partial chunk, then let the writers finish everything queued
+    if (current && current->used > 0) {
+        Dispatch();
+    } else if (current) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeChunks.push_back(current);
+        current = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    chunkQueued.notify_all();
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    writers.clear();
+
+    const uint64_t end = WriteIndex();
+    WriteFileHeader();
+    // Give back whatever was preallocated beyond the recording
+    if (ftruncate(fd, static_cast<off_t>(end)) != 0) {
+        SPIN_LOG_WARNING("Unable to trim ", filename, ": ", std::strerror(errno));
+    }
+    ::close(fd);
+    fd = -1;
+    FreeChunks();
+    index = std::deque<SpinRawFormat::IndexEntry>();
+
+    SPIN_LOG_INFO("Raw recording ", filename, " closed with ", nextSequence - framesLost.load(), " frames");
+    if (framesDropped.load() > 0) {
+        SPIN_LOG_WARNING("Raw recorder dropped ", framesDropped.load(), " frames, see PrintStats.");
+    }
+}
+
+SpinRawRecorderStats SpinRawRecorder::GetStats() const {
+    SpinRawRecorderStats stats;
+    stats.framesWritten = framesWritten.load(std::memory_order_relaxed);
+    stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    stats.framesDropped = framesDropped.load(std::memory_order_relaxed);
+    stats.writeErrors = writeErrors.load(std::memory_order_relaxed);
+    stats.framesLost = framesLost.load(std::memory_order_relaxed);
+    stats.blockedNs = blockedNs.load(std::memory_order_relaxed);
+    stats.rawBytes = rawBytes.load(std::memory_order_relaxed);
+    stats.storedBytes = storedBytes.load(std::memory_order_relaxed);
+    if (stats.storedBytes > 0) {
+        stats.compressionRatio = static_cast<double>(stats.rawBytes) / stats.storedBytes;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.chunksInFlight = chunksInFlight;
+        stats.peakChunksInFlight = peakChunksInFlight;
+    }
+    stats.chunkCount = config.chunkCount;
+    stats.directIO = directIO;
+    stats.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - openTime).count();
+    if (stats.elapsedSeconds > 0.0) {
+        stats.megabytesPerSecond = stats.bytesWritten / 1e6 / stats.elapsedSeconds;
+    }
+    return stats;
+}
+
+void SpinRawRecorder::PrintStats() const {
+    SpinLogger::Instance().BeginReport();
+    SpinRawRecorderStats stats = GetStats();
+    std::cout << "===== Raw Recorder =====" << std::endl;
+    std::cout << "File: " << filename << std::endl;
+    std::cout << "Direct I/O: " << (stats.directIO ? "Yes" : "No") << std::endl;
+    std::cout << "Frames Written: " << stats.framesWritten << std::endl;
+    std::cout << "Bytes Written: " << stats.bytesWritten << std::endl;
+    std::cout << "Throughput: " << stats.megabytesPerSecond << " MB/s" << std::endl;
+    std::cout << "Compression Ratio: " << stats.compressionRatio << std::endl;
+    std::cout << "Frames Dropped: " << stats.framesDropped << std::endl;
+    std::cout << "Write Errors: " << stats.writeErrors << " (" << stats.framesLost << " frames lost)" << std::endl;
+    std::cout << "Blocked: " << stats.blockedNs / 1e6 << " ms" << std::endl;
+    std::cout << "Chunks In Flight: " << stats.chunksInFlight << " (peak " << stats.peakChunksInFlight << " of " << stats.chunkCount << ")" << std::endl;
+    std::cout << "========================" << std::endl;
+}
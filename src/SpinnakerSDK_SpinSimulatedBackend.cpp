@@ -0,0 +1,695 @@
+#include "../include/SpinnakerSDK_SpinSimulatedBackend.h"
+#include <algorithm>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    // Image status reported for injected incomplete frames (missing packets)
+    const int kMissingPacketsStatus = 3;
+
+    // Buffer count used while StreamBufferCountMode is Auto
+    const int64_t kAutoBufferCount = 10;
+
+    struct FormatInfo {
+        Spinnaker::PixelFormatEnums format;
+        int bitsPerPixel;
+        bool bayer;
+    };
+
+    const std::unordered_map<std::string, FormatInfo> PixelFormat_info = {
+        {"BayerRG8",   {Spinnaker::PixelFormat_BayerRG8,   8,  true}},
+        {"BayerRG10p", {Spinnaker::PixelFormat_BayerRG10p, 10, true}},
+        {"BayerRG12p", {Spinnaker::PixelFormat_BayerRG12p, 12, true}},
+        {"BayerRG16",  {Spinnaker::PixelFormat_BayerRG16,  16, true}},
+        {"Mono8",      {Spinnaker::PixelFormat_Mono8,      8,  false}},
+        {"Mono10p",    {Spinnaker::PixelFormat_Mono10p,    10, false}},
+        {"Mono12p",    {Spinnaker::PixelFormat_Mono12p,    12, false}},
+        {"Mono16",     {Spinnaker::PixelFormat_Mono16,     16, false}}
+    };
+
+    const FormatInfo& GetFormatInfo(const std::string& pixelFormat) {
+        auto option = PixelFormat_info.find(pixelFormat);
+        if (option == PixelFormat_info.end()) {
+            throw std::runtime_error("[ ERROR ] Simulated camera does not support pixel format " + pixelFormat);
+        }
+        return option->second;
+    }
+
+    std::vector<std::string> PixelFormatNames() {
+        std::vector<std::string> names;
+        for (const auto& format : PixelFormat_info) {
+            names.push_back(format.first);
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+}
+
+struct SpinSimulatedBackend::Stream {
+    // A frame waiting in the output queue
+    struct QueuedFrame {
+        size_t buffer;
+        uint64_t timestamp;
+        uint64_t frameID;
+        bool incomplete;
+    };
+
+    std::mutex mutex;
+    std::condition_variable frameQueued;  // Also signalled when the stream stops
+    bool running = true;
+
+    // Frame geometry, fixed for the whole acquisition
+    int width = 0;
+    int height = 0;
+    size_t frameSize = 0;
+    Spinnaker::PixelFormatEnums pixelFormat = Spinnaker::PixelFormat_BayerRG8;
+    int bitsPerPixel = 8;
+    bool bayer = true;
+
+    // Every buffer is either free, queued or leased out
+    std::vector<std::unique_ptr<unsigned char[]>> buffers;
+    std::vector<size_t> freeBuffers;
+    std::deque<QueuedFrame> queue;
+    std::string handlingMode;
+    int64_t framesToAcquire = -1;  // -1 while acquiring continuously
+
+    // Hand out a queued frame as a lease, the buffer goes back to the free list once the last copy is dropped
+    static SpinImage Lease(const std::shared_ptr<Stream>& stream, const QueuedFrame& frame) {
+        const size_t buffer = frame.buffer;
+        std::shared_ptr<Stream> owner = stream;
+        SpinImage image(stream->buffers[buffer].get(), stream->frameSize, stream->width, stream->height, stream->pixelFormat,
+                        [owner, buffer]() {
+                            std::lock_guard<std::mutex> lock(owner->mutex);
+                            owner->freeBuffers.push_back(buffer);
+                        },
+                        frame.timestamp, frame.frameID);
+        if (frame.incomplete) {
+            image.MarkIncomplete(kMissingPacketsStatus);
+        }
+        return image;
+    }
+};
+
+SpinSimulatedBackend::SpinSimulatedBackend(const SpinSimulatedCameraConfig& config)
+    : config(config), random(config.seed) {
+    if (config.sensorWidth <= 0 || config.sensorHeight <= 0) {
+        throw std::runtime_error("[ ERROR ] Simulated camera needs a positive sensor size.");
+    }
+    if (config.frameRate <= 0.0) {
+        throw std::runtime_error("[ ERROR ] Simulated camera needs a positive frame rate.");
+    }
+    GetFormatInfo(config.pixelFormat);
+}
+
+SpinSimulatedBackend::~SpinSimulatedBackend() {
+    DeInit();
+}
+
+void SpinSimulatedBackend::Init() {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    if (initialized) {
+        return;
+    }
+    nodes.clear();
+
+    // Geometry and format
+    AddInteger("SensorWidth", config.sensorWidth, config.sensorWidth, config.sensorWidth);
+    AddInteger("SensorHeight", config.sensorHeight, config.sensorHeight, config.sensorHeight);
+    nodes["SensorWidth"].readOnly = true;
+    nodes["SensorHeight"].readOnly = true;
+    AddInteger("Width", config.sensorWidth, 8, config.sensorWidth, true);
+    AddInteger("Height", config.sensorHeight, 8, config.sensorHeight, true);
+    AddInteger("OffsetX", 0, 0, 0, true);
+    AddInteger("OffsetY", 0, 0, 0, true);
+    AddInteger("BinningHorizontal", 1, 1, 4, true);
+    AddInteger("BinningVertical", 1, 1, 4, true);
+    AddInteger("DecimationHorizontal", 1, 1, 4, true);
+    AddInteger("DecimationVertical", 1, 1, 4, true);
+    AddEnumeration("PixelFormat", config.pixelFormat, PixelFormatNames(), true);
+    AddInteger("PayloadSize", 0, 0, INT64_MAX);
+    nodes["PayloadSize"].readOnly = true;
+
+    // Acquisition
+    AddEnumeration("AcquisitionMode", "Continuous", {"Continuous", "SingleFrame", "MultiFrame"}, true);
+    AddInteger("AcquisitionFrameCount", 2, 1, 10000, true);
+    AddBoolean("AcquisitionFrameRateEnable", false);
+    AddFloat("AcquisitionFrameRate", config.frameRate, 1.0, config.frameRate, "", "AcquisitionFrameRateEnable");
+    AddFloat("AcquisitionResultingFrameRate", config.frameRate, 0.0, config.frameRate);
+    nodes["AcquisitionResultingFrameRate"].readOnly = true;
+
+    // Exposure, gain and tone
+    AddEnumeration("ExposureAuto", "Continuous", {"Off", "Once", "Continuous"});
+    AddFloat("ExposureTime", 5000.0, 10.0, 30000000.0, "ExposureAuto");
+    AddEnumeration("GainAuto", "Continuous", {"Off", "Once", "Continuous"});
+    AddFloat("Gain", 0.0, 0.0, 47.99, "GainAuto");
+    AddBoolean("GammaEnable", true);
+    AddFloat("Gamma", 0.8, 0.25, 4.0, "", "GammaEnable");
+    AddBoolean("BlackLevelEnable", true);
+    AddEnumeration("BlackLevelAuto", "Off", {"Off", "Once", "Continuous"});
+    AddFloat("BlackLevel", 0.0, 0.0, 10.0, "BlackLevelAuto", "BlackLevelEnable");
+    AddEnumeration("BalanceWhiteAuto", "Continuous", {"Off", "Once", "Continuous"});
+    AddEnumeration("BalanceRatioSelector", "Red", {"Red", "Blue"});
+    AddFloat("BalanceRatio", 1.0, 0.25, 8.0, "BalanceWhiteAuto");
+    balanceRatios = {{"Red", 1.0}, {"Blue", 1.0}};
+
+    // Stream
+    AddEnumeration("StreamBufferHandlingMode", "OldestFirst", {"OldestFirst", "OldestFirstOverwrite", "NewestOnly", "NewestFirst"}, true);
+    AddEnumeration("StreamBufferCountMode", "Auto", {"Auto", "Manual"}, true);
+    AddInteger("StreamBufferCountManual", kAutoBufferCount, 1, 1000, true);
+    AddInteger("StreamLostFrameCount", 0, 0, INT64_MAX);
+    nodes["StreamLostFrameCount"].readOnly = true;
+
+    // Clock
+    AddCommand("TimestampLatch");
+    AddInteger("TimestampLatchValue", 0, 0, INT64_MAX);
+    nodes["TimestampLatchValue"].readOnly = true;
+
+    UpdateDerivedNodes();
+    clockStart = std::chrono::steady_clock::now();
+    initialized = true;
+}
+
+void SpinSimulatedBackend::DeInit() {
+    bool streaming = false;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        streaming = stream != nullptr;
+    }
+    if (streaming) {
+        EndAcquisition();
+    }
+    UnregisterImageHandler();
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    nodes.clear();
+    initialized = false;
+}
+
+std::string SpinSimulatedBackend::GetSerialNumber() {
+    return config.serialNumber;
+}
+
+void SpinSimulatedBackend::AddInteger(const std::string& name, int64_t value, int64_t min, int64_t max, bool lockedWhileAcquiring) {
+    Node node;
+    node.type = NodeType::Integer;
+    node.intValue = value;
+    node.intMin = min;
+    node.intMax = max;
+    node.lockedWhileAcquiring = lockedWhileAcquiring;
+    nodes[name] = node;
+}
+
+void SpinSimulatedBackend::AddFloat(const std::string& name, double value, double min, double max, const std::string& autoNode, const std::string& enableNode) {
+    Node node;
+    node.type = NodeType::Float;
+    node.floatValue = value;
+    node.floatMin = min;
+    node.floatMax = max;
+    node.autoNode = autoNode;
+    node.enableNode = enableNode;
+    nodes[name] = node;
+}
+
+void SpinSimulatedBackend::AddBoolean(const std::string& name, bool value) {
+    Node node;
+    node.type = NodeType::Boolean;
+    node.boolValue = value;
+    nodes[name] = node;
+}
+
+void SpinSimulatedBackend::AddEnumeration(const std::string& name, const std::string& value, const std::vector<std::string>& entries, bool lockedWhileAcquiring) {
+    Node node;
+    node.type = NodeType::Enumeration;
+    node.enumValue = value;
+    node.entries = entries;
+    node.lockedWhileAcquiring = lockedWhileAcquiring;
+    nodes[name] = node;
+}
+
+void SpinSimulatedBackend::AddCommand(const std::string& name) {
+    Node node;
+    node.type = NodeType::Command;
+    nodes[name] = node;
+}
+
+SpinSimulatedBackend::Node& SpinSimulatedBackend::GetNode(const std::string& name, NodeType type) {
+    auto found = nodes.find(name);
+    if (found == nodes.end()) {
+        throw std::runtime_error("[ ERROR ] Node " + name + " not available");
+    }
+    if (found->second.type != type) {
+        throw std::runtime_error("[ ERROR ] Node " + name + " has a different type");
+    }
+    return found->second;
+}
+
+bool SpinSimulatedBackend::IsWritableLocked(const std::string& name) {
+    auto found = nodes.find(name);
+    if (found == nodes.end()) {
+        return false;
+    }
+    const Node& node = found->second;
+    if (node.readOnly || (node.lockedWhileAcquiring && acquiring)) {
+        return false;
+    }
+    if (!node.autoNode.empty() && nodes[node.autoNode].enumValue != "Off") {
+        return false;
+    }
+    if (!node.enableNode.empty() && !nodes[node.enableNode].boolValue) {
+        return false;
+    }
+    return true;
+}
+
+void SpinSimulatedBackend::UpdateDerivedNodes() {
+    // Binning and decimation shrink the largest possible image
+    Node& width = nodes["Width"];
+    Node& height = nodes["Height"];
+    Node& offsetX = nodes["OffsetX"];
+    Node& offsetY = nodes["OffsetY"];
+    width.intMax = config.sensorWidth / (nodes["BinningHorizontal"].intValue * nodes["DecimationHorizontal"].intValue);
+    height.intMax = config.sensorHeight / (nodes["BinningVertical"].intValue * nodes["DecimationVertical"].intValue);
+    width.intValue = std::min(width.intValue, width.intMax);
+    height.intValue = std::min(height.intValue, height.intMax);
+    offsetX.intMax = width.intMax - width.intValue;
+    offsetY.intMax = height.intMax - height.intValue;
+    offsetX.intValue = std::min(offsetX.intValue, offsetX.intMax);
+    offsetY.intValue = std::min(offsetY.intValue, offsetY.intMax);
+
+    const FormatInfo& format = GetFormatInfo(nodes["PixelFormat"].enumValue);
+    nodes["PayloadSize"].intValue = (width.intValue * height.intValue * format.bitsPerPixel + 7) / 8;
+
+    // The frame rate is capped by the exposure time
+    double frameRate = config.frameRate;
+    if (nodes["AcquisitionFrameRateEnable"].boolValue) {
+        frameRate = nodes["AcquisitionFrameRate"].floatValue;
+    }
+    frameRate = std::min(frameRate, 1000000.0 / nodes["ExposureTime"].floatValue);
+    nodes["AcquisitionResultingFrameRate"].floatValue = frameRate;
+}
+
+uint64_t SpinSimulatedBackend::DeviceTime() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - clockStart).count());
+}
+
+bool SpinSimulatedBackend::IsReadable(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return nodes.find(node) != nodes.end();
+}
+
+bool SpinSimulatedBackend::IsWritable(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return IsWritableLocked(node);
+}
+
+int64_t SpinSimulatedBackend::GetIntegerValue(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Integer).intValue;
+}
+
+int64_t SpinSimulatedBackend::GetIntegerMin(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Integer).intMin;
+}
+
+int64_t SpinSimulatedBackend::GetIntegerMax(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Integer).intMax;
+}
+
+void SpinSimulatedBackend::SetIntegerValue(const std::string& node, int64_t value) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    Node& integer = GetNode(node, NodeType::Integer);
+    if (!IsWritableLocked(node)) throw std::runtime_error("[ ERROR ] Node " + node + " is not writable");
+    if (value < integer.intMin || value > integer.intMax) throw std::runtime_error("[ ERROR ] Value out of range for node " + node);
+    integer.intValue = value;
+    UpdateDerivedNodes();
+}
+
+double SpinSimulatedBackend::GetFloatValue(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Float).floatValue;
+}
+
+double SpinSimulatedBackend::GetFloatMin(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Float).floatMin;
+}
+
+double SpinSimulatedBackend::GetFloatMax(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Float).floatMax;
+}
+
+void SpinSimulatedBackend::SetFloatValue(const std::string& node, double value) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    Node& floating = GetNode(node, NodeType::Float);
+    if (!IsWritableLocked(node)) throw std::runtime_error("[ ERROR ] Node " + node + " is not writable");
+    if (value < floating.floatMin || value > floating.floatMax) throw std::runtime_error("[ ERROR ] Value out of range for node " + node);
+    floating.floatValue = value;
+    if (node == "BalanceRatio") {
+        balanceRatios[nodes["BalanceRatioSelector"].enumValue] = value;
+    }
+    UpdateDerivedNodes();
+}
+
+bool SpinSimulatedBackend::GetBooleanValue(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Boolean).boolValue;
+}
+
+void SpinSimulatedBackend::SetBooleanValue(const std::string& node, bool value) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    Node& boolean = GetNode(node, NodeType::Boolean);
+    if (!IsWritableLocked(node)) throw std::runtime_error("[ ERROR ] Node " + node + " is not writable");
+    boolean.boolValue = value;
+    UpdateDerivedNodes();
+}
+
+std::string SpinSimulatedBackend::GetEnumerationValue(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    return GetNode(node, NodeType::Enumeration).enumValue;
+}
+
+bool SpinSimulatedBackend::IsEnumerationEntryReadable(const std::string& node, const std::string& entry) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    auto found = nodes.find(node);
+    if (found == nodes.end() || found->second.type != NodeType::Enumeration) {
+        return false;
+    }
+    const std::vector<std::string>& entries = found->second.entries;
+    return std::find(entries.begin(), entries.end(), entry) != entries.end();
+}
+
+void SpinSimulatedBackend::SetEnumerationValue(const std::string& node, const std::string& entry) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    Node& enumeration = GetNode(node, NodeType::Enumeration);
+    if (!IsWritableLocked(node)) throw std::runtime_error("[ ERROR ] Node " + node + " is not writable");
+    if (std::find(enumeration.entries.begin(), enumeration.entries.end(), entry) == enumeration.entries.end()) {
+        throw std::runtime_error("[ ERROR ] Entry " + entry + " of " + node + " not available");
+    }
+
+    // One-shot automatic modes settle immediately and switch themselves off
+    enumeration.enumValue = (entry == "Once") ? "Off" : entry;
+
+    // The balance ratio node shows the ratio of the selected channel
+    if (node == "BalanceRatioSelector") {
+        nodes["BalanceRatio"].floatValue = balanceRatios[entry];
+    }
+    UpdateDerivedNodes();
+}
+
+void SpinSimulatedBackend::ExecuteCommand(const std::string& node) {
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    GetNode(node, NodeType::Command);
+    if (node == "TimestampLatch") {
+        nodes["TimestampLatchValue"].intValue = static_cast<int64_t>(DeviceTime());
+    }
+}
+
+void SpinSimulatedBackend::BeginAcquisition() {
+    std::shared_ptr<Stream> newStream = std::make_shared<Stream>();
+    {
+        std::lock_guard<std::mutex> lock(nodeMutex);
+        if (!initialized) throw std::runtime_error("[ ERROR ] Unable to start camera Acquisition");
+        if (acquiring) throw std::runtime_error("[ ERROR ] Camera acquisition already started");
+
+        // Freeze the frame geometry and allocate the stream buffers
+        newStream->width = static_cast<int>(nodes["Width"].intValue);
+        newStream->height = static_cast<int>(nodes["Height"].intValue);
+        const FormatInfo& format = GetFormatInfo(nodes["PixelFormat"].enumValue);
+        newStream->pixelFormat = format.format;
+        newStream->bitsPerPixel = format.bitsPerPixel;
+        newStream->bayer = format.bayer;
+        newStream->frameSize = static_cast<size_t>(nodes["PayloadSize"].intValue);
+        newStream->handlingMode = nodes["StreamBufferHandlingMode"].enumValue;
+        int64_t bufferCount = kAutoBufferCount;
+        if (nodes["StreamBufferCountMode"].enumValue == "Manual") {
+            bufferCount = nodes["StreamBufferCountManual"].intValue;
+        }
+        for (int64_t i = 0; i < bufferCount; ++i) {
+            newStream->buffers.emplace_back(new unsigned char[newStream->frameSize]);
+            newStream->freeBuffers.push_back(static_cast<size_t>(i));
+        }
+
+        const std::string& mode = nodes["AcquisitionMode"].enumValue;
+        if (mode == "SingleFrame") {
+            newStream->framesToAcquire = 1;
+        } else if (mode == "MultiFrame") {
+            newStream->framesToAcquire = nodes["AcquisitionFrameCount"].intValue;
+        }
+
+        nodes["StreamLostFrameCount"].intValue = 0;
+        acquiring = true;
+    }
+
+    generatedFrames = 0;
+    injectedDrops = 0;
+    injectedIncompletes = 0;
+    generator = std::thread(&SpinSimulatedBackend::GeneratorLoop, this, newStream);
+    std::lock_guard<std::mutex> lock(streamMutex);
+    stream = newStream;
+}
+
+void SpinSimulatedBackend::EndAcquisition() {
+    // Take the stream over, so GetNextImage calls from now on fail while the ones already waiting keep theirs alive
+    std::shared_ptr<Stream> ending;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        ending.swap(stream);
+    }
+    if (!ending) throw std::runtime_error("[ ERROR ] Unable to end camera Acquisition");
+
+    {
+        std::lock_guard<std::mutex> lock(ending->mutex);
+        ending->running = false;
+        // Frames nobody picked up go back to the free list, leased ones stay valid until dropped
+        for (const Stream::QueuedFrame& frame : ending->queue) {
+            ending->freeBuffers.push_back(frame.buffer);
+        }
+        ending->queue.clear();
+    }
+    ending->frameQueued.notify_all();
+    if (generator.joinable()) {
+        generator.join();
+    }
+
+    std::lock_guard<std::mutex> lock(nodeMutex);
+    acquiring = false;
+}
+
+SpinImage SpinSimulatedBackend::GetNextImage(uint64_t timeoutMs) {
+    std::shared_ptr<Stream> current;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        current = stream;
+    }
+    if (!current) throw std::runtime_error("[ ERROR ] Camera acquisition not started");
+
+    std::unique_lock<std::mutex> lock(current->mutex);
+    auto frameAvailable = [&current] { return !current->queue.empty() || !current->running; };
+    if (timeoutMs == kInfiniteTimeout) {
+        current->frameQueued.wait(lock, frameAvailable);
+    } else if (!current->frameQueued.wait_for(lock, std::chrono::milliseconds(timeoutMs), frameAvailable)) {
+        throw std::runtime_error("[ ERROR ] Timed out waiting for the next image");
+    }
+    if (current->queue.empty()) {
+        throw std::runtime_error("[ ERROR ] Camera acquisition stopped while waiting for the next image");
+    }
+
+    Stream::QueuedFrame frame;
+    if (current->handlingMode == "NewestFirst") {
+        frame = current->queue.back();
+        current->queue.pop_back();
+    } else {
+        frame = current->queue.front();
+        current->queue.pop_front();
+    }
+    lock.unlock();
+    return Stream::Lease(current, frame);
+}
+
+void SpinSimulatedBackend::RegisterImageHandler(std::function<void(SpinImage&)> handler) {
+    std::lock_guard<std::mutex> lock(handlerMutex);
+    imageHandler = handler;
+}
+
+void SpinSimulatedBackend::UnregisterImageHandler() {
+    std::lock_guard<std::mutex> lock(handlerMutex);
+    imageHandler = nullptr;
+}
+
+void SpinSimulatedBackend::GeneratorLoop(std::shared_ptr<Stream> stream) {
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::chrono::steady_clock::time_point nextFrame = std::chrono::steady_clock::now();
+    uint64_t frameID = 0;
+    int64_t framesLeft = stream->framesToAcquire;
+
+    while (framesLeft != 0) {
+        double frameRate;
+        {
+            std::lock_guard<std::mutex> lock(nodeMutex);
+            frameRate = nodes["AcquisitionResultingFrameRate"].floatValue;
+        }
+
+        // The frame is exposed now and read out one frame period later
+        const uint64_t timestamp = DeviceTime();
+        const auto now = std::chrono::steady_clock::now();
+        const auto period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / frameRate));
+        nextFrame = std::max(nextFrame + period, now);  // Never try to catch up on frames missed while descheduled
+        {
+            std::unique_lock<std::mutex> lock(stream->mutex);
+            if (stream->frameQueued.wait_until(lock, nextFrame, [&stream] { return !stream->running; })) {
+                return;
+            }
+        }
+
+        const uint64_t id = frameID++;
+        if (framesLeft > 0) {
+            framesLeft--;
+        }
+        generatedFrames.fetch_add(1, std::memory_order_relaxed);
+
+        // Frames lost in transport never reach a buffer
+        int64_t lost = 0;
+        if (chance(random) < config.dropProbability) {
+            injectedDrops.fetch_add(1, std::memory_order_relaxed);
+            lost++;
+        }
+        const bool incomplete = lost == 0 && chance(random) < config.incompleteProbability;
+        if (incomplete) {
+            injectedIncompletes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Find a buffer, which may mean giving up this frame or an older one depending on the handling mode
+        bool haveBuffer = false;
+        size_t buffer = 0;
+        if (lost == 0) {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            if (!stream->freeBuffers.empty()) {
+                buffer = stream->freeBuffers.back();
+                stream->freeBuffers.pop_back();
+                haveBuffer = true;
+            } else if (!stream->queue.empty() && (stream->handlingMode == "OldestFirstOverwrite" || stream->handlingMode == "NewestOnly")) {
+                buffer = stream->queue.front().buffer;
+                stream->queue.pop_front();
+                haveBuffer = true;
+                lost++;
+            } else {
+                lost++;
+            }
+        }
+        if (lost > 0) {
+            std::lock_guard<std::mutex> lock(nodeMutex);
+            nodes["StreamLostFrameCount"].intValue += lost;
+        }
+        if (!haveBuffer) {
+            continue;
+        }
+
+        FillFrame(stream->buffers[buffer].get(), stream->width, stream->height, stream->bitsPerPixel, stream->bayer, id);
+        const Stream::QueuedFrame frame = {buffer, timestamp, id, incomplete};
+
+        // With a handler registered the frame goes straight to it, like an image event
+        std::function<void(SpinImage&)> handler;
+        {
+            std::lock_guard<std::mutex> lock(handlerMutex);
+            handler = imageHandler;
+        }
+        if (handler) {
+            SpinImage image = Stream::Lease(stream, frame);
+            handler(image);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            if (stream->handlingMode == "NewestOnly") {
+                for (const Stream::QueuedFrame& older : stream->queue) {
+                    stream->freeBuffers.push_back(older.buffer);
+                }
+                stream->queue.clear();
+            }
+            stream->queue.push_back(frame);
+        }
+        stream->frameQueued.notify_all();
+    }
+}
+
+// Diagonal gradient that moves a little every frame, on Bayer sensors each colour site gets its own variation
+void SpinSimulatedBackend::FillFrame(unsigned char* data, int width, int height, int bitsPerPixel, bool bayer, uint64_t frameID) const {
+    // Pixel (x, y) has gradient value (x + y + phase) & 0xFF, so every row is a window into a longer row of all values.
+    // One such row is built per row parity and gradient parity (which decide the colour site of each value).
+    std::vector<unsigned char> rows[2][2];
+    for (int rowParity = 0; rowParity < 2; ++rowParity) {
+        for (int gradientParity = 0; gradientParity < 2; ++gradientParity) {
+            std::vector<unsigned char>& row = rows[rowParity][gradientParity];
+            row.resize(width + 256);
+            for (int i = 0; i < width + 256; ++i) {
+                unsigned int value = static_cast<unsigned int>(i) & 0xFF;
+                const bool evenRow = rowParity == 0;
+                const bool evenColumn = ((i - gradientParity) & 1) == 0;
+                if (!bayer || (evenRow && evenColumn)) {
+                    // Mono or red
+                } else if (!evenRow && !evenColumn) {
+                    value = 255 - value;  // Blue
+                } else {
+                    value = 64 + value / 2;  // Green
+                }
+                row[i] = static_cast<unsigned char>(value);
+            }
+        }
+    }
+
+    const unsigned int shift = static_cast<unsigned int>(bitsPerPixel - 8);
+    const unsigned int phase = static_cast<unsigned int>(frameID * 4);
+
+    // Packed formats are written as one LSB-first bit stream
+    uint64_t bits = 0;
+    int bitCount = 0;
+    unsigned char* out = data;
+
+    for (int y = 0; y < height; ++y) {
+        const unsigned int start = (static_cast<unsigned int>(y) + phase) & 0xFF;
+        const unsigned char* values = rows[y & 1][start & 1].data() + start;
+
+        if (bitsPerPixel == 8) {
+            memcpy(out, values, width);
+            out += width;
+            continue;
+        }
+        for (int x = 0; x < width; ++x) {
+            const unsigned int sample = static_cast<unsigned int>(values[x]) << shift;
+            if (bitsPerPixel == 16) {
+                *out++ = static_cast<unsigned char>(sample & 0xFF);
+                *out++ = static_cast<unsigned char>(sample >> 8);
+            } else {
+                bits |= static_cast<uint64_t>(sample) << bitCount;
+                bitCount += bitsPerPixel;
+                while (bitCount >= 8) {
+                    *out++ = static_cast<unsigned char>(bits & 0xFF);
+                    bits >>= 8;
+                    bitCount -= 8;
+                }
+            }
+        }
+    }
+    if (bitCount > 0) {
+        *out = static_cast<unsigned char>(bits & 0xFF);
+    }
+}
+
+uint64_t SpinSimulatedBackend::GetGeneratedFrames() const {
+    return generatedFrames.load(std::memory_order_relaxed);
+}
+
+uint64_t SpinSimulatedBackend::GetInjectedDrops() const {
+    return injectedDrops.load(std::memory_order_relaxed);
+}
+
+uint64_t SpinSimulatedBackend::GetInjectedIncompletes() const {
+    return injectedIncompletes.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,312 @@
+#include "../include/SpinnakerSDK_SpinTelemetry.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include "../include/SpinnakerSDK_SpinImage.h"
+#include "../include/SpinnakerSDK_SpinTrigger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Buckets exported to Prometheus, a fixed set from ~1 us to ~34 s so every scrape has the same series
+    const size_t kFirstExportedBucket = 9;
+    const size_t kLastExportedBucket = 34;
+
+    size_t BucketIndex(uint64_t valueNs) {
+        size_t index = 0;
+        while (valueNs > 1) {
+            valueNs >>= 1;
+            index++;
+        }
+        return index;
+    }
+
+    // Exclusive upper bound of a bucket in ns (the last bucket has none)
+    double BucketUpperBound(size_t index) {
+        return index + 1 < SpinHistogram::kBucketCount ? static_cast<double>(uint64_t(1) << (index + 1)) : INFINITY;
+    }
+
+    void AtomicMax(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void WritePrometheusCounter(std::ostream& out, const std::string& name, const std::string& help, const std::string& labels, uint64_t value) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " counter\n";
+        out << name << "{" << labels << "} " << value << "\n";
+    }
+
+    void WritePrometheusGauge(std::ostream& out, const std::string& name, const std::string& help, const std::string& labels, double value) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " gauge\n";
+        out << name << "{" << labels << "} " << value << "\n";
+    }
+
+    // Buckets are converted to seconds and made cumulative, as Prometheus expects
+    void WritePrometheusHistogram(std::ostream& out, const std::string& name, const std::string& help, const std::string& labels,
+                                  const SpinHistogramSnapshot& histogram) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " histogram\n";
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i <= kLastExportedBucket; ++i) {
+            cumulative += histogram.buckets[i];
+            if (i >= kFirstExportedBucket) {
+                out << name << "_bucket{" << labels << ",le=\"" << BucketUpperBound(i) / 1e9 << "\"} " << cumulative << "\n";
+            }
+        }
+        out << name << "_bucket{" << labels << ",le=\"+Inf\"} " << histogram.count << "\n";
+        out << name << "_sum{" << labels << "} " << histogram.sum / 1e9 << "\n";
+        out << name << "_count{" << labels << "} " << histogram.count << "\n";
+    }
+
+    void WriteJsonHistogram(std::ostream& out, const SpinHistogramSnapshot& histogram) {
+        out << "{\"count\": " << histogram.count << ", \"sum_ns\": " << histogram.sum << ", \"max_ns\": " << histogram.max
+            << ", \"mean_ns\": " << histogram.Mean() << ", \"p50_ns\": " << histogram.Quantile(0.5) << ", \"p99_ns\": " << histogram.Quantile(0.99)
+            << ", \"buckets\": [";
+        for (size_t i = 0; i < histogram.buckets.size(); ++i) {
+            out << (i > 0 ? ", " : "") << histogram.buckets[i];
+        }
+        out << "]}";
+    }
+
+    std::string EscapeLabel(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '\\' || c == '"') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+double SpinHistogramSnapshot::Mean() const {
+    return count > 0 ? static_cast<double>(sum) / count : 0.0;
+}
+
+uint64_t SpinHistogramSnapshot::Quantile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(std::max(quantile, 0.0), 1.0) * count));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= std::max<uint64_t>(rank, 1)) {
+            return std::min(max, i + 1 < buckets.size() ? uint64_t(1) << (i + 1) : max);
+        }
+    }
+    return max;
+}
+
+SpinHistogram::SpinHistogram() {
+    Reset();
+}
+
+void SpinHistogram::Record(uint64_t valueNs) {
+    buckets[BucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(valueNs, std::memory_order_relaxed);
+    AtomicMax(max, valueNs);
+}
+
+SpinHistogramSnapshot SpinHistogram::Snapshot() const {
+    SpinHistogramSnapshot snapshot;
+    snapshot.buckets.resize(kBucketCount);
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count = count.load(std::memory_order_relaxed);
+    snapshot.sum = sum.load(std::memory_order_relaxed);
+    snapshot.max = max.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void SpinHistogram::Reset() {
+    for (std::atomic<uint64_t>& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+SpinTelemetry::SpinTelemetry(const std::string& cameraName) : cameraName(cameraName) {
+    startTime.store(static_cast<int64_t>(SpinTrigger::Now()), std::memory_order_relaxed);
+}
+
+void SpinTelemetry::RecordFrame(const SpinImage& frame) {
+    const uint64_t frameID = frame.GetFrameID();
+    const uint64_t timestamp = frame.GetTimeStamp();
+
+    // Gaps in the frame IDs and the spacing of the device timestamps
+    if (hasLastFrame.load(std::memory_order_relaxed)) {
+        const uint64_t previousID = lastFrameID.load(std::memory_order_relaxed);
+        if (frameID > previousID + 1) {
+            frameIDGaps.fetch_add(frameID - previousID - 1, std::memory_order_relaxed);
+        }
+        const uint64_t previousTimestamp = lastTimestamp.load(std::memory_order_relaxed);
+        if (timestamp > previousTimestamp) {
+            frameInterval.Record(timestamp - previousTimestamp);
+        }
+    }
+    lastFrameID.store(frameID, std::memory_order_relaxed);
+    lastTimestamp.store(timestamp, std::memory_order_relaxed);
+    hasLastFrame.store(true, std::memory_order_relaxed);
+
+    // Time from the end of exposure on the camera to the frame reaching the host
+    if (clockSynchronized.load(std::memory_order_relaxed) && timestamp > 0) {
+        const int64_t arrival = static_cast<int64_t>(SpinTrigger::Now()) + clockOffset.load(std::memory_order_relaxed);
+        const int64_t delay = arrival - static_cast<int64_t>(timestamp);
+        latency.Record(delay > 0 ? static_cast<uint64_t>(delay) : 0);
+    }
+
+    if (frame.IsIncomplete()) {
+        incompleteFrames.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        deliveredFrames.fetch_add(1, std::memory_order_relaxed);
+        deliveredBytes.fetch_add(frame.GetDataSize(), std::memory_order_relaxed);
+    }
+}
+
+void SpinTelemetry::BeginAcquisition() {
+    previousLostFrames.fetch_add(currentLostFrames.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    hasLastFrame.store(false, std::memory_order_relaxed);
+    acquisitions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SpinTelemetry::SetLostFrames(uint64_t lostFrames) {
+    currentLostFrames.store(lostFrames, std::memory_order_relaxed);
+}
+
+void SpinTelemetry::SetClockOffset(int64_t offset) {
+    clockOffset.store(offset, std::memory_order_relaxed);
+    clockSynchronized.store(true, std::memory_order_relaxed);
+}
+
+void SpinTelemetry::SetCameraName(const std::string& cameraName) {
+    this->cameraName = cameraName;
+}
+
+std::string SpinTelemetry::GetCameraName() const {
+    return cameraName;
+}
+
+SpinTelemetrySnapshot SpinTelemetry::Snapshot() const {
+    SpinTelemetrySnapshot snapshot;
+    snapshot.elapsedSeconds = (static_cast<int64_t>(SpinTrigger::Now()) - startTime.load(std::memory_order_relaxed)) / 1e9;
+    snapshot.deliveredFrames = deliveredFrames.load(std::memory_order_relaxed);
+    snapshot.deliveredBytes = deliveredBytes.load(std::memory_order_relaxed);
+    snapshot.incompleteFrames = incompleteFrames.load(std::memory_order_relaxed);
+    snapshot.lostFrames = previousLostFrames.load(std::memory_order_relaxed) + currentLostFrames.load(std::memory_order_relaxed);
+    snapshot.frameIDGaps = frameIDGaps.load(std::memory_order_relaxed);
+    snapshot.acquisitions = acquisitions.load(std::memory_order_relaxed);
+    if (snapshot.elapsedSeconds > 0.0) {
+        snapshot.framesPerSecond = snapshot.deliveredFrames / snapshot.elapsedSeconds;
+        snapshot.megabytesPerSecond = snapshot.deliveredBytes / 1e6 / snapshot.elapsedSeconds;
+    }
+    snapshot.frameInterval = frameInterval.Snapshot();
+    snapshot.latency = latency.Snapshot();
+    return snapshot;
+}
+
+void SpinTelemetry::Reset() {
+    startTime.store(static_cast<int64_t>(SpinTrigger::Now()), std::memory_order_relaxed);
+    deliveredFrames.store(0, std::memory_order_relaxed);
+    deliveredBytes.store(0, std::memory_order_relaxed);
+    incompleteFrames.store(0, std::memory_order_relaxed);
+    frameIDGaps.store(0, std::memory_order_relaxed);
+    acquisitions.store(0, std::memory_order_relaxed);
+    // The driver counter keeps counting for the running acquisition, so only what it reported so far is forgotten
+    previousLostFrames.store(0, std::memory_order_relaxed);
+    frameInterval.Reset();
+    latency.Reset();
+}
+
+std::string SpinTelemetry::ToPrometheus() const {
+    const SpinTelemetrySnapshot snapshot = Snapshot();
+    const std::string labels = "camera=\"" + EscapeLabel(cameraName) + "\"";
+
+    std::ostringstream out;
+    WritePrometheusCounter(out, "spin_frames_delivered_total", "Complete frames handed to the application.", labels, snapshot.deliveredFrames);
+    WritePrometheusCounter(out, "spin_bytes_delivered_total", "Bytes of complete frames handed to the application.", labels, snapshot.deliveredBytes);
+    WritePrometheusCounter(out, "spin_frames_incomplete_total", "Frames the camera or transport could not complete.", labels, snapshot.incompleteFrames);
+    WritePrometheusCounter(out, "spin_frames_lost_total", "Frames the driver reports lost.", labels, snapshot.lostFrames);
+    WritePrometheusCounter(out, "spin_frame_id_gaps_total", "Frame IDs skipped between consecutive frames.", labels, snapshot.frameIDGaps);
+    WritePrometheusCounter(out, "spin_acquisitions_total", "Acquisitions started.", labels, snapshot.acquisitions);
+    WritePrometheusGauge(out, "spin_frames_per_second", "Delivered frames per second since the telemetry was reset.", labels, snapshot.framesPerSecond);
+    WritePrometheusGauge(out, "spin_megabytes_per_second", "Delivered megabytes per second since the telemetry was reset.", labels, snapshot.megabytesPerSecond);
+    WritePrometheusHistogram(out, "spin_frame_interval_seconds", "Device timestamp difference between consecutive frames.", labels, snapshot.frameInterval);
+    WritePrometheusHistogram(out, "spin_frame_latency_seconds", "Host arrival time minus device timestamp.", labels, snapshot.latency);
+    return out.str();
+}
+
+std::string SpinTelemetry::ToJson() const {
+    const SpinTelemetrySnapshot snapshot = Snapshot();
+
+    std::ostringstream out;
+    out << "{\"camera\": \"" << EscapeLabel(cameraName) << "\""
+        << ", \"elapsed_seconds\": " << snapshot.elapsedSeconds
+        << ", \"frames_delivered\": " << snapshot.deliveredFrames
+        << ", \"bytes_delivered\": " << snapshot.deliveredBytes
+        << ", \"frames_incomplete\": " << snapshot.incompleteFrames
+        << ", \"frames_lost\": " << snapshot.lostFrames
+        << ", \"frame_id_gaps\": " << snapshot.frameIDGaps
+        << ", \"acquisitions\": " << snapshot.acquisitions
+        << ", \"frames_per_second\": " << snapshot.framesPerSecond
+        << ", \"megabytes_per_second\": " << snapshot.megabytesPerSecond
+        << ", \"frame_interval\": ";
+    WriteJsonHistogram(out, snapshot.frameInterval);
+    out << ", \"latency\": ";
+    WriteJsonHistogram(out, snapshot.latency);
+    out << "}\n";
+    return out.str();
+}
+
+bool SpinTelemetry::WriteFile(const std::string& filename) const {
+    const bool json = filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0;
+
+    // Write next to the target and rename, so a scraper never reads a half-written file
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file) {
+            SPIN_LOG_WARNING("Unable to write telemetry to ", filename);
+            return false;
+        }
+        file << (json ? ToJson() : ToPrometheus());
+        if (!file) {
+            SPIN_LOG_WARNING("Unable to write telemetry to ", filename);
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        SPIN_LOG_WARNING("Unable to write telemetry to ", filename);
+        return false;
+    }
+    return true;
+}
+
+void SpinTelemetry::PrintStats() const {
+    SpinLogger::Instance().BeginReport();
+    const SpinTelemetrySnapshot snapshot = Snapshot();
+    std::cout << "===== Telemetry (" << cameraName << ") =====" << std::endl;
+    std::cout << "Delivered Frames: " << snapshot.deliveredFrames << std::endl;
+    std::cout << "Incomplete Frames: " << snapshot.incompleteFrames << std::endl;
+    std::cout << "Lost Frames: " << snapshot.lostFrames << std::endl;
+    std::cout << "Frame ID Gaps: " << snapshot.frameIDGaps << std::endl;
+    std::cout << "Throughput: " << std::fixed << std::setprecision(1) << snapshot.framesPerSecond << " fps, "
+              << snapshot.megabytesPerSecond << " MB/s" << std::endl;
+    std::cout << "Frame Interval: mean " << snapshot.frameInterval.Mean() / 1e6 << " ms, max " << snapshot.frameInterval.max / 1e6 << " ms" << std::endl;
+    if (snapshot.latency.count > 0) {
+        std::cout << "Latency: mean " << snapshot.latency.Mean() / 1e6 << " ms, p99 < " << snapshot.latency.Quantile(0.99) / 1e6
+                  << " ms, max " << snapshot.latency.max / 1e6 << " ms" << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6) << "=====================" << std::endl;
+}
@@ -0,0 +1,78 @@
+#include "../include/SpinnakerSDK_SpinThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+SpinThreadPool::SpinThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&SpinThreadPool::WorkerLoop, this);
+    }
+}
+
+SpinThreadPool::~SpinThreadPool() {
+    // Queued tasks still run before the workers exit
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> SpinThreadPool::Submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(task);
+    std::future<void> result = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(packaged));
+    }
+    taskAvailable.notify_one();
+    return result;
+}
+
+void SpinThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    std::vector<std::future<void>> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        results.push_back(Submit([&body, i] { body(i); }));
+    }
+
+    std::exception_ptr firstError;
+    for (std::future<void>& result : results) {
+        try {
+            result.get();
+        } catch (...) {
+            if (!firstError) {
+                firstError = std::current_exception();
+            }
+        }
+    }
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+size_t SpinThreadPool::GetThreadCount() const {
+    return workers.size();
+}
+
+void SpinThreadPool::WorkerLoop() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,96 @@
+#include "../include/SpinnakerSDK_SpinTrigger.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Tell the CPU we are busy-waiting (saves power and lets the sibling hyperthread run)
+    inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+}
+
+SpinTrigger::SpinTrigger(SpinOption::TriggerWaitPolicy policy, int spin_time_us)
+    : waitPolicy(policy), spinTimeUs(spin_time_us) {}
+
+uint64_t SpinTrigger::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void SpinTrigger::Fire() {
+    // Record the time first, so it is visible to anyone who sees the trigger fired
+    triggerTime.store(Now(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        fired.store(true, std::memory_order_release);
+    }
+    condition.notify_all();
+}
+
+void SpinTrigger::Reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    fired.store(false, std::memory_order_release);
+    triggerTime.store(0, std::memory_order_relaxed);
+}
+
+bool SpinTrigger::IsFired() const {
+    return fired.load(std::memory_order_acquire);
+}
+
+void SpinTrigger::SetWaitPolicy(SpinOption::TriggerWaitPolicy policy, int spin_time_us) {
+    waitPolicy = policy;
+    spinTimeUs = spin_time_us;
+}
+
+uint64_t SpinTrigger::GetTriggerTime() const {
+    return IsFired() ? triggerTime.load(std::memory_order_relaxed) : 0;
+}
+
+// Busy-wait until the trigger fires or the deadline passes
+bool SpinTrigger::Spin(std::chrono::steady_clock::time_point deadline) const {
+    while (!fired.load(std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        CpuRelax();
+    }
+    return true;
+}
+
+void SpinTrigger::Wait() {
+    if (waitPolicy == SpinOption::TriggerWaitPolicy::Spin) {
+        Spin(std::chrono::steady_clock::time_point::max());
+        return;
+    }
+    if (waitPolicy == SpinOption::TriggerWaitPolicy::SpinThenBlock) {
+        if (Spin(std::chrono::steady_clock::now() + std::chrono::microseconds(spinTimeUs))) {
+            return;
+        }
+    }
+
+    // Sleep until Fire() wakes us
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return fired.load(std::memory_order_acquire); });
+}
+
+bool SpinTrigger::WaitFor(std::chrono::microseconds timeout) {
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    if (waitPolicy == SpinOption::TriggerWaitPolicy::Spin) {
+        return Spin(deadline);
+    }
+    if (waitPolicy == SpinOption::TriggerWaitPolicy::SpinThenBlock) {
+        const std::chrono::steady_clock::time_point spinDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds(spinTimeUs);
+        if (Spin(spinDeadline < deadline ? spinDeadline : deadline)) {
+            return true;
+        }
+    }
+
+    // Sleep until Fire() wakes us or the deadline passes
+    std::unique_lock<std::mutex> lock(mutex);
+    return condition.wait_until(lock, deadline, [this] { return fired.load(std::memory_order_acquire); });
+}
@@ -0,0 +1,175 @@
+#include "../include/SpinnakerSDK_SpinUnpack.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SPIN_UNPACK_SSE2 1
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SPIN_UNPACK_SSSE3 1  // Compiled for SSSE3 function by function, used only when the CPU has it
+#endif
+
+namespace {
+    // Samples in the smallest run of whole bytes
+    size_t GroupSize(int bitsPerPixel) {
+        return bitsPerPixel == 10 ? 4 : bitsPerPixel == 12 ? 2 : 1;
+    }
+
+    // Samples from a byte boundary, the reference the SIMD path has to match
+    void UnpackScalar(const unsigned char* data, int bitsPerPixel, size_t count, uint16_t* samples) {
+        if (bitsPerPixel == 8) {
+            for (size_t i = 0; i < count; ++i) {
+                samples[i] = data[i];
+            }
+        } else if (bitsPerPixel == 16) {
+            for (size_t i = 0; i < count; ++i) {
+                samples[i] = static_cast<uint16_t>(data[2 * i] | (data[2 * i + 1] << 8));
+            }
+        } else {
+            // One LSB-first bit stream
+            const uint32_t mask = (1u << bitsPerPixel) - 1;
+            uint64_t bits = 0;
+            int bitCount = 0;
+            for (size_t i = 0; i < count; ++i) {
+                while (bitCount < bitsPerPixel) {
+                    bits |= static_cast<uint64_t>(*data++) << bitCount;
+                    bitCount += 8;
+                }
+                samples[i] = static_cast<uint16_t>(bits & mask);
+                bits >>= bitsPerPixel;
+                bitCount -= bitsPerPixel;
+            }
+        }
+    }
+
+#ifdef SPIN_UNPACK_SSSE3
+    bool HasSSSE3() {
+        static const bool supported = __builtin_cpu_supports("ssse3") != 0;
+        return supported;
+    }
+
+    // 8 samples of 10p or 12p from a byte boundary per step, returns how many were done
+    // pshufb puts the two bytes holding every sample in its 16 bit lane, a multiply moves the sample to the top of the
+    // lane (dropping the bits of the next one) and a shift brings it down. Every step loads 16 bytes of which it uses 10
+    // or 12, so the loop stops while the load still ends inside the samples' own bytes.
+    __attribute__((target("ssse3"))) size_t UnpackSSSE3(const unsigned char* data, int bitsPerPixel, size_t count, uint16_t* samples) {
+        const bool tenBit = bitsPerPixel == 10;
+        const size_t stepBytes = tenBit ? 10 : 12;
+        const size_t dataBytes = count * bitsPerPixel / 8;
+        // 10p: sample j of a group is in bytes j and j + 1, 2j bits up. 12p: the even sample in bytes 0 and 1, the odd in 1 and 2, 4 bits up
+        const __m128i shuffle = tenBit ? _mm_setr_epi8(0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9)
+                                       : _mm_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+        const __m128i multiply = tenBit ? _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1) : _mm_setr_epi16(16, 1, 16, 1, 16, 1, 16, 1);
+        const int down = 16 - bitsPerPixel;
+
+        size_t done = 0;
+        size_t offset = 0;
+        for (; done + 8 <= count && offset + 16 <= dataBytes; done += 8, offset += stepBytes) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+            const __m128i lanes = _mm_mullo_epi16(_mm_shuffle_epi8(bytes, shuffle), multiply);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + done), _mm_srli_epi16(lanes, down));
+        }
+        return done;
+    }
+#endif
+}
+
+bool SpinUnpacker::IsSupported(int bitsPerPixel) {
+    return bitsPerPixel == 8 || bitsPerPixel == 10 || bitsPerPixel == 12 || bitsPerPixel == 16;
+}
+
+size_t SpinUnpacker::GetPackedSize(int bitsPerPixel, size_t count) {
+    return static_cast<size_t>((static_cast<uint64_t>(count) * bitsPerPixel + 7) / 8);
+}
+
+void SpinUnpacker::Unpack16(const unsigned char* data, int bitsPerPixel, size_t firstSample, size_t count, uint16_t* samples, int shift) {
+    if (!IsSupported(bitsPerPixel)) throw std::runtime_error("[ ERROR ] Unsupported bits per pixel for unpacking.");
+    if (count == 0) {
+        return;
+    }
+    if (!data || !samples) throw std::runtime_error("[ ERROR ] Invalid buffer for unpacking.");
+
+    // Start from the group holding the first sample, the samples before it in a partial first group are dropped
+    const size_t group = GroupSize(bitsPerPixel);
+    const size_t groupBytes = group * bitsPerPixel / 8;
+    const unsigned char* start = data + firstSample / group * groupBytes;
+    const size_t lead = firstSample % group;
+    size_t done = 0;
+    if (lead > 0) {
+        // Only as far as the samples asked for, the group may be the last (partial) one of the frame
+        uint16_t head[4];
+        done = std::min(group - lead, count);
+        UnpackScalar(start, bitsPerPixel, lead + done, head);
+        std::copy(head + lead, head + lead + done, samples);
+        start += groupBytes;
+    }
+
+    // Whole groups from here on
+    size_t vectorDone = 0;
+#ifdef SPIN_UNPACK_SSSE3
+    if ((bitsPerPixel == 10 || bitsPerPixel == 12) && HasSSSE3()) {
+        vectorDone = UnpackSSSE3(start, bitsPerPixel, count - done, samples + done);
+    }
+#endif
+    UnpackScalar(start + vectorDone * bitsPerPixel / 8, bitsPerPixel, count - done - vectorDone, samples + done + vectorDone);
+
+    if (shift > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] = static_cast<uint16_t>(samples[i] << shift);
+        }
+    }
+}
+
+void SpinUnpacker::Unpack8(const unsigned char* data, int bitsPerPixel, size_t firstSample, size_t count, unsigned char* samples,
+                           const unsigned char* toneMap) {
+    if (!IsSupported(bitsPerPixel)) throw std::runtime_error("[ ERROR ] Unsupported bits per pixel for unpacking.");
+    if (bitsPerPixel == 8 && !toneMap) {
+        if (count > 0) {
+            std::memcpy(samples, data + firstSample, count);
+        }
+        return;
+    }
+
+    // Through a 16 bit buffer that stays in the L1 cache, a multiple of every group size
+    const size_t kChunk = 1024;
+    uint16_t wide[kChunk];
+    const int down = bitsPerPixel - 8;
+    for (size_t offset = 0; offset < count; offset += kChunk) {
+        const size_t chunk = std::min(kChunk, count - offset);
+        Unpack16(data, bitsPerPixel, firstSample + offset, chunk, wide);
+        unsigned char* out = samples + offset;
+        if (toneMap) {
+            for (size_t i = 0; i < chunk; ++i) {
+                out[i] = toneMap[wide[i]];
+            }
+        } else {
+            size_t i = 0;
+#ifdef SPIN_UNPACK_SSE2
+            for (; i + 16 <= chunk; i += 16) {
+                const __m128i low = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(wide + i)), down);
+                const __m128i high = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(wide + i + 8)), down);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));
+            }
+#endif
+            for (; i < chunk; ++i) {
+                out[i] = static_cast<unsigned char>(wide[i] >> down);
+            }
+        }
+    }
+}
+
+std::vector<unsigned char> SpinUnpacker::MakeToneMap(int bitsPerPixel, double gamma) {
+    if (!IsSupported(bitsPerPixel)) throw std::runtime_error("[ ERROR ] Unsupported bits per pixel for a tone map.");
+    if (gamma <= 0.0) throw std::runtime_error("[ ERROR ] Tone map gamma must be positive.");
+    const size_t size = static_cast<size_t>(1) << bitsPerPixel;
+    const double maximum = static_cast<double>(size - 1);
+    std::vector<unsigned char> toneMap(size);
+    for (size_t i = 0; i < size; ++i) {
+        toneMap[i] = static_cast<unsigned char>(std::lround(255.0 * std::pow(i / maximum, gamma)));
+    }
+    return toneMap;
+}
@@ -0,0 +1,346 @@
+#include "../include/SpinnakerSDK_SpinVideoWriter.h"
+#include "../include/SpinnakerSDK_SpinLogger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+#include <signal.h>
+#include <stdexcept>
+
+namespace {
+    uint64_t NanosecondsSince(std::chrono::steady_clock::time_point start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    unsigned char Clamp(int value) {
+        return static_cast<unsigned char>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    // Full range BT.601 (the JPEG flavour) in 16.16 fixed point, chroma from the average of each 2x2 block
+    // The RGB rows are rgbStride bytes apart, the planes are written without padding.
+    void RgbToYuv420(const unsigned char* rgb, size_t rgbStride, int width, int height, unsigned char* yuv) {
+        const int chromaWidth = (width + 1) / 2;
+        const int chromaHeight = (height + 1) / 2;
+        unsigned char* planeY = yuv;
+        unsigned char* planeU = planeY + static_cast<size_t>(width) * height;
+        unsigned char* planeV = planeU + static_cast<size_t>(chromaWidth) * chromaHeight;
+
+        for (int y = 0; y < height; ++y) {
+            const unsigned char* row = rgb + static_cast<size_t>(y) * rgbStride;
+            unsigned char* outY = planeY + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; ++x) {
+                outY[x] = static_cast<unsigned char>((19595 * row[3 * x] + 38470 * row[3 * x + 1] + 7471 * row[3 * x + 2] + 32768) >> 16);
+            }
+        }
+
+        for (int cy = 0; cy < chromaHeight; ++cy) {
+            const int y0 = 2 * cy;
+            const int y1 = std::min(y0 + 1, height - 1);
+            const unsigned char* row0 = rgb + static_cast<size_t>(y0) * rgbStride;
+            const unsigned char* row1 = rgb + static_cast<size_t>(y1) * rgbStride;
+            for (int cx = 0; cx < chromaWidth; ++cx) {
+                const int x0 = 3 * (2 * cx);
+                const int x1 = 3 * std::min(2 * cx + 1, width - 1);
+                const int r = row0[x0] + row0[x1] + row1[x0] + row1[x1];
+                const int g = row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1];
+                const int b = row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2];
+                // The sums are four pixels, so shift by two more bits
+                const size_t i = static_cast<size_t>(cy) * chromaWidth + cx;
+                planeU[i] = Clamp(((-11059 * r - 21709 * g + 32768 * b + (1 << 17)) >> 18) + 128);
+                planeV[i] = Clamp(((32768 * r - 27439 * g - 5329 * b + (1 << 17)) >> 18) + 128);
+            }
+        }
+    }
+}
+
+SpinVideoWriter::SpinVideoWriter(const SpinVideoWriterConfig& config) : config(config) {
+    if (config.queueCapacity == 0) throw std::runtime_error("[ ERROR ] Video writer queue capacity must be at least 1.");
+    if (config.frameRate <= 0.0) throw std::runtime_error("[ ERROR ] Video frame rate must be positive.");
+}
+
+SpinVideoWriter::~SpinVideoWriter() {
+    try {
+        Close();
+    } catch (const std::exception& e) {
+        SPIN_LOG_ERROR("Exception caught while closing video: ", e.what());
+    }
+}
+
+void SpinVideoWriter::Open(const std::string& filename) {
+    if (output) throw std::runtime_error("[ ERROR ] Video writer is already writing to " + target);
+    output = fopen(filename.c_str(), "wb");
+    if (!output) {
+        throw std::runtime_error("[ ERROR ] Unable to open " + filename + " for writing: " + std::strerror(errno));
+    }
+    target = filename;
+    pipe = false;
+    Start();
+}
+
+void SpinVideoWriter::OpenPipe(const std::string& command) {
+    if (output) throw std::runtime_error("[ ERROR ] Video writer is already writing to " + target);
+    output = popen(command.c_str(), "w");
+    if (!output) {
+        throw std::runtime_error("[ ERROR ] Unable to start " + command + ": " + std::strerror(errno));
+    }
+    target = command;
+    pipe = true;
+    Start();
+}
+
+void SpinVideoWriter::Start() {
+    // Frames are written whole from frameBuffer, stdio buffering would only add a copy (and defer writes to Close,
+    // outside the writer thread)
+    setvbuf(output, nullptr, _IONBF, 0);
+    width = 0;
+    height = 0;
+    frameSize = 0;
+    headerWritten = false;
+    stopping = false;
+    peakQueueDepth = 0;
+    framesWritten = 0;
+    bytesWritten = 0;
+    framesDropped = 0;
+    writeErrors = 0;
+    convertNs = 0;
+    writeNs = 0;
+    writer = std::thread(&SpinVideoWriter::WriterLoop, this);
+}
+
+void SpinVideoWriter::Close() {
+    if (!output) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    frameQueued.notify_all();
+    writer.join();
+
+    if (pipe) {
+        // Waits for the encoder to finish the file
+        int status = pclose(output);
+        if (status != 0) {
+            SPIN_LOG_WARNING("Video encoder exited with status ", status, ": ", target);
+        }
+    } else if (fclose(output) != 0) {
+        writeErrors.fetch_add(1, std::memory_order_relaxed);
+        SPIN_LOG_ERROR("Unable to finish ", target, ": ", std::strerror(errno));
+    }
+    output = nullptr;
+    frameBuffer = std::vector<unsigned char>();
+    SPIN_LOG_INFO("Video ", target, " closed with ", framesWritten.load(), " frames");
+}
+
+bool SpinVideoWriter::IsOpen() const {
+    return output != nullptr;
+}
+
+bool SpinVideoWriter::Push(const SpinImage& frame) {
+    if (!output) {
+        return false;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (queue.size() >= config.queueCapacity) {
+            if (!config.blockWhenFull) {
+                framesDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            frameTaken.wait(lock, [this] { return queue.size() < config.queueCapacity; });
+        }
+        queue.push_back(frame);
+        peakQueueDepth = std::max(peakQueueDepth, queue.size());
+    }
+    frameQueued.notify_one();
+    return true;
+}
+
+std::function<void(SpinImage&)> SpinVideoWriter::GetStreamHandler() {
+    return [this](SpinImage& frame) {
+        Push(frame);
+    };
+}
+
+void SpinVideoWriter::WriterLoop() {
+    // A dead encoder should fail the write (EPIPE), not kill the process
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    while (true) {
+        SpinImage frame(nullptr);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            frameQueued.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            frame = queue.front();
+            queue.pop_front();
+        }
+        frameTaken.notify_one();
+
+        auto convertStart = std::chrono::steady_clock::now();
+        bool converted = Convert(frame);
+        // Let go of the source (and its driver buffer) before waiting on the output
+        frame = SpinImage(nullptr);
+        convertNs.fetch_add(NanosecondsSince(convertStart), std::memory_order_relaxed);
+        if (!converted) {
+            framesDropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto writeStart = std::chrono::steady_clock::now();
+        bool written = (headerWritten || WriteHeader());
+        if (written && config.container == SpinVideoFormat::Container::Y4M) {
+            written = Write("FRAME\n", 6);
+        }
+        written = written && Write(frameBuffer.data(), frameSize);
+        writeNs.fetch_add(NanosecondsSince(writeStart), std::memory_order_relaxed);
+        if (written) {
+            framesWritten.fetch_add(1, std::memory_order_relaxed);
+        } else if (writeErrors.fetch_add(1, std::memory_order_relaxed) == 0) {
+            SPIN_LOG_ERROR("Unable to write video frame to ", target, ": ", std::strerror(errno));
+        }
+    }
+}
+
+bool SpinVideoWriter::Convert(const SpinImage& frame) {
+    if (!frame.GetData() || frame.GetWidth() <= 0 || frame.GetHeight() <= 0) {
+        return false;
+    }
+
+    // Bring the frame to 8-bit grey or RGB
+    const Spinnaker::PixelFormatEnums pixelFormat = frame.GetPixelFormat();
+    const bool mono = pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono8 || pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono10p ||
+                      pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono12p || pixelFormat == Spinnaker::PixelFormatEnums::PixelFormat_Mono16;
+    const unsigned char* pixels = frame.GetData();
+    size_t pixelStride = frame.GetStride();  // Rows of the frame may be padded
+    Spinnaker::ImagePtr converted;
+    if (frame.GetBitsPerPixel() > 0 && pixelFormat != Spinnaker::PixelFormatEnums::PixelFormat_Mono8) {
+        // Unpack and demosaic natively into a reused buffer, no allocation per frame
+        rgbBuffer.resize(static_cast<size_t>(frame.GetWidth()) * frame.GetHeight() * (mono ? 1 : 3));
+        try {
+            if (mono) {
+                frame.UnpackTo8(rgbBuffer.data(), config.demosaicOptions.toneMap);
+            } else {
+                frame.DemosaicInto(rgbBuffer.data(), 0, config.demosaicOptions);
+            }
+        } catch (const std::exception& e) {
+            SPIN_LOG_ERROR("Unable to demosaic video frame ", frame.GetFrameID(), ": ", e.what());
+            return false;
+        }
+        pixels = rgbBuffer.data();
+        pixelStride = static_cast<size_t>(frame.GetWidth()) * (mono ? 1 : 3);
+    } else if (pixelFormat != Spinnaker::PixelFormatEnums::PixelFormat_Mono8 && pixelFormat != Spinnaker::PixelFormatEnums::PixelFormat_RGB8) {
+        Spinnaker::ImagePtr source = Spinnaker::Image::Create(frame.GetWidth(), frame.GetHeight(), 0, 0, pixelFormat,
+                                                              const_cast<unsigned char*>(frame.GetData()));
+        converted = imageProcessor.Convert(source, mono ? Spinnaker::PixelFormatEnums::PixelFormat_Mono8 : Spinnaker::PixelFormatEnums::PixelFormat_RGB8);
+        if (!converted) {
+            SPIN_LOG_ERROR("Unable to convert video frame ", frame.GetFrameID(), " to 8 bits.");
+            return false;
+        }
+        pixels = static_cast<const unsigned char*>(converted->GetData());
+        pixelStride = converted->GetStride();
+    }
+
+    // The first frame fixes the size of the video
+    if (width == 0) {
+        width = frame.GetWidth();
+        height = frame.GetHeight();
+        color = !mono;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        if (config.container == SpinVideoFormat::Container::Y4M) {
+            frameSize = color ? pixelCount + 2 * static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2) : pixelCount;
+        } else {
+            frameSize = color ? pixelCount * 3 : pixelCount;
+        }
+        frameBuffer.resize(frameSize);
+    }
+    if (frame.GetWidth() != width || frame.GetHeight() != height || mono == color) {
+        SPIN_LOG_WARNING("Dropping video frame ", frame.GetFrameID(), ", it does not match the size or colour of the first frame.");
+        return false;
+    }
+
+    const size_t rowSize = static_cast<size_t>(width) * (color ? 3 : 1);
+    if (pixelStride < rowSize) {
+        pixelStride = rowSize;
+    }
+    if (pixels == frame.GetData() && frame.GetDataSize() < pixelStride * (height - 1) + rowSize) {
+        SPIN_LOG_WARNING("Dropping video frame ", frame.GetFrameID(), ", its data is shorter than its rows.");
+        return false;
+    }
+
+    if (config.container == SpinVideoFormat::Container::Y4M && color) {
+        RgbToYuv420(pixels, pixelStride, width, height, frameBuffer.data());
+    } else if (pixelStride == rowSize) {
+        std::memcpy(frameBuffer.data(), pixels, frameSize);
+    } else {
+        // Padded rows one at a time
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(frameBuffer.data() + static_cast<size_t>(y) * rowSize, pixels + static_cast<size_t>(y) * pixelStride, rowSize);
+        }
+    }
+    return true;
+}
+
+bool SpinVideoWriter::WriteHeader() {
+    headerWritten = true;
+    if (config.container != SpinVideoFormat::Container::Y4M) {
+        return true;
+    }
+    // Frame rate as a fraction, so 29.97 stays exact enough
+    const long rate = std::lround(config.frameRate * 1000.0);
+    std::string header = "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) + " F" + std::to_string(rate) +
+                         ":1000 Ip A1:1 " + (color ? "C420jpeg" : "Cmono") + " XCOLORRANGE=FULL\n";
+    return Write(header.data(), header.size());
+}
+
+bool SpinVideoWriter::Write(const void* data, size_t size) {
+    if (fwrite(data, 1, size, output) != size) {
+        return false;
+    }
+    bytesWritten.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+SpinVideoWriterStats SpinVideoWriter::GetStats() const {
+    SpinVideoWriterStats stats;
+    stats.framesWritten = framesWritten.load(std::memory_order_relaxed);
+    stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    stats.framesDropped = framesDropped.load(std::memory_order_relaxed);
+    stats.writeErrors = writeErrors.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.peakQueueDepth = peakQueueDepth;
+    }
+    stats.convertSeconds = convertNs.load(std::memory_order_relaxed) / 1e9;
+    stats.writeSeconds = writeNs.load(std::memory_order_relaxed) / 1e9;
+    return stats;
+}
+
+void SpinVideoWriter::PrintStats() const {
+    SpinLogger::Instance().BeginReport();
+    SpinVideoWriterStats stats = GetStats();
+    std::cout << "===== Video Writer =====" << std::endl;
+    std::cout << "Output: " << target << std::endl;
+    std::cout << "Frames Written: " << stats.framesWritten << std::endl;
+    std::cout << "Bytes Written: " << stats.bytesWritten << std::endl;
+    std::cout << "Frames Dropped: " << stats.framesDropped << std::endl;
+    std::cout << "Write Errors: " << stats.writeErrors << std::endl;
+    std::cout << "Peak Queue Depth: " << stats.peakQueueDepth << " of " << config.queueCapacity << std::endl;
+    std::cout << "Convert Time: " << stats.convertSeconds << " s" << std::endl;
+    std::cout << "Write Time: " << stats.writeSeconds << " s" << std::endl;
+    std::cout << "========================" << std::endl;
+}
+
+std::string SpinVideoWriter::FfmpegCommand(const std::string& outputFilename, const std::string& codecOptions) {
+    return "ffmpeg -y -loglevel error -f yuv4mpegpipe -i - " + codecOptions + " \"" + outputFilename + "\"";
+}
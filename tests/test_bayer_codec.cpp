@@ -0,0 +1,124 @@
+// Lossless Bayer codec: byte exact round trips for every bit depth, odd sizes, trailing bytes and noise that is stored as
+// is, and a compressed recording read back through SpinRawReader
+#include "../include/SpinnakerSDK_SpinBayerCodec.h"
+#include "../include/SpinnakerSDK_SpinRawReader.h"
+#include "../include/SpinnakerSDK_SpinRawRecorder.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <cstdio>
+#include <random>
+#include <unistd.h>
+
+namespace {
+    // A smooth gradient with a little noise (what a camera gives), or nothing but noise (which does not compress)
+    std::vector<unsigned char> MakeSamples(size_t size, bool noise, std::mt19937& random) {
+        std::vector<unsigned char> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = noise ? static_cast<unsigned char>(random()) : static_cast<unsigned char>(i / 7 + random() % 3);
+        }
+        return data;
+    }
+
+    // Encode and decode, returns the encoded size (0 if the round trip failed)
+    size_t RoundTrip(SpinBayerCodec& codec, const std::vector<unsigned char>& data, int width, int height, Spinnaker::PixelFormatEnums pixelFormat) {
+        std::vector<unsigned char> encoded;
+        codec.Encode(data.data(), data.size(), width, height, pixelFormat, encoded);
+        if (SpinBayerCodec::GetDecodedSize(encoded.data(), encoded.size()) != data.size()) {
+            return 0;
+        }
+        std::vector<unsigned char> decoded(data.size());
+        codec.Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size());
+        return decoded == data ? encoded.size() : 0;
+    }
+}
+
+int main() {
+    std::mt19937 random(7);
+    const Spinnaker::PixelFormatEnums formats[] = {
+        Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8,  Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p,
+        Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p, Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16,
+        Spinnaker::PixelFormatEnums::PixelFormat_Mono8,     Spinnaker::PixelFormatEnums::PixelFormat_Mono12p,
+    };
+    const int sizes[][2] = {{1, 1}, {3, 5}, {33, 17}, {64, 64}, {101, 67}};
+
+    // Every depth, odd sizes (partial quads and a last partial byte), trailing bytes, small and large tiles
+    for (const Spinnaker::PixelFormatEnums pixelFormat : formats) {
+        const int bitsPerPixel = SpinBayerCodec::GetBitsPerPixel(pixelFormat);
+        SPIN_CHECK(bitsPerPixel > 0);
+        for (const auto& size : sizes) {
+            for (const size_t tail : {size_t(0), size_t(5)}) {
+                for (const int tileRows : {4, 64}) {
+                    for (const bool noise : {false, true}) {
+                        SpinBayerCodecOptions options;
+                        options.tileRows = tileRows;
+                        options.threadCount = noise ? 1 : 0;
+                        SpinBayerCodec codec(options);
+                        const uint64_t totalBits = static_cast<uint64_t>(size[0]) * size[1] * bitsPerPixel;
+                        const std::vector<unsigned char> data = MakeSamples((totalBits + 7) / 8 + tail, noise, random);
+                        const size_t encodedSize = RoundTrip(codec, data, size[0], size[1], pixelFormat);
+                        SPIN_CHECK(encodedSize > 0);
+                        // Noise is stored tile by tile, so it grows by no more than the headers
+                        SPIN_CHECK(encodedSize <= SpinBayerCodec::GetMaxEncodedSize(data.size(), size[1], tileRows));
+                    }
+                }
+            }
+        }
+    }
+
+    // A smooth frame compresses, a truncated one is refused
+    {
+        SpinBayerCodec codec;
+        const std::vector<unsigned char> data = MakeSamples(640 * 480, false, random);
+        std::vector<unsigned char> encoded;
+        codec.Encode(data.data(), data.size(), 640, 480, Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8, encoded);
+        SPIN_CHECK(encoded.size() < data.size() / 2);
+        std::vector<unsigned char> decoded(data.size());
+        bool threw = false;
+        try {
+            codec.Decode(encoded.data(), encoded.size() / 2, decoded.data(), decoded.size());
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        SPIN_CHECK(threw);
+    }
+
+    // Compressed recording: Bayer frames are coded on the way in and decoded on the way out, RGB ones are stored as is
+    {
+        const std::string filename = "/tmp/test_bayer_codec_" + std::to_string(getpid()) + ".raw";
+        const int width = kTestFrameWidth;
+        const int height = kTestFrameHeight;
+        std::vector<std::vector<unsigned char>> frames;
+        SpinRawRecorderConfig config;
+        config.chunkSize = 4 * SpinRawFormat::kBlockSize;
+        config.chunkCount = 4;
+        config.directIO = false;
+        config.blockWhenFull = true;
+        config.compression = SpinRawFormat::Compression::BayerLossless;
+        SpinRawRecorder recorder(config);
+        recorder.Open(filename, static_cast<size_t>(width) * height * 3);
+        for (uint64_t i = 0; i < 6; ++i) {
+            const bool rgb = i == 3;
+            frames.push_back(MakeSamples(static_cast<size_t>(width) * height * (rgb ? 3 : 1), false, random));
+            const Spinnaker::PixelFormatEnums pixelFormat = rgb ? Spinnaker::PixelFormatEnums::PixelFormat_RGB8
+                                                                : Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8;
+            SPIN_CHECK(recorder.Push(MakeTestFrame(frames.back(), width, height, pixelFormat, 0, 1000 * (i + 1), i)));
+        }
+        recorder.Close();
+        SPIN_CHECK(recorder.GetStats().framesWritten == 6);
+        SPIN_CHECK(recorder.GetStats().compressionRatio > 1.0);
+
+        SpinRawReader reader(filename);
+        SPIN_CHECK(reader.GetFrameCount() == 6);
+        for (size_t i = 0; i < reader.GetFrameCount(); ++i) {
+            const SpinRawFormat::IndexEntry& entry = reader.GetIndexEntry(i);
+            SPIN_CHECK((entry.rawSize > 0) == (i != 3));
+            SpinImage frame = reader.GetFrame(i);
+            SPIN_CHECK(frame.GetDataSize() == frames[i].size());
+            SPIN_CHECK(std::vector<unsigned char>(frame.GetData(), frame.GetData() + frame.GetDataSize()) == frames[i]);
+            SPIN_CHECK(frame.GetTimeStamp() == 1000 * (i + 1));
+        }
+        std::remove(filename.c_str());
+    }
+
+    return TestResult("test_bayer_codec");
+}
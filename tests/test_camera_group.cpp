@@ -0,0 +1,115 @@
+// Camera group on simulated cameras: members that fail keep their backend for a retry, and shutdown errors never escape the destructor
+#include "../include/SpinnakerSDK_SpinCameraGroup.h"
+#include "../include/SpinnakerSDK_SpinSimulatedBackend.h"
+#include "test_check.h"
+#include <atomic>
+
+namespace {
+    // Simulated camera whose Init and DeInit fail a given number of times
+    class FlakyBackend : public SpinSimulatedBackend {
+    public:
+        FlakyBackend(const std::string& serial, int failInits, int failDeInits)
+            : SpinSimulatedBackend(Config(serial)), failInits(failInits), failDeInits(failDeInits) {}
+
+        void Init() override {
+            initCalls++;
+            if (failInits > 0) {
+                failInits--;
+                throw std::runtime_error("Init failed");
+            }
+            SpinSimulatedBackend::Init();
+        }
+        void DeInit() override {
+            if (failDeInits > 0) {
+                failDeInits--;
+                throw std::runtime_error("DeInit failed");
+            }
+            SpinSimulatedBackend::DeInit();
+        }
+
+        std::atomic<int> initCalls{0};
+
+    private:
+        static SpinSimulatedCameraConfig Config(const std::string& serial) {
+            SpinSimulatedCameraConfig config;
+            config.sensorWidth = 64;
+            config.sensorHeight = 48;
+            config.serialNumber = serial;
+            return config;
+        }
+
+        std::atomic<int> failInits;
+        std::atomic<int> failDeInits;
+    };
+}
+
+int main() {
+    auto noConfiguration = [](SpinCamera&) {};
+
+    // A backend that fails Init stays with its member and is retried on the next Initialize
+    {
+        FlakyBackend* flaky = new FlakyBackend("SIM-A", 1, 0);
+        SpinCameraGroup group;
+        group.AddCamera(std::unique_ptr<SpinCameraBackend>(flaky));
+        group.AddCamera(std::unique_ptr<SpinCameraBackend>(new FlakyBackend("SIM-B", 0, 0)));
+
+        std::vector<SpinCameraGroupResult> results = group.Initialize(noConfiguration);
+        SPIN_CHECK(!results[0].success);
+        SPIN_CHECK(results[0].error == "Init failed");
+        SPIN_CHECK(results[1].success);
+        SPIN_CHECK(!group.IsReady(0));
+        SPIN_CHECK(group.IsReady(1));
+
+        results = group.Initialize(noConfiguration);
+        SPIN_CHECK(results[0].success);
+        SPIN_CHECK(group.IsReady(0));
+        SPIN_CHECK(group.GetCamera(0).GetBackend() == flaky);
+        SPIN_CHECK(flaky->initCalls == 2);
+
+        // Shutting down hands the backends back too, so the group can be initialized again
+        group.Shutdown();
+        SPIN_CHECK(!group.IsReady(0));
+        results = group.Initialize(noConfiguration);
+        SPIN_CHECK(results[0].success && results[1].success);
+        SPIN_CHECK(group.GetCamera(0).GetBackend() == flaky);
+    }
+
+    // So does a backend whose configuration failed
+    {
+        FlakyBackend* backend = new FlakyBackend("SIM-C", 0, 0);
+        SpinCameraGroup group;
+        group.AddCamera(std::unique_ptr<SpinCameraBackend>(backend));
+        std::atomic<int> configureCalls(0);
+        auto failOnce = [&configureCalls](SpinCamera&) {
+            if (configureCalls++ == 0) {
+                throw std::runtime_error("Configuration failed");
+            }
+        };
+        SPIN_CHECK(!group.Initialize(failOnce)[0].success);
+        SPIN_CHECK(group.Initialize(failOnce)[0].success);
+        SPIN_CHECK(group.GetCamera(0).GetBackend() == backend);
+        SPIN_CHECK(backend->initCalls == 2);
+    }
+
+    // Shutdown reports the failure, the destructor only logs it
+    {
+        SpinCameraGroup group;
+        group.AddCamera(std::unique_ptr<SpinCameraBackend>(new FlakyBackend("SIM-D", 0, 1)));
+        SPIN_CHECK(group.Initialize(noConfiguration)[0].success);
+        bool threw = false;
+        try {
+            group.Shutdown();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        SPIN_CHECK(threw);
+        SPIN_CHECK(!group.IsReady(0));
+    }
+    {
+        SpinCameraGroup group;
+        group.AddCamera(std::unique_ptr<SpinCameraBackend>(new FlakyBackend("SIM-E", 0, 1)));
+        SPIN_CHECK(group.Initialize(noConfiguration)[0].success);
+    }
+
+    return TestResult("test_camera_group");
+}
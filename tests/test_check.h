@@ -0,0 +1,27 @@
+#ifndef SPINNAKER_SDK_TEST_CHECK_H
+#define SPINNAKER_SDK_TEST_CHECK_H
+
+// Minimal checks for the hardware-free tests, each test is its own program and fails with a non-zero exit code
+#include <iostream>
+
+static int testFailures = 0;
+
+#define SPIN_CHECK(condition)                                                                          \
+    do {                                                                                               \
+        if (!(condition)) {                                                                            \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+            testFailures++;                                                                            \
+        }                                                                                              \
+    } while (0)
+
+// Exit code of the test, with a summary line
+static int TestResult(const char* name) {
+    if (testFailures == 0) {
+        std::cout << name << ": passed" << std::endl;
+        return 0;
+    }
+    std::cout << name << ": " << testFailures << " check(s) failed" << std::endl;
+    return 1;
+}
+
+#endif // SPINNAKER_SDK_TEST_CHECK_H
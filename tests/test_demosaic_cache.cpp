@@ -0,0 +1,63 @@
+// Lazy demosaicing of a synthetic BayerRG8 frame: tiles match the whole frame, and a square drawn into the tiles survives
+// a later request for another method
+#include "../include/SpinnakerSDK_SpinImage.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    const int kWidth = 256;
+    const int kHeight = 192;
+
+    bool IsRed(const unsigned char* rgb, int x, int y) {
+        const unsigned char* pixel = rgb + (static_cast<size_t>(y) * kWidth + x) * 3;
+        return pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 0;
+    }
+}
+
+int main() {
+    std::vector<unsigned char> bayer(kWidth * kHeight);
+    for (size_t i = 0; i < bayer.size(); ++i) {
+        bayer[i] = static_cast<unsigned char>((i * 37) ^ (i >> 5));
+    }
+    SpinDemosaicOptions bilinear;
+    SpinDemosaicOptions malvar;
+    malvar.method = SpinDemosaicing::Method::MalvarHeCutler;
+    std::vector<unsigned char> reference(bayer.size() * 3);
+    SpinDemosaicer::Demosaic(bayer.data(), 0, kWidth, kHeight, reference.data(), 0, malvar);
+
+    // Tiles done piecemeal give the whole frame demosaiced at once, after a change of method too
+    {
+        SpinDemosaicCache cache(bayer.data(), 0, kWidth, kHeight);
+        cache.Region(10, 10, 20, 20, bilinear);
+        SPIN_CHECK(cache.GetTilesDone() == 1);
+        cache.Region(100, 70, 80, 30, malvar);
+        const unsigned char* rgb = cache.Frame(malvar);
+        SPIN_CHECK(cache.IsComplete());
+        SPIN_CHECK(std::vector<unsigned char>(rgb, rgb + reference.size()) == reference);
+    }
+
+    // The square drawn into the tiles stays, and only its tiles keep the first method
+    {
+        SpinImage image = MakeTestFrame(bayer, kWidth, kHeight, Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8);
+        image.DemosaicRegion(192, 128, 10, 10, bilinear);
+        image.DrawRedSquare(100, 100, 10);
+        const unsigned char* rgb = image.DemosaicRegion(0, 0, kWidth, kHeight, malvar);
+        SPIN_CHECK(IsRed(rgb, 90, 90));
+        SPIN_CHECK(IsRed(rgb, 110, 100));
+        SPIN_CHECK(IsRed(rgb, 100, 110));
+        SPIN_CHECK(!IsRed(rgb, 100, 100));
+        // The tile at (64, 64) holds the square, the one at (192, 128) is redone with the new method
+        const size_t kept = (static_cast<size_t>(70) * kWidth + 70) * 3;
+        const size_t redone = (static_cast<size_t>(130) * kWidth + 200) * 3;
+        std::vector<unsigned char> first(reference.size());
+        SpinDemosaicer::Demosaic(bayer.data(), 0, kWidth, kHeight, first.data(), 0, bilinear);
+        SPIN_CHECK(!std::equal(first.begin() + kept, first.begin() + kept + 3, reference.begin() + kept));
+        SPIN_CHECK(std::equal(rgb + kept, rgb + kept + 3, first.begin() + kept));
+        SPIN_CHECK(!std::equal(first.begin() + redone, first.begin() + redone + 3, reference.begin() + redone));
+        SPIN_CHECK(std::equal(rgb + redone, rgb + redone + 3, reference.begin() + redone));
+    }
+
+    return TestResult("test_demosaic_cache");
+}
@@ -0,0 +1,114 @@
+// Native demosaicing on synthetic Bayer frames: every instruction set the CPU has gives the scalar output byte for byte,
+// for both methods, odd sizes, padded rows, bands on several threads, regions and 16 bit input
+#include "../include/SpinnakerSDK_SpinDemosaic.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    // Random samples with some smooth structure, so the gradient corrections get exercised as well as the clamping
+    std::vector<unsigned char> MakeBayer(int width, int height, size_t stride, uint32_t seed) {
+        std::vector<unsigned char> bayer(stride * height, 0xEE);
+        uint32_t state = seed;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                state = state * 1664525u + 1013904223u;
+                const int noise = static_cast<int>(state >> 26);  // 0 to 63
+                bayer[y * stride + x] = static_cast<unsigned char>(((x * 5 + y * 3) & 0xFF) / 2 + noise * 2);
+            }
+        }
+        return bayer;
+    }
+
+    std::vector<unsigned char> Demosaic(const std::vector<unsigned char>& bayer, size_t stride, int width, int height,
+                                        const SpinDemosaicOptions& options) {
+        std::vector<unsigned char> rgb(static_cast<size_t>(width) * height * 3);
+        SpinDemosaicer::Demosaic(bayer.data(), stride, width, height, rgb.data(), 0, options);
+        return rgb;
+    }
+}
+
+int main() {
+    const SpinDemosaicing::Isa simdIsas[] = {SpinDemosaicing::Isa::SSE2, SpinDemosaicing::Isa::AVX2, SpinDemosaicing::Isa::NEON};
+    const SpinDemosaicing::Method methods[] = {SpinDemosaicing::Method::Bilinear, SpinDemosaicing::Method::MalvarHeCutler};
+    const int sizes[][2] = {{8, 8}, {97, 61}, {640, 37}, {33, 130}};
+
+    int comparedIsas = 0;
+    for (SpinDemosaicing::Method method : methods) {
+        for (const int* size : sizes) {
+            const int width = size[0];
+            const int height = size[1];
+            const size_t stride = static_cast<size_t>(width) + 13;
+            const std::vector<unsigned char> bayer = MakeBayer(width, height, stride, static_cast<uint32_t>(width * 31 + height));
+
+            SpinDemosaicOptions options;
+            options.method = method;
+            options.isa = SpinDemosaicing::Isa::Scalar;
+            const std::vector<unsigned char> reference = Demosaic(bayer, stride, width, height, options);
+
+            // Every instruction set the CPU supports, and whatever Auto picks
+            for (SpinDemosaicing::Isa isa : simdIsas) {
+                if (SpinDemosaicer::ResolveIsa(isa) != isa) {
+                    continue;
+                }
+                options.isa = isa;
+                SPIN_CHECK(Demosaic(bayer, stride, width, height, options) == reference);
+                comparedIsas++;
+            }
+            options.isa = SpinDemosaicing::Isa::Auto;
+            SPIN_CHECK(Demosaic(bayer, stride, width, height, options) == reference);
+
+            // Bands on several threads
+            options.threadCount = 4;
+            options.bandRows = 6;
+            SPIN_CHECK(Demosaic(bayer, stride, width, height, options) == reference);
+            options.threadCount = 1;
+            options.bandRows = 0;
+
+            // A region at an odd offset matches the same pixels of the whole frame
+            const int x = width / 3 | 1;
+            const int y = height / 4 | 1;
+            const int regionWidth = width - x - 1;
+            const int regionHeight = height - y - 1;
+            if (regionWidth > 0 && regionHeight > 0) {
+                std::vector<unsigned char> region(static_cast<size_t>(regionWidth) * regionHeight * 3);
+                SpinDemosaicer::DemosaicRegion(bayer.data(), stride, width, height, x, y, regionWidth, regionHeight, region.data(), 0, options);
+                bool match = true;
+                for (int row = 0; row < regionHeight; ++row) {
+                    match = match && std::equal(region.begin() + static_cast<size_t>(row) * regionWidth * 3,
+                                                region.begin() + static_cast<size_t>(row + 1) * regionWidth * 3,
+                                                reference.begin() + (static_cast<size_t>(y + row) * width + x) * 3);
+                }
+                SPIN_CHECK(match);
+            }
+
+            // 16 bit samples keep their top 8 bits
+            std::vector<unsigned char> deep(static_cast<size_t>(width) * height * 2);
+            for (int row = 0; row < height; ++row) {
+                for (int column = 0; column < width; ++column) {
+                    const size_t i = static_cast<size_t>(row) * width + column;
+                    deep[2 * i] = static_cast<unsigned char>(column * 7 + row);  // Low byte, dropped
+                    deep[2 * i + 1] = bayer[row * stride + column];
+                }
+            }
+            std::vector<unsigned char> fromDeep(reference.size());
+            SpinDemosaicer::DemosaicPacked(deep.data(), 0, 16, width, height, fromDeep.data(), 0, options);
+            SPIN_CHECK(fromDeep == reference);
+        }
+
+        // A flat grey frame stays flat grey
+        const int width = 64;
+        const int height = 48;
+        SpinDemosaicOptions options;
+        options.method = method;
+        const std::vector<unsigned char> grey(width * height, 117);
+        const std::vector<unsigned char> rgb = Demosaic(grey, width, width, height, options);
+        SPIN_CHECK(rgb == std::vector<unsigned char>(rgb.size(), 117));
+    }
+
+    std::printf("Compared %d instruction set runs against the scalar path (best here: %s)\n", comparedIsas,
+                SpinDemosaicer::GetIsaName(SpinDemosaicer::ResolveIsa()));
+    return TestResult("test_demosaic_isa");
+}
@@ -0,0 +1,20 @@
+#ifndef SPINNAKER_SDK_TEST_FRAME_H
+#define SPINNAKER_SDK_TEST_FRAME_H
+
+// Synthetic frames for the hardware-free tests, over pixels the test keeps alive
+#include "../include/SpinnakerSDK_SpinImage.h"
+#include <functional>
+#include <vector>
+
+// Frame size of the tests that look at whole frames
+static const int kTestFrameWidth = 40;
+static const int kTestFrameHeight = 30;
+
+// Frame wrapping data (stride 0 for rows without padding), releaseHook runs once its last copy is gone
+static SpinImage MakeTestFrame(std::vector<unsigned char>& data, int width, int height, Spinnaker::PixelFormatEnums pixelFormat,
+                               size_t stride = 0, uint64_t timestamp = 0, uint64_t frameID = 0,
+                               std::function<void()> releaseHook = []() {}) {
+    return SpinImage(data.data(), data.size(), width, height, pixelFormat, releaseHook, timestamp, frameID, stride);
+}
+
+#endif // SPINNAKER_SDK_TEST_FRAME_H
@@ -0,0 +1,119 @@
+// Frame matching on synthetic timestamp streams: jitter within the tolerance, a dropped frame, cameras too far apart,
+// clock offsets and full queues
+#include "../include/SpinnakerSDK_SpinFrameSynchronizer.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <algorithm>
+
+namespace {
+    std::vector<unsigned char> pixel(1);
+
+    const int64_t kPeriod = 10000000;   // 100 fps
+    const int64_t kTolerance = 1000000;
+
+    // One pixel frame taken at timestamp
+    SpinImage FrameAt(int64_t timestamp, uint64_t frameID) {
+        return MakeTestFrame(pixel, 1, 1, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, 0, static_cast<uint64_t>(timestamp), frameID);
+    }
+
+    // Jitter of frame i of a camera, up to 400 us either way
+    int64_t Jitter(size_t camera, uint64_t i) {
+        return static_cast<int64_t>((i * 7919 + camera * 104729) % 801) * 1000 - 400000;
+    }
+}
+
+int main() {
+    // Jittered streams: every frame is matched with its counterpart
+    {
+        SpinFrameSynchronizer synchronizer(3, std::chrono::nanoseconds(kTolerance));
+        SpinFrameSet set;
+        SPIN_CHECK(!synchronizer.TryGetFrameSet(set));
+        for (uint64_t i = 0; i < 20; ++i) {
+            for (size_t camera = 0; camera < 3; ++camera) {
+                SPIN_CHECK(synchronizer.Push(camera, FrameAt(kPeriod * (i + 1) + Jitter(camera, i), i)));
+            }
+            SPIN_CHECK(synchronizer.TryGetFrameSet(set));
+            SPIN_CHECK(set.frames.size() == 3);
+            int64_t earliest = INT64_MAX;
+            int64_t latest = 0;
+            for (size_t camera = 0; camera < 3; ++camera) {
+                SPIN_CHECK(set.frames[camera].GetFrameID() == i);
+                earliest = std::min(earliest, static_cast<int64_t>(set.frames[camera].GetTimeStamp()));
+                latest = std::max(latest, static_cast<int64_t>(set.frames[camera].GetTimeStamp()));
+            }
+            SPIN_CHECK(set.timestamp == static_cast<uint64_t>(earliest));
+            SPIN_CHECK(set.skew == static_cast<uint64_t>(latest - earliest));
+            SPIN_CHECK(set.skew <= static_cast<uint64_t>(kTolerance));
+        }
+        SPIN_CHECK(!synchronizer.TryGetFrameSet(set));
+        SPIN_CHECK(synchronizer.GetMatchedSets() == 20);
+        for (size_t camera = 0; camera < 3; ++camera) {
+            SPIN_CHECK(synchronizer.GetCameraStats(camera).receivedFrames == 20);
+            SPIN_CHECK(synchronizer.GetCameraStats(camera).unmatchedFrames == 0);
+        }
+    }
+
+    // Camera 1 loses frame 3: camera 0's frame 3 is discarded and matching carries on with frame 4
+    {
+        SpinFrameSynchronizer synchronizer(2, std::chrono::nanoseconds(kTolerance));
+        for (uint64_t i = 0; i < 8; ++i) {
+            synchronizer.Push(0, FrameAt(kPeriod * (i + 1) + Jitter(0, i), i));
+            if (i != 3) {
+                synchronizer.Push(1, FrameAt(kPeriod * (i + 1) + Jitter(1, i), i));
+            }
+        }
+        std::vector<uint64_t> matched;
+        SpinFrameSet set;
+        while (synchronizer.TryGetFrameSet(set)) {
+            SPIN_CHECK(set.frames[0].GetFrameID() == set.frames[1].GetFrameID());
+            matched.push_back(set.frames[0].GetFrameID());
+        }
+        SPIN_CHECK((matched == std::vector<uint64_t>{0, 1, 2, 4, 5, 6, 7}));
+        SPIN_CHECK(synchronizer.GetCameraStats(0).unmatchedFrames == 1);
+        SPIN_CHECK(synchronizer.GetCameraStats(1).unmatchedFrames == 0);
+    }
+
+    // Cameras 2 ms apart never match within 1 ms, until the offset between their clocks is given
+    {
+        SpinFrameSynchronizer synchronizer(2, std::chrono::nanoseconds(kTolerance));
+        for (uint64_t i = 0; i < 5; ++i) {
+            synchronizer.Push(0, FrameAt(kPeriod * (i + 1), i));
+            synchronizer.Push(1, FrameAt(kPeriod * (i + 1) + 2000000, i));
+        }
+        SpinFrameSet set;
+        SPIN_CHECK(!synchronizer.TryGetFrameSet(set));
+        SPIN_CHECK(synchronizer.GetMatchedSets() == 0);
+        // All but the last frame of one camera, which still waits for a newer frame of the other
+        SPIN_CHECK(synchronizer.GetCameraStats(0).unmatchedFrames + synchronizer.GetCameraStats(1).unmatchedFrames == 9);
+
+        synchronizer.Clear();
+        synchronizer.SetClockOffset(1, 2000000);
+        for (uint64_t i = 5; i < 10; ++i) {
+            synchronizer.Push(0, FrameAt(kPeriod * (i + 1), i));
+            synchronizer.Push(1, FrameAt(kPeriod * (i + 1) + 2000000, i));
+        }
+        for (uint64_t i = 5; i < 10; ++i) {
+            SPIN_CHECK(synchronizer.TryGetFrameSet(set));
+            SPIN_CHECK(set.frames[1].GetFrameID() == i);
+            SPIN_CHECK(set.skew == 0);
+            SPIN_CHECK(set.timestamp == static_cast<uint64_t>(kPeriod * (i + 1)));
+        }
+    }
+
+    // A full queue refuses frames and counts them as dropped
+    {
+        SpinFrameSynchronizer synchronizer(2, std::chrono::nanoseconds(kTolerance), 4);
+        size_t accepted = 0;
+        for (uint64_t i = 0; i < 10; ++i) {
+            accepted += synchronizer.Push(0, FrameAt(kPeriod * (i + 1), i)) ? 1 : 0;
+        }
+        const SpinFrameSynchronizerCameraStats stats = synchronizer.GetCameraStats(0);
+        SPIN_CHECK(stats.receivedFrames == accepted);
+        SPIN_CHECK(stats.droppedFrames == 10 - accepted);
+        SPIN_CHECK(stats.droppedFrames > 0);
+        SpinFrameSet set;
+        SPIN_CHECK(!synchronizer.GetFrameSet(set, std::chrono::milliseconds(20)));
+    }
+
+    return TestResult("test_frame_synchronizer");
+}
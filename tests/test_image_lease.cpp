@@ -0,0 +1,71 @@
+// Zero-copy leased images: the release hook fires exactly once, when the last image referencing the buffer goes away
+#include "../include/SpinnakerSDK_SpinImage.h"
+#include "test_check.h"
+#include <cstring>
+#include <vector>
+
+int main() {
+    const int width = 16;
+    const int height = 8;
+    std::vector<unsigned char> buffer(width * height);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<unsigned char>(i);
+    }
+
+    // Copies share the lease
+    int releases = 0;
+    {
+        SpinImage leased(buffer.data(), buffer.size(), width, height, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, [&releases]() { releases++; }, 42, 7);
+        SPIN_CHECK(leased.IsLeased());
+        SPIN_CHECK(leased.GetData() == buffer.data());
+        SPIN_CHECK(leased.GetTimeStamp() == 42);
+        SPIN_CHECK(leased.GetFrameID() == 7);
+        {
+            SpinImage copy = leased;
+            SpinImage assigned(nullptr);
+            assigned = copy;
+            SPIN_CHECK(copy.GetData() == buffer.data());
+            SPIN_CHECK(assigned.GetData() == buffer.data());
+        }
+        SPIN_CHECK(releases == 0);
+    }
+    SPIN_CHECK(releases == 1);
+
+    // A detached copy owns its pixels, so the lease ends with the last leased image even while the copy lives on
+    releases = 0;
+    {
+        SpinImage detached(nullptr);
+        {
+            SpinImage leased(buffer.data(), buffer.size(), width, height, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, [&releases]() { releases++; });
+            detached = leased.Detach();
+            SPIN_CHECK(!detached.IsLeased());
+            SPIN_CHECK(detached.GetData() != buffer.data());
+            SPIN_CHECK(detached.GetDataSize() == buffer.size());
+            SPIN_CHECK(std::memcmp(detached.GetData(), buffer.data(), buffer.size()) == 0);
+            SPIN_CHECK(releases == 0);
+        }
+        SPIN_CHECK(releases == 1);
+        SPIN_CHECK(detached.GetData()[5] == 5);
+    }
+    SPIN_CHECK(releases == 1);
+
+    // Detaching into a pool borrows one of its buffers, given back with the detached image
+    releases = 0;
+    {
+        std::shared_ptr<SpinFramePool> pool = SpinFramePool::Create(2, buffer.size());
+        {
+            SpinImage leased(buffer.data(), buffer.size(), width, height, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, [&releases]() { releases++; });
+            SpinImage first = leased.Detach(pool);
+            SpinImage second = leased.Detach(pool);
+            SPIN_CHECK(pool->GetStats().inUse == 2);
+            // Exhausted, falls back to the heap
+            SpinImage third = leased.Detach(pool);
+            SPIN_CHECK(third.GetData() != nullptr);
+            SPIN_CHECK(pool->GetStats().exhaustions == 1);
+        }
+        SPIN_CHECK(pool->GetStats().inUse == 0);
+    }
+    SPIN_CHECK(releases == 1);
+
+    return TestResult("test_image_lease");
+}
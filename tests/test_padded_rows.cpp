@@ -0,0 +1,89 @@
+// Frames of 16 bit and packed samples with padded rows give what the same pixels without padding give: unpacked samples,
+// native demosaicing, pixel colours and region statistics
+#include "../include/SpinnakerSDK_SpinImage.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+    // Rows of every depth end on a whole byte, so the unpadded frame is also its rows back to back
+    const int kWidth = 44;
+    const int kHeight = 9;
+    const size_t kPadding = 10;
+
+    void CheckFormat(Spinnaker::PixelFormatEnums pixelFormat, int bitsPerPixel, bool bayer) {
+        const size_t rowBytes = static_cast<size_t>(kWidth) * bitsPerPixel / 8;
+        const size_t stride = rowBytes + kPadding;
+        std::vector<unsigned char> tight(rowBytes * kHeight);
+        for (size_t i = 0; i < tight.size(); ++i) {
+            tight[i] = static_cast<unsigned char>((i * 73) ^ (i >> 2));
+        }
+        // The same rows with padding bytes that would show if they were read as samples
+        std::vector<unsigned char> padded(stride * kHeight, 0xee);
+        for (int y = 0; y < kHeight; ++y) {
+            std::memcpy(&padded[y * stride], &tight[y * rowBytes], rowBytes);
+        }
+        SpinImage plain = MakeTestFrame(tight, kWidth, kHeight, pixelFormat);
+        SpinImage withPadding = MakeTestFrame(padded, kWidth, kHeight, pixelFormat, stride);
+        SPIN_CHECK(withPadding.GetStride() == stride);
+
+        const size_t pixels = static_cast<size_t>(kWidth) * kHeight;
+        std::vector<unsigned char> expected8(pixels), actual8(pixels);
+        plain.UnpackTo8(expected8.data());
+        withPadding.UnpackTo8(actual8.data());
+        SPIN_CHECK(expected8 == actual8);
+        std::vector<uint16_t> expected16(pixels), actual16(pixels);
+        plain.UnpackTo16(expected16.data());
+        withPadding.UnpackTo16(actual16.data());
+        SPIN_CHECK(expected16 == actual16);
+
+        if (bayer) {
+            std::vector<unsigned char> expectedRgb(pixels * 3), actualRgb(pixels * 3);
+            plain.DemosaicInto(expectedRgb.data());
+            withPadding.DemosaicInto(actualRgb.data());
+            SPIN_CHECK(expectedRgb == actualRgb);
+        }
+
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                unsigned char expected[3], actual[3];
+                plain.GetPixelRGB(x, y, expected[0], expected[1], expected[2]);
+                withPadding.GetPixelRGB(x, y, actual[0], actual[1], actual[2]);
+                SPIN_CHECK(std::memcmp(expected, actual, 3) == 0);
+            }
+        }
+        SpinRoi roi;
+        roi.width = kWidth;
+        roi.height = kHeight;
+        const SpinRoiStats expectedStats = plain.CalculateRoiStats({roi})[0];
+        const SpinRoiStats actualStats = withPadding.CalculateRoiStats({roi})[0];
+        for (int c = 0; c < 3; ++c) {
+            SPIN_CHECK(expectedStats.channels[c].sum == actualStats.channels[c].sum);
+        }
+
+        // A buffer that ends inside the last row's padding still holds every sample, one that ends before it does not
+        SpinImage shortest(padded.data(), stride * (kHeight - 1) + rowBytes, kWidth, kHeight, pixelFormat, []() {}, 0, 0, stride);
+        shortest.UnpackTo8(actual8.data());
+        SPIN_CHECK(expected8 == actual8);
+        SpinImage truncated(padded.data(), stride * (kHeight - 1) + rowBytes - 1, kWidth, kHeight, pixelFormat, []() {}, 0, 0, stride);
+        bool threw = false;
+        try {
+            truncated.UnpackTo8(actual8.data());
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        SPIN_CHECK(threw);
+    }
+}
+
+int main() {
+    CheckFormat(Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16, 16, true);
+    CheckFormat(Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p, 10, true);
+    CheckFormat(Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p, 12, true);
+    CheckFormat(Spinnaker::PixelFormatEnums::PixelFormat_Mono16, 16, false);
+    CheckFormat(Spinnaker::PixelFormatEnums::PixelFormat_Mono10p, 10, false);
+    CheckFormat(Spinnaker::PixelFormatEnums::PixelFormat_Mono12p, 12, false);
+
+    return TestResult("test_padded_rows");
+}
@@ -0,0 +1,100 @@
+// Region statistics, the average colour and the integral image give the colours GetPixelRGB does, for every pixel format
+// it reads (all Bayer patterns, grey and RGB, 8 and 16 bit, packed)
+#include "../include/SpinnakerSDK_SpinImage.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <vector>
+
+namespace {
+    // Odd sizes cut the last quads, the width is enough for the vector path
+    const int kWidth = 45;
+    const int kHeight = 7;
+
+    struct Format {
+        Spinnaker::PixelFormatEnums pixelFormat;
+        size_t rowBytes;  // 0 for packed formats, which have no row padding
+        size_t packedSize;
+    };
+
+    // Every pixel against GetPixelRGB, then a region against the sum of its pixels
+    void CheckImage(SpinImage& image) {
+        std::vector<unsigned char> colors(static_cast<size_t>(kWidth) * kHeight * 3);
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                unsigned char* rgb = &colors[(static_cast<size_t>(y) * kWidth + x) * 3];
+                image.GetPixelRGB(x, y, rgb[0], rgb[1], rgb[2]);
+                unsigned char R, G, B;
+                image.CalculateAverageColor(x, y, 1, 1, R, G, B);
+                SPIN_CHECK(R == rgb[0] && G == rgb[1] && B == rgb[2]);
+            }
+        }
+
+        SpinRoi roi;
+        roi.x = 3;
+        roi.y = 1;
+        roi.width = kWidth - 3;
+        roi.height = kHeight - 1;
+        uint64_t sums[3] = {};
+        for (int y = roi.y; y < kHeight; ++y) {
+            for (int x = roi.x; x < kWidth; ++x) {
+                for (int c = 0; c < 3; ++c) {
+                    sums[c] += colors[(static_cast<size_t>(y) * kWidth + x) * 3 + c];
+                }
+            }
+        }
+        const SpinRoiStats stats = image.CalculateRoiStats({roi})[0];
+        SPIN_CHECK(stats.pixelCount == static_cast<uint64_t>(roi.width) * roi.height);
+        for (int c = 0; c < 3; ++c) {
+            SPIN_CHECK(stats.channels[c].sum == sums[c]);
+        }
+    }
+}
+
+int main() {
+    const size_t pixels = static_cast<size_t>(kWidth) * kHeight;
+    const Format formats[] = {
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerRG8, kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerGR8, kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerGB8, kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerBG8, kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerRG16, 2 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerGR16, 2 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerGB16, 2 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerBG16, 2 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_Mono8, kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_Mono16, 2 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_RGB8, 3 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_RGB16, 6 * kWidth, 0},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerRG10p, 0, SpinUnpacker::GetPackedSize(10, pixels)},
+        {Spinnaker::PixelFormatEnums::PixelFormat_BayerRG12p, 0, SpinUnpacker::GetPackedSize(12, pixels)},
+        {Spinnaker::PixelFormatEnums::PixelFormat_Mono10p, 0, SpinUnpacker::GetPackedSize(10, pixels)},
+        {Spinnaker::PixelFormatEnums::PixelFormat_Mono12p, 0, SpinUnpacker::GetPackedSize(12, pixels)},
+    };
+
+    for (const Format& format : formats) {
+        // Rows of whole bytes per pixel are padded (keeping 16 bit samples aligned), so the stride is honoured too
+        const size_t stride = format.rowBytes ? format.rowBytes + 6 : 0;
+        const size_t size = format.rowBytes ? stride * kHeight : format.packedSize;
+        std::vector<unsigned char> data(size);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<unsigned char>((i * 151) ^ (i >> 3));
+        }
+        SpinImage image = MakeTestFrame(data, kWidth, kHeight, format.pixelFormat, stride);
+        CheckImage(image);
+        image.BuildIntegralImage();
+        CheckImage(image);
+    }
+
+    // Formats without colours the statistics know are refused rather than read as BayerRG8
+    std::vector<unsigned char> packed(8);
+    SpinImage other = MakeTestFrame(packed, 2, 1, Spinnaker::PixelFormatEnums::PixelFormat_RGB10p);
+    bool threw = false;
+    try {
+        other.CalculateRoiStats({SpinRoi()});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    SPIN_CHECK(threw);
+
+    return TestResult("test_pixel_stats");
+}
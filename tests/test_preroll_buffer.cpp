@@ -0,0 +1,78 @@
+// Pre-roll ring searched by synthetic timestamps: closest frame, windows, overwriting and waiting for later frames
+#include "../include/SpinnakerSDK_SpinPreRollBuffer.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <thread>
+
+namespace {
+    std::vector<unsigned char> pixel(1);
+    int releases = 0;
+
+    // One pixel frame with the given timestamp, counting its release
+    SpinImage FrameAt(uint64_t timestamp) {
+        return MakeTestFrame(pixel, 1, 1, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, 0, timestamp, timestamp / 100, []() { releases++; });
+    }
+
+    std::vector<uint64_t> Timestamps(const std::vector<SpinImage>& frames) {
+        std::vector<uint64_t> timestamps;
+        for (const SpinImage& frame : frames) {
+            timestamps.push_back(frame.GetTimeStamp());
+        }
+        return timestamps;
+    }
+}
+
+int main() {
+    SpinPreRollBuffer buffer(4);
+    SpinImage found(nullptr);
+    SPIN_CHECK(!buffer.FindClosest(100, found));
+    SPIN_CHECK(buffer.GetWindow(100, 1, 1).empty());
+
+    // 100, 200, 300 (frames every 100 ns with some jitter is the same search)
+    for (uint64_t timestamp : {100, 200, 300}) {
+        buffer.Push(FrameAt(timestamp));
+    }
+    SPIN_CHECK(buffer.Size() == 3);
+    SPIN_CHECK(buffer.FindClosest(0, found) && found.GetTimeStamp() == 100);      // Before the first frame
+    SPIN_CHECK(buffer.FindClosest(140, found) && found.GetTimeStamp() == 100);
+    SPIN_CHECK(buffer.FindClosest(150, found) && found.GetTimeStamp() == 200);    // Ties go to the later frame
+    SPIN_CHECK(buffer.FindClosest(260, found) && found.GetTimeStamp() == 300);
+    SPIN_CHECK(buffer.FindClosest(100000, found) && found.GetTimeStamp() == 300); // After the last frame
+
+    // Windows are clipped to what is buffered, oldest first
+    SPIN_CHECK(Timestamps(buffer.GetWindow(200, 1, 1)) == std::vector<uint64_t>({100, 200, 300}));
+    SPIN_CHECK(Timestamps(buffer.GetWindow(100, 5, 0)) == std::vector<uint64_t>({100}));
+    SPIN_CHECK(Timestamps(buffer.GetWindow(300, 0, 5)) == std::vector<uint64_t>({300}));
+
+    // Full: the oldest frames are overwritten and released
+    releases = 0;
+    for (uint64_t timestamp : {400, 500, 600}) {
+        buffer.Push(FrameAt(timestamp));
+    }
+    SPIN_CHECK(buffer.Size() == 4);
+    SPIN_CHECK(releases == 2);
+    SPIN_CHECK(Timestamps(buffer.GetWindow(0, 0, 10)) == std::vector<uint64_t>({300, 400, 500, 600}));
+    SPIN_CHECK(buffer.FindClosest(120, found) && found.GetTimeStamp() == 300);
+    found = SpinImage(nullptr);
+
+    // Waiting for frames after a timestamp: times out while they are missing, wakes when they arrive
+    SPIN_CHECK(buffer.WaitForFramesAfter(500, 1, std::chrono::milliseconds(10)));
+    SPIN_CHECK(!buffer.WaitForFramesAfter(600, 1, std::chrono::milliseconds(10)));
+    SPIN_CHECK(!buffer.WaitForFramesAfter(650, 0, std::chrono::milliseconds(10)));  // The closest frame may still change
+    std::thread producer([&buffer] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        buffer.Push(FrameAt(700));
+    });
+    SPIN_CHECK(buffer.WaitForFramesAfter(650, 0, std::chrono::seconds(5)));
+    producer.join();
+    SPIN_CHECK(buffer.FindClosest(650, found) && found.GetTimeStamp() == 700);
+    found = SpinImage(nullptr);
+
+    // Clearing hands every frame back
+    releases = 0;
+    buffer.Clear();
+    SPIN_CHECK(buffer.Size() == 0);
+    SPIN_CHECK(releases == 4);
+
+    return TestResult("test_preroll_buffer");
+}
@@ -0,0 +1,141 @@
+// Raw recording round trip on synthetic frames: index entries, read-only frames, padded rows, Close racing Push, and
+// frames of failed writes
+#include "../include/SpinnakerSDK_SpinRawReader.h"
+#include "../include/SpinnakerSDK_SpinRawRecorder.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    const int kWidth = kTestFrameWidth;
+    const int kHeight = kTestFrameHeight;
+
+    // Grey frame i, pixel p holds p + i
+    SpinImage MakeNumberedFrame(std::vector<unsigned char>& pixels, uint64_t i) {
+        for (size_t p = 0; p < pixels.size(); ++p) {
+            pixels[p] = static_cast<unsigned char>(p + i);
+        }
+        return MakeTestFrame(pixels, kWidth, kHeight, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, 0, 1000 * (i + 1), i);
+    }
+
+    SpinRawRecorderConfig SmallConfig() {
+        SpinRawRecorderConfig config;
+        config.chunkSize = 2 * SpinRawFormat::kBlockSize;
+        config.chunkCount = 4;
+        config.directIO = false;
+        config.blockWhenFull = true;
+        return config;
+    }
+}
+
+int main() {
+    const std::string filename = "/tmp/test_raw_recorder_" + std::to_string(getpid()) + ".raw";
+    std::vector<unsigned char> pixels(kWidth * kHeight);
+
+    // Every frame comes back with its index entry, the stride is the frame's own
+    {
+        SpinRawRecorder recorder(SmallConfig());
+        recorder.Open(filename, pixels.size());
+        for (uint64_t i = 0; i < 10; ++i) {
+            SPIN_CHECK(recorder.Push(MakeNumberedFrame(pixels, i)));
+        }
+        recorder.Close();
+        SPIN_CHECK(recorder.GetStats().framesWritten == 10);
+        SPIN_CHECK(recorder.GetStats().framesLost == 0);
+
+        SpinRawReader reader(filename);
+        SPIN_CHECK(reader.HasStoredIndex());
+        SPIN_CHECK(reader.GetFrameCount() == 10);
+        SPIN_CHECK(reader.GetFirstTimestamp() == 1000 && reader.GetLastTimestamp() == 10000);
+        for (size_t i = 0; i < reader.GetFrameCount(); ++i) {
+            const SpinRawFormat::IndexEntry& entry = reader.GetIndexEntry(i);
+            SPIN_CHECK(entry.frameID == i);
+            SPIN_CHECK(entry.stride == static_cast<uint32_t>(kWidth));
+            SpinImage frame = reader.GetFrame(i);
+            SPIN_CHECK(frame.GetWidth() == kWidth && frame.GetHeight() == kHeight);
+            SPIN_CHECK(static_cast<const unsigned char*>(frame.GetData())[5] == static_cast<unsigned char>(5 + i));
+        }
+
+        // Frames are views of a read-only mapping, writing into one copies it and leaves the recording alone
+        SpinImage frame = reader.GetFrame(2);
+        const unsigned char* mapped = frame.GetData();
+        SPIN_CHECK(frame.IsReadOnly());
+        const SpinImage& constFrame = frame;
+        SPIN_CHECK(constFrame.GetView<SpinPixel::Mono8>().At(5, 0) == 7);
+        SPIN_CHECK(frame.IsReadOnly() && frame.GetData() == mapped);
+        frame.GetView<SpinPixel::Mono8>().At(5, 0) = 0;
+        SPIN_CHECK(!frame.IsReadOnly());
+        SPIN_CHECK(frame.GetData() != mapped);
+        SPIN_CHECK(frame.GetData()[5] == 0 && mapped[5] == 7);
+        SPIN_CHECK(frame.GetData()[6] == 8);
+        SPIN_CHECK(reader.GetFrame(2).GetData()[5] == 7);
+        SPIN_CHECK(!reader.GetFrame(2).Detach().IsReadOnly());
+    }
+
+    // Padded rows come back with their stride, so the padding is never read as pixels
+    {
+        const size_t stride = kWidth + 8;
+        std::vector<unsigned char> padded(stride * kHeight, 238);
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                padded[y * stride + x] = static_cast<unsigned char>(x + y);
+            }
+        }
+        SpinRawRecorder recorder(SmallConfig());
+        recorder.Open(filename, padded.size());
+        SPIN_CHECK(recorder.Push(MakeTestFrame(padded, kWidth, kHeight, Spinnaker::PixelFormatEnums::PixelFormat_Mono8, stride, 1000)));
+        recorder.Close();
+
+        SpinRawReader reader(filename);
+        SPIN_CHECK(reader.GetFrameCount() == 1);
+        SPIN_CHECK(reader.GetIndexEntry(0).stride == stride);
+        const SpinImage frame = reader.GetFrame(0);
+        SPIN_CHECK(frame.GetStride() == stride);
+        unsigned char R, G, B;
+        SpinImage(frame).GetPixelRGB(0, 1, R, G, B);
+        SPIN_CHECK(R == 1);
+        SPIN_CHECK(frame.GetView<SpinPixel::Mono8>().At(kWidth - 1, kHeight - 1) == kWidth + kHeight - 2);
+    }
+
+    // Close from another thread while frames are still coming in: Push either records the frame or reports it dropped
+    for (int round = 0; round < 10; ++round) {
+        SpinRawRecorder recorder(SmallConfig());
+        recorder.Open(filename, pixels.size());
+        std::atomic<bool> done(false);
+        std::atomic<uint64_t> accepted(0);
+        std::thread producer([&] {
+            std::vector<unsigned char> own(pixels.size());
+            for (uint64_t i = 0; !done; ++i) {
+                if (recorder.Push(MakeNumberedFrame(own, i))) {
+                    accepted++;
+                }
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(round));
+        recorder.Close();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        done = true;
+        producer.join();
+        SPIN_CHECK(SpinRawReader(filename).GetFrameCount() == accepted);
+    }
+
+    // Frames of chunks that fail to write are counted as lost
+    if (access("/dev/full", W_OK) == 0) {
+        SpinRawRecorder recorder(SmallConfig());
+        recorder.Open("/dev/full", pixels.size());
+        for (uint64_t i = 0; i < 6; ++i) {
+            recorder.Push(MakeNumberedFrame(pixels, i));
+        }
+        recorder.Close();
+        const SpinRawRecorderStats stats = recorder.GetStats();
+        SPIN_CHECK(stats.framesWritten == 0);
+        SPIN_CHECK(stats.framesLost == 6);
+        SPIN_CHECK(stats.writeErrors > 0);
+    }
+
+    std::remove(filename.c_str());
+    return TestResult("test_raw_recorder");
+}
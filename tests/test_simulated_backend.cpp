@@ -0,0 +1,140 @@
+// Simulated backend: frame delivery and geometry, injected faults, timeouts, and ending acquisition while another thread waits
+#include "../include/SpinnakerSDK_SpinSimulatedBackend.h"
+#include "test_check.h"
+#include <atomic>
+#include <thread>
+
+int main() {
+    SpinSimulatedCameraConfig config;
+    config.sensorWidth = 64;
+    config.sensorHeight = 48;
+    config.pixelFormat = "Mono8";
+    config.frameRate = 100.0;
+
+    // Frames arrive in order with the configured geometry and rising timestamps
+    {
+        SpinSimulatedBackend backend(config);
+        backend.Init();
+        SPIN_CHECK(backend.GetSerialNumber() == "SIM00000");
+        SPIN_CHECK(backend.GetIntegerValue("Width") == 64);
+        SPIN_CHECK(backend.GetIntegerValue("PayloadSize") == 64 * 48);
+        backend.BeginAcquisition();
+        uint64_t lastID = 0;
+        uint64_t lastTimestamp = 0;
+        for (int i = 0; i < 5; ++i) {
+            SpinImage image = backend.GetNextImage(1000);
+            SPIN_CHECK(image.GetWidth() == 64);
+            SPIN_CHECK(image.GetHeight() == 48);
+            SPIN_CHECK(image.GetData() != nullptr);
+            SPIN_CHECK(!image.IsIncomplete());
+            if (i > 0) {
+                SPIN_CHECK(image.GetFrameID() > lastID);
+                SPIN_CHECK(image.GetTimeStamp() > lastTimestamp);
+            }
+            lastID = image.GetFrameID();
+            lastTimestamp = image.GetTimeStamp();
+        }
+        // Locked while acquiring, like on a camera
+        SPIN_CHECK(!backend.IsWritable("Width"));
+        backend.EndAcquisition();
+        SPIN_CHECK(backend.IsWritable("Width"));
+        backend.DeInit();
+    }
+
+    // Every frame lost or incomplete, depending on the injected probabilities
+    {
+        SpinSimulatedCameraConfig dropping = config;
+        dropping.dropProbability = 1.0;
+        SpinSimulatedBackend backend(dropping);
+        backend.Init();
+        backend.BeginAcquisition();
+        bool timedOut = false;
+        try {
+            backend.GetNextImage(100);
+        } catch (const std::runtime_error&) {
+            timedOut = true;
+        }
+        SPIN_CHECK(timedOut);
+        backend.EndAcquisition();
+        SPIN_CHECK(backend.GetGeneratedFrames() > 0);
+        SPIN_CHECK(backend.GetInjectedDrops() == backend.GetGeneratedFrames());
+        SPIN_CHECK(backend.GetIntegerValue("StreamLostFrameCount") == static_cast<int64_t>(backend.GetInjectedDrops()));
+        backend.DeInit();
+    }
+    {
+        SpinSimulatedCameraConfig incomplete = config;
+        incomplete.incompleteProbability = 1.0;
+        SpinSimulatedBackend backend(incomplete);
+        backend.Init();
+        backend.BeginAcquisition();
+        SpinImage image = backend.GetNextImage(1000);
+        SPIN_CHECK(image.IsIncomplete());
+        backend.EndAcquisition();
+        SPIN_CHECK(backend.GetInjectedIncompletes() > 0);
+        SPIN_CHECK(backend.GetInjectedDrops() == 0);
+        backend.DeInit();
+    }
+
+    // Not acquiring: GetNextImage and EndAcquisition throw
+    {
+        SpinSimulatedBackend backend(config);
+        backend.Init();
+        bool threw = false;
+        try {
+            backend.GetNextImage(10);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        SPIN_CHECK(threw);
+        threw = false;
+        try {
+            backend.EndAcquisition();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        SPIN_CHECK(threw);
+        backend.DeInit();
+    }
+
+    // Ending acquisition from another thread wakes the waiting reader, which throws instead of touching a freed stream
+    {
+        SpinSimulatedCameraConfig starved = config;
+        starved.dropProbability = 1.0;
+        for (int round = 0; round < 20; ++round) {
+            SpinSimulatedBackend backend(starved);
+            backend.Init();
+            backend.BeginAcquisition();
+            std::atomic<bool> woken(false);
+            std::thread reader([&backend, &woken] {
+                try {
+                    backend.GetNextImage();
+                } catch (const std::runtime_error&) {
+                }
+                woken = true;
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(round % 4));
+            backend.EndAcquisition();
+            reader.join();
+            SPIN_CHECK(woken);
+            backend.DeInit();
+        }
+    }
+
+    // A leased frame stays valid after acquisition ended
+    {
+        SpinSimulatedBackend backend(config);
+        backend.Init();
+        backend.BeginAcquisition();
+        SpinImage image = backend.GetNextImage(1000);
+        backend.EndAcquisition();
+        backend.DeInit();
+        const unsigned char* data = static_cast<const unsigned char*>(image.GetData());
+        unsigned int sum = 0;
+        for (int i = 0; i < 64 * 48; ++i) {
+            sum += data[i];
+        }
+        SPIN_CHECK(sum > 0);
+    }
+
+    return TestResult("test_simulated_backend");
+}
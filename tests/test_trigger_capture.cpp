@@ -0,0 +1,79 @@
+// Trigger capture on the simulated camera, with and without pre-roll: a trigger that never fires times out, one that fires
+// gives the frames around it
+#include "../include/SpinnakerSDK_SpinCamera.h"
+#include "../include/SpinnakerSDK_SpinSimulatedBackend.h"
+#include "test_check.h"
+#include <thread>
+
+int main() {
+    SpinSimulatedCameraConfig config;
+    config.sensorWidth = 64;
+    config.sensorHeight = 48;
+    config.frameRate = 100.0;
+    SpinCamera camera;
+    camera.Initialize(std::unique_ptr<SpinCameraBackend>(new SpinSimulatedBackend(config)));
+    camera.SetDefaultSettings();
+    camera.SetExposureTime(SpinOption::ExposureTime::Preset_1ms);
+
+    // Never fired: gives up after the timeout and leaves the image alone
+    {
+        SpinTrigger trigger;
+        SpinImage image(nullptr);
+        const auto start = std::chrono::steady_clock::now();
+        const bool captured = camera.CaptureSingleFrameOnTrigger(image, trigger, std::chrono::milliseconds(200));
+        const auto waited = std::chrono::steady_clock::now() - start;
+        SPIN_CHECK(!captured);
+        SPIN_CHECK(image.GetData() == nullptr);
+        SPIN_CHECK(waited >= std::chrono::milliseconds(200));
+        SPIN_CHECK(waited < std::chrono::seconds(5));
+    }
+
+    // Fired from another thread: the frame was exposed after the trigger
+    {
+        SpinTrigger trigger;
+        SpinImage image(nullptr);
+        std::thread firing([&trigger] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            trigger.Fire();
+        });
+        const bool captured = camera.CaptureSingleFrameOnTrigger(image, trigger, std::chrono::seconds(2));
+        firing.join();
+        SPIN_CHECK(captured);
+        SPIN_CHECK(image.GetData() != nullptr);
+        SPIN_CHECK(image.GetWidth() == 64);
+        SPIN_CHECK(image.GetTimeStamp() >= camera.HostToDeviceTime(trigger.GetTriggerTime()));
+    }
+
+    // With pre-roll: a trigger that never fires times out too, one that fires picks buffered frames around it
+    camera.EnablePreRoll(8);
+    {
+        SpinTrigger trigger;
+        std::vector<SpinImage> window;
+        const auto start = std::chrono::steady_clock::now();
+        const bool captured = camera.CaptureFrameWindowOnTrigger(window, trigger, 2, 1, std::chrono::milliseconds(200));
+        const auto waited = std::chrono::steady_clock::now() - start;
+        SPIN_CHECK(!captured);
+        SPIN_CHECK(window.empty());
+        SPIN_CHECK(waited >= std::chrono::milliseconds(200));
+        SPIN_CHECK(waited < std::chrono::seconds(5));
+
+        SpinImage image(nullptr);
+        SPIN_CHECK(!camera.CaptureSingleFrameOnTrigger(image, trigger, std::chrono::milliseconds(100)));
+        SPIN_CHECK(image.GetData() == nullptr);
+    }
+    {
+        SpinTrigger trigger;
+        std::vector<SpinImage> window;
+        std::thread firing([&trigger] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            trigger.Fire();
+        });
+        const bool captured = camera.CaptureFrameWindowOnTrigger(window, trigger, 2, 1, std::chrono::seconds(2));
+        firing.join();
+        SPIN_CHECK(captured);
+        SPIN_CHECK(!window.empty());
+    }
+    camera.DisablePreRoll();
+
+    return TestResult("test_trigger_capture");
+}
@@ -0,0 +1,131 @@
+// Video output of synthetic frames with padded rows: the Y4M header, grey frames byte for byte, RGB through YUV 4:2:0,
+// and bare RGB frames
+#include "../include/SpinnakerSDK_SpinVideoWriter.h"
+#include "test_check.h"
+#include "test_frame.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace {
+    const int kWidth = kTestFrameWidth;
+    const int kHeight = kTestFrameHeight;
+
+    // Frame of rows stride bytes apart, the padding filled with a value that must never show up in the video
+    SpinImage MakePaddedFrame(std::vector<unsigned char>& data, int channels, size_t stride, uint64_t i,
+                              const std::function<unsigned char(int, int, int)>& value) {
+        data.assign(stride * kHeight, 0xEE);
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    data[y * stride + x * channels + c] = value(x, y, c);
+                }
+            }
+        }
+        return MakeTestFrame(data, kWidth, kHeight,
+                             channels == 1 ? Spinnaker::PixelFormatEnums::PixelFormat_Mono8 : Spinnaker::PixelFormatEnums::PixelFormat_RGB8,
+                             stride, 1000 * (i + 1), i);
+    }
+
+    std::string ReadFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+int main() {
+    const std::string filename = "/tmp/test_video_writer_" + std::to_string(getpid());
+    std::vector<unsigned char> data;
+
+    // Grey: the header, then every frame's pixels without the padding
+    {
+        SpinVideoWriter writer;
+        writer.Open(filename + ".y4m");
+        auto value = [](int x, int y, int) { return static_cast<unsigned char>(x + 3 * y); };
+        for (uint64_t i = 0; i < 3; ++i) {
+            SPIN_CHECK(writer.Push(MakePaddedFrame(data, 1, kWidth + 8, i, value)));
+        }
+        writer.Close();
+        SPIN_CHECK(writer.GetStats().framesWritten == 3);
+
+        const std::string video = ReadFile(filename + ".y4m");
+        const std::string header = "YUV4MPEG2 W40 H30 F30000:1000 Ip A1:1 Cmono XCOLORRANGE=FULL\n";
+        const size_t frameSize = 6 + kWidth * kHeight;
+        SPIN_CHECK(video.size() == header.size() + 3 * frameSize);
+        SPIN_CHECK(video.compare(0, header.size(), header) == 0);
+        for (size_t i = 0; i < 3 && video.size() == header.size() + 3 * frameSize; ++i) {
+            const size_t frame = header.size() + i * frameSize;
+            SPIN_CHECK(video.compare(frame, 6, "FRAME\n") == 0);
+            bool match = true;
+            for (int y = 0; y < kHeight; ++y) {
+                for (int x = 0; x < kWidth; ++x) {
+                    match = match && static_cast<unsigned char>(video[frame + 6 + y * kWidth + x]) == value(x, y, 0);
+                }
+            }
+            SPIN_CHECK(match);
+        }
+    }
+
+    // RGB: full range BT.601 4:2:0, pure red is Y 76, U 85, V 255 and white is Y 255, U and V 128
+    {
+        SpinVideoWriter writer;
+        writer.Open(filename + ".y4m");
+        SPIN_CHECK(writer.Push(MakePaddedFrame(data, 3, kWidth * 3 + 5, 0, [](int, int, int c) { return static_cast<unsigned char>(c == 0 ? 255 : 0); })));
+        writer.Close();
+
+        const std::string video = ReadFile(filename + ".y4m");
+        const std::string header = "YUV4MPEG2 W40 H30 F30000:1000 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+        const size_t lumaSize = kWidth * kHeight;
+        const size_t chromaSize = (kWidth / 2) * (kHeight / 2);
+        SPIN_CHECK(video.size() == header.size() + 6 + lumaSize + 2 * chromaSize);
+        SPIN_CHECK(video.compare(0, header.size(), header) == 0);
+        if (video.size() == header.size() + 6 + lumaSize + 2 * chromaSize) {
+            const unsigned char* planes = reinterpret_cast<const unsigned char*>(video.data()) + header.size() + 6;
+            bool match = true;
+            for (size_t i = 0; i < lumaSize; ++i) {
+                match = match && planes[i] == 76;
+            }
+            for (size_t i = 0; i < chromaSize; ++i) {
+                match = match && planes[lumaSize + i] == 85 && planes[lumaSize + chromaSize + i] == 255;
+            }
+            SPIN_CHECK(match);
+        }
+    }
+    {
+        SpinVideoWriter writer;
+        writer.Open(filename + ".y4m");
+        SPIN_CHECK(writer.Push(MakePaddedFrame(data, 3, kWidth * 3 + 5, 0, [](int, int, int) { return static_cast<unsigned char>(255); })));
+        writer.Close();
+        const std::string video = ReadFile(filename + ".y4m");
+        const size_t planes = video.size() - kWidth * kHeight * 3 / 2;
+        SPIN_CHECK(static_cast<unsigned char>(video[planes]) == 255);
+        SPIN_CHECK(static_cast<unsigned char>(video[video.size() - 1]) == 128);
+    }
+
+    // Bare RGB frames, back to back without padding
+    {
+        SpinVideoWriterConfig config;
+        config.container = SpinVideoFormat::Container::RawVideo;
+        SpinVideoWriter writer(config);
+        writer.Open(filename + ".rgb");
+        auto value = [](int x, int y, int c) { return static_cast<unsigned char>(x * 5 + y + c * 80); };
+        SPIN_CHECK(writer.Push(MakePaddedFrame(data, 3, kWidth * 3 + 12, 0, value)));
+        writer.Close();
+        const std::string video = ReadFile(filename + ".rgb");
+        SPIN_CHECK(video.size() == static_cast<size_t>(kWidth * kHeight * 3));
+        bool match = video.size() == static_cast<size_t>(kWidth * kHeight * 3);
+        for (int y = 0; y < kHeight && match; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                for (int c = 0; c < 3; ++c) {
+                    match = match && static_cast<unsigned char>(video[(y * kWidth + x) * 3 + c]) == value(x, y, c);
+                }
+            }
+        }
+        SPIN_CHECK(match);
+    }
+
+    std::remove((filename + ".y4m").c_str());
+    std::remove((filename + ".rgb").c_str());
+    return TestResult("test_video_writer");
+}